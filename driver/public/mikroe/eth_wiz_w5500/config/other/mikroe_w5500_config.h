@@ -56,6 +56,14 @@ extern "C" {
 // <i> Default: 0
 #define W5x00_ETHERNET_LARGE_BUFFERS_ENABLE        0
 
+// <o W5x00_SOCKET_RX_CACHE_SIZE> Socket receive cache size <0-1024>
+// <i>
+// <i> Small reads (byte reads, peeks, UDP headers) fetch up to this many
+// <i> received bytes in one SPI burst and are then served from RAM.
+// <i> One cache is reserved for each socket, 0 disables caching.
+// <i> Default: 64
+#define W5x00_SOCKET_RX_CACHE_SIZE                 64
+
 // <q W5x00_HTTP_SERVER_DEBUG_ENABLE> HTTP Server debug message enable
 // <i>
 // <i> Default: 0
@@ -65,6 +73,18 @@ extern "C" {
 // <i> Default: 1024
 #define W5x00_HTTP_SERVER_BUFFER_SIZE              1024
 
+// <o W5x00_HTTP_SERVER_KEEPALIVE_TIMEOUT_MS> HTTP server keep-alive timeout (ms) <0-60000>
+// <i> Idle time after which a persistent connection is closed.
+// <i> 0 closes every connection after its response.
+// <i> Default: 5000
+#define W5x00_HTTP_SERVER_KEEPALIVE_TIMEOUT_MS     5000
+
+// <o W5x00_DNS_CACHE_SIZE> DNS cache entries <0-32>
+// <i> Number of host names whose address is kept for the TTL of the answer.
+// <i> 0 disables the cache.
+// <i> Default: 4
+#define W5x00_DNS_CACHE_SIZE                       4
+
 // <<< end of configuration section >>>
 
 // <<< sl:start pin_tool >>>
@@ -76,6 +96,12 @@ extern "C" {
 // #define W5500_RESET_PIN                    8
 // [GPIO_W5500_RESET]$
 
+// <gpio optional=true> W5500_INT
+// $[GPIO_W5500_INT]
+// #define W5500_INT_PORT                     gpioPortB
+// #define W5500_INT_PIN                      1
+// [GPIO_W5500_INT]$
+
 // <<< sl:end pin_tool >>>
 
 #ifdef __cplusplus
@@ -55,18 +55,66 @@ extern "C" {
  * @addtogroup DNS
  * @brief  Ethernet DNS client function.
  * @details
+ *    Answers are kept in a cache shared by all DNS instances for the TTL
+ *    given by the server, names that do not exist are remembered for
+ *    W5x00_DNS_NEGATIVE_TTL_S. Several names can be resolved at the same
+ *    time on one UDP socket with @ref w5x00_dns_resolve_start and
+ *    @ref w5x00_dns_resolve_poll. A query that is not answered within
+ *    W5x00_DNS_RETRY_MS is sent to the next server while the previous ones
+ *    may still answer, so a dead server only costs one retry interval.
  * @{
  ******************************************************************************/
 
+/// Number of cached host names, 0 disables the cache
+#ifndef W5x00_DNS_CACHE_SIZE
+#define W5x00_DNS_CACHE_SIZE              4
+#endif
+
+/// Longest host name that is cached
+#define W5x00_DNS_CACHE_NAME_LEN          64
+
+/// Upper limit of the time an answer is cached
+#define W5x00_DNS_MAX_TTL_S               3600
+
+/// Time a non-existent host name is cached
+#define W5x00_DNS_NEGATIVE_TTL_S          30
+
+/// Number of DNS servers of an instance
+#define W5x00_DNS_MAX_SERVERS             3
+
+/// Number of queries in flight on an instance
+#define W5x00_DNS_MAX_QUERIES             4
+
+/// Time before a query is sent to the next server
+#define W5x00_DNS_RETRY_MS                1000
+
+/***************************************************************************//**
+ * @brief
+ *    DNS query definition
+ ******************************************************************************/
+typedef struct
+{
+  const char *hostname;             /// Host name, kept by the caller
+  w5x00_ip4_addr_t address;         /// Resolved address
+  uint32_t start;                   /// Tick of the first request
+  uint32_t last_sent;               /// Tick of the last request
+  uint16_t timeout;                 /// Overall timeout in ms
+  uint16_t id;                      /// Request ID
+  uint8_t state;                    /// Query state
+  uint8_t server;                   /// Server asked last
+} w5x00_dns_query_t;
+
 /***************************************************************************//**
  * @brief
  *    DNS client object definition
  ******************************************************************************/
 typedef struct
 {
-  w5x00_ip4_addr_t dns_server;      /// DNS server ip address
+  w5x00_ip4_addr_t dns_server[W5x00_DNS_MAX_SERVERS]; /// DNS server ip addresses
+  uint8_t server_count;             /// Number of DNS servers
   uint16_t request_id;              /// Request ID
   w5x00_ethernet_udp_t udp_socket;  /// UDP socket
+  w5x00_dns_query_t query[W5x00_DNS_MAX_QUERIES]; /// Queries
 } w5x00_dns_t;
 
 /***************************************************************************//**
@@ -101,6 +149,81 @@ sl_status_t w5x00_dns_get_host_by_name(w5x00_dns_t *dns,
                                        w5x00_ip4_addr_t *a_result,
                                        uint16_t timeout);
 
+/***************************************************************************//**
+ * @brief
+ *    Add a DNS server to fail over to
+ * @param[in] dns
+ *    DNS instance
+ * @param[in] server
+ *    DNS Server IP
+ * @return
+ *    @ref SL_STATUS_OK on success,
+ *    @ref SL_STATUS_NO_MORE_RESOURCE if W5x00_DNS_MAX_SERVERS are set.
+ ******************************************************************************/
+sl_status_t w5x00_dns_add_server(w5x00_dns_t *dns,
+                                 const w5x00_ip4_addr_t server);
+
+/***************************************************************************//**
+ * @brief
+ *    Start resolving a host name without waiting
+ * @param[in] dns
+ *    DNS instance
+ * @param[in] a_hostname
+ *    hostname, must stay valid until the query is finished
+ * @param[out] a_result
+ *    IP address of the hostname if it is known already
+ * @param[out] handle
+ *    Query handle for @ref w5x00_dns_resolve_poll
+ * @param[in] timeout
+ *    Time to wait for an answer in ms
+ * @return
+ *    @ref SL_STATUS_OK if a_result is set (numeric address or cached),
+ *    @ref SL_STATUS_IN_PROGRESS if a query has been sent,
+ *    @ref SL_STATUS_NOT_FOUND if the name is cached as non-existent,
+ *    @ref SL_STATUS_NO_MORE_RESOURCE if W5x00_DNS_MAX_QUERIES are in flight,
+ *    @ref SL_STATUS_FAIL on failure.
+ ******************************************************************************/
+sl_status_t w5x00_dns_resolve_start(w5x00_dns_t *dns,
+                                    const char *a_hostname,
+                                    w5x00_ip4_addr_t *a_result,
+                                    uint8_t *handle,
+                                    uint16_t timeout);
+
+/***************************************************************************//**
+ * @brief
+ *    Process answers and retries, then get the state of a query
+ * @details
+ *    A query that has finished is released by this call.
+ * @param[in] dns
+ *    DNS instance
+ * @param[in] handle
+ *    Query handle from @ref w5x00_dns_resolve_start
+ * @param[out] a_result
+ *    IP address of the hostname
+ * @return
+ *    @ref SL_STATUS_OK if a_result is set,
+ *    @ref SL_STATUS_IN_PROGRESS if there is no answer yet,
+ *    @ref SL_STATUS_NOT_FOUND if the name does not exist,
+ *    @ref SL_STATUS_TIMEOUT if no server answered in time.
+ ******************************************************************************/
+sl_status_t w5x00_dns_resolve_poll(w5x00_dns_t *dns,
+                                   uint8_t handle,
+                                   w5x00_ip4_addr_t *a_result);
+
+/***************************************************************************//**
+ * @brief
+ *    Cancel all queries and release the UDP socket
+ * @param[in] dns
+ *    DNS instance
+ ******************************************************************************/
+void w5x00_dns_stop(w5x00_dns_t *dns);
+
+/***************************************************************************//**
+ * @brief
+ *    Forget all cached host names
+ ******************************************************************************/
+void w5x00_dns_cache_flush(void);
+
 /** @} (end group DNS) */
 #ifdef __cplusplus
 }
@@ -0,0 +1,172 @@
+/***************************************************************************//**
+ * @file http_parser.h
+ * @brief Incremental HTTP request parser.
+ * @version 0.0.1
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided \'as-is\', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ *
+ * EVALUATION QUALITY
+ * This code has been minimally tested to ensure that it builds with the
+ * specified dependency versions and is suitable as a demonstration for
+ * evaluation purposes only.
+ * This code will be maintained at the sole discretion of Silicon Labs.
+ *
+ ******************************************************************************/
+#ifndef HTTP_PARSER_H_
+#define HTTP_PARSER_H_
+
+#include <stdint.h>
+#include "sl_status.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************************************************************//**
+ * @defgroup HTTP_Parser HTTP Request Parser
+ ******************************************************************************/
+
+/***************************************************************************//**
+ * @addtogroup HTTP_Parser
+ * @brief  Incremental, allocation-free HTTP request parser.
+ * @details
+ *    The request head is parsed in a single pass with constant work per
+ *    byte and may be fed in chunks of any size, e.g. straight from a socket
+ *    receive buffer. Only the method, the URI, the protocol version and the
+ *    header fields the web server acts on are kept:
+ *    Content-Length, Connection, Accept-Encoding and If-None-Match.
+ * @{
+ ******************************************************************************/
+
+/// Request methods
+#define W5x00_HTTP_PARSER_METHOD_OTHER    0 ///< Not supported method
+#define W5x00_HTTP_PARSER_METHOD_GET      1 ///< GET
+#define W5x00_HTTP_PARSER_METHOD_HEAD     2 ///< HEAD
+#define W5x00_HTTP_PARSER_METHOD_POST     3 ///< POST
+
+/// Request flags
+#define W5x00_HTTP_PARSER_KEEP_ALIVE      0x01 ///< Connection stays open
+#define W5x00_HTTP_PARSER_ACCEPT_GZIP     0x02 ///< Client accepts gzip
+
+/// Entity tag length kept from If-None-Match
+#define W5x00_HTTP_PARSER_MAX_ETAG_LEN    32
+
+/// HTTP request parser state
+typedef struct {
+  uint8_t state;           ///< Parser state
+  uint8_t method;          ///< Request method, W5x00_HTTP_PARSER_METHOD_...
+  uint8_t version_minor;   ///< Minor version of HTTP/1.x
+  uint8_t flags;           ///< Request flags, W5x00_HTTP_PARSER_...
+  uint8_t tokens;          ///< Connection tokens seen
+  uint8_t header;          ///< Header field being parsed
+  uint8_t candidates;      ///< Names still matching the current token
+  uint8_t index;           ///< Position in the current token
+  uint8_t match[2];        ///< Position in the searched value tokens
+  char *uri;               ///< URI path, then query after a null byte
+  uint16_t uri_size;       ///< Size of the URI buffer
+  uint16_t uri_len;        ///< Number of bytes stored in the URI buffer
+  uint16_t query;          ///< Offset of the query in uri, 0 if none
+  uint32_t content_length; ///< Content-Length of the request body
+  uint8_t etag_len;        ///< Length of if_none_match
+  char if_none_match[W5x00_HTTP_PARSER_MAX_ETAG_LEN]; ///< If-None-Match value
+} w5x00_http_parser_t;
+
+/***************************************************************************//**
+ * @brief
+ *    Prepare a parser for a new request
+ * @param[out] parser
+ *    Parser instance
+ * @param[in] uri
+ *    Buffer for the URI path and query, both null terminated
+ * @param[in] uri_size
+ *    Size of the URI buffer
+ ******************************************************************************/
+void w5x00_http_parser_init(w5x00_http_parser_t *parser,
+                            char *uri,
+                            uint16_t uri_size);
+
+/***************************************************************************//**
+ * @brief
+ *    Feed the next part of a request head
+ * @param[in] parser
+ *    Parser instance
+ * @param[in] data
+ *    Received data
+ * @param[in] len
+ *    Length of the received data
+ * @param[out] used
+ *    Number of bytes taken from data, the request body or a pipelined
+ *    request starts after them once the head is complete
+ * @return
+ *    @ref SL_STATUS_OK when the head is complete,
+ *    @ref SL_STATUS_IN_PROGRESS if more data is needed,
+ *    @ref SL_STATUS_WOULD_OVERFLOW if the URI does not fit its buffer,
+ *    @ref SL_STATUS_FAIL if the request is malformed.
+ ******************************************************************************/
+sl_status_t w5x00_http_parser_feed(w5x00_http_parser_t *parser,
+                                   const uint8_t *data,
+                                   uint16_t len,
+                                   uint16_t *used);
+
+/***************************************************************************//**
+ * @brief
+ *    Get the query of the parsed URI
+ * @param[in] parser
+ *    Parser instance
+ * @return
+ *    Query string without '?', NULL if the URI has none
+ ******************************************************************************/
+const char *w5x00_http_parser_get_query(const w5x00_http_parser_t *parser);
+
+/***************************************************************************//**
+ * @brief
+ *    Get a parameter of a query or form encoded body
+ * @details
+ *    Scans "name=value&..." once, the value is URL decoded.
+ * @param[in] params
+ *    Query string or application/x-www-form-urlencoded body
+ * @param[in] name
+ *    Parameter name
+ * @param[out] value
+ *    Decoded value, null terminated
+ * @param[in] size
+ *    Size of the value buffer
+ * @return
+ *    @ref SL_STATUS_OK on success,
+ *    @ref SL_STATUS_NOT_FOUND if the parameter is not present,
+ *    @ref SL_STATUS_WOULD_OVERFLOW if the value was truncated.
+ ******************************************************************************/
+sl_status_t w5x00_http_parser_get_param(const char *params,
+                                        const char *name,
+                                        char *value,
+                                        uint16_t size);
+
+/** @} (end group HTTP_Parser) */
+#ifdef __cplusplus
+}
+#endif
+#endif // HTTP_PARSER_H_
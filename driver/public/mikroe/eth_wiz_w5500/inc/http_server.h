@@ -39,6 +39,7 @@
 
 #include <stdint.h>
 #include "w5x00.h"
+#include "http_parser.h"
 
 #ifndef  HTTP_SERVER_H__
 #define  HTTP_SERVER_H__
@@ -83,6 +84,18 @@ extern "C" {
 #define W5x00_HTTP_MAX_CLIENT                     W5x00_MAX_SOCK_NUM
 #endif
 
+/// Idle time before a persistent connection is closed, 0 disables keep-alive
+#ifndef W5x00_HTTP_SERVER_KEEPALIVE_TIMEOUT_MS
+#define W5x00_HTTP_SERVER_KEEPALIVE_TIMEOUT_MS    5000
+#endif
+
+/// HTTP entity tag length
+#define W5x00_HTTP_SERVER_MAX_ETAG_LEN            W5x00_HTTP_PARSER_MAX_ETAG_LEN
+
+/// HTTP request flags
+#define HTTP_REQUEST_KEEP_ALIVE                   W5x00_HTTP_PARSER_KEEP_ALIVE  ///< Connection stays open
+#define HTTP_REQUEST_ACCEPT_GZIP                  W5x00_HTTP_PARSER_ACCEPT_GZIP ///< Client accepts gzip
+
 /// HTTP Process states list
 enum STATE_HTTP {
   STATE_HTTP_IDLE       = 0,   ///< IDLE, Waiting for data received (TCP established)
@@ -96,7 +109,11 @@ enum STATE_HTTP {
 typedef struct {
   uint8_t method;                               ///< request method #STATE_HTTP value enum
   uint8_t type;                                 ///< request type(PTYPE_HTML...).
+  uint8_t flags;                                ///< request flags (HTTP_REQUEST_...)
+  char if_none_match[W5x00_HTTP_SERVER_MAX_ETAG_LEN]; ///< If-None-Match header
   uint8_t uri[W5x00_HTTP_SERVER_MAX_URI_SIZE];  ///< request file name.
+  const char *query;                            ///< URI query, NULL if none
+  const char *body;                             ///< Request body, null terminated
 } w5x00_http_request_t;
 
 /// HTTP socket state
@@ -107,6 +124,11 @@ typedef struct {
   uint32_t file_id;                                          ///< Content file ID
   uint32_t file_len;                                         ///< Content file total length
   uint32_t file_offset;                                      ///< Content file offset
+  uint8_t keep_alive;                                        ///< Connection is persistent
+  uint32_t last_activity;                                    ///< Tick of the last response
+  w5x00_http_request_t request;                              ///< Request being received
+  w5x00_http_parser_t parser;                                ///< Parser of the request head
+  uint16_t request_offset;                                   ///< Request bytes parsed so far
 } w5x00_http_socket_t;
 
 /***************************************************************************//**
@@ -167,6 +189,25 @@ typedef uint16_t (*w5x00_http_read_web_content_t)(uint32_t file_id,
  ******************************************************************************/
 typedef void (*w5x00_http_close_web_content_t)(uint32_t file_id);
 
+/***************************************************************************//**
+ * @brief
+ *    Get entity tag of a content file callback type (HTTP GET request)
+ * @details
+ *    Optional. Without it a weak tag is made from the file id and length.
+ * @param[in] file_id
+ *    Content file id
+ * @param[out] etag
+ *    Quoted entity tag, e.g. "\"v1.2\""
+ * @param[in] size
+ *    Size of the etag buffer
+ * @return
+ *    1 on success
+ *    0 if the content has no entity tag
+ ******************************************************************************/
+typedef uint8_t (*w5x00_http_get_web_content_etag_t)(uint32_t file_id,
+                                                     char *etag,
+                                                     uint16_t size);
+
 /***************************************************************************//**
  * @brief
  *    Read CGI content callback type (HTTP GET request)
@@ -213,6 +254,7 @@ typedef struct {
   w5x00_http_close_web_content_t close_web_content; ///< Close web content file
   w5x00_http_get_cgi_handler_t get_cgi_handler;     ///< Get CGI
   w5x00_http_post_cgi_handler_t post_cgi_handler;   ///< Post CGI
+  w5x00_http_get_web_content_etag_t get_web_content_etag; ///< Entity tag, may be NULL
 } w5x00_http_server_callback_t;
 
 /// HTTP server object defination
@@ -220,6 +262,7 @@ typedef struct {
   w5x00_http_socket_t socket[W5x00_HTTP_MAX_CLIENT];  ///< Socket state
   uint16_t port;                                      ///< Listen port
   const w5x00_http_server_callback_t *callback;       ///< Callback
+  const char *query;                                  ///< Query of the request in process
   uint8_t buf[W5x00_HTTP_SERVER_BUFFER_SIZE];         ///< Buffer to parse the request
 } w5x00_http_server_t;
 
@@ -240,6 +283,13 @@ sl_status_t w5x00_http_server_init(w5x00_http_server_t *http,
 /***************************************************************************//**
  * @brief
  *    Run server on 1 socket
+ * @details
+ *    Never waits for the network: a response body is written as far as the
+ *    TX buffer of the socket takes it and continued by the next run.
+ *    Connections are kept open for further (pipelined) requests unless the
+ *    client asks otherwise or stays idle for
+ *    W5x00_HTTP_SERVER_KEEPALIVE_TIMEOUT_MS. If the client accepts gzip,
+ *    "<name>.gz" is served in place of "<name>" when it can be opened.
  * @param[in] http
  *    HTTP server instance
  * @param[in] s
@@ -259,6 +309,30 @@ sl_status_t w5x00_http_server_socket_run(w5x00_http_server_t *http, uint8_t s);
  ******************************************************************************/
 sl_status_t w5x00_http_server_run(w5x00_http_server_t *http);
 
+/***************************************************************************//**
+ * @brief
+ *    Get a query parameter of the request in process
+ * @details
+ *    Only valid inside the CGI callbacks. Form encoded POST bodies are
+ *    decoded with @ref w5x00_http_parser_get_param.
+ * @param[in] http
+ *    HTTP server instance
+ * @param[in] name
+ *    Parameter name
+ * @param[out] value
+ *    URL decoded value, null terminated
+ * @param[in] size
+ *    Size of the value buffer
+ * @return
+ *    @ref SL_STATUS_OK on success,
+ *    @ref SL_STATUS_NOT_FOUND if the request has no such parameter,
+ *    @ref SL_STATUS_WOULD_OVERFLOW if the value was truncated.
+ ******************************************************************************/
+sl_status_t w5x00_http_server_get_param(const w5x00_http_server_t *http,
+                                        const char *name,
+                                        char *value,
+                                        uint16_t size);
+
 /** @} (end group HTTP) */
 #ifdef __cplusplus
 }
@@ -57,6 +57,15 @@ extern "C" {
  * @{
  ******************************************************************************/
 
+/***************************************************************************//**
+ * @brief
+ *    Data fragment for scatter-gather sending
+ ******************************************************************************/
+typedef struct {
+  const uint8_t *data;  ///< Fragment data
+  uint16_t len;         ///< Fragment length
+} w5x00_iovec_t;
+
 /***************************************************************************//**
  * @brief
  *    Initialize random local port for socket
@@ -230,6 +239,41 @@ int w5x00_socket_recv(w5x00_socket_t s, uint8_t *buf, int16_t len);
  ******************************************************************************/
 uint16_t w5x00_socket_recv_available(w5x00_socket_t s);
 
+/***************************************************************************//**
+ * @brief
+ *    Read received data without consuming it
+ * @details
+ *    Gives a parser a window into the receive buffer of the chip. Data is
+ *    only released with @ref w5x00_socket_recv_consume, so a parser can
+ *    look ahead and consume exactly what it has processed.
+ * @param[in] s
+ *    Socket number
+ * @param[in] offset
+ *    Offset from the first unconsumed byte
+ * @param[out] buf
+ *    Pointer to receive buffer
+ * @param[in] len
+ *    Number of bytes to read
+ * @return
+ *    Number of bytes read, 0 if no data is available at the offset
+ ******************************************************************************/
+uint16_t w5x00_socket_recv_peek(w5x00_socket_t s,
+                                uint16_t offset,
+                                uint8_t *buf,
+                                uint16_t len);
+
+/***************************************************************************//**
+ * @brief
+ *    Release received data without reading it
+ * @param[in] s
+ *    Socket number
+ * @param[in] len
+ *    Number of bytes to release
+ * @return
+ *    Number of bytes released
+ ******************************************************************************/
+uint16_t w5x00_socket_recv_consume(w5x00_socket_t s, uint16_t len);
+
 /***************************************************************************//**
  * @brief
  *    Get the first byte in the receive queue (no checking)
@@ -255,13 +299,128 @@ uint16_t w5x00_socket_send(w5x00_socket_t s,
                            const uint8_t *buf,
                            uint16_t len);
 
+/***************************************************************************//**
+ * @brief
+ *    Queue data for sending in TCP mode without waiting
+ * @details
+ *    As much data as fits into the free space of the TX buffer is copied,
+ *    the SEND command is issued and the function returns without waiting
+ *    for SEND_OK. While a SEND is running, the data is copied behind it
+ *    without touching Sn_TX_WR, and all data queued meanwhile follows with
+ *    one SEND when @ref w5x00_socket_send_poll or the event layer reaps
+ *    SEND_OK. Up to the free TX space at the start of the running SEND can
+ *    be queued that way.
+ * @param[in] s
+ *    Socket number
+ * @param[in] buf
+ *    Pointer to send buffer
+ * @param[in] len
+ *    Size of send buffer
+ * @return
+ *    Number of bytes queued, 0 if the TX buffer is full or the connection is
+ *    not established
+ ******************************************************************************/
+uint16_t w5x00_socket_send_nonblocking(w5x00_socket_t s,
+                                       const uint8_t *buf,
+                                       uint16_t len);
+
+/***************************************************************************//**
+ * @brief
+ *    Copy data into the TX buffer in TCP mode without sending it
+ * @details
+ *    Like @ref w5x00_socket_send_nonblocking, but no SEND is issued, so
+ *    several pieces can go out with one SEND of
+ *    @ref w5x00_socket_send_flush.
+ * @param[in] s
+ *    Socket number
+ * @param[in] buf
+ *    Pointer to send buffer
+ * @param[in] len
+ *    Size of send buffer
+ * @return
+ *    Number of bytes queued, 0 if the TX buffer is full or the connection is
+ *    not established
+ ******************************************************************************/
+uint16_t w5x00_socket_send_queue(w5x00_socket_t s,
+                                 const uint8_t *buf,
+                                 uint16_t len);
+
+/***************************************************************************//**
+ * @brief
+ *    Send the data copied by @ref w5x00_socket_send_queue
+ * @details
+ *    If a SEND is running, the data follows when its SEND_OK is reaped.
+ * @param[in] s
+ *    Socket number
+ ******************************************************************************/
+void w5x00_socket_send_flush(w5x00_socket_t s);
+
+/***************************************************************************//**
+ * @brief
+ *    Queue several data fragments for sending in TCP mode without waiting
+ * @details
+ *    The fragments are written from their own buffers directly into the TX
+ *    buffer, one bus transfer each, and sent together with a single SEND,
+ *    e.g. a response header and a body that is kept elsewhere. Nothing is
+ *    queued unless all fragments fit into the free TX space; retry after
+ *    @ref w5x00_socket_send_poll has reported progress. See
+ *    @ref w5x00_socket_send_nonblocking for data queued behind a running
+ *    SEND.
+ * @param[in] s
+ *    Socket number
+ * @param[in] iov
+ *    Array of fragments
+ * @param[in] iovcnt
+ *    Number of fragments
+ * @return
+ *    Total number of bytes queued, 0 if they do not fit or the connection
+ *    is not established
+ ******************************************************************************/
+uint16_t w5x00_socket_send_iov(w5x00_socket_t s,
+                               const w5x00_iovec_t *iov,
+                               uint8_t iovcnt);
+
+/***************************************************************************//**
+ * @brief
+ *    Progress the sending of data queued by
+ *    @ref w5x00_socket_send_nonblocking
+ * @details
+ *    Reaps SEND_OK and issues the SEND for the data queued behind the
+ *    completed one. Call it from the main loop or when the socket SEND_OK
+ *    interrupt occurs.
+ * @param[in] s
+ *    Socket number
+ * @return
+ *    @ref SL_STATUS_OK if all queued data has been sent,
+ *    @ref SL_STATUS_IN_PROGRESS if a SEND is still running or was issued
+ *    for further queued data,
+ *    @ref SL_STATUS_FAIL on timeout or if the socket was closed.
+ ******************************************************************************/
+sl_status_t w5x00_socket_send_poll(w5x00_socket_t s);
+
+/***************************************************************************//**
+ * @brief
+ *    Handle a SEND_OK interrupt that the caller already read and cleared
+ * @details
+ *    Used by the event layer, which clears all socket interrupts at once.
+ *    Data queued behind the completed SEND is sent.
+ * @param[in] s
+ *    Socket number
+ * @return
+ *    @ref SL_STATUS_OK, @ref SL_STATUS_IN_PROGRESS if a SEND was issued for
+ *    further queued data
+ ******************************************************************************/
+sl_status_t w5x00_socket_send_complete(w5x00_socket_t s);
+
 /***************************************************************************//**
  * @brief
  *    Get available size of socket send queue
  * @param[in] s
  *    Socket number
  * @return
- *    Size of send queue
+ *    Size of send queue. While a SEND issued by
+ *    @ref w5x00_socket_send_nonblocking or @ref w5x00_socket_send_iov is
+ *    running, the space that can still be queued behind it
  ******************************************************************************/
 uint16_t w5x00_socket_send_available(w5x00_socket_t s);
 
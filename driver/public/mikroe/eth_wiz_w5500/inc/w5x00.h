@@ -171,18 +171,83 @@ uint16_t  w5x00_get_CH_BASE_MSB(void);
 
 /***************************************************************************//**
  * @brief
- *    Get socket data pointer mask (read & write)
+ *    Set the buffer size of every socket
+ * @details
+ *    By default every socket gets the same share of the buffer memory.
+ *    Each entry is the buffer size in KB, 0, 1, 2, 4, 8 or 16, and the
+ *    sizes of each direction must not exceed 16 KB in total (W5100: 1, 2,
+ *    4 or 8 for the first 4 sockets, 8 KB in total). Call after
+ *    @ref w5x00_init while all sockets are closed. Example for an HTTP file
+ *    socket and small DNS/NTP sockets:
+ *    rx_kb = { 8, 2, 1, 1, 1, 1, 1, 1 }, tx_kb = { 8, 2, 1, 1, 1, 1, 1, 1 }
+ * @param[in] rx_kb
+ *    Receive buffer size of each socket, @ref W5x00_MAX_SOCK_NUM entries
+ * @param[in] tx_kb
+ *    Send buffer size of each socket, @ref W5x00_MAX_SOCK_NUM entries
+ * @return
+ *    @ref SL_STATUS_OK on success. @ref SL_STATUS_INVALID_PARAMETER if the
+ *    sizes are not supported, the default sizes are restored then.
+ ******************************************************************************/
+sl_status_t w5x00_set_socket_buffer_sizes(const uint8_t *rx_kb,
+                                          const uint8_t *tx_kb);
+
+/***************************************************************************//**
+ * @brief
+ *    Get the send buffer size of a socket
+ * @param[in] socknum
+ *    Socket number
  * @return
- *    Socket data pointer mask (read & write)
+ *    Send buffer size in bytes
  ******************************************************************************/
-uint16_t w5x00_get_SMASK(void);
+uint16_t w5x00_get_socket_tx_size(uint8_t socknum);
 
 /***************************************************************************//**
  * @brief
- *    Get socket buffer size
+ *    Get the receive buffer size of a socket
+ * @param[in] socknum
+ *    Socket number
  * @return
+ *    Receive buffer size in bytes
+ ******************************************************************************/
+uint16_t w5x00_get_socket_rx_size(uint8_t socknum);
+
+/***************************************************************************//**
+ * @brief
+ *    Write to the send buffer of a socket
+ * @param[in] socknum
+ *    Socket number
+ * @param[in] ptr
+ *    Buffer pointer as used by Sn_TX_WR, wraps at the socket buffer size
+ * @param[in] buf
+ *    Pointer to data buffer which is to be written
+ * @param[in] len
+ *    Number of bytes to write
+ * @return
+ *    Length of written data on success, 0 on failure
+ ******************************************************************************/
+uint16_t w5x00_write_tx_buffer(uint8_t socknum,
+                               uint16_t ptr,
+                               const uint8_t *buf,
+                               uint16_t len);
+
+/***************************************************************************//**
+ * @brief
+ *    Read from the receive buffer of a socket
+ * @param[in] socknum
+ *    Socket number
+ * @param[in] ptr
+ *    Buffer pointer as used by Sn_RX_RD, wraps at the socket buffer size
+ * @param[out] buf
+ *    Pointer to data buffer to store the read data
+ * @param[in] len
+ *    Number of bytes to read
+ * @return
+ *    Length of read data on success, 0 on failure
  ******************************************************************************/
-uint16_t w5x00_get_SSIZE(void);
+uint16_t w5x00_read_rx_buffer(uint8_t socknum,
+                              uint16_t ptr,
+                              uint8_t *buf,
+                              uint16_t len);
 
 /***************************************************************************//**
  * @brief
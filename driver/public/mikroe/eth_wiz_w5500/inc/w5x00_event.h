@@ -0,0 +1,151 @@
+/***************************************************************************//**
+ * @file w5x00_event.h
+ * @brief Wiznet interrupt driven socket events.
+ * @version 0.0.1
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided \'as-is\', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ *
+ * EVALUATION QUALITY
+ * This code has been minimally tested to ensure that it builds with the
+ * specified dependency versions and is suitable as a demonstration for
+ * evaluation purposes only.
+ * This code will be maintained at the sole discretion of Silicon Labs.
+ *
+ ******************************************************************************/
+#ifndef W5x00_EVENT_H_
+#define W5x00_EVENT_H_
+
+#include <stdbool.h>
+#include "sl_status.h"
+#include "w5x00.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************************************************************//**
+ * @defgroup Event Socket Events
+ ******************************************************************************/
+
+/***************************************************************************//**
+ * @addtogroup Event
+ * @brief  Interrupt driven socket events (W5500 only).
+ * @details
+ *    The chip signals socket events through SIR/SnIR and its INTn pin. When
+ *    the mikroe_eth_wiz_int component is installed and
+ *    W5500_INT_PORT/W5500_INT_PIN are configured, the INTn falling edge
+ *    marks events as pending and @ref w5x00_event_process does not access
+ *    the bus at all while the link is idle. Without the pin every call
+ *    reads the interrupt registers in a single transfer.
+ * @{
+ ******************************************************************************/
+
+/***************************************************************************//**
+ * @brief
+ *    Socket event callback
+ * @param[in] s
+ *    Socket number
+ * @param[in] events
+ *    #SnIR bits that occurred and have been cleared
+ * @param[in] context
+ *    Context passed to @ref w5x00_event_register
+ ******************************************************************************/
+typedef void (*w5x00_event_callback_t)(w5x00_socket_t s,
+                                       uint8_t events,
+                                       void *context);
+
+/***************************************************************************//**
+ * @brief
+ *    Init the event layer
+ * @details
+ *    Masks all socket interrupts and configures the INTn GPIO interrupt
+ *    when available. Call after @ref w5x00_init.
+ * @return
+ *    @ref SL_STATUS_OK on success,
+ *    @ref SL_STATUS_NOT_SUPPORTED if the chip is not a W5500.
+ ******************************************************************************/
+sl_status_t w5x00_event_init(void);
+
+/***************************************************************************//**
+ * @brief
+ *    Register a callback for socket events
+ * @details
+ *    Writes the socket interrupt mask Sn_IMR and enables the socket in SIMR.
+ *    Events of the mask that are already set are dropped, except SEND_OK.
+ *    SnIR_SEND_OK is always handled internally to progress
+ *    @ref w5x00_socket_send_nonblocking, it is passed to the callback only
+ *    if it is part of the mask.
+ * @param[in] s
+ *    Socket number
+ * @param[in] mask
+ *    #SnIR bits to report
+ * @param[in] callback
+ *    Callback, called from @ref w5x00_event_process
+ * @param[in] context
+ *    Context passed to the callback
+ * @return
+ *    @ref SL_STATUS_OK on success or @ref SL_STATUS_INVALID_PARAMETER
+ ******************************************************************************/
+sl_status_t w5x00_event_register(w5x00_socket_t s,
+                                 uint8_t mask,
+                                 w5x00_event_callback_t callback,
+                                 void *context);
+
+/***************************************************************************//**
+ * @brief
+ *    Stop reporting events of a socket
+ * @param[in] s
+ *    Socket number
+ ******************************************************************************/
+void w5x00_event_unregister(w5x00_socket_t s);
+
+/***************************************************************************//**
+ * @brief
+ *    Check if @ref w5x00_event_process has to read the interrupt registers
+ * @return
+ *    With the INTn pin (mikroe_eth_wiz_int component and W5500_INT_PORT/PIN
+ *    configured), true once INTn has fallen since the last
+ *    @ref w5x00_event_process. Without it, true whenever a socket is
+ *    registered, as the registers have to be polled; false before
+ *    @ref w5x00_event_init or with no socket registered.
+ ******************************************************************************/
+bool w5x00_event_pending(void);
+
+/***************************************************************************//**
+ * @brief
+ *    Read, clear and dispatch pending socket events
+ * @details
+ *    Must be called from the main loop, not from interrupt context, as the
+ *    callbacks use the bus.
+ ******************************************************************************/
+void w5x00_event_process(void);
+
+/** @} (end group Event) */
+#ifdef __cplusplus
+}
+#endif
+#endif /* W5x00_EVENT_H_ */
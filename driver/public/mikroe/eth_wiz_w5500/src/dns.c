@@ -38,6 +38,7 @@
  ******************************************************************************/
 
 #include <stddef.h>
+#include <string.h>
 #include "ethernet.h"
 #include "dns.h"
 #include "w5x00.h"
@@ -79,14 +80,54 @@
 #define INVALID_SERVER           -2
 #define TRUNCATED                -3
 #define INVALID_RESPONSE         -4
+#define NAME_ERROR               -5
+
+// Query states
+#define QUERY_FREE               0
+#define QUERY_PENDING            1
+#define QUERY_RESOLVED           2
+#define QUERY_NOT_FOUND          3
+#define QUERY_TIMED_OUT          4
+
+// Cache entry states
+#define CACHE_EMPTY              0
+#define CACHE_POSITIVE           1
+#define CACHE_NEGATIVE           2
+
+// Time to wait between checks of the blocking resolution
+#define POLL_INTERVAL_MS         10
+
+typedef struct {
+  char name[W5x00_DNS_CACHE_NAME_LEN];
+  w5x00_ip4_addr_t address;
+  uint32_t expiry;
+  uint8_t state;
+} dns_cache_entry_t;
+
+#if W5x00_DNS_CACHE_SIZE > 0
+// Shared by all instances, protocol clients resolve with short lived ones
+static dns_cache_entry_t dns_cache[W5x00_DNS_CACHE_SIZE];
+#endif
 
 // -----------------------------------------------------------------------------
 // Private function declarations
 
-static uint16_t build_request(w5x00_dns_t *dns, const char *a_name);
-static uint16_t process_response(w5x00_dns_t *dns,
-                                 uint16_t a_timeout,
-                                 w5x00_ip4_addr_t *a_address);
+static uint16_t build_request(w5x00_dns_t *dns,
+                              uint16_t id,
+                              const char *a_name);
+static int process_response(w5x00_dns_t *dns,
+                            const uint16_t *header,
+                            w5x00_ip4_addr_t *a_address,
+                            uint32_t *ttl);
+static sl_status_t send_query(w5x00_dns_t *dns, w5x00_dns_query_t *query);
+static void process_queries(w5x00_dns_t *dns);
+static void receive_responses(w5x00_dns_t *dns);
+static int8_t find_server(w5x00_dns_t *dns, w5x00_ip4_addr_t ip);
+static uint8_t cache_lookup(const char *name, w5x00_ip4_addr_t *address);
+static void cache_insert(const char *name,
+                         const w5x00_ip4_addr_t *address,
+                         uint32_t ttl);
+static bool name_equal(const char *a, const char *b);
 
 // -----------------------------------------------------------------------------
 // Public function definitions
@@ -96,99 +137,414 @@ static uint16_t process_response(w5x00_dns_t *dns,
  ******************************************************************************/
 sl_status_t w5x00_dns_init(w5x00_dns_t *dns,
                            const w5x00_ip4_addr_t a_dns_server)
+{
+  uint8_t i;
+
+  if (dns == NULL) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+  dns->dns_server[0] = a_dns_server;
+  dns->server_count = 1;
+  dns->request_id = w5x00_get_tick_ms();
+  for (i = 0; i < W5x00_DNS_MAX_QUERIES; i++) {
+    dns->query[i].state = QUERY_FREE;
+  }
+  return ethernet_udp_init(&dns->udp_socket);
+}
+
+/***************************************************************************//**
+ * DNS Add Server.
+ ******************************************************************************/
+sl_status_t w5x00_dns_add_server(w5x00_dns_t *dns,
+                                 const w5x00_ip4_addr_t server)
 {
   if (dns == NULL) {
     return SL_STATUS_INVALID_PARAMETER;
   }
-  dns->dns_server = a_dns_server;
-  dns->request_id = 0;
+  if (dns->server_count >= W5x00_DNS_MAX_SERVERS) {
+    return SL_STATUS_NO_MORE_RESOURCE;
+  }
+  dns->dns_server[dns->server_count++] = server;
   return SL_STATUS_OK;
 }
 
-sl_status_t w5x00_dns_get_host_by_name(w5x00_dns_t *dns,
-                                       const char *a_hostname,
-                                       w5x00_ip4_addr_t *a_result,
-                                       uint16_t timeout)
+/***************************************************************************//**
+ * DNS Resolve Start.
+ ******************************************************************************/
+sl_status_t w5x00_dns_resolve_start(w5x00_dns_t *dns,
+                                    const char *a_hostname,
+                                    w5x00_ip4_addr_t *a_result,
+                                    uint8_t *handle,
+                                    uint16_t timeout)
 {
-  int ret = 0;
+  w5x00_dns_query_t *query = NULL;
   sl_status_t result;
+  uint8_t i;
 
-  if (dns == NULL) {
+  if ((dns == NULL) || (a_hostname == NULL)
+      || (a_result == NULL) || (handle == NULL)) {
     return SL_STATUS_INVALID_PARAMETER;
   }
   // See if it's a numeric IP address
   if (w5x00_ip4addr_aton(a_hostname, a_result)) {
     // It is, our work here is done
-    return 1;
+    return SL_STATUS_OK;
+  }
+  switch (cache_lookup(a_hostname, a_result)) {
+    case CACHE_POSITIVE:
+      return SL_STATUS_OK;
+    case CACHE_NEGATIVE:
+      return SL_STATUS_NOT_FOUND;
+    default:
+      break;
   }
 
   // Check we've got a valid DNS server to use
-  if (dns->dns_server.addr == WIZNET_IPADDR_NONE) {
+  if (!dns->server_count
+      || (dns->dns_server[0].addr == WIZNET_IPADDR_NONE)) {
     return SL_STATUS_INVALID_PARAMETER;
   }
+  for (i = 0; i < W5x00_DNS_MAX_QUERIES; i++) {
+    if (dns->query[i].state == QUERY_FREE) {
+      query = &dns->query[i];
+      break;
+    }
+  }
+  if (query == NULL) {
+    return SL_STATUS_NO_MORE_RESOURCE;
+  }
 
-  // Find a socket to use
-  result = w5x00_ethernet_udp_begin(&dns->udp_socket,
-                                    1024 + (w5x00_get_tick_ms() & 0xF));
-  if (result == SL_STATUS_OK) {
-    w5x00_log_info(TAG,
-                   "Start DNS resolution for host name: '%s'\r\n",
-                   a_hostname);
-    // Try up to three times
-    int retries = 0;
-    // while ((retries < 3) && (ret <= 0)) {
-    // Send DNS request
-    if (SL_STATUS_OK == w5x00_ethernet_udp_begin_packet(&dns->udp_socket,
-                                                        &dns->dns_server,
-                                                        DNS_PORT)) {
-      // Now output the request data
-      ret = build_request(dns, a_hostname);
-      if (ret != 0) {
-        // And finally send the request
-        if (SL_STATUS_OK == w5x00_ethernet_udp_end_packet(&dns->udp_socket)) {
-          // Now wait for a response
-          int wait_retries = 0;
-          ret = TIMED_OUT;
-          while ((wait_retries < 3) && (ret == TIMED_OUT)) {
-            ret = process_response(dns, timeout, a_result);
-            wait_retries++;
-          }
-        }
-      }
+  // One socket carries all queries of the instance
+  if (dns->udp_socket.sockindex >= W5x00_MAX_SOCK_NUM) {
+    result = w5x00_ethernet_udp_begin(&dns->udp_socket,
+                                      1024 + (w5x00_get_tick_ms() & 0xF));
+    if (result != SL_STATUS_OK) {
+      w5x00_log_error(TAG, "Couldn't get a socket to start DNS resolution\r\n");
+      return result;
     }
-    retries++;
-    // }
+  }
+  w5x00_log_info(TAG,
+                 "Start DNS resolution for host name: '%s'\r\n",
+                 a_hostname);
+  query->hostname = a_hostname;
+  query->id = dns->request_id++;
+  query->server = 0;
+  query->timeout = timeout;
+  query->start = w5x00_get_tick_ms();
+  query->state = QUERY_PENDING;
+  if (send_query(dns, query) != SL_STATUS_OK) {
+    query->state = QUERY_FREE;
+    return SL_STATUS_FAIL;
+  }
+  *handle = i;
+  return SL_STATUS_IN_PROGRESS;
+}
 
-    // We're done with the socket now
-    w5x00_ethernet_udp_stop(&dns->udp_socket);
-  } else {
-    w5x00_log_error(TAG, "Couldn't get a socket to start DNS resolution\r\n");
+/***************************************************************************//**
+ * DNS Resolve Poll.
+ ******************************************************************************/
+sl_status_t w5x00_dns_resolve_poll(w5x00_dns_t *dns,
+                                   uint8_t handle,
+                                   w5x00_ip4_addr_t *a_result)
+{
+  w5x00_dns_query_t *query;
+  sl_status_t status;
+
+  if ((dns == NULL) || (handle >= W5x00_DNS_MAX_QUERIES)
+      || (a_result == NULL)) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+  query = &dns->query[handle];
+  if (query->state == QUERY_PENDING) {
+    process_queries(dns);
   }
+  switch (query->state) {
+    case QUERY_PENDING:
+      return SL_STATUS_IN_PROGRESS;
+    case QUERY_RESOLVED:
+      *a_result = query->address;
+      w5x00_log_info(TAG, "Host name: '%s', IP Address: ", query->hostname);
+      w5x00_log_print_ip(a_result);
+      w5x00_log_printf("\r\n");
+      status = SL_STATUS_OK;
+      break;
+    case QUERY_NOT_FOUND:
+      w5x00_log_error(TAG,
+                      "Host name: '%s' does not exist\r\n",
+                      query->hostname);
+      status = SL_STATUS_NOT_FOUND;
+      break;
+    case QUERY_TIMED_OUT:
+      w5x00_log_error(TAG,
+                      "DNS resolution for host name: '%s' is timeout\r\n",
+                      query->hostname);
+      status = SL_STATUS_TIMEOUT;
+      break;
+    default:
+      return SL_STATUS_INVALID_PARAMETER;
+  }
+  query->state = QUERY_FREE;
+  process_queries(dns);
+  return status;
+}
 
-  if (ret == SUCCESS) {
-    w5x00_log_info(TAG,
-                   "DNS resolution for host name: '%s' is complete\r\n",
-                   a_hostname);
-    w5x00_log_info(TAG, "Host name: '%s', IP Address: ", a_hostname);
-    w5x00_log_print_ip(a_result);
-    w5x00_log_printf("\r\n");
-    return SL_STATUS_OK;
-  } else if (ret == TIMED_OUT) {
-    w5x00_log_error(TAG,
-                    "DNS resolution for host name: '%s' is timeout\r\n",
-                    a_hostname);
-    return SL_STATUS_TIMEOUT;
-  }
-  w5x00_log_error(TAG,
-                  "DNS resolution for host name: '%s' is failed\r\n",
-                  a_hostname);
-  return SL_STATUS_FAIL;
+/***************************************************************************//**
+ * DNS Stop.
+ ******************************************************************************/
+void w5x00_dns_stop(w5x00_dns_t *dns)
+{
+  uint8_t i;
+
+  if (dns == NULL) {
+    return;
+  }
+  for (i = 0; i < W5x00_DNS_MAX_QUERIES; i++) {
+    dns->query[i].state = QUERY_FREE;
+  }
+  w5x00_ethernet_udp_stop(&dns->udp_socket);
+}
+
+/***************************************************************************//**
+ * DNS Cache Flush.
+ ******************************************************************************/
+void w5x00_dns_cache_flush(void)
+{
+#if W5x00_DNS_CACHE_SIZE > 0
+  uint8_t i;
+
+  for (i = 0; i < W5x00_DNS_CACHE_SIZE; i++) {
+    dns_cache[i].state = CACHE_EMPTY;
+  }
+#endif
+}
+
+/***************************************************************************//**
+ * DNS Get Host By Name.
+ ******************************************************************************/
+sl_status_t w5x00_dns_get_host_by_name(w5x00_dns_t *dns,
+                                       const char *a_hostname,
+                                       w5x00_ip4_addr_t *a_result,
+                                       uint16_t timeout)
+{
+  sl_status_t status;
+  uint8_t handle;
+
+  status = w5x00_dns_resolve_start(dns,
+                                   a_hostname,
+                                   a_result,
+                                   &handle,
+                                   timeout);
+  while (status == SL_STATUS_IN_PROGRESS) {
+    w5x00_delay_ms(POLL_INTERVAL_MS);
+    status = w5x00_dns_resolve_poll(dns, handle, a_result);
+  }
+  return status;
 }
 
 // -----------------------------------------------------------------------------
 // Private function
 
-static uint16_t build_request(w5x00_dns_t *dns, const char *a_name)
+static sl_status_t send_query(w5x00_dns_t *dns, w5x00_dns_query_t *query)
+{
+  sl_status_t status;
+
+  query->last_sent = w5x00_get_tick_ms();
+  status = w5x00_ethernet_udp_begin_packet(&dns->udp_socket,
+                                           &dns->dns_server[query->server],
+                                           DNS_PORT);
+  if (status == SL_STATUS_OK) {
+    build_request(dns, query->id, query->hostname);
+    status = w5x00_ethernet_udp_end_packet(&dns->udp_socket);
+  }
+  return status;
+}
+
+static void process_queries(w5x00_dns_t *dns)
+{
+  w5x00_dns_query_t *query;
+  uint32_t now;
+  bool pending = false;
+  uint8_t i;
+
+  if (dns->udp_socket.sockindex >= W5x00_MAX_SOCK_NUM) {
+    return;
+  }
+  receive_responses(dns);
+
+  now = w5x00_get_tick_ms();
+  for (i = 0; i < W5x00_DNS_MAX_QUERIES; i++) {
+    query = &dns->query[i];
+    if (query->state != QUERY_PENDING) {
+      continue;
+    }
+    if ((now - query->start) >= query->timeout) {
+      query->state = QUERY_TIMED_OUT;
+      continue;
+    }
+    if ((now - query->last_sent) >= W5x00_DNS_RETRY_MS) {
+      // Ask the next server, earlier ones may still answer
+      query->server = (query->server + 1) % dns->server_count;
+      send_query(dns, query);
+    }
+    pending = true;
+  }
+  if (!pending) {
+    // Give the socket back while there's nothing to resolve
+    w5x00_ethernet_udp_stop(&dns->udp_socket);
+  }
+}
+
+static void receive_responses(w5x00_dns_t *dns)
+{
+  w5x00_dns_query_t *query;
+  w5x00_ip4_addr_t address;
+  uint32_t ttl;
+  int8_t server;
+  uint8_t i;
+  int ret;
+  union {
+    uint8_t  byte[DNS_HEADER_SIZE]; // Enough space to reuse for the DNS header
+    uint16_t word[DNS_HEADER_SIZE / 2];
+  } header;
+
+  while (w5x00_ethernet_udp_parse_packet(&dns->udp_socket) > 0) {
+    // Check that it's a response from one of our servers
+    server = find_server(dns, dns->udp_socket.remote_ip);
+    if ((server < 0) || (dns->udp_socket.remote_port != DNS_PORT)) {
+      continue;
+    }
+    if (w5x00_ethernet_udp_available(&dns->udp_socket) < DNS_HEADER_SIZE) {
+      continue;
+    }
+    w5x00_ethernet_udp_read(&dns->udp_socket,
+                            header.byte,
+                            DNS_HEADER_SIZE);
+
+    // Check that it's a response to one of the pending requests
+    query = NULL;
+    for (i = 0; i < W5x00_DNS_MAX_QUERIES; i++) {
+      if ((dns->query[i].state == QUERY_PENDING)
+          && (dns->query[i].id == header.word[0])) {
+        query = &dns->query[i];
+        break;
+      }
+    }
+    if ((query == NULL)
+        || ((htons(header.word[1]) & QUERY_RESPONSE_MASK)
+            != (uint16_t)RESPONSE_FLAG)) {
+      continue;
+    }
+
+    ret = process_response(dns, header.word, &address, &ttl);
+    if (ret == SUCCESS) {
+      query->address = address;
+      query->state = QUERY_RESOLVED;
+      cache_insert(query->hostname, &address, ttl);
+    } else if (ret == NAME_ERROR) {
+      query->state = QUERY_NOT_FOUND;
+      cache_insert(query->hostname, NULL, W5x00_DNS_NEGATIVE_TTL_S);
+    } else if (dns->server_count > 1) {
+      // This server can't help, don't wait for the retry interval
+      query->server = (server + 1) % dns->server_count;
+      send_query(dns, query);
+    }
+  }
+}
+
+static int8_t find_server(w5x00_dns_t *dns, w5x00_ip4_addr_t ip)
+{
+  uint8_t i;
+
+  for (i = 0; i < dns->server_count; i++) {
+    if (dns->dns_server[i].addr == ip.addr) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+static uint8_t cache_lookup(const char *name, w5x00_ip4_addr_t *address)
+{
+#if W5x00_DNS_CACHE_SIZE > 0
+  uint32_t now = w5x00_get_tick_ms();
+  uint8_t i;
+
+  for (i = 0; i < W5x00_DNS_CACHE_SIZE; i++) {
+    if (dns_cache[i].state == CACHE_EMPTY) {
+      continue;
+    }
+    if ((int32_t)(dns_cache[i].expiry - now) <= 0) {
+      dns_cache[i].state = CACHE_EMPTY;
+      continue;
+    }
+    if (name_equal(dns_cache[i].name, name)) {
+      *address = dns_cache[i].address;
+      return dns_cache[i].state;
+    }
+  }
+#else
+  (void)name;
+  (void)address;
+#endif
+  return CACHE_EMPTY;
+}
+
+static void cache_insert(const char *name,
+                         const w5x00_ip4_addr_t *address,
+                         uint32_t ttl)
+{
+#if W5x00_DNS_CACHE_SIZE > 0
+  dns_cache_entry_t *entry = NULL;
+  uint32_t now = w5x00_get_tick_ms();
+  uint8_t i;
+
+  if ((strlen(name) >= W5x00_DNS_CACHE_NAME_LEN) || !ttl) {
+    return;
+  }
+  if (ttl > W5x00_DNS_MAX_TTL_S) {
+    ttl = W5x00_DNS_MAX_TTL_S;
+  }
+  // Reuse the entry of the name, else a free one, else the oldest one
+  for (i = 0; i < W5x00_DNS_CACHE_SIZE; i++) {
+    if ((dns_cache[i].state != CACHE_EMPTY)
+        && name_equal(dns_cache[i].name, name)) {
+      entry = &dns_cache[i];
+      break;
+    }
+    if ((entry == NULL) || (dns_cache[i].state == CACHE_EMPTY)
+        || ((entry->state != CACHE_EMPTY)
+            && ((int32_t)(dns_cache[i].expiry - entry->expiry) < 0))) {
+      entry = &dns_cache[i];
+    }
+  }
+  strcpy(entry->name, name);
+  if (address != NULL) {
+    entry->address = *address;
+    entry->state = CACHE_POSITIVE;
+  } else {
+    entry->state = CACHE_NEGATIVE;
+  }
+  entry->expiry = now + ttl * 1000;
+#else
+  (void)name;
+  (void)address;
+  (void)ttl;
+#endif
+}
+
+static bool name_equal(const char *a, const char *b)
+{
+  // Host names are case-insensitive
+  while (*a && ((*a | 0x20) == (*b | 0x20))) {
+    a++;
+    b++;
+  }
+  return !*a && !*b;
+}
+
+static uint16_t build_request(w5x00_dns_t *dns,
+                              uint16_t id,
+                              const char *a_name)
 {
   // Build header
   //                                    1  1  1  1  1  1
@@ -206,16 +562,14 @@ static uint16_t build_request(w5x00_dns_t *dns, const char *a_name)
   //    +--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+
   //    |                    ARCOUNT                    |
   //    +--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+
-  // As we only support one request at a time at present, we can simplify
-  // some of this header
-  dns->request_id = w5x00_get_tick_ms(); // generate a random ID
+  // The ID tells the answers of queries in flight apart
   uint16_t twoByteBuffer;
 
   // FIXME We should also check that there's enough space available to write to,
   // rather FIXME than assume there's enough space (as the code does at present)
   w5x00_ethernet_udp_write(&dns->udp_socket,
-                           (uint8_t *)&dns->request_id,
-                           sizeof(dns->request_id));
+                           (uint8_t *)&id,
+                           sizeof(id));
 
   twoByteBuffer = htons(QUERY_FLAG
                         | OPCODE_STANDARD_QUERY
@@ -282,69 +636,32 @@ static uint16_t build_request(w5x00_dns_t *dns, const char *a_name)
   return 1;
 }
 
-static uint16_t process_response(w5x00_dns_t *dns,
-                                 uint16_t a_timeout,
-                                 w5x00_ip4_addr_t *a_address)
+static int process_response(w5x00_dns_t *dns,
+                            const uint16_t *header,
+                            w5x00_ip4_addr_t *a_address,
+                            uint32_t *ttl)
 {
-  uint32_t start_time = w5x00_get_tick_ms();
+  uint16_t header_flags = htons(header[1]);
+  uint32_t answer_ttl;
+  uint32_t min_ttl = W5x00_DNS_MAX_TTL_S;
 
-  // Wait for a response packet
-  while (w5x00_ethernet_udp_parse_packet(&dns->udp_socket) <= 0) {
-    if ((w5x00_get_tick_ms() - start_time) > a_timeout) {
-      return TIMED_OUT;
-    }
-    w5x00_delay_ms(50);
-  }
-
-  // We've had a reply!
-  // Read the UDP header
-  // uint8_t header[DNS_HEADER_SIZE]; // Enough space to reuse for the DNS header
-  union {
-    uint8_t  byte[DNS_HEADER_SIZE]; // Enough space to reuse for the DNS header
-    uint16_t word[DNS_HEADER_SIZE / 2];
-  } header;
-
-  // Check that it's a response from the right server and the right port
-  if ((dns->dns_server.addr != dns->udp_socket.remote_ip.addr)
-      || (dns->udp_socket.remote_port != DNS_PORT)) {
-    // It's not from who we expected
-    return INVALID_SERVER;
-  }
-
-  // Read through the rest of the response
-  if (w5x00_ethernet_udp_available(&dns->udp_socket) < DNS_HEADER_SIZE) {
-    return TRUNCATED;
-  }
-  w5x00_ethernet_udp_read(&dns->udp_socket,
-                          header.byte,
-                          DNS_HEADER_SIZE);
-
-  uint16_t header_flags = htons(header.word[1]);
-  // Check that it's a response to this request
-  if ((dns->request_id != (header.word[0]))
-      || ((header_flags & QUERY_RESPONSE_MASK) != (uint16_t)RESPONSE_FLAG)) {
-    // Mark the entire packet as read
-    w5x00_ethernet_udp_flush(&dns->udp_socket); // FIXME
-    return INVALID_RESPONSE;
-  }
   // Check for any errors in the response (or in our request)
-  // although we don't do anything to get round these
+  if ((header_flags & RESP_MASK) == RESP_NAME_ERROR) {
+    return NAME_ERROR;
+  }
   if ((header_flags & TRUNCATION_FLAG) || (header_flags & RESP_MASK)) {
-    // Mark the entire packet as read
-    w5x00_ethernet_udp_flush(&dns->udp_socket); // FIXME
-    return -5; // INVALID_RESPONSE;
+    return INVALID_RESPONSE;
   }
 
   // And make sure we've got (at least) one answer
-  uint16_t answerCount = htons(header.word[3]);
+  uint16_t answerCount = htons(header[3]);
   if (answerCount == 0) {
-    // Mark the entire packet as read
-    w5x00_ethernet_udp_flush(&dns->udp_socket); // FIXME
-    return -6; // INVALID_RESPONSE;
+    // The name exists but has no address
+    return NAME_ERROR;
   }
 
   // Skip over any questions
-  for (uint16_t i = 0; i < htons(header.word[2]); i++) {
+  for (uint16_t i = 0; i < htons(header[2]); i++) {
     // Skip over the name
     uint8_t len;
     do {
@@ -404,10 +721,15 @@ static uint16_t process_response(w5x00_dns_t *dns,
                             (uint8_t *)&answerClass,
                             sizeof(answerClass));
 
-    // Ignore the Time-To-Live as we don't do any caching
+    // The answer is cached no longer than any record of the chain lives
     w5x00_ethernet_udp_read(&dns->udp_socket,
-                            (uint8_t *)NULL,
-                            TTL_SIZE);  // don't care about the returned bytes
+                            (uint8_t *)&answer_ttl,
+                            TTL_SIZE);
+    answer_ttl = ((answer_ttl & 0xFF) << 24) | ((answer_ttl & 0xFF00) << 8)
+                 | ((answer_ttl >> 8) & 0xFF00) | (answer_ttl >> 24);
+    if (answer_ttl < min_ttl) {
+      min_ttl = answer_ttl;
+    }
 
     // And read out the length of this answer
     // Don't need header_flags anymore, so we can reuse it here
@@ -418,11 +740,10 @@ static uint16_t process_response(w5x00_dns_t *dns,
     if ((htons(answerType) == TYPE_A) && (htons(answerClass) == CLASS_IN)) {
       if (htons(header_flags) != 4) {
         // It's a weird size
-        // Mark the entire packet as read
-        w5x00_ethernet_udp_flush(&dns->udp_socket); // FIXME
-        return -9;  // INVALID_RESPONSE;
+        return INVALID_RESPONSE;
       }
       w5x00_ethernet_udp_read(&dns->udp_socket, (uint8_t *)a_address, 4);
+      *ttl = min_ttl;
       return SUCCESS;
     } else {
       // This isn't an answer type we're after, move onto the next one
@@ -432,9 +753,7 @@ static uint16_t process_response(w5x00_dns_t *dns,
     }
   }
 
-  // Mark the entire packet as read
-  w5x00_ethernet_udp_flush(&dns->udp_socket); // FIXME
-
-  // If we get here then we haven't found an answer
-  return -10; // INVALID_RESPONSE;
+  // If we get here then we haven't found an answer, the rest of the packet
+  // is dropped by the next parse
+  return NAME_ERROR;
 }
@@ -227,7 +227,8 @@ sl_status_t w5x00_ethernet_client_flush(w5x00_ethernet_client_t *c)
     if ((stat != SnSR_ESTABLISHED) && (stat != SnSR_CLOSE_WAIT)) {
       return SL_STATUS_INVALID_STATE;
     }
-    if (w5x00_socket_send_available(c->sockindex) >= w5x00_get_SSIZE()) {
+    if (w5x00_socket_send_available(c->sockindex)
+        >= w5x00_get_socket_tx_size(c->sockindex)) {
       return SL_STATUS_OK;
     }
   }
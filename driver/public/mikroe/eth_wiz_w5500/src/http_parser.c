@@ -0,0 +1,502 @@
+/***************************************************************************//**
+ * @file http_parser.c
+ * @brief Incremental HTTP request parser.
+ * @version 0.0.1
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided \'as-is\', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ *
+ * EVALUATION QUALITY
+ * This code has been minimally tested to ensure that it builds with the
+ * specified dependency versions and is suitable as a demonstration for
+ * evaluation purposes only.
+ * This code will be maintained at the sole discretion of Silicon Labs.
+ *
+ ******************************************************************************/
+#include <stdbool.h>
+#include <stddef.h>
+#include "http_parser.h"
+
+// Parser states
+enum {
+  PARSER_METHOD = 0,
+  PARSER_PATH,
+  PARSER_QUERY,
+  PARSER_VERSION,
+  PARSER_REQUEST_LF,
+  PARSER_LINE_START,
+  PARSER_NAME,
+  PARSER_VALUE,
+  PARSER_LINE_LF,
+  PARSER_END_LF,
+  PARSER_DONE,
+  PARSER_ERROR,
+  PARSER_OVERFLOW
+};
+
+// Header fields of interest, index + 1 is the field id
+enum {
+  HEADER_OTHER = 0,
+  HEADER_CONTENT_LENGTH,
+  HEADER_CONNECTION,
+  HEADER_ACCEPT_ENCODING,
+  HEADER_IF_NONE_MATCH
+};
+
+// Connection tokens
+#define TOKEN_CLOSE               0x01
+#define TOKEN_KEEP_ALIVE          0x02
+
+// Longest method or header name that is compared
+#define MAX_NAME_LEN              32
+
+// Largest accepted request body
+#define MAX_CONTENT_LENGTH        0x00FFFFFFUL
+
+static const char *const method_names[] = { "GET", "HEAD", "POST" };
+static const char *const header_names[] = {
+  "content-length", "connection", "accept-encoding", "if-none-match"
+};
+
+#define ARRAY_LEN(a)              (sizeof(a) / sizeof((a)[0]))
+
+static uint8_t match_names(const char *const *names,
+                           uint8_t count,
+                           uint8_t candidates,
+                           uint8_t index,
+                           char c);
+static uint8_t resolve_name(const char *const *names,
+                            uint8_t count,
+                            uint8_t candidates,
+                            uint8_t index);
+static uint8_t match_token(const char *token, uint8_t pos, char c);
+static uint8_t append_uri(w5x00_http_parser_t *parser, char c);
+static void parse_value(w5x00_http_parser_t *parser, char c);
+static void finish(w5x00_http_parser_t *parser);
+static int8_t hex_value(char c);
+
+/***************************************************************************//**
+ * HTTP Parser Init.
+ ******************************************************************************/
+void w5x00_http_parser_init(w5x00_http_parser_t *parser,
+                            char *uri,
+                            uint16_t uri_size)
+{
+  parser->state = PARSER_METHOD;
+  parser->method = W5x00_HTTP_PARSER_METHOD_OTHER;
+  parser->version_minor = 0;
+  parser->flags = 0;
+  parser->tokens = 0;
+  parser->header = HEADER_OTHER;
+  parser->candidates = (1 << ARRAY_LEN(method_names)) - 1;
+  parser->index = 0;
+  parser->match[0] = 0;
+  parser->match[1] = 0;
+  parser->uri = uri;
+  parser->uri_size = uri_size;
+  parser->uri_len = 0;
+  parser->query = 0;
+  parser->content_length = 0;
+  parser->etag_len = 0;
+  parser->if_none_match[0] = '\0';
+  if ((uri != NULL) && uri_size) {
+    uri[0] = '\0';
+  }
+}
+
+/***************************************************************************//**
+ * HTTP Parser Feed.
+ ******************************************************************************/
+sl_status_t w5x00_http_parser_feed(w5x00_http_parser_t *parser,
+                                   const uint8_t *data,
+                                   uint16_t len,
+                                   uint16_t *used)
+{
+  uint16_t i;
+  char c;
+
+  for (i = 0; (i < len) && (parser->state < PARSER_DONE); i++) {
+    c = (char)data[i];
+
+    switch (parser->state) {
+      case PARSER_METHOD:
+        if (c == ' ') {
+          parser->method = resolve_name(method_names,
+                                        ARRAY_LEN(method_names),
+                                        parser->candidates,
+                                        parser->index);
+          parser->state = parser->index ? PARSER_PATH : PARSER_ERROR;
+        } else if ((c == '\r') || (c == '\n')
+                   || (parser->index >= MAX_NAME_LEN)) {
+          parser->state = PARSER_ERROR;
+        } else {
+          if ((c >= 'a') && (c <= 'z')) {
+            c -= 'a' - 'A';
+          }
+          parser->candidates = match_names(method_names,
+                                           ARRAY_LEN(method_names),
+                                           parser->candidates,
+                                           parser->index,
+                                           c);
+          parser->index++;
+        }
+        break;
+
+      case PARSER_PATH:
+      case PARSER_QUERY:
+        if ((c == ' ') && parser->uri_len) {
+          append_uri(parser, '\0');
+          parser->index = 0;
+          parser->state = PARSER_VERSION;
+        } else if ((c == ' ') || (c == '\r') || (c == '\n')) {
+          parser->state = PARSER_ERROR;
+        } else if ((c == '?') && (parser->state == PARSER_PATH)) {
+          // Path and query are kept as two strings
+          if (append_uri(parser, '\0')) {
+            parser->query = parser->uri_len;
+            parser->state = PARSER_QUERY;
+          }
+        } else {
+          append_uri(parser, c);
+        }
+        break;
+
+      case PARSER_VERSION:
+        if (parser->index < 7) {
+          if (c == "HTTP/1."[parser->index]) {
+            parser->index++;
+          } else {
+            parser->state = PARSER_ERROR;
+          }
+        } else if ((parser->index == 7) && (c >= '0') && (c <= '9')) {
+          parser->version_minor = c - '0';
+          parser->index++;
+        } else if ((parser->index == 8) && (c == '\r')) {
+          parser->state = PARSER_REQUEST_LF;
+        } else if ((parser->index == 8) && (c == '\n')) {
+          parser->state = PARSER_LINE_START;
+        } else {
+          parser->state = PARSER_ERROR;
+        }
+        break;
+
+      case PARSER_REQUEST_LF:
+      case PARSER_LINE_LF:
+        parser->state = (c == '\n') ? PARSER_LINE_START : PARSER_ERROR;
+        break;
+
+      case PARSER_LINE_START:
+        if (c == '\r') {
+          parser->state = PARSER_END_LF;
+        } else if (c == '\n') {
+          finish(parser);
+        } else if ((c == ' ') || (c == '\t')) {
+          // Obsolete line folding continues the previous value
+          parser->state = PARSER_VALUE;
+        } else {
+          parser->header = HEADER_OTHER;
+          parser->candidates = (1 << ARRAY_LEN(header_names)) - 1;
+          parser->index = 0;
+          parser->state = PARSER_NAME;
+          i--; // Parse the character as part of the name
+        }
+        break;
+
+      case PARSER_NAME:
+        if (c == ':') {
+          parser->header = resolve_name(header_names,
+                                        ARRAY_LEN(header_names),
+                                        parser->candidates,
+                                        parser->index);
+          parser->index = 0;
+          parser->match[0] = 0;
+          parser->match[1] = 0;
+          if (parser->header == HEADER_CONTENT_LENGTH) {
+            parser->content_length = 0;
+          } else if (parser->header == HEADER_IF_NONE_MATCH) {
+            parser->etag_len = 0;
+          }
+          parser->state = PARSER_VALUE;
+        } else if ((c == '\r') || (c == '\n')) {
+          parser->state = PARSER_ERROR;
+        } else if (parser->candidates) {
+          if ((c >= 'A') && (c <= 'Z')) {
+            c += 'a' - 'A';
+          }
+          parser->candidates = (parser->index < MAX_NAME_LEN)
+                               ? match_names(header_names,
+                                             ARRAY_LEN(header_names),
+                                             parser->candidates,
+                                             parser->index,
+                                             c)
+                               : 0;
+          parser->index++;
+        }
+        break;
+
+      case PARSER_VALUE:
+        if (c == '\r') {
+          parser->state = PARSER_LINE_LF;
+        } else if (c == '\n') {
+          parser->state = PARSER_LINE_START;
+        } else if (((c != ' ') && (c != '\t')) || parser->index) {
+          // Leading white space is not part of the value
+          parser->index = 1;
+          parse_value(parser, c);
+        }
+        break;
+
+      case PARSER_END_LF:
+        if (c == '\n') {
+          finish(parser);
+        } else {
+          parser->state = PARSER_ERROR;
+        }
+        break;
+
+      default:
+        break;
+    }
+  }
+
+  if (used != NULL) {
+    *used = i;
+  }
+  switch (parser->state) {
+    case PARSER_DONE:
+      return SL_STATUS_OK;
+    case PARSER_ERROR:
+      return SL_STATUS_FAIL;
+    case PARSER_OVERFLOW:
+      return SL_STATUS_WOULD_OVERFLOW;
+    default:
+      return SL_STATUS_IN_PROGRESS;
+  }
+}
+
+/***************************************************************************//**
+ * HTTP Parser Get Query.
+ ******************************************************************************/
+const char *w5x00_http_parser_get_query(const w5x00_http_parser_t *parser)
+{
+  if ((parser == NULL) || (parser->uri == NULL) || !parser->query) {
+    return NULL;
+  }
+  return &parser->uri[parser->query];
+}
+
+/***************************************************************************//**
+ * HTTP Parser Get Parameter.
+ ******************************************************************************/
+sl_status_t w5x00_http_parser_get_param(const char *params,
+                                        const char *name,
+                                        char *value,
+                                        uint16_t size)
+{
+  const char *n;
+  uint16_t len = 0;
+  int8_t hi, lo;
+  bool found = false;
+
+  if ((params == NULL) || (name == NULL) || (value == NULL) || !size) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+  while (*params) {
+    for (n = name; *n && (*params == *n); n++) {
+      params++;
+    }
+    if (!*n && ((*params == '=') || (*params == '&') || !*params)) {
+      found = true;
+      break;
+    }
+    // Skip to the next parameter
+    while (*params && (*params != '&')) {
+      params++;
+    }
+    if (*params) {
+      params++;
+    }
+  }
+  if (!found) {
+    return SL_STATUS_NOT_FOUND;
+  }
+  if (*params == '=') {
+    params++;
+  }
+
+  // URL decode the value
+  while (*params && (*params != '&')) {
+    if (len >= (size - 1)) {
+      value[len] = '\0';
+      return SL_STATUS_WOULD_OVERFLOW;
+    }
+    if (*params == '+') {
+      value[len++] = ' ';
+      params++;
+    } else if ((*params == '%')
+               && ((hi = hex_value(params[1])) >= 0)
+               && ((lo = hex_value(params[2])) >= 0)) {
+      value[len++] = (char)((hi << 4) | lo);
+      params += 3;
+    } else {
+      value[len++] = *params++;
+    }
+  }
+  value[len] = '\0';
+  return SL_STATUS_OK;
+}
+
+static uint8_t match_names(const char *const *names,
+                           uint8_t count,
+                           uint8_t candidates,
+                           uint8_t index,
+                           char c)
+{
+  uint8_t i;
+
+  for (i = 0; i < count; i++) {
+    if ((candidates & (1 << i))
+        && ((names[i][index] == '\0') || (names[i][index] != c))) {
+      candidates &= ~(1 << i);
+    }
+  }
+  return candidates;
+}
+
+static uint8_t resolve_name(const char *const *names,
+                            uint8_t count,
+                            uint8_t candidates,
+                            uint8_t index)
+{
+  uint8_t i;
+
+  for (i = 0; i < count; i++) {
+    if ((candidates & (1 << i)) && (names[i][index] == '\0')) {
+      return i + 1;
+    }
+  }
+  return 0;
+}
+
+static uint8_t match_token(const char *token, uint8_t pos, char c)
+{
+  if ((c >= 'A') && (c <= 'Z')) {
+    c += 'a' - 'A';
+  }
+  if (token[pos] == c) {
+    return pos + 1;
+  }
+  return (token[0] == c) ? 1 : 0;
+}
+
+static uint8_t append_uri(w5x00_http_parser_t *parser, char c)
+{
+  // A character always leaves room for the terminating null byte
+  if ((parser->uri == NULL)
+      || ((parser->uri_len + ((c != '\0') ? 2 : 1)) > parser->uri_size)) {
+    parser->state = PARSER_OVERFLOW;
+    return 0;
+  }
+  parser->uri[parser->uri_len++] = c;
+  return 1;
+}
+
+static void parse_value(w5x00_http_parser_t *parser, char c)
+{
+  switch (parser->header) {
+    case HEADER_CONTENT_LENGTH:
+      if ((c >= '0') && (c <= '9')) {
+        parser->content_length = parser->content_length * 10 + (c - '0');
+        if (parser->content_length > MAX_CONTENT_LENGTH) {
+          parser->state = PARSER_ERROR;
+        }
+      } else if ((c != ' ') && (c != '\t')) {
+        parser->state = PARSER_ERROR;
+      }
+      break;
+
+    case HEADER_CONNECTION:
+      parser->match[0] = match_token("close", parser->match[0], c);
+      if (parser->match[0] == 5) {
+        parser->tokens |= TOKEN_CLOSE;
+        parser->match[0] = 0;
+      }
+      parser->match[1] = match_token("keep-alive", parser->match[1], c);
+      if (parser->match[1] == 10) {
+        parser->tokens |= TOKEN_KEEP_ALIVE;
+        parser->match[1] = 0;
+      }
+      break;
+
+    case HEADER_ACCEPT_ENCODING:
+      parser->match[0] = match_token("gzip", parser->match[0], c);
+      if (parser->match[0] == 4) {
+        parser->flags |= W5x00_HTTP_PARSER_ACCEPT_GZIP;
+        parser->match[0] = 0;
+      }
+      break;
+
+    case HEADER_IF_NONE_MATCH:
+      if (parser->etag_len < (W5x00_HTTP_PARSER_MAX_ETAG_LEN - 1)) {
+        parser->if_none_match[parser->etag_len++] = c;
+      }
+      break;
+
+    default:
+      break;
+  }
+}
+
+static void finish(w5x00_http_parser_t *parser)
+{
+  // Persistent by default from HTTP/1.1 on
+  if (!(parser->tokens & TOKEN_CLOSE)
+      && ((parser->version_minor >= 1)
+          || (parser->tokens & TOKEN_KEEP_ALIVE))) {
+    parser->flags |= W5x00_HTTP_PARSER_KEEP_ALIVE;
+  }
+  while (parser->etag_len
+         && ((parser->if_none_match[parser->etag_len - 1] == ' ')
+             || (parser->if_none_match[parser->etag_len - 1] == '\t'))) {
+    parser->etag_len--;
+  }
+  parser->if_none_match[parser->etag_len] = '\0';
+  parser->state = PARSER_DONE;
+}
+
+static int8_t hex_value(char c)
+{
+  if ((c >= '0') && (c <= '9')) {
+    return c - '0';
+  }
+  if ((c >= 'a') && (c <= 'f')) {
+    return c - 'a' + 10;
+  }
+  if ((c >= 'A') && (c <= 'F')) {
+    return c - 'A' + 10;
+  }
+  return -1;
+}
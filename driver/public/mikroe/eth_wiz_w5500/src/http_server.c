@@ -100,9 +100,9 @@ enum METHOD_HTTP {
 
 // HTML Doc. for ERROR
 static const char ERROR_HTML_PAGE[] =
-  "HTTP/1.1 404 Not Found\r\nContent-Type: text/html\r\nContent-Length: 78\r\n\r\n<HTML>\r\n<BODY>\r\nSorry, the page you requested was not found.\r\n</BODY>\r\n</HTML>\r\n\0";
+  "HTTP/1.1 404 Not Found\r\nContent-Type: text/html\r\nContent-Length: 80\r\n\r\n<HTML>\r\n<BODY>\r\nSorry, the page you requested was not found.\r\n</BODY>\r\n</HTML>\r\n\0";
 static const char ERROR_REQUEST_PAGE[] =
-  "HTTP/1.1 400 OK\r\nContent-Type: text/html\r\nContent-Length: 50\r\n\r\n<HTML>\r\n<BODY>\r\nInvalid request.\r\n</BODY>\r\n</HTML>\r\n\0";
+  "HTTP/1.1 400 Bad Request\r\nContent-Type: text/html\r\nConnection: close\r\nContent-Length: 52\r\n\r\n<HTML>\r\n<BODY>\r\nInvalid request.\r\n</BODY>\r\n</HTML>\r\n\0";
 
 // HTML Doc. for CGI result
 #define HTML_HEADER \
@@ -110,7 +110,7 @@ static const char ERROR_REQUEST_PAGE[] =
 
 // Response header for HTML
 #define RES_HTMLHEAD_OK \
-        "HTTP/1.1 200 OK\r\nContent-Type: text/html\r\nConnection: keep-alive\r\nContent-Length: "
+        "HTTP/1.1 200 OK\r\nContent-Type: text/html\r\nContent-Length: "
 
 // Response head for TEXT
 #define RES_TEXTHEAD_OK \
@@ -134,7 +134,7 @@ static const char ERROR_REQUEST_PAGE[] =
 
 // Response head for XML
 #define RES_XMLHEAD_OK \
-        "HTTP/1.1 200 OK\r\nContent-Type: text/xml\r\nConnection: keep-alive\r\nContent-Length: "
+        "HTTP/1.1 200 OK\r\nContent-Type: text/xml\r\nContent-Length: "
 
 // Response head for CSS
 #define RES_CSSHEAD_OK \
@@ -176,6 +176,20 @@ static const char ERROR_REQUEST_PAGE[] =
 #define RES_SVGHEAD_OK \
         "HTTP/1.1 200 OK\r\nContent-Type: image/svg+xml\r\nContent-Length: "
 
+// Response head for unchanged content
+#define RES_NOT_MODIFIED \
+        "HTTP/1.1 304 Not Modified\r\n"
+
+// Connection header of a response
+#define RES_KEEP_ALIVE            "Connection: keep-alive\r\n"
+#define RES_CLOSE                 "Connection: close\r\n"
+
+// Content encoding header of a precompressed response
+#define RES_GZIP                  "Content-Encoding: gzip\r\nVary: Accept-Encoding\r\n"
+
+// Largest header lines added to a response head
+#define RES_EXTRA_HEADER_SIZE     (W5x00_HTTP_SERVER_MAX_ETAG_LEN + 96)
+
 static inline void safe_strncpy(char *dst, const char *src, size_t dst_size)
 {
   while (*src && --dst_size > 0) {
@@ -190,35 +204,60 @@ static inline void safe_strncpy(char *dst, const char *src, size_t dst_size)
 static void http_process_handler(w5x00_http_server_t *http,
                                  uint8_t s,
                                  w5x00_http_request_t *p_http_request);
+static uint16_t make_http_response_header(uint8_t s,
+                                          uint8_t *buf,
+                                          uint32_t buf_size,
+                                          uint8_t content_type,
+                                          uint32_t body_len,
+                                          uint16_t http_status,
+                                          const char *extra);
 static void send_http_response_header(uint8_t s,
                                       uint8_t *buf,
                                       uint32_t buf_size,
                                       uint8_t content_type,
                                       uint32_t body_len,
-                                      uint16_t http_status);
+                                      uint16_t http_status,
+                                      const char *extra);
+static void send_http_response_data(uint8_t s,
+                                    const uint8_t *data,
+                                    uint16_t len);
 static void send_http_response_body(w5x00_http_socket_t *socket,
                                     uint8_t *uri_name,
                                     uint8_t *buf,
                                     uint32_t buf_size,
+                                    uint16_t header_len,
                                     uint32_t start_addr,
                                     uint32_t file_len,
                                     const w5x00_http_server_callback_t *callback);
 static void send_http_response_cgi(uint8_t s,
                                    uint8_t *buf,
                                    uint8_t *http_body,
-                                   uint16_t file_len);
+                                   uint16_t file_len,
+                                   const char *extra);
 
-static const char *get_content_body(const char *uri);
 static void make_http_response_head(char *buf,
                                     uint32_t buf_size,
                                     char type,
-                                    uint32_t len);
+                                    uint32_t len,
+                                    const char *extra);
 static void find_http_uri_type(uint8_t *type, uint8_t *buff);
-static void parse_http_request(w5x00_http_request_t *request, uint8_t *buf);
-static uint8_t get_http_uri_name(uint8_t *uri,
-                                 uint8_t *uri_buf,
-                                 uint32_t uri_buf_len);
-static void mid(char *src, char *s1, char *s2, char *sub);
+static uint8_t *get_http_uri_name(w5x00_http_request_t *request);
+static sl_status_t read_http_request(w5x00_http_server_t *http,
+                                     w5x00_http_socket_t *socket,
+                                     uint16_t *req_len);
+static void reset_http_request(w5x00_http_socket_t *socket);
+static uint8_t open_http_content(w5x00_http_server_t *http,
+                                 w5x00_http_request_t *request,
+                                 const char *uri_name,
+                                 uint32_t *file_id,
+                                 uint32_t *file_len,
+                                 uint8_t *gzip);
+static void make_http_etag(const w5x00_http_server_callback_t *callback,
+                           uint32_t file_id,
+                           uint32_t file_len,
+                           char *etag);
+static void close_http_content(w5x00_http_socket_t *socket,
+                               const w5x00_http_server_callback_t *callback);
 
 /***************************************************************************//**
  * HTTP Server Init.
@@ -241,7 +280,9 @@ sl_status_t w5x00_http_server_init(w5x00_http_server_t *http,
         http->socket[i].file_id = 0;
         http->socket[i].file_len = 0;
         http->socket[i].file_offset = 0;
+        http->socket[i].keep_alive = 0;
         http->socket[i].sock_status = STATE_HTTP_IDLE;
+        reset_http_request(&http->socket[i]);
       } else {
         w5x00_socket_disconnect(sockindex);
         http->socket[i].socknum = W5x00_MAX_SOCK_NUM;
@@ -275,9 +316,8 @@ sl_status_t w5x00_http_server_run(w5x00_http_server_t *http)
  ******************************************************************************/
 sl_status_t w5x00_http_server_socket_run(w5x00_http_server_t *http, uint8_t s)
 {
-  uint16_t len;
-  uint32_t gettime = 0;
-  w5x00_http_request_t parsed_http_request;
+  uint16_t req_len;
+  sl_status_t status;
 
 #if W5x00_HTTP_SERVER_DEBUG_ENABLE
   uint8_t destip[4] = { 0, };
@@ -300,17 +340,19 @@ sl_status_t w5x00_http_server_socket_run(w5x00_http_server_t *http, uint8_t s)
       // HTTP Process states
       switch (socket->sock_status) {
         case STATE_HTTP_IDLE:
-          if ((len = w5x00_socket_recv_available(socket->socknum)) > 0) {
-            if (len > (W5x00_HTTP_SERVER_BUFFER_SIZE - 1)) {
-              len = W5x00_HTTP_SERVER_BUFFER_SIZE - 1;
+          if (w5x00_socket_recv_available(socket->socknum) > 0) {
+            // Take exactly one request, pipelined ones stay in the socket
+            status = read_http_request(http, socket, &req_len);
+            if (status == SL_STATUS_IN_PROGRESS) {
+              break; // Wait for the rest of the request
             }
-            len = w5x00_socket_recv(socket->socknum,
-                                    (uint8_t *)http->buf,
-                                    len);
-
-            *(((uint8_t *)http->buf) + len) = '\0';
-
-            parse_http_request(&parsed_http_request, http->buf);
+            if (status != SL_STATUS_OK) {
+              // The request cannot be delimited, answer it and close
+              socket->request.method = METHOD_ERR;
+              socket->request.flags = 0;
+              req_len = w5x00_socket_recv_available(socket->socknum);
+            }
+            w5x00_socket_recv_consume(socket->socknum, req_len);
 #if W5x00_HTTP_SERVER_DEBUG_ENABLE
             w5x00_readSnDIPR(socket->socknum, destip);
             w5x00_log_printf("\r\n");
@@ -327,25 +369,15 @@ sl_status_t w5x00_http_server_socket_run(w5x00_http_server_t *http, uint8_t s)
               "> HTTPSocket[%d] : [State] STATE_HTTP_REQ_DONE\r\n",
               s);
 #endif
+            socket->keep_alive =
+              (socket->request.flags & HTTP_REQUEST_KEEP_ALIVE) ? 1 : 0;
+
             // HTTP 'response' handler;
             // includes send_http_response_header / body function
-            http_process_handler(http,
-                                 socket->socknum,
-                                 &parsed_http_request);
-
-            gettime = w5x00_get_tick_ms();
-            // Check the TX socket buffer for End of HTTP response sends
-            while (w5x00_socket_get_tx_free_size(socket->socknum)
-                   != w5x00_get_socket_tx_max_size(socket->socknum)) {
-              if ((w5x00_get_tick_ms() - gettime) > 3000) {
-#if W5x00_HTTP_SERVER_DEBUG_ENABLE
-                w5x00_log_printf(
-                  "> HTTPSocket[%d] : [State] STATE_HTTP_REQ_DONE: TX Buffer clear timeout\r\n",
-                  s);
-#endif
-                break;
-              }
-            }
+            http->query = socket->request.query;
+            http_process_handler(http, s, &socket->request);
+            http->query = NULL;
+            reset_http_request(socket);
 
             if (socket->file_len > 0) {
               socket->sock_status = STATE_HTTP_RES_INPROC;
@@ -353,6 +385,14 @@ sl_status_t w5x00_http_server_socket_run(w5x00_http_server_t *http, uint8_t s)
               socket->sock_status = STATE_HTTP_RES_DONE; // Send the 'HTTP
                                                          //   response' end
             }
+          } else if (socket->keep_alive
+                     && ((w5x00_get_tick_ms() - socket->last_activity)
+                         > W5x00_HTTP_SERVER_KEEPALIVE_TIMEOUT_MS)) {
+#if W5x00_HTTP_SERVER_DEBUG_ENABLE
+            w5x00_log_printf("> HTTPSocket[%d] : Keep-alive timeout\r\n", s);
+#endif
+            socket->keep_alive = 0;
+            w5x00_socket_disconnect(socket->socknum);
           }
           break;
 
@@ -370,6 +410,7 @@ sl_status_t w5x00_http_server_socket_run(w5x00_http_server_t *http, uint8_t s)
                                   W5x00_HTTP_SERVER_BUFFER_SIZE,
                                   0,
                                   0,
+                                  0,
                                   http->callback);
 
           if (socket->file_len == 0) {
@@ -378,6 +419,11 @@ sl_status_t w5x00_http_server_socket_run(w5x00_http_server_t *http, uint8_t s)
           break;
 
         case STATE_HTTP_RES_DONE:
+          // Disconnecting now would drop body data still in the TX buffer
+          if (w5x00_socket_send_poll(socket->socknum)
+              == SL_STATUS_IN_PROGRESS) {
+            break;
+          }
 #if W5x00_HTTP_SERVER_DEBUG_ENABLE
           w5x00_log_printf("> HTTPSocket[%d] : [State] STATE_HTTP_RES_DONE\r\n",
                            s);
@@ -390,7 +436,12 @@ sl_status_t w5x00_http_server_socket_run(w5x00_http_server_t *http, uint8_t s)
 #ifdef W5x00_USE_WATCHDOG
           http->callback->wdt_reset();
 #endif
-          w5x00_socket_disconnect(socket->socknum);
+          if (socket->keep_alive) {
+            // Ready for the next request on this connection
+            socket->last_activity = w5x00_get_tick_ms();
+          } else {
+            w5x00_socket_disconnect(socket->socknum);
+          }
           break;
 
         default:
@@ -418,6 +469,13 @@ sl_status_t w5x00_http_server_socket_run(w5x00_http_server_t *http, uint8_t s)
 #if W5x00_HTTP_SERVER_DEBUG_ENABLE
       w5x00_log_printf("> HTTPSocket[%d] : CLOSED\r\n", socket->socknum);
 #endif
+      // A response cut short by the peer must not resume on the next client
+      if (socket->file_len) {
+        close_http_content(socket, http->callback);
+      }
+      socket->keep_alive = 0;
+      socket->sock_status = STATE_HTTP_IDLE;
+      reset_http_request(socket);
       if (w5x00_socket_init(socket->socknum, SnMR_TCP,
                             http->port) == socket->socknum) {   // Reinitialize the socket
 #if W5x00_HTTP_SERVER_DEBUG_ENABLE
@@ -448,8 +506,30 @@ static void send_http_response_header(uint8_t s,
                                       uint32_t buf_size,
                                       uint8_t content_type,
                                       uint32_t body_len,
-                                      uint16_t http_status)
+                                      uint16_t http_status,
+                                      const char *extra)
 {
+  send_http_response_data(s,
+                          buf,
+                          make_http_response_header(s,
+                                                    buf,
+                                                    buf_size,
+                                                    content_type,
+                                                    body_len,
+                                                    http_status,
+                                                    extra));
+}
+
+static uint16_t make_http_response_header(uint8_t s,
+                                          uint8_t *buf,
+                                          uint32_t buf_size,
+                                          uint8_t content_type,
+                                          uint32_t body_len,
+                                          uint16_t http_status,
+                                          const char *extra)
+{
+  (void)s;
+
   switch (http_status) {
     case STATUS_OK:     // HTTP/1.1 200 OK
       if ((content_type != PTYPE_CGI)
@@ -459,7 +539,11 @@ static void send_http_response_header(uint8_t s,
           "> HTTPSocket[%d] : HTTP Response Header - STATUS_OK\r\n",
           s);
 #endif
-        make_http_response_head((char *)buf, buf_size, content_type, body_len);
+        make_http_response_head((char *)buf,
+                                buf_size,
+                                content_type,
+                                body_len,
+                                extra);
       } else {
 #if W5x00_HTTP_SERVER_DEBUG_ENABLE
         w5x00_log_printf(
@@ -495,19 +579,50 @@ static void send_http_response_header(uint8_t s,
       memcpy(buf, ERROR_HTML_PAGE, buf_size);
       break;
 
+    case STATUS_NOT_MODIF:  // HTTP/1.1 304 Not Modified
+#if W5x00_HTTP_SERVER_DEBUG_ENABLE
+      w5x00_log_printf(
+        "> HTTPSocket[%d] : HTTP Response Header - STATUS_NOT_MODIF\r\n",
+        s);
+#endif
+      snprintf((char *)buf, buf_size, "%s%s\r\n", RES_NOT_MODIFIED, extra);
+      break;
+
     default:
       break;
   }
 
-  // Send the HTTP Response 'header'
-  if (http_status) {
+  // The HTTP Response 'header' is left at the start of buf
+  if (!http_status) {
+    return 0;
+  }
 #if W5x00_HTTP_SERVER_DEBUG_ENABLE
-    w5x00_log_printf(
-      "> HTTPSocket[%d] : [Send] HTTP Response Header [ %d ]byte\r\n",
-      s,
-      (uint16_t)strlen((char *)buf));
+  w5x00_log_printf(
+    "> HTTPSocket[%d] : [Send] HTTP Response Header [ %d ]byte\r\n",
+    s,
+    (uint16_t)strlen((char *)buf));
 #endif
-    w5x00_socket_send(s, buf, strlen((char *)buf));
+  return (uint16_t)strlen((char *)buf);
+}
+
+static void send_http_response_data(uint8_t s,
+                                    const uint8_t *data,
+                                    uint16_t len)
+{
+  uint32_t gettime = w5x00_get_tick_ms();
+  uint16_t sent;
+
+  // Queued behind a running SEND; only while the TX buffer is full, this
+  // waits up to 3 s for SEND_OK to free space
+  while (len) {
+    sent = w5x00_socket_send_nonblocking(s, data, len);
+    data += sent;
+    len -= sent;
+    if (!sent
+        && ((w5x00_socket_send_poll(s) == SL_STATUS_FAIL)
+            || ((w5x00_get_tick_ms() - gettime) > 3000))) {
+      break;
+    }
   }
 }
 
@@ -515,134 +630,143 @@ static void send_http_response_body(w5x00_http_socket_t *socket,
                                     uint8_t *uri_name,
                                     uint8_t *buf,
                                     uint32_t buf_size,
+                                    uint16_t header_len,
                                     uint32_t start_addr,
                                     uint32_t file_len,
                                     const w5x00_http_server_callback_t *callback)
 {
   uint32_t send_len;
-
-  uint8_t flag_datasend_end = 0;
+  uint16_t tx_free;
+  uint16_t queued;
 
   // Send the HTTP Response 'body'; requested file
   if (!socket->file_len) { // ### Send HTTP response body: First part ###
     socket->file_id = start_addr;
     socket->file_len = file_len;
-    if (file_len > (buf_size - 1)) {
-      send_len = buf_size - 1;
-
-      int n = strlen((char *)uri_name);
-      if (n > (W5x00_HTTP_SERVER_MAX_CONTENT_NAME_LEN - 1)) {
-        n = W5x00_HTTP_SERVER_MAX_CONTENT_NAME_LEN - 1;
-      }
-      memcpy(socket->file_name, uri_name, n);
-      socket->file_name[n] = '\0';
-#if W5x00_HTTP_SERVER_DEBUG_ENABLE
-      w5x00_log_printf(
-        "> HTTPSocket[%d] : HTTP Response body - file name [ %s ]\r\n",
-        socket->socknum,
-        socket->file_name);
-#endif
+    socket->file_offset = 0;
 
+    int n = strlen((char *)uri_name);
+    if (n > (W5x00_HTTP_SERVER_MAX_CONTENT_NAME_LEN - 1)) {
+      n = W5x00_HTTP_SERVER_MAX_CONTENT_NAME_LEN - 1;
+    }
+    memcpy(socket->file_name, uri_name, n);
+    socket->file_name[n] = '\0';
 #if W5x00_HTTP_SERVER_DEBUG_ENABLE
-      w5x00_log_printf(
-        "> HTTPSocket[%d] : HTTP Response body - file len [ %ld ]byte\r\n",
-        socket->socknum,
-        file_len);
+    w5x00_log_printf(
+      "> HTTPSocket[%d] : HTTP Response body - file name [ %s ]\r\n",
+      socket->socknum,
+      socket->file_name);
+    w5x00_log_printf(
+      "> HTTPSocket[%d] : HTTP Response body - file len [ %lu ]byte\r\n",
+      socket->socknum,
+      (unsigned long)file_len);
 #endif
-    } else {
-      // Send process end
-      send_len = file_len;
+  }
 
-#if W5x00_HTTP_SERVER_DEBUG_ENABLE
-      w5x00_log_printf(
-        "> HTTPSocket[%d] : HTTP Response end - file len [ %ld ]byte\r\n",
-        socket->socknum,
-        send_len);
-#endif
-    }
-  } else { // remained parts
+  // Fill the TX buffer with as many chunks as fit, they go out with one SEND;
+  // the rest is queued by the next runs once SEND_OK has freed space, so
+  // other sockets are not held up
+  while (socket->file_offset < socket->file_len) {
+    // The response head goes out together with the first part of the body
     send_len = socket->file_len - socket->file_offset;
+    if (send_len > buf_size - header_len) {
+      send_len = buf_size - header_len;
+    }
+    tx_free = w5x00_socket_send_available(socket->socknum);
+    if (tx_free <= header_len) {
+      if (header_len) {
+        // No room for any body yet, the head is queued on its own
+        send_http_response_data(socket->socknum, buf, header_len);
+        header_len = 0;
+        continue;
+      }
+      w5x00_socket_send_flush(socket->socknum);
+      return;
+    }
+    if (send_len > (uint32_t)(tx_free - header_len)) {
+      send_len = tx_free - header_len;
+    }
 
-    if (send_len > buf_size - 1) {
-      send_len = buf_size - 1;
-      // socket->file_offset += send_len;
-    } else {
+    if (send_len != callback->read_web_content(socket->file_id,
+                                               buf + header_len,
+                                               socket->file_offset,
+                                               send_len)) {
 #if W5x00_HTTP_SERVER_DEBUG_ENABLE
       w5x00_log_printf(
-        "> HTTPSocket[%d] : HTTP Response end - file len [ %ld ]byte\r\n",
+        "> HTTPSocket[%d] : (File Read) / HTTP Send Failed - %s\r\n",
         socket->socknum,
-        socket->file_len);
+        socket->file_name);
 #endif
-      // Send process end
-      flag_datasend_end = 1;
+      // The length is already announced, the client must see the cut
+      socket->keep_alive = 0;
+      break;
     }
+    queued = header_len + (uint16_t)send_len;
+    header_len = 0;
+    if (w5x00_socket_send_queue(socket->socknum, buf, queued) != queued) {
+      // The room was checked, so the connection is gone
+      socket->keep_alive = 0;
+      break;
+    }
+    socket->file_offset += send_len;
 #if W5x00_HTTP_SERVER_DEBUG_ENABLE
     w5x00_log_printf(
-      "> HTTPSocket[%d] : HTTP Response body - send len [ %ld ]byte\r\n",
-      socket->socknum,
-      send_len);
-#endif
-  }
-
-  if (send_len == callback->read_web_content(socket->file_id,
-                                             buf,
-                                             socket->file_offset,
-                                             send_len)) {
-    // Requested content send to HTTP client
-#if W5x00_HTTP_SERVER_DEBUG_ENABLE
-    w5x00_log_printf(
-      "> HTTPSocket[%d] : [Send] HTTP Response body [ %ld ]byte\r\n",
-      socket->socknum,
-      send_len);
-#endif
-  } else {
-    send_len = 0;
-#if W5x00_HTTP_SERVER_DEBUG_ENABLE
-    w5x00_log_printf(
-      "> HTTPSocket[%d] : (File Read) / HTTP Send Failed - %s\r\n",
+      "> HTTPSocket[%d] : [Send] HTTP Response body [ %lu ]byte, offset [ %lu ]\r\n",
       socket->socknum,
-      socket->file_name);
+      (unsigned long)send_len,
+      (unsigned long)socket->file_offset);
 #endif
   }
-
-  if (send_len) {
-    w5x00_socket_send(socket->socknum, buf, send_len);
-  } else {
-    flag_datasend_end = 1;
+  if (header_len) {
+    // Empty content or a failed read, the head still has to go out
+    send_http_response_data(socket->socknum, buf, header_len);
   }
+  w5x00_socket_send_flush(socket->socknum);
 
-  if (flag_datasend_end) {
-    socket->file_id = 0;
-    socket->file_len = 0;
-    socket->file_offset = 0;
-    flag_datasend_end = 0;
-  } else {
-    socket->file_offset += send_len;
 #if W5x00_HTTP_SERVER_DEBUG_ENABLE
-    w5x00_log_printf(
-      "> HTTPSocket[%d] : HTTP Response body - offset [ %ld ]\r\n",
-      socket->socknum,
-      socket->file_offset);
+  w5x00_log_printf(
+    "> HTTPSocket[%d] : HTTP Response end - file len [ %lu ]byte\r\n",
+    socket->socknum,
+    (unsigned long)socket->file_len);
 #endif
+  close_http_content(socket, callback);
+}
+
+static void close_http_content(w5x00_http_socket_t *socket,
+                               const w5x00_http_server_callback_t *callback)
+{
+  if (callback->close_web_content) {
+    callback->close_web_content(socket->file_id);
   }
+  socket->file_id = 0;
+  socket->file_len = 0;
+  socket->file_offset = 0;
 }
 
 static void send_http_response_cgi(uint8_t s,
                                    uint8_t *buf,
                                    uint8_t *http_body,
-                                   uint16_t file_len)
+                                   uint16_t file_len,
+                                   const char *extra)
 {
   uint16_t send_len = 0;
+  w5x00_iovec_t iov[2];
+  uint32_t gettime;
 
 #if W5x00_HTTP_SERVER_DEBUG_ENABLE
   w5x00_log_printf("> HTTPSocket[%d] : HTTP Response Header + Body - CGI\r\n",
                    s);
 #endif
-  send_len = sprintf((char *)buf,
-                     "%s%d\r\n\r\n%s",
-                     RES_CGIHEAD_OK,
-                     file_len,
-                     http_body);
+  // The body is sent from where the CGI handler left it
+  iov[0].data = buf;
+  iov[0].len = sprintf((char *)buf,
+                       "%s%d\r\n%s\r\n",
+                       RES_CGIHEAD_OK,
+                       file_len,
+                       extra);
+  iov[1].data = http_body;
+  iov[1].len = file_len;
+  send_len = iov[0].len + iov[1].len;
 #if W5x00_HTTP_SERVER_DEBUG_ENABLE
   w5x00_log_printf(
     "> HTTPSocket[%d] : HTTP Response Header + Body - send len [ %d ]byte\r\n",
@@ -650,7 +774,24 @@ static void send_http_response_cgi(uint8_t s,
     send_len);
 #endif
 
-  w5x00_socket_send(s, buf, send_len);
+  // Queued behind a running SEND; only while the TX buffer is full, this
+  // waits up to 3 s for SEND_OK to free space
+  gettime = w5x00_get_tick_ms();
+  while (w5x00_socket_send_iov(s, iov, 2) != send_len) {
+    if ((w5x00_socket_send_poll(s) == SL_STATUS_FAIL)
+        || ((w5x00_get_tick_ms() - gettime) > 3000)) {
+      break;
+    }
+  }
+}
+
+static uint8_t *get_http_uri_name(w5x00_http_request_t *request)
+{
+  // Content names are relative, except for the root
+  if ((request->uri[0] == '/') && request->uri[1]) {
+    return &request->uri[1];
+  }
+  return request->uri;
 }
 
 static void http_process_handler(w5x00_http_server_t *http,
@@ -665,7 +806,11 @@ static void http_process_handler(w5x00_http_server_t *http,
   uint32_t file_len = 0;
 
   uint16_t http_status;
+  uint16_t header_len;
   uint8_t content_found;
+  uint8_t gzip = 0;
+  char etag[W5x00_HTTP_SERVER_MAX_ETAG_LEN];
+  char extra[RES_EXTRA_HEADER_SIZE];
   w5x00_http_socket_t *socket;
 
   socket = &http->socket[s];
@@ -676,38 +821,37 @@ static void http_process_handler(w5x00_http_server_t *http,
   switch (p_http_request->method) {
     case METHOD_ERR:
       http_status = STATUS_BAD_REQ;
+      socket->keep_alive = 0;
       send_http_response_header(socket->socknum,
                                 http->buf,
                                 W5x00_HTTP_SERVER_BUFFER_SIZE,
                                 0,
                                 0,
-                                http_status);
+                                http_status,
+                                NULL);
       break;
 
     case METHOD_HEAD:
     case METHOD_GET:
-      get_http_uri_name(p_http_request->uri,
-                        uri_buf,
-                        W5x00_HTTP_SERVER_MAX_URI_SIZE);
-      uri_name = uri_buf;
+      uri_name = get_http_uri_name(p_http_request);
 
       // If uri is "/", respond by index.html
       if (!strcmp((char *)uri_name, "/")) {
         safe_strncpy((char *)uri_name,
                      INITIAL_WEBPAGE,
-                     W5x00_HTTP_SERVER_MAX_URI_SIZE);
+                     W5x00_HTTP_SERVER_MAX_URI_SIZE - 1);
       }
 
       if (!strcmp((char *)uri_name, "m")) {
         safe_strncpy((char *)uri_name,
                      M_INITIAL_WEBPAGE,
-                     W5x00_HTTP_SERVER_MAX_URI_SIZE);
+                     W5x00_HTTP_SERVER_MAX_URI_SIZE - 1);
       }
 
       if (!strcmp((char *)uri_name, "mobile")) {
         safe_strncpy((char *)uri_name,
                      MOBILE_INITIAL_WEBPAGE,
-                     W5x00_HTTP_SERVER_MAX_URI_SIZE);
+                     W5x00_HTTP_SERVER_MAX_URI_SIZE - 1);
       }
       // Checking requested file types (HTML, TEXT, GIF, JPEG and Etc. are included)
       find_http_uri_type(&p_http_request->type, uri_name);
@@ -732,21 +876,26 @@ static void http_process_handler(w5x00_http_server_t *http,
           send_http_response_cgi(socket->socknum,
                                  http->buf,
                                  uri_buf,
-                                 (uint16_t)file_len);
+                                 (uint16_t)file_len,
+                                 socket->keep_alive ? RES_KEEP_ALIVE : RES_CLOSE);
         } else {
           send_http_response_header(socket->socknum,
                                     http->buf,
                                     W5x00_HTTP_SERVER_BUFFER_SIZE,
                                     PTYPE_CGI,
                                     0,
-                                    STATUS_NOT_FOUND);
+                                    STATUS_NOT_FOUND,
+                                    NULL);
         }
         content_found = 0;
       } else {
         // Find the User registered index for web content
-        if (http->callback->open_web_content((const char *)uri_buf,
-                                             &content_num,
-                                             &file_len)) {
+        if (open_http_content(http,
+                              p_http_request,
+                              (const char *)uri_name,
+                              &content_num,
+                              &file_len,
+                              &gzip)) {
           content_found = 1; // Web content found in code flash memory
           content_addr = (uint32_t)content_num;
         } else { // Not CGI request, Web content in 'SD card' or 'Data flash' requested
@@ -758,50 +907,80 @@ static void http_process_handler(w5x00_http_server_t *http,
           w5x00_log_printf("> HTTPSocket[%d] : Unknown Page Request\r\n", s);
 #endif
           http_status = STATUS_NOT_FOUND;
+          extra[0] = '\0';
         } else {
 #if W5x00_HTTP_SERVER_DEBUG_ENABLE
           w5x00_log_printf(
-            "> HTTPSocket[%d] : Find Content [%s] ok - Start [%ld] len [ %ld ]byte\r\n",
+            "> HTTPSocket[%d] : Find Content [%s] ok - Start [%lu] len [ %lu ]byte\r\n",
             socket->socknum,
             uri_name,
-            content_addr,
-            file_len);
+            (unsigned long)content_addr,
+            (unsigned long)file_len);
 #endif
           http_status = STATUS_OK;
+          if (p_http_request->type == PTYPE_XML) {
+            // Sent without a response head, only the close ends it
+            socket->keep_alive = 0;
+          }
+          make_http_etag(http->callback, content_addr, file_len, etag);
+          if (etag[0] && p_http_request->if_none_match[0]
+              && ((p_http_request->if_none_match[0] == '*')
+                  || strstr(p_http_request->if_none_match, etag))) {
+            // The client already has this content
+            http_status = STATUS_NOT_MODIF;
+          }
+          snprintf(extra,
+                   sizeof(extra),
+                   "%s%s%s%s%s",
+                   gzip ? RES_GZIP : "",
+                   etag[0] ? "ETag: " : "",
+                   etag,
+                   etag[0] ? "\r\n" : "",
+                   socket->keep_alive ? RES_KEEP_ALIVE : RES_CLOSE);
         }
 
-        // Send HTTP header
+        // Build the HTTP header, for a GET it is sent with the body
+        header_len = 0;
         if (http_status) {
 #if W5x00_HTTP_SERVER_DEBUG_ENABLE
           w5x00_log_printf(
-            "> HTTPSocket[%d] : Requested content len = [ %ld ]byte\r\n",
+            "> HTTPSocket[%d] : Requested content len = [ %lu ]byte\r\n",
             socket->socknum,
-            file_len);
+            (unsigned long)file_len);
 #endif
-          send_http_response_header(socket->socknum,
-                                    http->buf,
-                                    W5x00_HTTP_SERVER_BUFFER_SIZE,
-                                    p_http_request->type,
-                                    file_len,
-                                    http_status);
+          header_len = make_http_response_header(socket->socknum,
+                                                 http->buf,
+                                                 W5x00_HTTP_SERVER_BUFFER_SIZE,
+                                                 p_http_request->type,
+                                                 file_len,
+                                                 http_status,
+                                                 extra);
         }
 
         // Send HTTP body (content)
-        if (http_status == STATUS_OK) {
+        if ((http_status == STATUS_OK)
+            && (p_http_request->method == METHOD_GET)) {
           send_http_response_body(socket,
                                   uri_name,
                                   http->buf,
                                   W5x00_HTTP_SERVER_BUFFER_SIZE,
+                                  header_len,
                                   content_addr,
                                   file_len,
                                   http->callback);
+        } else {
+          send_http_response_data(socket->socknum, http->buf, header_len);
+          if (content_found) {
+            // HEAD request or not modified, no body follows
+            socket->file_id = content_addr;
+            close_http_content(socket, http->callback);
+          }
         }
       }
       break;
 
     case METHOD_POST:
-      mid((char *)p_http_request->uri, "/", " HTTP", (char *)uri_buf);
-      uri_name = uri_buf;
+      uri_name = get_http_uri_name(p_http_request);
       // Check file type (HTML, TEXT, GIF, JPEG are included)
       find_http_uri_type(&p_http_request->type,
                          uri_name);
@@ -817,22 +996,26 @@ static void http_process_handler(w5x00_http_server_t *http,
       if (p_http_request->type == PTYPE_CGI) { // HTTP POST Method; CGI Process
         file_len = sizeof(uri_buf);
         content_found = http->callback->post_cgi_handler((const char *)uri_name,
-                                                         get_content_body((const char *)p_http_request->uri),
+                                                         p_http_request->body,
                                                          uri_buf,
                                                          &file_len);
 #if W5x00_HTTP_SERVER_DEBUG_ENABLE
         w5x00_log_printf(
-          "> HTTPSocket[%d] : [CGI: %s] / Response len [ %ld ]byte\r\n",
+          "> HTTPSocket[%d] : [CGI: %s] / Response len [ %lu ]byte\r\n",
           socket->socknum,
           content_found ? "Content found":"Content not found",
-          file_len);
+          (unsigned long)file_len);
 #endif
+        if (content_found == HTTP_RESET) {
+          socket->keep_alive = 0;
+        }
         if (content_found
             && (file_len <= (W5x00_HTTP_SERVER_BUFFER_SIZE - (strlen(RES_CGIHEAD_OK) + 8)))) {
           send_http_response_cgi(socket->socknum,
                                  http->buf,
                                  uri_buf,
-                                 (uint16_t)file_len);
+                                 (uint16_t)file_len,
+                                 socket->keep_alive ? RES_KEEP_ALIVE : RES_CLOSE);
 
           // Reset the H/W for apply to the change configuration information
           if (content_found == HTTP_RESET) {
@@ -844,7 +1027,8 @@ static void http_process_handler(w5x00_http_server_t *http,
                                     W5x00_HTTP_SERVER_BUFFER_SIZE,
                                     PTYPE_CGI,
                                     0,
-                                    STATUS_NOT_FOUND);
+                                    STATUS_NOT_FOUND,
+                                    NULL);
         }
       } else { // HTTP POST Method; Content not found
         send_http_response_header(socket->socknum,
@@ -852,56 +1036,100 @@ static void http_process_handler(w5x00_http_server_t *http,
                                   W5x00_HTTP_SERVER_BUFFER_SIZE,
                                   0,
                                   0,
-                                  STATUS_NOT_FOUND);
+                                  STATUS_NOT_FOUND,
+                                  NULL);
       }
       break;
 
     default:
       http_status = STATUS_BAD_REQ;
+      socket->keep_alive = 0;
       send_http_response_header(socket->socknum,
                                 http->buf,
                                 W5x00_HTTP_SERVER_BUFFER_SIZE,
                                 0,
                                 0,
-                                http_status);
+                                http_status,
+                                NULL);
       break;
   }
 }
 
-static const char *get_content_body(const char *uri)
+/***************************************************************************//**
+ * @brief
+ *    Open web content, preferring a precompressed copy
+ * @param[in] http
+ *    HTTP server instance
+ * @param[in] request
+ *    Parsed request
+ * @param[in] uri_name
+ *    Content name
+ * @param[out] file_id
+ *    Content file id
+ * @param[out] file_len
+ *    Size of the content
+ * @param[out] gzip
+ *    Set to 1 if "<uri_name>.gz" was opened
+ * @return
+ *    1 on success
+ *    0 if the content is not found
+ ******************************************************************************/
+static uint8_t open_http_content(w5x00_http_server_t *http,
+                                 w5x00_http_request_t *request,
+                                 const char *uri_name,
+                                 uint32_t *file_id,
+                                 uint32_t *file_len,
+                                 uint8_t *gzip)
 {
-  const char *start;
-  const char *end;
-
-  start = end = uri;
-  while (*uri) {
-    if (((uri[0] == '\r') && (uri[1] == '\n'))
-        || ((uri[0] == '\n') && (uri[1] == '\r'))) { // line ending with <cr><lf>
-      if (end == start) { // checking for empty line
-        if (uri[2]) {
-          return &uri[2]; // body is the next line
-        } else {
-          break; // next line is not found
-        }
-      }
-      end = start = &uri[2];
-      uri += 2;
-    } else if ((uri[0] == '\n')
-               && (uri[1] != '\r')) {   // line ending with <lf>
-      if (end == start) {   // checking for empty line
-        if (uri[1]) {
-          return &uri[1];   // body is the next line
-        } else {
-          break;   // next line is not found
-        }
-      }
-      end = start = &uri[1];
-      uri += 1;
-    } else {
-      end = uri++;
+  char *gz_name = (char *)http->buf;
+
+  *gzip = 0;
+  // The request has been parsed, its buffer is free to hold the name
+  if ((request->flags & HTTP_REQUEST_ACCEPT_GZIP)
+      && ((strlen(uri_name) + 4) <= W5x00_HTTP_SERVER_BUFFER_SIZE)) {
+    strcpy(gz_name, uri_name);
+    strcat(gz_name, ".gz");
+    if (http->callback->open_web_content(gz_name, file_id, file_len)) {
+      *gzip = 1;
+      return 1;
+    }
+  }
+  return http->callback->open_web_content(uri_name, file_id, file_len);
+}
+
+/***************************************************************************//**
+ * @brief
+ *    Make the entity tag of a content
+ * @param[in] callback
+ *    Server callbacks
+ * @param[in] file_id
+ *    Content file id
+ * @param[in] file_len
+ *    Size of the content
+ * @param[out] etag
+ *    Entity tag, W5x00_HTTP_SERVER_MAX_ETAG_LEN bytes, empty if none
+ ******************************************************************************/
+static void make_http_etag(const w5x00_http_server_callback_t *callback,
+                           uint32_t file_id,
+                           uint32_t file_len,
+                           char *etag)
+{
+  etag[0] = '\0';
+  if (callback->get_web_content_etag) {
+    if (!callback->get_web_content_etag(file_id,
+                                        etag,
+                                        W5x00_HTTP_SERVER_MAX_ETAG_LEN)) {
+      etag[0] = '\0';
     }
+    etag[W5x00_HTTP_SERVER_MAX_ETAG_LEN - 1] = '\0';
+    return;
   }
-  return NULL;
+  // Weak validator, content stored at the same id changes its length
+  snprintf(etag,
+           W5x00_HTTP_SERVER_MAX_ETAG_LEN,
+           "W/\"%lx-%lx\"",
+           (unsigned long)file_id,
+           (unsigned long)file_len);
 }
 
 /***************************************************************************//**
@@ -915,11 +1143,14 @@ static const char *get_content_body(const char *uri)
  *    Response type
  * @param[in] len
  *    Size of response body
+ * @param[in] extra
+ *    Additional header lines, each ending with CRLF, may be NULL
  ******************************************************************************/
 static void make_http_response_head(char *buf,
                                     uint32_t buf_size,
                                     char type,
-                                    uint32_t len)
+                                    uint32_t len,
+                                    const char *extra)
 {
   char *head;
 
@@ -974,13 +1205,15 @@ static void make_http_response_head(char *buf,
   }
 #endif
 
-  snprintf(buf, buf_size, "%s%ld", head, len);
-  len = strlen(buf);
-  if (len > (buf_size - 5)) {
-    len = (buf_size - 5);
+  if (head == NULL) {
+    head = RES_TEXTHEAD_OK;
   }
-  strcat(buf, "\r\n\r\n");
-  buf[len + 4] = '\0';
+  snprintf(buf,
+           buf_size,
+           "%s%lu\r\n%s\r\n",
+           head,
+           (unsigned long)len,
+           extra ? extra : "");
 }
 
 /***************************************************************************//**
@@ -993,270 +1226,141 @@ static void make_http_response_head(char *buf,
  ******************************************************************************/
 static void find_http_uri_type(uint8_t *type, uint8_t *buff)
 {
-  // Decide type according to extension
-  char *buf;
-  buf = (char *)buff;
-
-  if (strstr(buf, ".htm") || strstr(buf, ".html")) {
-    *type = PTYPE_HTML;
-  } else if (strstr(buf, ".gif")) {
-    *type = PTYPE_GIF;
-  } else if (strstr(buf, ".text") || strstr(buf, ".txt")) {
-    *type = PTYPE_TEXT;
-  } else if (strstr(buf, ".jpeg") || strstr(buf, ".jpg")) {
-    *type = PTYPE_JPEG;
-  } else if (strstr(buf, ".swf")) {
-    *type = PTYPE_FLASH;
-  } else if (strstr(buf, ".cgi") || strstr(buf, ".CGI")) {
-    *type = PTYPE_CGI;
-  } else if (strstr(buf, ".json") || strstr(buf, ".JSON")) {
-    *type = PTYPE_JSON;
-  } else if (strstr(buf, ".js") || strstr(buf, ".JS")) {
-    *type = PTYPE_JS;
-  } else if (strstr(buf, ".CGI") || strstr(buf, ".cgi")) {
-    *type = PTYPE_CGI;
-  } else if (strstr(buf, ".xml") || strstr(buf, ".XML")) {
-    *type = PTYPE_XML;
-  } else if (strstr(buf, ".css") || strstr(buf, ".CSS")) {
-    *type = PTYPE_CSS;
-  } else if (strstr(buf, ".png") || strstr(buf, ".PNG")) {
-    *type = PTYPE_PNG;
-  } else if (strstr(buf, ".ico") || strstr(buf, ".ICO")) {
-    *type = PTYPE_ICO;
-  } else if (strstr(buf, ".ttf") || strstr(buf, ".TTF")) {
-    *type = PTYPE_TTF;
-  } else if (strstr(buf, ".otf") || strstr(buf, ".OTF")) {
-    *type = PTYPE_OTF;
-  } else if (strstr(buf, ".woff") || strstr(buf, ".WOFF")) {
-    *type = PTYPE_WOFF;
-  } else if (strstr(buf, ".eot") || strstr(buf, ".EOT")) {
-    *type = PTYPE_EOT;
-  } else if (strstr(buf, ".svg") || strstr(buf, ".SVG")) {
-    *type = PTYPE_SVG;
-  } else {
-    *type = PTYPE_ERR;
-  }
-}
+  static const struct {
+    const char *ext;
+    uint8_t type;
+  } types[] = {
+    { "htm", PTYPE_HTML }, { "html", PTYPE_HTML }, { "gif", PTYPE_GIF },
+    { "text", PTYPE_TEXT }, { "txt", PTYPE_TEXT }, { "jpeg", PTYPE_JPEG },
+    { "jpg", PTYPE_JPEG }, { "swf", PTYPE_FLASH }, { "cgi", PTYPE_CGI },
+    { "json", PTYPE_JSON }, { "js", PTYPE_JS }, { "xml", PTYPE_XML },
+    { "css", PTYPE_CSS }, { "png", PTYPE_PNG }, { "ico", PTYPE_ICO },
+    { "ttf", PTYPE_TTF }, { "otf", PTYPE_OTF }, { "woff", PTYPE_WOFF },
+    { "eot", PTYPE_EOT }, { "svg", PTYPE_SVG },
+  };
+  const char *ext = NULL;
+  const char *p;
+  size_t i, n;
 
-/***************************************************************************//**
- * @brief
- *    Parse http request from a peer
- * @param[in] request
- *    Request to be returned
- * @param[in] buff
- *    Pointer to be parsed
- ******************************************************************************/
-static void parse_http_request(w5x00_http_request_t *request, uint8_t *buf)
-{
-  char *nexttok;
-
-  nexttok = strtok((char *)buf, " ");
-  if (!nexttok) {
-    request->method = METHOD_ERR;
-    return;
-  }
-  if (!strcmp(nexttok, "GET") || !strcmp(nexttok, "get")) {
-    request->method = METHOD_GET;
-    nexttok = strtok(NULL, " ");
-  } else if (!strcmp(nexttok, "HEAD") || !strcmp(nexttok, "head")) {
-    request->method = METHOD_HEAD;
-    nexttok = strtok(NULL, " ");
-  } else if (!strcmp(nexttok, "POST") || !strcmp(nexttok, "post")) {
-    nexttok = strtok(NULL, "\0");
-    request->method = METHOD_POST;
-  } else {
-    request->method = METHOD_ERR;
+  // Decide type according to extension
+  for (p = (const char *)buff; *p; p++) {
+    if (*p == '.') {
+      ext = p + 1;
+    }
   }
-
-  if (!nexttok) {
-    request->method = METHOD_ERR;
+  *type = PTYPE_ERR;
+  if (ext == NULL) {
     return;
   }
-  int len = strlen(nexttok);
-  if (len > (W5x00_HTTP_SERVER_MAX_URI_SIZE - 1)) {
-    len = W5x00_HTTP_SERVER_MAX_URI_SIZE - 1;
-  }
-  memcpy(request->uri, nexttok, len);
-  request->uri[len] = '\0';
-}
-
-#if 0
-
-/**
- *    @brief get next parameter value in the request
- */
-static uint8_t *get_http_param_value(char *uri, char *param_name)
-{
-  static uint8_t BUFPUB[256];
-  uint8_t *name = 0;
-  uint8_t *ret = BUFPUB;
-  uint8_t *pos2;
-  uint16_t len = 0, content_len = 0;
-  uint8_t tmp_buf[10] = { 0x00, };
-
-  if (!uri || !param_name) {
-    return 0;
-  }
-
-  /***************/
-  mid(uri, "Content-Length: ", "\r\n", (char *)tmp_buf);
-  content_len = a2i(tmp_buf, 10);
-  uri = strstr(uri, "\r\n\r\n");
-  uri += 4;
-  uri[content_len] = 0;
-
-  /***************/
-
-  if ((name = (uint8_t *)strstr(uri, param_name))) {
-    name += strlen(param_name) + 1;
-    pos2 = (uint8_t *)strstr((char *)name, "&");
-    if (!pos2) {
-      pos2 = name + strlen((char *)name);
+  for (i = 0; i < sizeof(types) / sizeof(types[0]); i++) {
+    for (n = 0; types[i].ext[n] && ((ext[n] | 0x20) == types[i].ext[n]); n++) {
     }
-    len = pos2 - name;
-
-    if (len) {
-      ret[len] = 0;
-      strncpy((char *)ret, (char *)name, len);
-      unescape_http_url((char *)ret);
-      replacetochar(ret, '+', ' ');
-      // ret[len] = 0;
-      // ret[strlen((int8*)ret)] = 0;
-      // w5x00_log_printf("len=%d\r\n",len);
-    } else {
-      ret[0] = 0;
+    if (!types[i].ext[n] && !ext[n]) {
+      *type = types[i].type;
+      return;
     }
-  } else {
-    return NULL;
   }
-#ifdef _HTTPPARSER_DEBUG_
-  w5x00_log_printf("  %s=%s\r\n", param_name, ret);
-#endif
-  return ret;
 }
 
-#endif
-
-static uint8_t get_http_uri_name(uint8_t *uri,
-                                 uint8_t *uri_buf,
-                                 uint32_t uri_buf_len)
+/***************************************************************************//**
+ * @brief
+ *    Take the next request out of the socket receive buffer
+ * @details
+ *    The head is fed to the parser in chunks straight from the receive
+ *    buffer of the chip, only a body is copied to the server buffer.
+ *    Nothing is consumed until the whole request is available.
+ * @param[in] http
+ *    HTTP server instance
+ * @param[in] sock
+ *    Socket number
+ * @param[out] request
+ *    Parsed request
+ * @param[out] req_len
+ *    Length of the request head and body
+ * @return
+ *    @ref SL_STATUS_OK when a request is complete,
+ *    @ref SL_STATUS_IN_PROGRESS if more data is needed,
+ *    other codes if the request cannot be served.
+ ******************************************************************************/
+static sl_status_t read_http_request(w5x00_http_server_t *http,
+                                     w5x00_http_socket_t *socket,
+                                     uint16_t *req_len)
 {
-  uint8_t *uri_ptr;
+  w5x00_http_parser_t *parser = &socket->parser;
+  w5x00_http_request_t *request = &socket->request;
+  uint8_t sock = socket->socknum;
+  sl_status_t status;
+  uint16_t offset;
+  uint16_t body_len;
+  uint16_t len;
+  uint16_t used;
 
-  if (!uri) {
-    return 0;
+  // The parser keeps its state between runs, only new bytes are fed
+  status = w5x00_http_parser_feed(parser, NULL, 0, NULL);
+  while (status == SL_STATUS_IN_PROGRESS) {
+    len = w5x00_socket_recv_peek(sock,
+                                 socket->request_offset,
+                                 http->buf,
+                                 W5x00_HTTP_SERVER_BUFFER_SIZE);
+    if (!len) {
+      // A head that fills the receive buffer never completes
+      return (socket->request_offset < w5x00_get_socket_rx_size(sock))
+             ? SL_STATUS_IN_PROGRESS : SL_STATUS_WOULD_OVERFLOW;
+    }
+    status = w5x00_http_parser_feed(parser, http->buf, len, &used);
+    socket->request_offset += used;
   }
-
-  safe_strncpy((char *)uri_buf, (char *)uri, uri_buf_len);
-
-  uri_ptr = (uint8_t *)strtok((char *)uri_buf, " ?");
-
-  if (strcmp((char *)uri_ptr, "/")) {
-    uri_ptr++;
+  if (status != SL_STATUS_OK) {
+    return status;
+  }
+  if (parser->content_length > (W5x00_HTTP_SERVER_BUFFER_SIZE - 1)) {
+    return SL_STATUS_WOULD_OVERFLOW;
   }
-  safe_strncpy((char *)uri_buf, (char *)uri_ptr, uri_buf_len);
-
-#ifdef _HTTPPARSER_DEBUG_
-  w5x00_log_printf("  uri_name = %s\r\n", uri_buf);
-#endif
-
-  return 1;
-}
 
-#if 0
+  offset = socket->request_offset;
+  body_len = (uint16_t)parser->content_length;
+  len = body_len ? w5x00_socket_recv_peek(sock, offset, http->buf, body_len) : 0;
+  if (len < body_len) {
+    return ((offset + body_len) <= w5x00_get_socket_rx_size(sock))
+           ? SL_STATUS_IN_PROGRESS : SL_STATUS_WOULD_OVERFLOW;
+  }
+  http->buf[len] = '\0';
 
-/**
- *    @brief  CONVERT STRING INTO INTEGER
- *    @return a integer number
- */
-static uint16_t a2i(
-  uint8_t *str,    /**< is a pointer to convert */
-  uint8_t base   /**< is a base value (must be in the range 2 - 16) */
-  )
-{
-  unsigned int num = 0;
-// debug_2013_11_25
-//        while (*str !=0)
-  while ((*str != 0) && (*str != 0x20)) {    // not include the space(0x020)
-    num = num * base + c2d(*str++);
+  request->method = parser->method;
+  request->flags = parser->flags;
+  if (W5x00_HTTP_SERVER_KEEPALIVE_TIMEOUT_MS == 0) {
+    request->flags &= ~HTTP_REQUEST_KEEP_ALIVE;
   }
-  return num;
+  memcpy(request->if_none_match,
+         parser->if_none_match,
+         sizeof(request->if_none_match));
+  request->query = w5x00_http_parser_get_query(parser);
+  request->body = (const char *)http->buf;
+  *req_len = offset + body_len;
+  return SL_STATUS_OK;
 }
 
-#endif
-
 /***************************************************************************//**
- * @brief
- *    Check strings and then execute callback function by each string.
- * @param[in] src
- *     The information of uri
- * @param[in] s1
- *    The start string to be researched
- * @param[in] s2
- *    The end string to be researched
- * @param[in] sub
- *    The string between s1 and s2
- * @return The length value atfer working
+ * Prepare the socket for the next request, after one has been consumed.
  ******************************************************************************/
-static void mid(char *src, char *s1, char *s2, char *sub)
+static void reset_http_request(w5x00_http_socket_t *socket)
 {
-  char *sub1;
-  char *sub2;
-  uint16_t n;
-
-  sub1 = strstr((char *)src, (char *)s1);
-  sub1 += strlen((char *)s1);
-  sub2 = strstr((char *)sub1, (char *)s2);
-
-  n = sub2 - sub1;
-  strncpy((char *)sub, (char *)sub1, n);
-  sub[n] = '\0';
+  w5x00_http_parser_init(&socket->parser,
+                         (char *)socket->request.uri,
+                         sizeof(socket->request.uri));
+  socket->request_offset = 0;
 }
 
-#if 0
-
-/**
- *    @brief  replace the specified character in a string with new character
- */
-static void replacetochar(
-  uint8_t *str,       /**< pointer to be replaced */
-  uint8_t oldchar,    /**< old character */
-  uint8_t newchar   /**< new character */
-  )
-{
-  int x;
-  for (x = 0; str[x]; x++) {
-    if (str[x] == oldchar) {
-      str[x] = newchar;
-    }
-  }
-}
-
-#endif
-
-#if 0
-
-/**
- *    @brief  CONVERT CHAR INTO HEX
- *    @return HEX
- *
- *    This function converts HEX(0-F) to a character
- */
-static uint8_t c2d(
-  uint8_t c   /**< is a character('0'-'F') to convert to HEX */
-  )
+/***************************************************************************//**
+ * HTTP Server Get Parameter.
+ ******************************************************************************/
+sl_status_t w5x00_http_server_get_param(const w5x00_http_server_t *http,
+                                        const char *name,
+                                        char *value,
+                                        uint16_t size)
 {
-  if ((c >= '0') && (c <= '9')) {
-    return c - '0';
-  }
-  if ((c >= 'a') && (c <= 'f')) {
-    return 10 + c - 'a';
-  }
-  if ((c >= 'A') && (c <= 'F')) {
-    return 10 + c - 'A';
+  if ((http == NULL) || (http->query == NULL)) {
+    return SL_STATUS_NOT_FOUND;
   }
-
-  return (char)c;
+  return w5x00_http_parser_get_param(http->query, name, value, size);
 }
-
-#endif
@@ -37,6 +37,7 @@
  *
  ******************************************************************************/
 #include <stdbool.h>
+#include <string.h>
 #include "sl_status.h"
 
 #include "w5x00.h"
@@ -52,10 +53,20 @@ typedef struct {
   uint16_t RX_RD;  // Address to read
   uint16_t TX_FSR; // Free space ready for transmit
   uint8_t  RX_inc; // how much have we advanced RX_RD
+  bool     sending;    // SEND command issued, SEND_OK not reaped yet
+  uint16_t tx_wr;      // Sn_TX_WR including the data queued behind a SEND
+  uint16_t tx_queued;  // Bytes written after the running SEND
+  uint16_t cache_base; // RX buffer address mirrored at rx_cache[s][0]
+  uint16_t cache_len;  // Number of valid bytes in rx_cache[s]
 } socketstate_t;
 
 static socketstate_t state[W5x00_MAX_SOCK_NUM];
 
+#if W5x00_SOCKET_RX_CACHE_SIZE > 0
+// Read-ahead copy of unread RX buffer data, small reads are served from here
+static uint8_t rx_cache[W5x00_MAX_SOCK_NUM][W5x00_SOCKET_RX_CACHE_SIZE];
+#endif
+
 static uint16_t getSnTX_FSR(w5x00_socket_t s);
 static uint16_t getSnRX_RSR(w5x00_socket_t s);
 static void write_data(w5x00_socket_t s,
@@ -66,6 +77,14 @@ static void read_data(w5x00_socket_t s,
                       uint16_t src,
                       uint8_t *dst,
                       uint16_t len);
+static void read_data_cached(w5x00_socket_t s,
+                             uint16_t src,
+                             uint8_t *dst,
+                             uint16_t len,
+                             uint16_t avail);
+static uint16_t tx_room(w5x00_socket_t s);
+static void tx_append(w5x00_socket_t s, const uint8_t *data, uint16_t len);
+static void tx_flush(w5x00_socket_t s);
 
 /*****************************************/
 /*          Socket management            */
@@ -116,6 +135,9 @@ w5x00_socket_t w5x00_socket_init(w5x00_socket_t s,
   state[s].RX_RD = w5x00_readSnRX_RD(s);  // always zero?
   state[s].RX_inc = 0;
   state[s].TX_FSR = 0;
+  state[s].sending = false;
+  state[s].tx_queued = 0;
+  state[s].cache_len = 0;
   // w5x00_log_info("W5000socket prot=%d, RX_RD=%d\n", w5x00_readSnMR(s), state[s].RX_RD);
   return s;
 }
@@ -165,6 +187,9 @@ w5x00_socket_t w5x00_socket_init_multicast(w5x00_socket_t s,
   state[s].RX_RD = w5x00_readSnRX_RD(s);  // always zero?
   state[s].RX_inc = 0;
   state[s].TX_FSR = 0;
+  state[s].sending = false;
+  state[s].tx_queued = 0;
+  state[s].cache_len = 0;
   return s;
 }
 
@@ -409,23 +434,41 @@ static void read_data(w5x00_socket_t s,
                       uint8_t *dst,
                       uint16_t len)
 {
-  uint16_t size;
-  uint16_t src_mask;
-  uint16_t src_ptr;
-
   // w5x00_log_info("read_data, len=%d, at:%d\n", len, src);
-  src_mask = (uint16_t)src & w5x00_get_SMASK();
-  src_ptr = w5x00_get_RBASE(s) + src_mask;
+  w5x00_read_rx_buffer(s, src, dst, len);
+}
 
-  if (w5x00_has_offset_address_mapping()
-      || ((src_mask + len) <= w5x00_get_SSIZE())) {
-    w5x00_read(src_ptr, dst, len);
-  } else {
-    size = w5x00_get_SSIZE() - src_mask;
-    w5x00_read(src_ptr, dst, size);
-    dst += size;
-    w5x00_read(w5x00_get_RBASE(s), dst, len - size);
+static void read_data_cached(w5x00_socket_t s,
+                             uint16_t src,
+                             uint8_t *dst,
+                             uint16_t len,
+                             uint16_t avail)
+{
+#if W5x00_SOCKET_RX_CACHE_SIZE > 0
+  uint16_t offset = src - state[s].cache_base;
+
+  if ((offset < state[s].cache_len)
+      && (len <= state[s].cache_len - offset)) {
+    memcpy(dst, &rx_cache[s][offset], len);
+    return;
   }
+  if ((len < W5x00_SOCKET_RX_CACHE_SIZE) && (avail >= len)) {
+    // Pull everything that is known to be received in one burst
+    if (avail > W5x00_SOCKET_RX_CACHE_SIZE) {
+      avail = W5x00_SOCKET_RX_CACHE_SIZE;
+    }
+    read_data(s, src, rx_cache[s], avail);
+    state[s].cache_base = src;
+    state[s].cache_len = avail;
+    memcpy(dst, rx_cache[s], len);
+    return;
+  }
+  // Large reads go straight to the caller
+  state[s].cache_len = 0;
+#else
+  (void)avail;
+#endif
+  read_data(s, src, dst, len);
 }
 
 /***************************************************************************//**
@@ -463,10 +506,13 @@ int w5x00_socket_recv(w5x00_socket_t s, uint8_t *buf, int16_t len)
     }
     uint16_t ptr = state[s].RX_RD;
     if (buf) {
-      read_data(s, ptr, buf, ret);
+      read_data_cached(s, ptr, buf, ret, state[s].RX_RSR);
     }
     ptr += ret;
     state[s].RX_RD = ptr;
+    if ((uint16_t)(ptr - state[s].cache_base) >= state[s].cache_len) {
+      state[s].cache_len = 0;
+    }
     state[s].RX_RSR -= ret;
     uint16_t inc = state[s].RX_inc + ret;
     if ((inc >= 250) || (state[s].RX_RSR == 0)) {
@@ -502,6 +548,50 @@ uint16_t w5x00_socket_recv_available(w5x00_socket_t s)
   return ret;
 }
 
+/***************************************************************************//**
+ * Socket Receive Peek.
+ ******************************************************************************/
+uint16_t w5x00_socket_recv_peek(w5x00_socket_t s,
+                                uint16_t offset,
+                                uint8_t *buf,
+                                uint16_t len)
+{
+  uint16_t avail;
+
+  if ((s >= W5x00_MAX_SOCK_NUM) || (buf == NULL)) {
+    return 0;
+  }
+  // Look for newly arrived data when the window reaches past the known data
+  avail = state[s].RX_RSR;
+  if (avail < (uint32_t)offset + len) {
+    avail = getSnRX_RSR(s) - state[s].RX_inc;
+    state[s].RX_RSR = avail;
+  }
+  if (offset >= avail) {
+    return 0;
+  }
+  if (len > avail - offset) {
+    len = avail - offset;
+  }
+  read_data_cached(s, state[s].RX_RD + offset, buf, len, avail - offset);
+  return len;
+}
+
+/***************************************************************************//**
+ * Socket Receive Consume.
+ ******************************************************************************/
+uint16_t w5x00_socket_recv_consume(w5x00_socket_t s, uint16_t len)
+{
+  int ret;
+
+  if (len > INT16_MAX) {
+    len = INT16_MAX;
+  }
+  ret = w5x00_socket_recv(s, NULL, (int16_t)len);
+
+  return (ret > 0) ? (uint16_t)ret : 0;
+}
+
 /***************************************************************************//**
  * Socket Peek.
  ******************************************************************************/
@@ -510,11 +600,8 @@ uint8_t w5x00_socket_peek(w5x00_socket_t s)
   if (s >= W5x00_MAX_SOCK_NUM) {
     return 0;
   }
-  uint16_t ptr = state[s].RX_RD;
-  uint8_t b;
-  w5x00_read((ptr & w5x00_get_SMASK()) + w5x00_get_SBASE(s),
-             &b,
-             1);
+  uint8_t b = 0;
+  read_data_cached(s, state[s].RX_RD, &b, 1, state[s].RX_RSR);
   return b;
 }
 
@@ -543,18 +630,7 @@ static void write_data(w5x00_socket_t s,
 {
   uint16_t ptr = w5x00_readSnTX_WR(s);
   ptr += data_offset;
-  uint16_t offset = ptr & w5x00_get_SMASK();
-  uint16_t dstAddr = offset + w5x00_get_SBASE(s);
-
-  if (w5x00_has_offset_address_mapping()
-      || ((offset + len) <= w5x00_get_SSIZE())) {
-    w5x00_write(dstAddr, data, len);
-  } else {
-    // Wrap around circular buffer
-    uint16_t size = w5x00_get_SSIZE() - offset;
-    w5x00_write(dstAddr, data, size);
-    w5x00_write(w5x00_get_SBASE(s), data + size, len - size);
-  }
+  w5x00_write_tx_buffer(s, ptr, data, len);
   ptr += len;
   w5x00_writeSnTX_WR(s, ptr);
 }
@@ -574,12 +650,17 @@ uint16_t w5x00_socket_send(w5x00_socket_t s,
     return 0;
   }
 
-  if (len > w5x00_get_SSIZE()) {
-    ret = w5x00_get_SSIZE(); // check size not to exceed MAX size.
+  if (len > w5x00_get_socket_tx_size(s)) {
+    ret = w5x00_get_socket_tx_size(s); // check size not to exceed MAX size.
   } else {
     ret = len;
   }
 
+  // wait for data queued by w5x00_socket_send_nonblocking to go out first
+  while (w5x00_socket_send_poll(s) == SL_STATUS_IN_PROGRESS) {
+    yield();
+  }
+
   // if freebuf is available, start.
   do {
     freesize = getSnTX_FSR(s);
@@ -609,6 +690,193 @@ uint16_t w5x00_socket_send(w5x00_socket_t s,
   return ret;
 }
 
+/***************************************************************************//**
+ * Socket Send Non-blocking.
+ ******************************************************************************/
+uint16_t w5x00_socket_send_nonblocking(w5x00_socket_t s,
+                                       const uint8_t *buf,
+                                       uint16_t len)
+{
+  len = w5x00_socket_send_queue(s, buf, len);
+  if (len) {
+    tx_flush(s);
+  }
+  return len;
+}
+
+/***************************************************************************//**
+ * Socket Send Queue.
+ ******************************************************************************/
+uint16_t w5x00_socket_send_queue(w5x00_socket_t s,
+                                 const uint8_t *buf,
+                                 uint16_t len)
+{
+  uint8_t status;
+  uint16_t freesize;
+
+  if ((s >= W5x00_MAX_SOCK_NUM) || !len) {
+    return 0;
+  }
+  status = w5x00_readSnSR(s);
+  if ((status != SnSR_ESTABLISHED) && (status != SnSR_CLOSE_WAIT)) {
+    return 0;
+  }
+
+  if (w5x00_socket_send_poll(s) == SL_STATUS_FAIL) {
+    return 0;
+  }
+  freesize = tx_room(s);
+  if (len > freesize) {
+    len = freesize;
+  }
+  if (!len) {
+    return 0;
+  }
+
+  tx_append(s, buf, len);
+  return len;
+}
+
+/***************************************************************************//**
+ * Socket Send Flush.
+ ******************************************************************************/
+void w5x00_socket_send_flush(w5x00_socket_t s)
+{
+  if (s < W5x00_MAX_SOCK_NUM) {
+    tx_flush(s);
+  }
+}
+
+/***************************************************************************//**
+ * Socket Send Scatter-Gather.
+ ******************************************************************************/
+uint16_t w5x00_socket_send_iov(w5x00_socket_t s,
+                               const w5x00_iovec_t *iov,
+                               uint8_t iovcnt)
+{
+  uint32_t total = 0;
+  uint8_t status;
+  uint8_t i;
+
+  if ((s >= W5x00_MAX_SOCK_NUM) || (iov == NULL)) {
+    return 0;
+  }
+  for (i = 0; i < iovcnt; i++) {
+    total += iov[i].len;
+  }
+  if (!total || (total > w5x00_get_socket_tx_size(s))) {
+    return 0;
+  }
+  status = w5x00_readSnSR(s);
+  if ((status != SnSR_ESTABLISHED) && (status != SnSR_CLOSE_WAIT)) {
+    return 0;
+  }
+  if ((w5x00_socket_send_poll(s) == SL_STATUS_FAIL)
+      || (tx_room(s) < total)) {
+    return 0;
+  }
+
+  // Each fragment goes straight from its owner into the TX buffer
+  for (i = 0; i < iovcnt; i++) {
+    if (iov[i].len) {
+      tx_append(s, iov[i].data, iov[i].len);
+    }
+  }
+  tx_flush(s);
+  return (uint16_t)total;
+}
+
+/***************************************************************************//**
+ * Free TX space that can be written without touching Sn_TX_WR.
+ *
+ * Sn_TX_FSR and Sn_TX_WR are only reliable while no SEND is running. During
+ * a SEND the free space left at its start, less what has been queued since,
+ * is used; it only grows while the SEND runs.
+ ******************************************************************************/
+static uint16_t tx_room(w5x00_socket_t s)
+{
+  if (state[s].sending || state[s].tx_queued) {
+    return state[s].TX_FSR;
+  }
+  state[s].tx_wr = w5x00_readSnTX_WR(s);
+  return getSnTX_FSR(s);
+}
+
+/***************************************************************************//**
+ * Copy data behind the queued data, the caller checked tx_room() first.
+ ******************************************************************************/
+static void tx_append(w5x00_socket_t s, const uint8_t *data, uint16_t len)
+{
+  w5x00_write_tx_buffer(s, state[s].tx_wr, data, len);
+  state[s].tx_wr += len;
+  state[s].TX_FSR -= len;
+  state[s].tx_queued += len;
+}
+
+/***************************************************************************//**
+ * Send the queued data unless a SEND is running, it then follows on SEND_OK.
+ ******************************************************************************/
+static void tx_flush(w5x00_socket_t s)
+{
+  if (state[s].sending || !state[s].tx_queued) {
+    return;
+  }
+  w5x00_writeSnTX_WR(s, state[s].tx_wr);
+  w5x00_exec_cmd_socket(s, Sock_SEND);
+  state[s].tx_queued = 0;
+  state[s].sending = true;
+}
+
+/***************************************************************************//**
+ * Socket Send Poll.
+ ******************************************************************************/
+sl_status_t w5x00_socket_send_poll(w5x00_socket_t s)
+{
+  uint8_t ir;
+
+  if (s >= W5x00_MAX_SOCK_NUM) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+  if (!state[s].sending) {
+    return SL_STATUS_OK;
+  }
+
+  ir = w5x00_readSnIR(s);
+  if (ir & SnIR_SEND_OK) {
+    w5x00_writeSnIR(s, SnIR_SEND_OK);
+    return w5x00_socket_send_complete(s);
+  }
+  if ((ir & SnIR_TIMEOUT) || (w5x00_readSnSR(s) == SnSR_CLOSED)) {
+    w5x00_writeSnIR(s, SnIR_TIMEOUT);
+    state[s].sending = false;
+    state[s].tx_queued = 0;
+    return SL_STATUS_FAIL;
+  }
+  return SL_STATUS_IN_PROGRESS;
+}
+
+/***************************************************************************//**
+ * Socket Send Complete.
+ ******************************************************************************/
+sl_status_t w5x00_socket_send_complete(w5x00_socket_t s)
+{
+  if (s >= W5x00_MAX_SOCK_NUM) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+  if (!state[s].sending) {
+    return SL_STATUS_OK;
+  }
+  state[s].sending = false;
+  if (!state[s].tx_queued) {
+    return SL_STATUS_OK;
+  }
+
+  // The registers are reliable again, data queued meanwhile goes out now
+  state[s].TX_FSR = getSnTX_FSR(s) - state[s].tx_queued;
+  tx_flush(s);
+  return SL_STATUS_IN_PROGRESS;
+}
+
 /***************************************************************************//**
  * Socket Send Buffer Available.
  ******************************************************************************/
@@ -620,8 +888,11 @@ uint16_t w5x00_socket_send_available(w5x00_socket_t s)
   if (s >= W5x00_MAX_SOCK_NUM) {
     return 0;
   }
+  if (w5x00_socket_send_poll(s) == SL_STATUS_FAIL) {
+    return 0;
+  }
 
-  freesize = getSnTX_FSR(s);
+  freesize = tx_room(s);
   status = w5x00_readSnSR(s);
   if ((status == SnSR_ESTABLISHED)
       || (status == SnSR_CLOSE_WAIT)) {
@@ -44,18 +44,28 @@
 
 #include "w5x00.h"
 
+// Default buffer size of every socket, see w5x00_get_socket_tx_size()
 #if W5x00_ETHERNET_LARGE_BUFFERS_ENABLE
 static uint16_t SSIZE;
-static uint16_t SMASK;
 #else
 static const uint16_t SSIZE = 2048;
-static const uint16_t SMASK = 0x07FF;
 #endif
 
-#define SBASE(socknum)  \
-  ((chip) == W5x00_W5100 ? ((socknum) * SSIZE + 0x4000) : ((socknum) * SSIZE + 0x8000))
-#define RBASE(socknum)  \
-  ((chip) == W5x00_W5100 ? ((socknum) * SSIZE + 0x6000) : ((socknum) * SSIZE + 0xC000))
+#define TX_MEM_BASE  ((chip) == W5x00_W5100 ? 0x4000 : 0x8000)
+#define RX_MEM_BASE  ((chip) == W5x00_W5100 ? 0x6000 : 0xC000)
+
+#define SBASE(socknum)  (TX_MEM_BASE + tx_base[socknum])
+#define RBASE(socknum)  (RX_MEM_BASE + rx_base[socknum])
+
+// Total socket buffer memory of each direction in KB
+#define W5100_BUFFER_MEM_KB   8
+#define W5x00_BUFFER_MEM_KB   16
+
+// Per socket buffer sizes and offsets in the TX/RX memory, in bytes
+static uint16_t tx_size[W5x00_MAX_SOCK_NUM];
+static uint16_t rx_size[W5x00_MAX_SOCK_NUM];
+static uint16_t tx_base[W5x00_MAX_SOCK_NUM];
+static uint16_t rx_base[W5x00_MAX_SOCK_NUM];
 
 static bool initialized = false;
 
@@ -70,6 +80,8 @@ static enum W5x00Chip  chip = W5x00_UNKNOWN;
 static uint8_t w5x00_is_w5100(void);
 static uint8_t w5x00_is_w5200(void);
 static uint8_t w5x00_is_w5500(void);
+static bool apply_buffer_sizes(const uint8_t *rx_kb, const uint8_t *tx_kb);
+static void apply_default_buffer_sizes(void);
 
 static inline uint32_t w5x00_bus_writebyte(const uint8_t data)
 {
@@ -156,13 +168,84 @@ static uint8_t w5x00_is_w5500(void)
   return 1;
 }
 
+static bool apply_buffer_sizes(const uint8_t *rx_kb, const uint8_t *tx_kb)
+{
+  uint8_t max_sock = (chip == W5x00_W5100) ? 4 : 8;
+  uint8_t max_kb = (chip == W5x00_W5100) ? W5100_BUFFER_MEM_KB
+                   : W5x00_BUFFER_MEM_KB;
+  uint8_t tx_total = 0, rx_total = 0;
+  uint8_t tmsr = 0, rmsr = 0;
+  uint8_t i, code;
+
+  // Sizes must be powers of two so the buffer pointers can be masked
+  for (i = 0; i < W5x00_MAX_SOCK_NUM; i++) {
+    if ((rx_kb[i] & (rx_kb[i] - 1)) || (tx_kb[i] & (tx_kb[i] - 1))) {
+      return false;
+    }
+    if ((i >= max_sock) && (rx_kb[i] || tx_kb[i])) {
+      return false;
+    }
+    if ((chip == W5x00_W5100) && (i < max_sock)
+        && (!rx_kb[i] || !tx_kb[i])) {
+      return false; // W5100 has no way to disable a socket buffer
+    }
+    rx_total += rx_kb[i];
+    tx_total += tx_kb[i];
+  }
+  if ((rx_total > max_kb) || (tx_total > max_kb)) {
+    return false;
+  }
+
+  rx_total = 0;
+  tx_total = 0;
+  for (i = 0; i < W5x00_MAX_SOCK_NUM; i++) {
+    rx_base[i] = (uint16_t)rx_total << 10;
+    tx_base[i] = (uint16_t)tx_total << 10;
+    rx_size[i] = (uint16_t)rx_kb[i] << 10;
+    tx_size[i] = (uint16_t)tx_kb[i] << 10;
+    rx_total += rx_kb[i];
+    tx_total += tx_kb[i];
+    if (chip == W5x00_W5100) {
+      if (i < max_sock) {
+        // 2 bit size code per socket: 1K, 2K, 4K, 8K
+        for (code = 0; (1 << code) < rx_kb[i]; code++) {}
+        rmsr |= code << (2 * i);
+        for (code = 0; (1 << code) < tx_kb[i]; code++) {}
+        tmsr |= code << (2 * i);
+      }
+    } else {
+      w5x00_writeSnRX_SIZE(i, rx_kb[i]);
+      w5x00_writeSnTX_SIZE(i, tx_kb[i]);
+    }
+  }
+  if (chip == W5x00_W5100) {
+    w5x00_writeTMSR(tmsr);
+    w5x00_writeRMSR(rmsr);
+  } else {
+    for (i = W5x00_MAX_SOCK_NUM; i < 8; i++) {
+      w5x00_writeSnRX_SIZE(i, 0);
+      w5x00_writeSnTX_SIZE(i, 0);
+    }
+  }
+  return true;
+}
+
+static void apply_default_buffer_sizes(void)
+{
+  uint8_t kb[W5x00_MAX_SOCK_NUM];
+  uint8_t i;
+
+  for (i = 0; i < W5x00_MAX_SOCK_NUM; i++) {
+    kb[i] = ((chip == W5x00_W5100) && (i >= 4)) ? 0 : (SSIZE >> 10);
+  }
+  apply_buffer_sizes(kb, kb);
+}
+
 /***************************************************************************//**
  * W5x00 Init.
  ******************************************************************************/
 bool w5x00_init(SPIDRV_Handle_t handle)
 {
-  uint8_t i;
-
   if (initialized) {
     return true;
   }
@@ -194,16 +277,8 @@ bool w5x00_init(SPIDRV_Handle_t handle)
 #else
     SSIZE = 2048;
 #endif
-    SMASK = SSIZE - 1;
 #endif
-    for (i = 0; i < W5x00_MAX_SOCK_NUM; i++) {
-      w5x00_writeSnRX_SIZE(i, SSIZE >> 10);
-      w5x00_writeSnTX_SIZE(i, SSIZE >> 10);
-    }
-    for (; i < 8; i++) {
-      w5x00_writeSnRX_SIZE(i, 0);
-      w5x00_writeSnTX_SIZE(i, 0);
-    }
+    apply_default_buffer_sizes();
     // Try W5500 next.  Wiznet finally seems to have implemented
     // SPI well with this chip.  It appears to be very resilient,
     // so try it after the fragile W5200
@@ -219,16 +294,8 @@ bool w5x00_init(SPIDRV_Handle_t handle)
 #else
     SSIZE = 2048;
 #endif
-    SMASK = SSIZE - 1;
-    for (i = 0; i < W5x00_MAX_SOCK_NUM; i++) {
-      w5x00_writeSnRX_SIZE(i, SSIZE >> 10);
-      w5x00_writeSnTX_SIZE(i, SSIZE >> 10);
-    }
-    for (; i < 8; i++) {
-      w5x00_writeSnRX_SIZE(i, 0);
-      w5x00_writeSnTX_SIZE(i, 0);
-    }
 #endif
+    apply_default_buffer_sizes();
     // Try W5100 last.  This simple chip uses fixed 4 byte frames
     // for every 8 bit access.  Terribly inefficient, but so simple
     // it recovers from "hearing" unsuccessful W5100 or W5200
@@ -239,22 +306,13 @@ bool w5x00_init(SPIDRV_Handle_t handle)
 #if W5x00_ETHERNET_LARGE_BUFFERS_ENABLE
 #if W5x00_MAX_SOCK_NUM <= 1
     SSIZE = 8192;
-    w5x00_writeTMSR(0x03);
-    w5x00_writeRMSR(0x03);
 #elif W5x00_MAX_SOCK_NUM <= 2
     SSIZE = 4096;
-    w5x00_writeTMSR(0x0A);
-    w5x00_writeRMSR(0x0A);
 #else
     SSIZE = 2048;
-    w5x00_writeTMSR(0x55);
-    w5x00_writeRMSR(0x55);
 #endif
-    SMASK = SSIZE - 1;
-#else
-    w5x00_writeTMSR(0x55);
-    w5x00_writeRMSR(0x55);
 #endif
+    apply_default_buffer_sizes();
     // No hardware seems to be present.  Or it could be a W5200
     // that's heard other SPI communication if its chip select
     // pin wasn't high when a SD card or other SPI chip was used.
@@ -549,19 +607,121 @@ uint16_t w5x00_get_RBASE(uint8_t socknum)
 }
 
 /***************************************************************************//**
- * Get socket data pointer mask.
+ * Set per socket buffer sizes.
+ ******************************************************************************/
+sl_status_t w5x00_set_socket_buffer_sizes(const uint8_t *rx_kb,
+                                          const uint8_t *tx_kb)
+{
+  if ((rx_kb == NULL) || (tx_kb == NULL)) {
+    return SL_STATUS_NULL_POINTER;
+  }
+  if (!initialized) {
+    return SL_STATUS_NOT_INITIALIZED;
+  }
+  if (!apply_buffer_sizes(rx_kb, tx_kb)) {
+    // Leave the chip in a consistent state
+    apply_default_buffer_sizes();
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ * Get socket send buffer size.
  ******************************************************************************/
-uint16_t w5x00_get_SMASK(void)
+uint16_t w5x00_get_socket_tx_size(uint8_t socknum)
 {
-  return SMASK;
+  return (socknum < W5x00_MAX_SOCK_NUM) ? tx_size[socknum] : 0;
 }
 
 /***************************************************************************//**
- * Get socket buffer size.
+ * Get socket receive buffer size.
  ******************************************************************************/
-uint16_t w5x00_get_SSIZE(void)
+uint16_t w5x00_get_socket_rx_size(uint8_t socknum)
 {
-  return SSIZE;
+  return (socknum < W5x00_MAX_SOCK_NUM) ? rx_size[socknum] : 0;
+}
+
+/***************************************************************************//**
+ * Access a socket buffer of the W5500 through its own SPI block.
+ ******************************************************************************/
+static uint16_t w5500_socket_buffer_access(uint8_t socknum,
+                                           uint8_t block,
+                                           uint16_t ptr,
+                                           uint8_t *buf,
+                                           uint16_t len,
+                                           bool write)
+{
+  uint8_t cmd[3];
+  uint32_t ret = 0;
+
+  // The chip masks the pointer with the socket buffer size itself
+  cmd[0] = ptr >> 8;
+  cmd[1] = ptr & 0xFF;
+  cmd[2] = (socknum << 5) | block | (write ? 0x04 : 0x00);
+  w5x00_bus_select();
+  ret += w5x00_bus_write(cmd, 3);
+  if (write) {
+    ret += w5x00_bus_write(buf, len);
+  } else {
+    ret += w5x00_bus_read(buf, len);
+  }
+  w5x00_bus_deselect();
+  return ret ? 0 : len;
+}
+
+/***************************************************************************//**
+ * Write to socket send buffer.
+ ******************************************************************************/
+uint16_t w5x00_write_tx_buffer(uint8_t socknum,
+                               uint16_t ptr,
+                               const uint8_t *buf,
+                               uint16_t len)
+{
+  uint16_t offset, size;
+
+  if ((socknum >= W5x00_MAX_SOCK_NUM) || !tx_size[socknum]) {
+    return 0;
+  }
+  if (chip == W5x00_W5500) {
+    return w5500_socket_buffer_access(socknum, 0x10, ptr,
+                                      (uint8_t *)buf, len, true);
+  }
+  offset = ptr & (tx_size[socknum] - 1);
+  if ((offset + len) <= tx_size[socknum]) {
+    return w5x00_write(SBASE(socknum) + offset, buf, len);
+  }
+  // Wrap around circular buffer
+  size = tx_size[socknum] - offset;
+  w5x00_write(SBASE(socknum) + offset, buf, size);
+  w5x00_write(SBASE(socknum), buf + size, len - size);
+  return len;
+}
+
+/***************************************************************************//**
+ * Read from socket receive buffer.
+ ******************************************************************************/
+uint16_t w5x00_read_rx_buffer(uint8_t socknum,
+                              uint16_t ptr,
+                              uint8_t *buf,
+                              uint16_t len)
+{
+  uint16_t offset, size;
+
+  if ((socknum >= W5x00_MAX_SOCK_NUM) || !rx_size[socknum]) {
+    return 0;
+  }
+  if (chip == W5x00_W5500) {
+    return w5500_socket_buffer_access(socknum, 0x18, ptr, buf, len, false);
+  }
+  offset = ptr & (rx_size[socknum] - 1);
+  if ((offset + len) <= rx_size[socknum]) {
+    return w5x00_read(RBASE(socknum) + offset, buf, len);
+  }
+  size = rx_size[socknum] - offset;
+  w5x00_read(RBASE(socknum) + offset, buf, size);
+  w5x00_read(RBASE(socknum), buf + size, len - size);
+  return len;
 }
 
 /***************************************************************************//**
@@ -0,0 +1,214 @@
+/***************************************************************************//**
+ * @file w5x00_event.c
+ * @brief Wiznet interrupt driven socket events.
+ * @version 0.0.1
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided \'as-is\', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ *
+ * EVALUATION QUALITY
+ * This code has been minimally tested to ensure that it builds with the
+ * specified dependency versions and is suitable as a demonstration for
+ * evaluation purposes only.
+ * This code will be maintained at the sole discretion of Silicon Labs.
+ *
+ ******************************************************************************/
+#include <stddef.h>
+
+#include "sl_component_catalog.h"
+#include "socket.h"
+#include "w5x00_event.h"
+
+#if defined(SL_CATALOG_MIKROE_ETH_WIZ_INT_PRESENT) \
+  && defined(W5500_INT_PORT) && defined(W5500_INT_PIN)
+#include "em_gpio.h"
+#include "gpiointerrupt.h"
+#define W5x00_EVENT_USE_INT_PIN
+#endif
+
+// Common interrupt registers read in one transfer: IR, IMR, SIR
+#define W5x00_EVENT_IR_ADDR    0x0015
+#define W5x00_EVENT_SIR_OFS    2
+
+// Bound the loop when new events keep arriving while dispatching
+#define W5x00_EVENT_MAX_ROUNDS 4
+
+typedef struct {
+  w5x00_event_callback_t callback;
+  void *context;
+  uint8_t mask;
+} w5x00_event_handler_t;
+
+static w5x00_event_handler_t handlers[W5x00_MAX_SOCK_NUM];
+static uint8_t socket_mask; // SIMR shadow
+static bool initialized = false;
+
+#ifdef W5x00_EVENT_USE_INT_PIN
+static volatile bool int_pending;
+
+static void w5x00_event_int_callback(uint8_t int_no)
+{
+  (void)int_no;
+  int_pending = true;
+}
+#endif
+
+/***************************************************************************//**
+ * Event Init.
+ ******************************************************************************/
+sl_status_t w5x00_event_init(void)
+{
+  w5x00_socket_t s;
+
+  if (w5x00_get_chip() != W5x00_W5500) {
+    return SL_STATUS_NOT_SUPPORTED;
+  }
+  for (s = 0; s < W5x00_MAX_SOCK_NUM; s++) {
+    handlers[s].callback = NULL;
+    handlers[s].mask = 0;
+    w5x00_writeSn_IMR(s, 0);
+  }
+  socket_mask = 0;
+  w5x00_writeSIMR(0);
+  w5x00_writeIMR(0);
+
+#ifdef W5x00_EVENT_USE_INT_PIN
+  // INTn is active low and stays low while an unmasked event is set
+  GPIO_PinModeSet(W5500_INT_PORT, W5500_INT_PIN, gpioModeInputPull, 1);
+  GPIOINT_Init();
+  GPIOINT_CallbackRegister(W5500_INT_PIN, w5x00_event_int_callback);
+  GPIO_ExtIntConfig(W5500_INT_PORT,
+                    W5500_INT_PIN,
+                    W5500_INT_PIN,
+                    false,
+                    true,
+                    true);
+  int_pending = false;
+#endif
+  initialized = true;
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ * Event Register.
+ ******************************************************************************/
+sl_status_t w5x00_event_register(w5x00_socket_t s,
+                                 uint8_t mask,
+                                 w5x00_event_callback_t callback,
+                                 void *context)
+{
+  if (!initialized || (s >= W5x00_MAX_SOCK_NUM) || (callback == NULL)) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+  handlers[s].callback = callback;
+  handlers[s].context = context;
+  handlers[s].mask = mask;
+
+  // Drop events of the mask that happened before registration; SEND_OK
+  // belongs to the socket layer and may complete a send already running
+  w5x00_writeSnIR(s, mask & (uint8_t)~SnIR_SEND_OK);
+  w5x00_writeSn_IMR(s, mask | SnIR_SEND_OK);
+  socket_mask |= (uint8_t)(1 << s);
+  w5x00_writeSIMR(socket_mask);
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ * Event Unregister.
+ ******************************************************************************/
+void w5x00_event_unregister(w5x00_socket_t s)
+{
+  if (!initialized || (s >= W5x00_MAX_SOCK_NUM)) {
+    return;
+  }
+  socket_mask &= (uint8_t)~(1 << s);
+  w5x00_writeSIMR(socket_mask);
+  w5x00_writeSn_IMR(s, 0);
+  handlers[s].callback = NULL;
+  handlers[s].mask = 0;
+}
+
+/***************************************************************************//**
+ * Event Pending.
+ ******************************************************************************/
+bool w5x00_event_pending(void)
+{
+#ifdef W5x00_EVENT_USE_INT_PIN
+  return int_pending;
+#else
+  return initialized && socket_mask;
+#endif
+}
+
+/***************************************************************************//**
+ * Event Process.
+ ******************************************************************************/
+void w5x00_event_process(void)
+{
+  uint8_t regs[3];
+  uint8_t sir;
+  uint8_t ir;
+  uint8_t round;
+  w5x00_socket_t s;
+
+  if (!w5x00_event_pending()) {
+    return;
+  }
+
+  for (round = 0; round < W5x00_EVENT_MAX_ROUNDS; round++) {
+#ifdef W5x00_EVENT_USE_INT_PIN
+    // Cleared first, an edge arriving while dispatching sets it again
+    int_pending = false;
+#endif
+    w5x00_read(W5x00_EVENT_IR_ADDR, regs, sizeof(regs));
+    sir = regs[W5x00_EVENT_SIR_OFS] & socket_mask;
+    if (!sir) {
+      break;
+    }
+
+    for (s = 0; s < W5x00_MAX_SOCK_NUM; s++) {
+      if (!(sir & (1 << s))) {
+        continue;
+      }
+      ir = w5x00_readSnIR(s);
+      w5x00_writeSnIR(s, ir);
+      if (ir & SnIR_SEND_OK) {
+        w5x00_socket_send_complete(s);
+      }
+      ir &= handlers[s].mask;
+      if (ir && handlers[s].callback) {
+        handlers[s].callback(s, ir, handlers[s].context);
+      }
+    }
+
+#ifdef W5x00_EVENT_USE_INT_PIN
+    // No new edge if INTn never went high, so check the level
+    if (GPIO_PinInGet(W5500_INT_PORT, W5500_INT_PIN)) {
+      break;
+    }
+#endif
+  }
+}
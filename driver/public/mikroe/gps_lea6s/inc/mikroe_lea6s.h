@@ -42,6 +42,7 @@
 #include "sl_status.h"
 #include "drv_uart.h"
 #include "gps.h"
+#include "sl_nmea_parser.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -375,21 +376,21 @@ sl_status_t mikroe_lea6s_generic_read(uint8_t *data_buf,
  *    GPS response data.
  *
  * @param[in] raw_data_buffer
- *    The buffer store read back data from GPS module.
+ *    The NUL terminated buffer store read back data from GPS module.
  * @param[in] command
  *    The command to parser. This function supports gps_command_nema_gpgga_e and
  *    gps_command_nema_gpgll_e command.
  * @param[in] element
  *    The element of command to parser.
  * @param[in] element_parser_buffer
- *    The buffer to store element value.
+ *    The buffer to store element value. The value is NUL terminated and is
+ *    at most SL_NMEA_MAX_SENTENCE_LENGTH bytes long.
  * @return
  *    gps_parser_no_error_e: If successful parser data.
  *    gps_parser_error_command_or_element_e: If command or element not support.
  *    gps_parser_error_start_or_end_command_e: If error occur at start or end
- *    of command.
- *    gps_parser_error_next_element_e: If error occur at next element.
- *    gps_parser_error_current_element_e:  If error occur at current element.
+ *    of command, or no sentence of this type with a valid checksum was
+ *    found in raw_data_buffer.
  *    gps_parser_invalid_input_parameter_e: If (raw_data_buffer == NULL) or
  *    (element_parser_buffer == NULL)
  ******************************************************************************/
@@ -399,6 +400,32 @@ mikroe_lea6s_generic_parser(uint8_t *raw_data_buffer,
                             mikroe_leas6_gpgga_command_elements_t element,
                             uint8_t *element_parser_buffer);
 
+/***************************************************************************//**
+ * @brief
+ *    Mikroe LEA 6S (GPS CLICK) incremental NMEA input. This function feeds one
+ *    received byte to the driver's NMEA tokenizer, so sentences can be decoded
+ *    as they arrive without buffering and rescanning them.
+ *
+ * @param[in] c
+ *    The byte received from the GPS module.
+ * @return
+ *    true: A complete sentence with a valid checksum is available from
+ *    mikroe_lea6s_get_nmea_sentence() until the next byte is fed.
+ *    false: The sentence is not complete yet, or it was dropped.
+ ******************************************************************************/
+bool mikroe_lea6s_nmea_process(uint8_t c);
+
+/***************************************************************************//**
+ * @brief
+ *    Mikroe LEA 6S (GPS CLICK) get the last complete NMEA sentence. Its fields
+ *    can be read with sl_nmea_get_field() or decoded with the
+ *    sl_nmea_decode_xxx() functions.
+ *
+ * @return
+ *    Pointer to the driver's NMEA tokenizer.
+ ******************************************************************************/
+const sl_nmea_tokenizer_t *mikroe_lea6s_get_nmea_sentence(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -38,9 +38,11 @@
  ******************************************************************************/
 #include "mikroe_lea6s.h"
 #include "mikroe_gps_lea6s_config.h"
+#include <string.h>
 
 static gps_t mikroe_lea6s;
 static gps_cfg_t mikroe_lea6s_cfg;
+static sl_nmea_tokenizer_t mikroe_lea6s_tokenizer;
 
 sl_status_t mikroe_lea6s_init(sl_iostream_uart_t *uart_handle)
 {
@@ -57,6 +59,7 @@ sl_status_t mikroe_lea6s_init(sl_iostream_uart_t *uart_handle)
 
     mikroe_lea6s.uart.handle = uart_handle;
     gps_init(&mikroe_lea6s, &mikroe_lea6s_cfg);
+    sl_nmea_tokenizer_init(&mikroe_lea6s_tokenizer);
 
     stt = SL_STATUS_OK;
   }
@@ -118,15 +121,55 @@ mikroe_lea6s_generic_parser(uint8_t *raw_data_buffer,
                             mikroe_leas6_gpgga_command_elements_t element,
                             uint8_t *element_parser_buffer)
 {
-  mikroe_leas6_parser_result_t stt = gps_parser_invalid_input_parameter_e;
-
-  if ((NULL != raw_data_buffer) && (NULL != element_parser_buffer)) {
-    stt = (mikroe_leas6_parser_result_t)
-          gps_generic_parser((char *)raw_data_buffer,
-                             command,
-                             element,
-                             (char *)element_parser_buffer);
+  sl_nmea_tokenizer_t tokenizer;
+  const char *address;
+  const char *field;
+  uint8_t num_element;
+
+  if ((NULL == raw_data_buffer) || (NULL == element_parser_buffer)) {
+    return gps_parser_invalid_input_parameter_e;
   }
 
-  return stt;
+  switch (command) {
+    case gps_command_nema_gpgga_e:
+      address = "GPGGA";
+      num_element = GPS_NEMA_GPGGA_NUM_ELEMENT;
+      break;
+
+    case gps_command_nema_gpgll_e:
+      address = "GPGLL";
+      num_element = GPS_NEMA_GPGLL_NUM_ELEMENT;
+      break;
+
+    default:
+      return gps_parser_error_command_or_element_e;
+  }
+
+  if ((uint8_t)element > num_element) {
+    return gps_parser_error_command_or_element_e;
+  }
+
+  // Walk the raw buffer once, stopping at the first complete sentence
+  // of the requested type that passes its checksum
+  sl_nmea_tokenizer_init(&tokenizer);
+  while ('\0' != *raw_data_buffer) {
+    if (sl_nmea_tokenizer_process(&tokenizer, (char)*raw_data_buffer++)
+        && (0 == strcmp(sl_nmea_get_field(&tokenizer, 0), address))) {
+      field = sl_nmea_get_field(&tokenizer, element);
+      memcpy(element_parser_buffer, field, strlen(field) + 1);
+      return gps_parser_no_error_e;
+    }
+  }
+
+  return gps_parser_error_start_or_end_command_e;
+}
+
+bool mikroe_lea6s_nmea_process(uint8_t c)
+{
+  return sl_nmea_tokenizer_process(&mikroe_lea6s_tokenizer, (char)c);
+}
+
+const sl_nmea_tokenizer_t *mikroe_lea6s_get_nmea_sentence(void)
+{
+  return &mikroe_lea6s_tokenizer;
 }
@@ -60,6 +60,14 @@ extern "C"
 // <o CMD_Q_SIZE> Size of queue to store at_cmd_desc_t
 // <i> Default: 20
 #define CMD_Q_SIZE     20
+
+// <o CMD_URGENT_Q_SIZE> Size of queue to store commands inserted ahead
+// <i> Default: 4
+#define CMD_URGENT_Q_SIZE 4
+
+// <o URC_LISTENER_COUNT> Maximum number of URC listeners
+// <i> Default: 8
+#define URC_LISTENER_COUNT 8
 // </h> end LTE IOT2 BG96 config
 
 // <<< end of configuration section >>>
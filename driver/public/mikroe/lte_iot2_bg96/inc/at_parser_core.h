@@ -53,10 +53,36 @@ typedef enum {
   SCH_READY = 0, SCH_SENDING, SCH_PROCESSED, SCH_ERROR,
 } at_cmd_scheduler_state_t;
 
+/// Kind of a received line, told by its leading characters
+typedef enum {
+  AT_LINE_OTHER = 0,      ///< Payload or unknown response
+  AT_LINE_ECHO,           ///< Echo of the command ("AT...")
+  AT_LINE_OK,             ///< "OK"
+  AT_LINE_ERROR,          ///< "ERROR"
+  AT_LINE_CME_ERROR,      ///< "+CME ERROR: <err>"
+  AT_LINE_CMS_ERROR,      ///< "+CMS ERROR: <err>"
+  AT_LINE_PROMPT,         ///< "> " data prompt
+  AT_LINE_SEND_OK,        ///< "SEND OK"
+  AT_LINE_SEND_FAIL,      ///< "SEND FAIL"
+  AT_LINE_CONNECT,        ///< "CONNECT"
+  AT_LINE_REVISION,       ///< "Revision: ..."
+  AT_LINE_CMGS,           ///< "+CMGS: ..."
+  AT_LINE_COPS,           ///< "+COPS: ..."
+  AT_LINE_QIACT,          ///< "+QIACT: ..."
+  AT_LINE_QIOPEN,         ///< "+QIOPEN: ..."
+  AT_LINE_QIRD,           ///< "+QIRD: ..."
+  AT_LINE_QISTATE,        ///< "+QISTATE: ..."
+  AT_LINE_QIURC,          ///< "+QIURC: ..."
+  AT_LINE_QGPSLOC,        ///< "+QGPSLOC: ..."
+} at_line_type_t;
+
+typedef void (*at_urc_cb_t)(uint8_t *urc_line);
+
 typedef struct {
   sl_status_t status;
   uint16_t error_code;
   uint8_t response_data[CMD_MAX_SIZE];
+  uint16_t data_length;     ///< Raw bytes stored in rx_buffer of the command
 } at_scheduler_status_t;
 
 /**************************************************************************//**
@@ -138,6 +164,64 @@ at_cmd_scheduler_state_t at_parser_get_scheduler_state(void);
  *****************************************************************************/
 sl_status_t at_parser_add_cmd_to_q(const at_cmd_desc_t *at_cmd_descriptor);
 
+/**************************************************************************//**
+ * @brief
+ *    Insert a command descriptor ahead of the queued commands.
+ *    The command is sent as soon as the running command completes and
+ *    reports to the output object of the running chain. If the scheduler
+ *    is idle it behaves as at_parser_add_cmd_to_q().
+ *    Command descriptor MUST be allocated until the scheduler runs.
+ *
+ * @param[in] at_cmd_descriptor
+ *    Pointer to the command descriptor to insert.
+ *
+ * @return
+ *    SL_STATUS_OK if there are no errors.
+ *    SL_STATUS_ALLOCATION_FAILED if command queue is full.
+ *    SL_STATUS_INVALID_PARAMETER if at_cmd_descriptor == NULL
+ *
+ *****************************************************************************/
+sl_status_t at_parser_insert_cmd_to_q(const at_cmd_desc_t *at_cmd_descriptor);
+
+/**************************************************************************//**
+ * @brief
+ *    Add an unsolicited result code listener.
+ *    Lines starting with the prefix are passed to the listener instead of
+ *    the line callback of the running command, whether a command is running
+ *    or not, and they don't count as lines of the command.
+ *    "+QIURC:" lines can't be listened to, at_data_cb() reads them as the
+ *    response of the data sent with QISEND.
+ *
+ * @param[in] prefix
+ *    Leading characters of the URC, e.g. "+QIND:". MUST stay allocated.
+ *
+ * @param[in] urc_callback
+ *    Callback function for the URC line.
+ *
+ * @return
+ *    SL_STATUS_OK if there are no errors.
+ *    SL_STATUS_ALLOCATION_FAILED if all listeners are in use.
+ *    SL_STATUS_INVALID_PARAMETER if prefix == NULL or urc_callback == NULL
+ *    or the prefix matches "+QIURC:" lines.
+ *
+ *****************************************************************************/
+sl_status_t at_parser_add_urc_listener(const char *prefix,
+                                       at_urc_cb_t urc_callback);
+
+/**************************************************************************//**
+ * @brief
+ *    Remove an unsolicited result code listener.
+ *
+ * @param[in] urc_callback
+ *    Callback function of the listener to remove.
+ *
+ * @return
+ *    SL_STATUS_OK if there are no errors.
+ *    SL_STATUS_NOT_FOUND if the callback is not listening.
+ *
+ *****************************************************************************/
+sl_status_t at_parser_remove_urc_listener(at_urc_cb_t urc_callback);
+
 /**************************************************************************//**
  * @brief
  *    Clears the command string in the command descriptor.
@@ -150,6 +234,18 @@ sl_status_t at_parser_add_cmd_to_q(const at_cmd_desc_t *at_cmd_descriptor);
  *****************************************************************************/
 sl_status_t at_parser_clear_cmd(at_cmd_desc_t *at_cmd_descriptor);
 
+/**************************************************************************//**
+ * @brief
+ *    Get the type of the line being handled.
+ *    The line is classified once before the line callback is called, so
+ *    callbacks don't need to search the line themselves.
+ *
+ * @return
+ *    Type of the line passed to the running line callback.
+ *
+ *****************************************************************************/
+at_line_type_t at_parser_get_line_type(void);
+
 /**************************************************************************//**
  * @brief
  *    AT parser process function.
@@ -179,5 +275,7 @@ void at_ip_cb(uint8_t *new_line, uint8_t call_number);
 void at_qistate_cb(uint8_t *new_line, uint8_t call_number);
 void at_open_cb(uint8_t *new_line, uint8_t call_number);
 void at_gpsloc_cb(uint8_t *new_line, uint8_t call_number);
+void at_recv_data_cb(uint8_t *new_line, uint8_t call_number);
+void at_send_data_cb(uint8_t *new_line, uint8_t call_number);
 
 #endif /* AT_PARSER_CORE_H_ */
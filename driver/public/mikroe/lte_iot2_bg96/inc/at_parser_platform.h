@@ -50,6 +50,8 @@
  **************************   TYPE DEFINITIONS   *******************************
  ******************************************************************************/
 typedef void (*ln_cb_t)(uint8_t *response, uint8_t call_number);
+typedef void (*at_data_cb_t)(const uint8_t *data, uint16_t length);
+typedef void (*at_idle_cb_t)(void);
 
 typedef enum {
   NOT_INITIALIZED = 0, READY, TRANSMIT
@@ -59,6 +61,11 @@ typedef struct {
   uint8_t cms_string[CMD_MAX_SIZE];
   ln_cb_t ln_cb;
   uint32_t timeout_ms;
+  const uint8_t *tx_data;   ///< Raw payload, sent instead of cms_string,
+                            ///< its echo is dropped
+  uint16_t tx_length;       ///< Length of the raw payload
+  uint8_t *rx_buffer;       ///< Buffer of the raw data phase of the response
+  uint16_t rx_size;         ///< Size of the buffer
 } at_cmd_desc_t;
 
 /**************************************************************************//**
@@ -110,6 +117,61 @@ sl_status_t at_platform_check_device_ready(void);
 sl_status_t at_platform_send_cmd(volatile uint8_t *cmd,
                                  volatile uint16_t timeout_ms);
 
+/**************************************************************************//**
+ * @brief
+ *   Platform driver send raw data function.
+ *   The data is written as is, nothing is appended.
+ *   Data SHALL be allocated until it is sent.
+ *
+ * @param[in] data
+ *   Pointer to the data to send.
+ *
+ * @param[in] length
+ *   Number of bytes to send.
+ *
+ * @param[in] timeout_ms
+ *    Timeout for the response in milliseconds.
+ *
+ * @return
+ *   SL_STATUS_OK if there are no errors.
+ *   SL_STATUS_INVALID_PARAMETER if data == NULL.
+ *****************************************************************************/
+sl_status_t at_platform_send_data(const uint8_t *data,
+                                  uint16_t length,
+                                  uint32_t timeout_ms);
+
+/**************************************************************************//**
+ * @brief
+ *   Platform driver receive raw data function.
+ *   The next length bytes after the current line are passed to the data
+ *   callback as they arrive, without any line processing. Line handling
+ *   continues after them.
+ *   Shall be called from the line callback of the line announcing the data
+ *   (e.g. "+QIRD: <len>" or "CONNECT <len>").
+ *
+ * @param[in] length
+ *   Number of raw bytes which follow the current line.
+ *
+ * @param[in] data_callback
+ *   Callback function for the raw data, may be called several times.
+ *
+ *****************************************************************************/
+void at_platform_receive_data(uint16_t length, at_data_cb_t data_callback);
+
+/**************************************************************************//**
+ * @brief
+ *   Platform driver discard raw data function.
+ *   The next length bytes are dropped without any line processing. Line
+ *   handling continues after them.
+ *   Used for the echo of the data sent with at_platform_send_data(), so a
+ *   payload looking like a result code can't end the command.
+ *
+ * @param[in] length
+ *   Number of raw bytes to drop.
+ *
+ *****************************************************************************/
+void at_platform_discard_data(uint16_t length);
+
 /**************************************************************************//**
  * @brief
  *   Platform driver finish function.
@@ -122,11 +184,25 @@ void at_platform_finish_cmd(void);
 /**************************************************************************//**
  * @brief
  *   Platform driver process function.
- *   This function removes \r and \n characters.
+ *   Drains all bytes available on the iostream in chunks and assembles
+ *   them into lines. This function removes \r and \n characters.
  *   Calls global callback if it is defined.
  *   Used to process incoming uart rx data
  *
  *****************************************************************************/
 void at_platform_process(void);
 
+/**************************************************************************//**
+ * @brief
+ *   Run a callback once at_platform_process() has handled all the bytes
+ *   received so far.
+ *   Used to send the next command only after the rest of the previous
+ *   response has been handled, so none of it is taken as its response.
+ *
+ * @param[in] idle_callback
+ *   Callback function, replaces any callback still pending.
+ *
+ *****************************************************************************/
+void at_platform_call_when_idle(at_idle_cb_t idle_callback);
+
 #endif /* AT_PARSER_PLATFORM_H_ */
@@ -58,6 +58,8 @@ extern "C" {
 #define BG96_GPIO_H_TIME 1000
 #define BG96_TIMEOUT_MS  15000
 #define DATA_MAX_LENGTH  80u
+#define BG96_NB_SEND_MAX_LENGTH 1460u
+#define BG96_NB_READ_MAX_LENGTH 1500u
 
 typedef enum {
   set_sms_mode_pdu = 0,
@@ -271,6 +273,70 @@ sl_status_t bg96_nb_send_data(bg96_nb_connection_t *connection,
  *****************************************************************************/
 sl_status_t bg96_nb_receive_data(at_scheduler_status_t *output_object);
 
+/**************************************************************************//**
+ * @brief
+ *    BG96 NB send binary data function.
+ *    The payload is written to the modem as is after the prompt, so it may
+ *    contain any byte value. Its echo is dropped unparsed, echo (ATE1) is
+ *    expected to be on as for the other commands.
+ *    Data MUST be allocated until the scheduler runs.
+ *
+ * @param[in] connection
+ *    Pointer to the connection descriptor structure.
+ *
+ * @param[in] data
+ *    Pointer to the data to send.
+ *
+ * @param[in] length
+ *    Number of bytes to send, at most BG96_NB_SEND_MAX_LENGTH.
+ *
+ * @param[out] output_object
+ *    Pointer to the output object which contains the command status and
+ *    output data.
+ *
+ * @return
+ *    SL_STATUS_OK if command successfully added to the command queue.
+ *    SL_STATUS_FAIL if scheduler is busy or command queue is full.
+ *    SL_STATUS_INVALID_PARAMETER if output_object == NULL or data == NULL or
+ *    connection == NULL or length is out of range.
+ *****************************************************************************/
+sl_status_t bg96_nb_send_buffer(bg96_nb_connection_t *connection,
+                                const uint8_t *data,
+                                uint16_t length,
+                                at_scheduler_status_t *output_object);
+
+/**************************************************************************//**
+ * @brief
+ *    BG96 NB receive binary data function.
+ *    The data announced by +QIRD is copied straight into the buffer, the
+ *    number of bytes received is returned in data_length of the output
+ *    object.
+ *    Buffer MUST be allocated until the scheduler runs.
+ *
+ * @param[in] connection
+ *    Pointer to the connection descriptor structure.
+ *
+ * @param[out] buffer
+ *    Pointer to the buffer of the received data.
+ *
+ * @param[in] size
+ *    Size of the buffer, at most BG96_NB_READ_MAX_LENGTH is read.
+ *
+ * @param[out] output_object
+ *    Pointer to the output object which contains the command status and
+ *    output data.
+ *
+ * @return
+ *    SL_STATUS_OK if command successfully added to the command queue.
+ *    SL_STATUS_FAIL if scheduler is busy or command queue is full.
+ *    SL_STATUS_INVALID_PARAMETER if output_object == NULL or buffer == NULL
+ *    or connection == NULL or size == 0.
+ *****************************************************************************/
+sl_status_t bg96_nb_receive_buffer(bg96_nb_connection_t *connection,
+                                   uint8_t *buffer,
+                                   uint16_t size,
+                                   at_scheduler_status_t *output_object);
+
 /**************************************************************************//**
  * @brief
  *    BG96 NB IoT read actual IP address function.
@@ -43,18 +43,48 @@
 /******************************************************************************
  **********************   MACRO UTILITY FUNCTIONS   ***************************
  *****************************************************************************/
-#define has_substring(container, substr) \
-  (NULL != strstr((const char *) new_line, (const char *)substr))
+#define is_line(type)   (line_type == (type))
+#define is_error_line()                                          \
+  (is_line(AT_LINE_ERROR) || is_line(AT_LINE_CME_ERROR)          \
+   || is_line(AT_LINE_CMS_ERROR))
+#define is_echo(line, cmd)                                       \
+  (is_line(AT_LINE_ECHO)                                         \
+   && (0 == strncmp((const char *) (line), cmd, sizeof(cmd) - 1)))
+
+// Type of the line if it starts with the prefix, AT_LINE_OTHER otherwise
+#define MATCH_PREFIX(line, prefix, type)                             \
+  ((0 == strncmp((const char *) (line), prefix, sizeof(prefix) - 1)) \
+   ? (type) : AT_LINE_OTHER)
+
+typedef struct {
+  const char *prefix;
+  uint8_t length;
+  at_urc_cb_t callback;
+} at_urc_listener_t;
 
 APP_QUEUE(cmd_q, at_cmd_desc_t, CMD_Q_SIZE);
+APP_QUEUE(urgent_q, at_cmd_desc_t, CMD_URGENT_Q_SIZE);
 static at_cmd_scheduler_state_t sch_state = SCH_READY;
 static at_scheduler_status_t *global_status;
+static at_cmd_desc_t active_cmd;
+static uint8_t active_cmd_line_counter = 0;
+static at_urc_listener_t urc_listeners[URC_LISTENER_COUNT];
+static at_line_type_t line_type = AT_LINE_OTHER;
+static uint8_t *raw_buffer;
+static uint16_t raw_buffer_size;
+static uint16_t raw_buffer_used;
 
 static void at_parser_scheduler_next_cmd();
+static void at_parser_scheduler_continue(void);
 static void at_parser_scheduler_error(uint8_t error_code);
 static void general_platform_cb(uint8_t *data, uint8_t call_number);
 static void at_parser_report_data(uint8_t *data);
 static void at_parser_get_ip(uint8_t *response, uint8_t *ip_output);
+static at_line_type_t at_parser_classify_line(const uint8_t *line);
+static sl_status_t at_parser_send(at_cmd_desc_t *at_cmd_descriptor);
+static sl_status_t at_parser_send_next(void);
+static bool at_parser_dispatch_urc(uint8_t *line);
+static void at_parser_store_data(const uint8_t *data, uint16_t length);
 
 /**************************************************************************//**
  * @brief
@@ -63,6 +93,7 @@ static void at_parser_get_ip(uint8_t *response, uint8_t *ip_output);
 void at_parser_init(sl_iostream_t *iostream_handle)
 {
   APP_QUEUE_INIT(&cmd_q, at_cmd_desc_t, CMD_Q_SIZE);
+  APP_QUEUE_INIT(&urgent_q, at_cmd_desc_t, CMD_URGENT_Q_SIZE);
   at_platform_init(iostream_handle, general_platform_cb);
 }
 
@@ -83,6 +114,7 @@ void at_parser_init_output_object(at_scheduler_status_t *output_object)
     output_object->error_code = 0;
     output_object->status = SL_STATUS_NOT_INITIALIZED;
     memset((void *) output_object->response_data, '\0', CMD_MAX_SIZE);
+    output_object->data_length = 0;
   }
 }
 
@@ -136,21 +168,16 @@ sl_status_t at_parser_extend_cmd(at_cmd_desc_t *at_cmd_descriptor,
 sl_status_t at_parser_start_scheduler(at_scheduler_status_t *output_object)
 {
   if (NULL != output_object) {
-    static at_cmd_desc_t at_cmd_descriptor;
-
     if (SCH_READY != sch_state) {
       return SL_STATUS_BUSY;
     }
-    if (app_queue_is_empty(&cmd_q)) {
+    if (app_queue_is_empty(&cmd_q) && app_queue_is_empty(&urgent_q)) {
       return SL_STATUS_OK;
     }
 
-    sch_state = SCH_SENDING;
     global_status = output_object;
     at_parser_init_output_object(global_status);
-    app_queue_peek(&cmd_q, (uint8_t *)&at_cmd_descriptor);
-    return at_platform_send_cmd(at_cmd_descriptor.cms_string,
-                                at_cmd_descriptor.timeout_ms);
+    return at_parser_send_next();
   }
   return SL_STATUS_INVALID_PARAMETER;
 }
@@ -169,6 +196,21 @@ at_cmd_scheduler_state_t at_parser_get_scheduler_state()
   return sch_state;
 }
 
+/**************************************************************************//**
+ * @brief
+ *    Get the type of the line being handled.
+ *    The line is classified once before the line callback is called, so
+ *    callbacks don't need to search the line themselves.
+ *
+ * @return
+ *    Type of the line passed to the running line callback.
+ *
+ *****************************************************************************/
+at_line_type_t at_parser_get_line_type(void)
+{
+  return line_type;
+}
+
 /**************************************************************************//**
  * @brief
  *    Add a command descriptor to the command queue.
@@ -196,6 +238,113 @@ sl_status_t at_parser_add_cmd_to_q(const at_cmd_desc_t *at_cmd_descriptor)
   return app_queue_add(&cmd_q, (uint8_t *)at_cmd_descriptor);
 }
 
+/**************************************************************************//**
+ * @brief
+ *    Insert a command descriptor ahead of the queued commands.
+ *    The command is sent as soon as the running command completes and
+ *    reports to the output object of the running chain. If the scheduler
+ *    is idle it behaves as at_parser_add_cmd_to_q().
+ *    Command descriptor MUST be allocated until the scheduler runs.
+ *
+ * @param[in] at_cmd_descriptor
+ *    Pointer to the command descriptor to insert.
+ *
+ * @return
+ *    SL_STATUS_OK if there are no errors.
+ *    SL_STATUS_ALLOCATION_FAILED if command queue is full.
+ *    SL_STATUS_INVALID_PARAMETER if at_cmd_descriptor == NULL
+ *
+ *****************************************************************************/
+sl_status_t at_parser_insert_cmd_to_q(const at_cmd_desc_t *at_cmd_descriptor)
+{
+  if (app_queue_is_full(&urgent_q)) {
+    return SL_STATUS_ALLOCATION_FAILED;
+  }
+
+  if (at_cmd_descriptor == NULL) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  return app_queue_add(&urgent_q, (uint8_t *)at_cmd_descriptor);
+}
+
+/**************************************************************************//**
+ * @brief
+ *    Add an unsolicited result code listener.
+ *    Lines starting with the prefix are passed to the listener instead of
+ *    the line callback of the running command, whether a command is running
+ *    or not, and they don't count as lines of the command.
+ *    "+QIURC:" lines can't be listened to, at_data_cb() reads them as the
+ *    response of the data sent with QISEND.
+ *
+ * @param[in] prefix
+ *    Leading characters of the URC, e.g. "+QIND:". MUST stay allocated.
+ *
+ * @param[in] urc_callback
+ *    Callback function for the URC line.
+ *
+ * @return
+ *    SL_STATUS_OK if there are no errors.
+ *    SL_STATUS_ALLOCATION_FAILED if all listeners are in use.
+ *    SL_STATUS_INVALID_PARAMETER if prefix == NULL or urc_callback == NULL
+ *    or the prefix matches "+QIURC:" lines.
+ *
+ *****************************************************************************/
+sl_status_t at_parser_add_urc_listener(const char *prefix,
+                                       at_urc_cb_t urc_callback)
+{
+  size_t prefix_length;
+  uint8_t i;
+
+  if ((prefix == NULL) || (urc_callback == NULL)) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+  prefix_length = sl_strlen((char *) prefix);
+  if ((prefix_length == 0) || (prefix_length >= IN_BUFFER_SIZE)) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+  // The line numbers of at_data_cb() count on the "+QIURC:" lines
+  if (0 == strncmp(prefix, "+QIURC:",
+                   (prefix_length < 7) ? prefix_length : 7)) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+  for (i = 0; i < URC_LISTENER_COUNT; i++) {
+    if (urc_listeners[i].callback == NULL) {
+      urc_listeners[i].prefix = prefix;
+      urc_listeners[i].length = (uint8_t) prefix_length;
+      urc_listeners[i].callback = urc_callback;
+      return SL_STATUS_OK;
+    }
+  }
+  return SL_STATUS_ALLOCATION_FAILED;
+}
+
+/**************************************************************************//**
+ * @brief
+ *    Remove an unsolicited result code listener.
+ *
+ * @param[in] urc_callback
+ *    Callback function of the listener to remove.
+ *
+ * @return
+ *    SL_STATUS_OK if there are no errors.
+ *    SL_STATUS_NOT_FOUND if the callback is not listening.
+ *
+ *****************************************************************************/
+sl_status_t at_parser_remove_urc_listener(at_urc_cb_t urc_callback)
+{
+  sl_status_t status = SL_STATUS_NOT_FOUND;
+  uint8_t i;
+
+  for (i = 0; i < URC_LISTENER_COUNT; i++) {
+    if ((urc_callback != NULL) && (urc_listeners[i].callback == urc_callback)) {
+      urc_listeners[i].callback = NULL;
+      status = SL_STATUS_OK;
+    }
+  }
+  return status;
+}
+
 /**************************************************************************//**
  * @brief
  *    Clears the command string in the command descriptor.
@@ -227,21 +376,14 @@ void at_parser_process(void)
 
   switch (sch_state) {
     case SCH_PROCESSED:
-      // remove previous command
-      app_queue_remove(&cmd_q, (uint8_t *)&at_cmd_descriptor);
-      at_platform_finish_cmd();
-      if (!app_queue_is_empty(&cmd_q)) {
-        app_queue_peek(&cmd_q, (uint8_t *)&at_cmd_descriptor);
-        at_platform_send_cmd(at_cmd_descriptor.cms_string,
-                             at_cmd_descriptor.timeout_ms);
-        sch_state = SCH_SENDING;
-      } else {
-        global_status->status = SL_STATUS_OK;
-        sch_state = SCH_READY;
-      }
+      // commands may have been added since the chain completed
+      at_parser_scheduler_continue();
       break;
     case SCH_ERROR:
       at_platform_finish_cmd();
+      while (!app_queue_is_empty(&urgent_q)) {
+        app_queue_remove(&urgent_q, (uint8_t *)&at_cmd_descriptor);
+      }
       while (!app_queue_is_empty(&cmd_q)) {
         app_queue_remove(&cmd_q, (uint8_t *)&at_cmd_descriptor);
       }
@@ -270,30 +412,84 @@ void at_parser_process(void)
  *****************************************************************************/
 static void general_platform_cb(uint8_t *data, uint8_t call_number)
 {
-  static at_cmd_desc_t at_cmd_descriptor;
-  if (!app_queue_is_empty(&cmd_q)) {
-    app_queue_peek(&cmd_q, (uint8_t *)&at_cmd_descriptor);
-
-    // call number == 0 means timeout occurred
-    if (call_number == 0) {
+  // call number == 0 means timeout occurred
+  if (call_number == 0) {
+    if (SCH_SENDING == sch_state) {
       at_platform_finish_cmd();
       at_parser_scheduler_error(SL_STATUS_TIMEOUT);
-    } else {
-      if (at_cmd_descriptor.ln_cb != NULL) {
-        // call line callback of the command descriptor if available
-        at_cmd_descriptor.ln_cb(data, call_number);
-      }
     }
+    return;
+  }
+  line_type = at_parser_classify_line(data);
+  if (at_parser_dispatch_urc(data)) {
+    return;
+  }
+  if ((SCH_SENDING == sch_state) && (active_cmd.ln_cb != NULL)) {
+    // call line callback of the command descriptor if available
+    active_cmd.ln_cb(data, ++active_cmd_line_counter);
   }
 }
 
 static void at_parser_scheduler_next_cmd()
 {
+  // Stop the timeout and hold back further lines until the next command
+  at_platform_finish_cmd();
   sch_state = SCH_PROCESSED;
+  // The next command goes out as soon as the rest of the received bytes are
+  // handled, not on the next process call
+  at_platform_call_when_idle(at_parser_scheduler_continue);
+}
+
+static void at_parser_scheduler_continue(void)
+{
+  if ((SCH_PROCESSED == sch_state)
+      && (SL_STATUS_EMPTY == at_parser_send_next())) {
+    global_status->status = SL_STATUS_OK;
+    sch_state = SCH_READY;
+  }
+}
+
+static sl_status_t at_parser_send_next(void)
+{
+  sl_status_t status;
+
+  // Inserted commands go first
+  if (!app_queue_is_empty(&urgent_q)) {
+    app_queue_remove(&urgent_q, (uint8_t *)&active_cmd);
+  } else if (!app_queue_is_empty(&cmd_q)) {
+    app_queue_remove(&cmd_q, (uint8_t *)&active_cmd);
+  } else {
+    return SL_STATUS_EMPTY;
+  }
+  sch_state = SCH_SENDING;
+  active_cmd_line_counter = 0;
+  status = at_parser_send(&active_cmd);
+  if (SL_STATUS_OK != status) {
+    at_parser_scheduler_error(status);
+  }
+  return status;
+}
+
+static bool at_parser_dispatch_urc(uint8_t *line)
+{
+  uint8_t i;
+
+  for (i = 0; i < URC_LISTENER_COUNT; i++) {
+    if ((urc_listeners[i].callback != NULL)
+        && (urc_listeners[i].prefix[0] == (char) line[0])
+        && (0 == strncmp((const char *) line,
+                         urc_listeners[i].prefix,
+                         urc_listeners[i].length))) {
+      urc_listeners[i].callback(line);
+      return true;
+    }
+  }
+  return false;
 }
 
 static void at_parser_scheduler_error(uint8_t error_code)
 {
+  at_platform_finish_cmd();
   global_status->error_code = error_code;
   sch_state = SCH_ERROR;
 }
@@ -306,7 +502,7 @@ void at_imei_cb(uint8_t *new_line, uint8_t call_number)
   if (new_line != NULL) {
     switch (call_number) {
       case 1:
-        if (!has_substring(new_line, "AT+GSN")) {
+        if (!is_echo(new_line, "AT+GSN")) {
           at_parser_scheduler_error(SL_STATUS_FAIL);
         }
         break;
@@ -314,7 +510,7 @@ void at_imei_cb(uint8_t *new_line, uint8_t call_number)
         at_parser_report_data(new_line);
         break;
       case 3:
-        if (has_substring(new_line, "OK")) {
+        if (is_line(AT_LINE_OK)) {
           at_parser_scheduler_next_cmd();
         } else {
           at_parser_scheduler_error(SL_STATUS_FAIL);
@@ -332,7 +528,7 @@ void at_infor_cb(uint8_t *new_line, uint8_t call_number)
   if (new_line != NULL) {
     switch (call_number) {
       case 1:
-        if (!has_substring(new_line, "ATI")) {
+        if (!is_echo(new_line, "ATI")) {
           at_parser_scheduler_error(SL_STATUS_FAIL);
         }
         break;
@@ -341,14 +537,14 @@ void at_infor_cb(uint8_t *new_line, uint8_t call_number)
       case 3:
         break;
       case 4:
-        if (has_substring(new_line, "Revision:")) {
+        if (is_line(AT_LINE_REVISION)) {
           at_parser_report_data(new_line);
         } else {
           at_parser_scheduler_error(SL_STATUS_FAIL);
         }
         break;
       case 5:
-        if (has_substring(new_line, "OK")) {
+        if (is_line(AT_LINE_OK)) {
           at_parser_scheduler_next_cmd();
         } else {
           at_parser_scheduler_error(SL_STATUS_FAIL);
@@ -366,12 +562,12 @@ void at_te_gsm_cb(uint8_t *new_line, uint8_t call_number)
   if (new_line != NULL) {
     switch (call_number) {
       case 1:
-        if (!has_substring(new_line, "AT+CSCS=")) {
+        if (!is_echo(new_line, "AT+CSCS=")) {
           at_parser_scheduler_error(SL_STATUS_FAIL);
         }
         break;
       case 2:
-        if (has_substring(new_line, "OK")) {
+        if (is_line(AT_LINE_OK)) {
           at_parser_scheduler_next_cmd();
         } else {
           at_parser_scheduler_error(SL_STATUS_FAIL);
@@ -389,12 +585,12 @@ void at_service_domain_cb(uint8_t *new_line, uint8_t call_number)
   if (new_line != NULL) {
     switch (call_number) {
       case 1:
-        if (!has_substring(new_line, "+QCFG=\"servicedomain\"")) {
+        if (!is_echo(new_line, "AT+QCFG=\"servicedomain\"")) {
           at_parser_scheduler_error(SL_STATUS_FAIL);
         }
         break;
       case 2:
-        if (has_substring(new_line, "OK")) {
+        if (is_line(AT_LINE_OK)) {
           at_parser_scheduler_next_cmd();
         } else {
           at_parser_scheduler_error(SL_STATUS_FAIL);
@@ -412,12 +608,12 @@ void set_sms_mode_cb(uint8_t *new_line, uint8_t call_number)
   if (new_line != NULL) {
     switch (call_number) {
       case 1:
-        if (!has_substring(new_line, "AT+CMGF=")) {
+        if (!is_echo(new_line, "AT+CMGF=")) {
           at_parser_scheduler_error(SL_STATUS_FAIL);
         }
         break;
       case 2:
-        if (has_substring(new_line, "OK")) {
+        if (is_line(AT_LINE_OK)) {
           at_parser_report_data(new_line);
           at_parser_scheduler_next_cmd();
         } else {
@@ -436,13 +632,12 @@ void at_sms_send_command_cb(uint8_t *new_line, uint8_t call_number)
   if (new_line != NULL) {
     switch (call_number) {
       case 1:
-        if (has_substring(new_line, "+CMS ERROR:")
-            || has_substring(new_line, "ERROR")) {
+        if (is_error_line()) {
           at_parser_scheduler_error(SL_STATUS_FAIL);
         }
         break;
       case 2:
-        if (has_substring(new_line, ">")) {
+        if (is_line(AT_LINE_PROMPT)) {
           at_parser_scheduler_next_cmd();
         } else {
           at_parser_scheduler_error(SL_STATUS_FAIL);
@@ -461,17 +656,16 @@ void at_sms_send_data_cb(uint8_t *new_line, uint8_t call_number)
     switch (call_number) {
       case 1:
       case 2:
-        if (has_substring(new_line, "+CMS ERROR:")
-            || has_substring(new_line, "ERROR")) {
+        if (is_error_line()) {
           at_parser_scheduler_error(SL_STATUS_FAIL);
         }
 
-        if (has_substring(new_line, "+CMGS:")) {
+        if (is_line(AT_LINE_CMGS)) {
           at_parser_report_data(new_line);
         }
         break;
       case 3:
-        if (has_substring(new_line, "OK")) {
+        if (is_line(AT_LINE_OK)) {
           at_parser_scheduler_next_cmd();
         } else {
           at_parser_scheduler_error(SL_STATUS_FAIL);
@@ -489,12 +683,12 @@ void at_set_sim_apn_cb(uint8_t *new_line, uint8_t call_number)
   if (new_line != NULL) {
     switch (call_number) {
       case 1:
-        if (!has_substring(new_line, "AT+CGDCONT")) {
+        if (!is_echo(new_line, "AT+CGDCONT")) {
           at_parser_scheduler_error(SL_STATUS_FAIL);
         }
         break;
       case 2:
-        if (has_substring(new_line, "OK")) {
+        if (is_line(AT_LINE_OK)) {
           at_parser_report_data(new_line);
           at_parser_scheduler_next_cmd();
         } else {
@@ -513,14 +707,13 @@ void at_gps_start_stop_cb(uint8_t *new_line, uint8_t call_number)
   if (new_line != NULL) {
     switch (call_number) {
       case 1:
-        if ((!has_substring(new_line,
-                            "AT+QGPS="))
-            && (!has_substring(new_line, "AT+QGPSEND"))) {
+        if ((!is_echo(new_line, "AT+QGPS="))
+            && (!is_echo(new_line, "AT+QGPSEND"))) {
           at_parser_scheduler_error(SL_STATUS_FAIL);
         }
         break;
       case 2:
-        if (has_substring(new_line, "OK")) {
+        if (is_line(AT_LINE_OK)) {
           at_parser_report_data(new_line);
           at_parser_scheduler_next_cmd();
         } else {
@@ -539,11 +732,11 @@ void at_ok_error_cb(uint8_t *new_line, uint8_t call_number)
   if (new_line != NULL) {
     switch (call_number) {
       case 1:
-        if (has_substring(new_line, "OK")) {
+        if (is_line(AT_LINE_OK)) {
           at_parser_report_data(new_line);
           at_parser_scheduler_next_cmd();
         }
-        if (has_substring(new_line, "ERROR")) {
+        if (is_error_line()) {
           at_parser_report_data(new_line);
           at_parser_scheduler_error(SL_STATUS_FAIL);
         }
@@ -561,12 +754,12 @@ void at_cops_cb(uint8_t *new_line, uint8_t call_number)
     switch (call_number) {
       case 1:
         at_parser_report_data(new_line);
-        if (!has_substring(new_line, "+COPS:")) {
+        if (!is_line(AT_LINE_COPS)) {
           at_parser_scheduler_error(SL_STATUS_FAIL);
         }
         break;
       case 2:
-        if (has_substring(new_line, "OK")) {
+        if (is_line(AT_LINE_OK)) {
           at_parser_scheduler_next_cmd();
         } else {
           at_parser_scheduler_error(SL_STATUS_FAIL);
@@ -588,7 +781,7 @@ void at_recv_cb(uint8_t *new_line, uint8_t call_number)
 
     switch (call_number) {
       case 1:
-        if (!has_substring(new_line, "+QIRD:")) {
+        if (!is_line(AT_LINE_QIRD)) {
           at_parser_report_data(new_line);
           at_parser_scheduler_error(SL_STATUS_FAIL);
         } else {
@@ -608,7 +801,7 @@ void at_recv_cb(uint8_t *new_line, uint8_t call_number)
         if (data_available) {
           at_parser_report_data(new_line);
         } else {
-          if (has_substring(new_line, "OK")) {
+          if (is_line(AT_LINE_OK)) {
             at_parser_scheduler_next_cmd();
           } else {
             at_parser_scheduler_error(SL_STATUS_FAIL);
@@ -617,7 +810,7 @@ void at_recv_cb(uint8_t *new_line, uint8_t call_number)
         data_available = false;
         break;
       case 3:
-        if (has_substring(new_line, "OK")) {
+        if (is_line(AT_LINE_OK)) {
           at_parser_scheduler_next_cmd();
         } else {
           at_parser_scheduler_error(SL_STATUS_FAIL);
@@ -635,7 +828,7 @@ void at_send_cb(uint8_t *new_line, uint8_t call_number)
   if (new_line != NULL) {
     switch (call_number) {
       case 1:
-        if (has_substring(new_line, ">")) {
+        if (is_line(AT_LINE_PROMPT)) {
           at_parser_scheduler_next_cmd();
         } else {
           at_parser_scheduler_error(SL_STATUS_FAIL);
@@ -653,28 +846,28 @@ void at_data_cb(uint8_t *new_line, uint8_t call_number)
   if (new_line != NULL) {
     switch (call_number) {
       case 1:
-        if (!has_substring(new_line, " ")) {
+        if (NULL == strchr((const char *) new_line, ' ')) {
           at_parser_scheduler_error(SL_STATUS_FAIL);
         }
         break;
       case 2:
-        if (!has_substring(new_line, "SEND OK")) {
+        if (!is_line(AT_LINE_SEND_OK)) {
           at_parser_scheduler_error(SL_STATUS_FAIL);
         }
         break;
       case 3:
-        if (!has_substring(new_line, "+QIURC:")) {
+        if (!is_line(AT_LINE_QIURC)) {
           at_parser_scheduler_error(SL_STATUS_FAIL);
         }
         break;
       case 4:
-        if (!has_substring(new_line, "[")) {
+        if (NULL == strchr((const char *) new_line, '[')) {
           at_parser_report_data(new_line);
           at_parser_scheduler_error(SL_STATUS_FAIL);
         }
         break;
       case 5:
-        if (!has_substring(new_line, "+QIURC:")) {
+        if (!is_line(AT_LINE_QIURC)) {
           at_parser_scheduler_next_cmd();
         } else {
           at_parser_scheduler_error(SL_STATUS_FAIL);
@@ -692,14 +885,14 @@ void at_ip_cb(uint8_t *new_line, uint8_t call_number)
   if (new_line != NULL) {
     switch (call_number) {
       case 1:
-        if (has_substring(new_line, "+QIACT:")) {
+        if (is_line(AT_LINE_QIACT)) {
           at_parser_get_ip(new_line, global_status->response_data);
         } else {
           at_parser_scheduler_error(SL_STATUS_FAIL);
         }
         break;
       case 2:
-        if (has_substring(new_line, "OK")) {
+        if (is_line(AT_LINE_OK)) {
           at_parser_scheduler_next_cmd();
         } else {
           at_parser_scheduler_error(SL_STATUS_FAIL);
@@ -718,12 +911,12 @@ void at_qistate_cb(uint8_t *new_line, uint8_t call_number)
     switch (call_number) {
       case 1:
         at_parser_report_data(new_line);
-        if (!has_substring(new_line, "+QISTATE:")) {
+        if (!is_line(AT_LINE_QISTATE)) {
           at_parser_scheduler_error(SL_STATUS_FAIL);
         }
         break;
       case 2:
-        if (has_substring(new_line, "OK")) {
+        if (is_line(AT_LINE_OK)) {
           at_parser_scheduler_next_cmd();
         } else {
           at_parser_scheduler_error(SL_STATUS_FAIL);
@@ -746,13 +939,13 @@ void at_open_cb(uint8_t *new_line, uint8_t call_number)
 
     switch (call_number) {
       case 1:
-        if (!has_substring(new_line, "OK")) {
+        if (!is_line(AT_LINE_OK)) {
           at_parser_scheduler_error(SL_STATUS_FAIL);
         }
         break;
       case 2:
         at_parser_report_data(new_line);
-        if (has_substring(new_line, "+QIOPEN:")) {
+        if (is_line(AT_LINE_QIOPEN)) {
           coma = (uint8_t *) strchr((const char *) new_line, ',');
           if (NULL != coma) {
             error_code = strtol((const char *) (++coma), NULL, 10);
@@ -783,19 +976,19 @@ void at_gpsloc_cb(uint8_t *new_line, uint8_t call_number)
     // wait OK
     switch (call_number) {
       case 1:
-        if (!has_substring(new_line, "AT+QGPSLOC?")) {
+        if (!is_echo(new_line, "AT+QGPSLOC?")) {
           at_parser_scheduler_error(SL_STATUS_FAIL);
         }
         break;
       case 2:
-        if (!has_substring(new_line, "+QGPSLOC:")) {
+        if (!is_line(AT_LINE_QGPSLOC)) {
           at_parser_scheduler_error(SL_STATUS_FAIL);
         } else {
           at_parser_report_data(new_line);
         }
         break;
       case 3:
-        if (has_substring(new_line, "OK")) {
+        if (is_line(AT_LINE_OK)) {
           at_parser_scheduler_next_cmd();
         } else {
           at_parser_scheduler_error(SL_STATUS_FAIL);
@@ -809,6 +1002,79 @@ void at_gpsloc_cb(uint8_t *new_line, uint8_t call_number)
   }
 }
 
+void at_recv_data_cb(uint8_t *new_line, uint8_t call_number)
+{
+  (void) call_number;
+  if (new_line != NULL) {
+    // The data doesn't count as lines, only its header and the result do
+    if (is_line(AT_LINE_QIRD) || is_line(AT_LINE_CONNECT)) {
+      uint8_t *space_ptr = (uint8_t *) strchr((const char *) new_line, ' ');
+      uint32_t data_length = 0;
+
+      if (space_ptr != NULL) {
+        data_length = (uint32_t) strtol((const char *) (++space_ptr), NULL, 10);
+      }
+      if (data_length > UINT16_MAX) {
+        at_parser_scheduler_error(SL_STATUS_FAIL);
+      } else if (data_length > 0) {
+        at_platform_receive_data((uint16_t) data_length, at_parser_store_data);
+      }
+    } else if (is_line(AT_LINE_OK)) {
+      at_parser_scheduler_next_cmd();
+    } else if (is_error_line()) {
+      at_parser_report_data(new_line);
+      at_parser_scheduler_error(SL_STATUS_FAIL);
+    }
+  }
+}
+
+void at_send_data_cb(uint8_t *new_line, uint8_t call_number)
+{
+  (void) call_number;
+  if (new_line != NULL) {
+    // The echo of the payload is dropped by the platform, see at_parser_send()
+    if (is_line(AT_LINE_SEND_OK)) {
+      at_parser_scheduler_next_cmd();
+    } else if (is_line(AT_LINE_SEND_FAIL) || is_error_line()) {
+      at_parser_report_data(new_line);
+      at_parser_scheduler_error(SL_STATUS_FAIL);
+    }
+  }
+}
+
+static sl_status_t at_parser_send(at_cmd_desc_t *at_cmd_descriptor)
+{
+  raw_buffer = at_cmd_descriptor->rx_buffer;
+  raw_buffer_size = at_cmd_descriptor->rx_size;
+  raw_buffer_used = 0;
+  if (at_cmd_descriptor->tx_data != NULL) {
+    // The module echoes the payload (ATE1), it must not be parsed as lines
+    at_platform_discard_data(at_cmd_descriptor->tx_length);
+    return at_platform_send_data(at_cmd_descriptor->tx_data,
+                                 at_cmd_descriptor->tx_length,
+                                 at_cmd_descriptor->timeout_ms);
+  }
+  return at_platform_send_cmd(at_cmd_descriptor->cms_string,
+                              at_cmd_descriptor->timeout_ms);
+}
+
+static void at_parser_store_data(const uint8_t *data, uint16_t length)
+{
+  uint16_t space;
+
+  if ((global_status == NULL) || (raw_buffer == NULL)) {
+    return;
+  }
+  // Data beyond the buffer is consumed but dropped
+  space = raw_buffer_size - raw_buffer_used;
+  if (length > space) {
+    length = space;
+  }
+  memcpy(&raw_buffer[raw_buffer_used], data, length);
+  raw_buffer_used += length;
+  global_status->data_length = raw_buffer_used;
+}
+
 static void at_parser_report_data(uint8_t *data)
 {
   if ((global_status != NULL) && (data != NULL)) {
@@ -842,3 +1108,77 @@ static void at_parser_get_ip(uint8_t *response, uint8_t *ip_output)
     }
   }
 }
+
+static at_line_type_t at_parser_classify_line(const uint8_t *line)
+{
+  if (line == NULL) {
+    return AT_LINE_OTHER;
+  }
+  // Trie on the leading characters, a single prefix is compared in full.
+  // The line is NUL terminated, so no case reads past its end.
+  switch (line[0]) {
+    case 'O':
+      return MATCH_PREFIX(line, "OK", AT_LINE_OK);
+    case 'E':
+      return MATCH_PREFIX(line, "ERROR", AT_LINE_ERROR);
+    case 'A':
+      return MATCH_PREFIX(line, "AT", AT_LINE_ECHO);
+    case '>':
+      return MATCH_PREFIX(line, "> ", AT_LINE_PROMPT);
+    case 'C':
+      return MATCH_PREFIX(line, "CONNECT", AT_LINE_CONNECT);
+    case 'R':
+      return MATCH_PREFIX(line, "Revision:", AT_LINE_REVISION);
+    case 'S':
+      if (0 == strncmp((const char *) line, "SEND ", 5)) {
+        return (line[5] == 'O')
+               ? MATCH_PREFIX(line, "SEND OK", AT_LINE_SEND_OK)
+               : MATCH_PREFIX(line, "SEND FAIL", AT_LINE_SEND_FAIL);
+      }
+      break;
+    case '+':
+      if (line[1] == 'Q') {
+        if (line[2] == 'G') {
+          return MATCH_PREFIX(line, "+QGPSLOC:", AT_LINE_QGPSLOC);
+        }
+        if (line[2] != 'I') {
+          break;
+        }
+        switch (line[3]) {
+          case 'U':
+            return MATCH_PREFIX(line, "+QIURC:", AT_LINE_QIURC);
+          case 'R':
+            return MATCH_PREFIX(line, "+QIRD:", AT_LINE_QIRD);
+          case 'O':
+            return MATCH_PREFIX(line, "+QIOPEN:", AT_LINE_QIOPEN);
+          case 'S':
+            return MATCH_PREFIX(line, "+QISTATE:", AT_LINE_QISTATE);
+          case 'A':
+            return MATCH_PREFIX(line, "+QIACT:", AT_LINE_QIACT);
+          default:
+            break;
+        }
+      } else if (line[1] == 'C') {
+        if (line[2] == 'O') {
+          return MATCH_PREFIX(line, "+COPS:", AT_LINE_COPS);
+        }
+        if (line[2] != 'M') {
+          break;
+        }
+        switch (line[3]) {
+          case 'E':
+            return MATCH_PREFIX(line, "+CME ERROR:", AT_LINE_CME_ERROR);
+          case 'S':
+            return MATCH_PREFIX(line, "+CMS ERROR:", AT_LINE_CMS_ERROR);
+          case 'G':
+            return MATCH_PREFIX(line, "+CMGS:", AT_LINE_CMGS);
+          default:
+            break;
+        }
+      }
+      break;
+    default:
+      break;
+  }
+  return AT_LINE_OTHER;
+}
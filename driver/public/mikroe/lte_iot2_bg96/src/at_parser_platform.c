@@ -33,6 +33,7 @@
  * at the sole discretion of Silicon Labs.
  ******************************************************************************/
 
+#include <stdbool.h>
 #include <string.h>
 #include <sl_string.h>
 #include "em_eusart.h"
@@ -42,15 +43,28 @@
 #include "app_queue.h"
 #include "mikroe_lte_iot2_bg96_config.h"
 
+// Bytes taken from the iostream per read, the backlog is drained in chunks
+// on every call of at_platform_process()
+#define RX_CHUNK_SIZE 64
+
 at_platform_status_t status = NOT_INITIALIZED;
 ln_cb_t global_cb = 0;
 sl_sleeptimer_timer_handle_t my_timer;
 static uint8_t line_counter = 0;
 static uint8_t input_buffer[IN_BUFFER_SIZE];
 static uint16_t input_buffer_index = 0;
+static uint8_t rx_chunk[RX_CHUNK_SIZE];
+static size_t rx_chunk_index = 0;
+static size_t rx_chunk_length = 0;
+static uint16_t raw_remaining = 0;
+static bool raw_skip_lf = false;
+static at_data_cb_t raw_cb = NULL;
+static at_idle_cb_t idle_cb = NULL;
 static sl_iostream_t *bg96_iostream_handle = NULL;
 
 static void timer_cb(sl_sleeptimer_timer_handle_t *handle, void *data);
+static void emit_line(void);
+static sl_status_t start_response_timer(uint32_t timeout_ms);
 
 /**************************************************************************//**
  * @brief
@@ -141,8 +155,6 @@ sl_status_t at_platform_check_device_ready(void)
 sl_status_t at_platform_send_cmd(volatile uint8_t *cmd,
                                  volatile uint16_t timeout_ms)
 {
-  sl_status_t st;
-
   if (NULL != cmd) {
     size_t cmd_length = sl_strlen((char *) cmd);
     if (cmd_length < CMD_MAX_SIZE - 1) {
@@ -150,16 +162,80 @@ sl_status_t at_platform_send_cmd(volatile uint8_t *cmd,
       sl_iostream_write(bg96_iostream_handle, (const void *)cmd,
                         sl_strlen((char *) cmd));
 
-      line_counter = 0;
-      status = TRANSMIT;
-      st = sl_sleeptimer_restart_timer_ms(&my_timer, timeout_ms, timer_cb,
-                                          (void *) NULL, 0, 0);
-      return st;
+      return start_response_timer(timeout_ms);
     }
   }
   return SL_STATUS_INVALID_PARAMETER;
 }
 
+/**************************************************************************//**
+ * @brief
+ *   Platform driver send raw data function.
+ *   The data is written as is, nothing is appended.
+ *   Data SHALL be allocated until it is sent.
+ *
+ * @param[in] data
+ *   Pointer to the data to send.
+ *
+ * @param[in] length
+ *   Number of bytes to send.
+ *
+ * @param[in] timeout_ms
+ *    Timeout for the response in milliseconds.
+ *
+ * @return
+ *   SL_STATUS_OK if there are no errors.
+ *   SL_STATUS_INVALID_PARAMETER if data == NULL.
+ *****************************************************************************/
+sl_status_t at_platform_send_data(const uint8_t *data,
+                                  uint16_t length,
+                                  uint32_t timeout_ms)
+{
+  if (NULL == data) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+  sl_iostream_write(bg96_iostream_handle, (const void *) data, length);
+  return start_response_timer(timeout_ms);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Platform driver receive raw data function.
+ *   The next length bytes after the current line are passed to the data
+ *   callback as they arrive, without any line processing.
+ *
+ * @param[in] length
+ *   Number of raw bytes which follow the current line.
+ *
+ * @param[in] data_callback
+ *   Callback function for the raw data, may be called several times.
+ *
+ *****************************************************************************/
+void at_platform_receive_data(uint16_t length, at_data_cb_t data_callback)
+{
+  raw_remaining = length;
+  raw_cb = data_callback;
+  // The line was passed on at its \r, the \n is still to come
+  raw_skip_lf = true;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Platform driver discard raw data function.
+ *   The next length bytes are dropped without any line processing.
+ *
+ * @param[in] length
+ *   Number of raw bytes to drop.
+ *
+ *****************************************************************************/
+void at_platform_discard_data(uint16_t length)
+{
+  raw_remaining = length;
+  raw_cb = NULL;
+  // Not announced by a line, the bytes start right away
+  raw_skip_lf = false;
+}
+
 /**************************************************************************//**
  * @brief
  *   Platform driver finish function.
@@ -170,6 +246,7 @@ sl_status_t at_platform_send_cmd(volatile uint8_t *cmd,
 void at_platform_finish_cmd(void)
 {
   status = READY;
+  raw_remaining = 0;
   sl_sleeptimer_stop_timer(&my_timer);
 }
 
@@ -181,43 +258,85 @@ void at_platform_finish_cmd(void)
  *****************************************************************************/
 void at_platform_process(void)
 {
-  static uint8_t tempdata;
+  at_idle_cb_t callback;
+  size_t raw_length;
+  uint8_t byte;
 
-  if (SL_STATUS_OK == sl_iostream_getchar(bg96_iostream_handle,
-                                          ( char *)&tempdata)) {
-    input_buffer[input_buffer_index] = tempdata;
-
-    if (input_buffer_index == 0) {
-      if ((input_buffer[0] == '\r') || (input_buffer[0] == '\n')) {
-        input_buffer[0] = 0;
-      } else {
-        input_buffer_index++;
+  for (;;) {
+    if (rx_chunk_index == rx_chunk_length) {
+      rx_chunk_index = 0;
+      if (SL_STATUS_OK != sl_iostream_read(bg96_iostream_handle,
+                                           rx_chunk,
+                                           sizeof(rx_chunk),
+                                           &rx_chunk_length)) {
+        rx_chunk_length = 0;
       }
-    } else if (input_buffer_index == 1) {
-      if ((input_buffer[1] == ' ') && (input_buffer[0] == '>')) {
-        global_cb(input_buffer, ++line_counter);
-        memset(input_buffer, 0, IN_BUFFER_SIZE);
-        input_buffer_index = 0;
-      } else {
-        input_buffer_index++;
+      if (rx_chunk_length == 0) {
+        // All received bytes are handled, deferred work may start now
+        callback = idle_cb;
+        idle_cb = NULL;
+        if (NULL != callback) {
+          callback();
+        }
+        return;
+      }
+    }
+    if (raw_remaining > 0) {
+      if (raw_skip_lf) {
+        raw_skip_lf = false;
+        if (rx_chunk[rx_chunk_index] == '\n') {
+          rx_chunk_index++;
+          continue;
+        }
+      }
+      // Raw data phase, pass the bytes on as they are
+      raw_length = rx_chunk_length - rx_chunk_index;
+      if (raw_length > raw_remaining) {
+        raw_length = raw_remaining;
+      }
+      if (NULL != raw_cb) {
+        raw_cb(&rx_chunk[rx_chunk_index], (uint16_t) raw_length);
+      }
+      rx_chunk_index += raw_length;
+      raw_remaining -= (uint16_t) raw_length;
+      continue;
+    }
+    byte = rx_chunk[rx_chunk_index++];
+
+    if ((byte == '\r') || (byte == '\n')) {
+      // Line terminator, empty lines are dropped
+      if (input_buffer_index == 0) {
+        continue;
       }
     } else {
-      if (input_buffer[input_buffer_index] == '\r') {
-        input_buffer[input_buffer_index] = 0;
-        global_cb(input_buffer, ++line_counter);
-        memset((void *) input_buffer, 0, IN_BUFFER_SIZE);
-        input_buffer_index = 0;
-      } else if (input_buffer_index < (IN_BUFFER_SIZE - 1)) {
-        input_buffer_index++;
-      } else {
-        global_cb(input_buffer, ++line_counter);
-        memset(input_buffer, 0, IN_BUFFER_SIZE);
-        input_buffer_index = 0;
+      input_buffer[input_buffer_index++] = byte;
+
+      // Data prompt is not terminated, overlong lines are passed in pieces
+      if (!((input_buffer_index == 2)
+            && (input_buffer[0] == '>') && (input_buffer[1] == ' '))
+          && (input_buffer_index < (IN_BUFFER_SIZE - 1))) {
+        continue;
       }
     }
+
+    emit_line();
   }
 }
 
+/**************************************************************************//**
+ * @brief
+ *   Run a callback once at_platform_process() has handled all the bytes
+ *   received so far.
+ *
+ * @param[in] idle_callback
+ *   Callback function, replaces any callback still pending.
+ *
+ *****************************************************************************/
+void at_platform_call_when_idle(at_idle_cb_t idle_callback)
+{
+  idle_cb = idle_callback;
+}
+
 /**************************************************************************//**
  * @brief
  *   Timeout handler function.
@@ -239,3 +358,34 @@ static void timer_cb(sl_sleeptimer_timer_handle_t *handle,
     global_cb(NULL, 0);
   }
 }
+
+/**************************************************************************//**
+ * @brief
+ *   Starts waiting for the response of the data just written.
+ *
+ * @param[in] timeout_ms
+ *    Timeout for the response in milliseconds.
+ *
+ *****************************************************************************/
+static sl_status_t start_response_timer(uint32_t timeout_ms)
+{
+  line_counter = 0;
+  status = TRANSMIT;
+  return sl_sleeptimer_restart_timer_ms(&my_timer, timeout_ms, timer_cb,
+                                        (void *) NULL, 0, 0);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Hands the assembled line to the line callback.
+ *   Only the terminator is written, the buffer is never cleared.
+ *
+ *****************************************************************************/
+static void emit_line(void)
+{
+  input_buffer[input_buffer_index] = 0;
+  input_buffer_index = 0;
+  if (NULL != global_cb) {
+    global_cb(input_buffer, ++line_counter);
+  }
+}
@@ -586,6 +586,107 @@ sl_status_t bg96_nb_receive_data(at_scheduler_status_t *output_object)
   return SL_STATUS_INVALID_PARAMETER;
 }
 
+/**************************************************************************//**
+ * @brief
+ *    BG96 NB send binary data function.
+ *
+ * @param[in] connection
+ *    Pointer to the connection descriptor structure.
+ *
+ * @param[in] data
+ *    Pointer to the data to send.
+ *
+ * @param[in] length
+ *    Number of bytes to send, at most BG96_NB_SEND_MAX_LENGTH.
+ *
+ * @param[out] output_object
+ *    Pointer to the output object which contains the command status and
+ *    output data.
+ *
+ * @return
+ *    SL_STATUS_OK if command successfully added to the command queue.
+ *    SL_STATUS_FAIL if scheduler is busy or command queue is full.
+ *    SL_STATUS_INVALID_PARAMETER if output_object == NULL or data == NULL or
+ *    connection == NULL or length is out of range.
+ *****************************************************************************/
+sl_status_t bg96_nb_send_buffer(bg96_nb_connection_t *connection,
+                                const uint8_t *data,
+                                uint16_t length,
+                                at_scheduler_status_t *output_object)
+{
+  if ((NULL != output_object) && (NULL != data) && (NULL != connection)
+      && (length > 0) && (length <= BG96_NB_SEND_MAX_LENGTH)) {
+    sl_status_t cmd_status = SL_STATUS_OK;
+    uint8_t data_l_string[10];
+    uint8_t base_cmd[] = "AT+QISEND=";
+    static at_cmd_desc_t at_qisend = { "", at_send_cb, AT_DEFAULT_TIMEOUT };
+    static at_cmd_desc_t at_data = { "", at_send_data_cb, AT_SEND_TIMEOUT };
+
+    at_parser_clear_cmd(&at_qisend);
+    validate(cmd_status, at_parser_extend_cmd(&at_qisend, base_cmd));
+    snprintf((char *) data_l_string, 10, "%d,%d", (int) connection->socket,
+             (int) length);
+    validate(cmd_status, at_parser_extend_cmd(&at_qisend, data_l_string));
+    at_data.tx_data = data;
+    at_data.tx_length = length;
+    validate(cmd_status, at_parser_add_cmd_to_q(&at_qisend));
+    validate(cmd_status, at_parser_add_cmd_to_q(&at_data));
+    validate(cmd_status, at_parser_start_scheduler(output_object));
+    return cmd_status;
+  }
+  return SL_STATUS_INVALID_PARAMETER;
+}
+
+/**************************************************************************//**
+ * @brief
+ *    BG96 NB receive binary data function.
+ *
+ * @param[in] connection
+ *    Pointer to the connection descriptor structure.
+ *
+ * @param[out] buffer
+ *    Pointer to the buffer of the received data.
+ *
+ * @param[in] size
+ *    Size of the buffer, at most BG96_NB_READ_MAX_LENGTH is read.
+ *
+ * @param[out] output_object
+ *    Pointer to the output object which contains the command status and
+ *    output data.
+ *
+ * @return
+ *    SL_STATUS_OK if command successfully added to the command queue.
+ *    SL_STATUS_FAIL if scheduler is busy or command queue is full.
+ *    SL_STATUS_INVALID_PARAMETER if output_object == NULL or buffer == NULL
+ *    or connection == NULL or size == 0.
+ *****************************************************************************/
+sl_status_t bg96_nb_receive_buffer(bg96_nb_connection_t *connection,
+                                   uint8_t *buffer,
+                                   uint16_t size,
+                                   at_scheduler_status_t *output_object)
+{
+  if ((NULL != output_object) && (NULL != buffer) && (NULL != connection)
+      && (size > 0)) {
+    sl_status_t cmd_status = SL_STATUS_OK;
+    uint8_t read_string[24];
+    static at_cmd_desc_t at_qird = { "", at_recv_data_cb, AT_DEFAULT_TIMEOUT };
+
+    if (size > BG96_NB_READ_MAX_LENGTH) {
+      size = BG96_NB_READ_MAX_LENGTH;
+    }
+    at_parser_clear_cmd(&at_qird);
+    snprintf((char *) read_string, sizeof(read_string), "AT+QIRD=%d,%d",
+             (int) connection->socket, (int) size);
+    validate(cmd_status, at_parser_extend_cmd(&at_qird, read_string));
+    at_qird.rx_buffer = buffer;
+    at_qird.rx_size = size;
+    validate(cmd_status, at_parser_add_cmd_to_q(&at_qird));
+    validate(cmd_status, at_parser_start_scheduler(output_object));
+    return cmd_status;
+  }
+  return SL_STATUS_INVALID_PARAMETER;
+}
+
 /**************************************************************************//**
  * @brief
  *    BG96 NB IoT read actual IP address function.
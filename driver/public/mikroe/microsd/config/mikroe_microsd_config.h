@@ -57,6 +57,21 @@ extern "C" {
 // <i> Default: 0
 #define MIKROE_MICROSD_MMC_FAST_CLOCK         0
 // </h>
+
+// <h> SDcard transfer integrity
+
+// <q MIKROE_MICROSD_CRC_ENABLE> Enable CRC protection of data blocks
+// <i>
+// <i> Sends CMD59 after initialization so the card checks the CRC16 of
+// <i> written blocks, and checks the CRC16 of every block read.
+// <i> Default: 0
+#define MIKROE_MICROSD_CRC_ENABLE             0
+
+// <o MIKROE_MICROSD_CRC_RETRY> Read retries after a CRC error <0-8>
+// <i>
+// <i> Default: 2
+#define MIKROE_MICROSD_CRC_RETRY              2
+// </h>
 // <<< end of configuration section >>>
 
 // <<< sl:start pin_tool >>>
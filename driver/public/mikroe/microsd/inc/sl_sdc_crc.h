@@ -0,0 +1,87 @@
+/***************************************************************************//**
+ * @file sl_sdc_crc.h
+ * @brief Storage Device Controls SD Card CRC7 and CRC16
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ ********************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided \'as-is\', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+#ifndef SL_SDC_CRC_H
+#define SL_SDC_CRC_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************************************************************//**
+ * @brief
+ *   Compute the CRC7 of a command token.
+ *
+ * @param[in] data
+ *   Pointer to the data (start bit, command index and argument)
+ *
+ * @param[in] len
+ *   Number of bytes
+ *
+ * @return CRC7 in bits 7..1 with the end bit set, ready to be sent
+ *
+ * @note Reference values: CMD0 (40 00 00 00 00) gives 0x95,
+ *   CMD8 (48 00 00 01 AA) gives 0x87.
+ ******************************************************************************/
+uint8_t sd_card_crc7(const uint8_t *data, size_t len);
+
+/***************************************************************************//**
+ * @brief
+ *   Compute the CRC16-CCITT (polynomial 0x1021, initial value 0) of a data
+ *   block.
+ *
+ * @param[in] crc
+ *   CRC of the previous part of the block, 0 for the first part
+ *
+ * @param[in] data
+ *   Pointer to the data
+ *
+ * @param[in] len
+ *   Number of bytes
+ *
+ * @return CRC16 of the data
+ *
+ * @note Reference value: a 512-byte block of 0xFF gives 0x7FA1, also when
+ *   it is passed in several parts.
+ ******************************************************************************/
+uint16_t sd_card_crc16(uint16_t crc, const uint8_t *data, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SL_SDC_CRC_H
@@ -84,6 +84,29 @@ DSTATUS sd_card_disk_status(void);
  ******************************************************************************/
 dresult_t sd_card_disk_read(BYTE *buff, LBA_t sector, UINT count);
 
+/***************************************************************************//**
+ * @brief
+ *   Read consecutive sectors into separate buffers from SD Card.
+ *
+ * @details
+ *   The sectors are received in a single multiple block read (CMD18) even
+ *   though their buffers are not contiguous in RAM.
+ *
+ * @param[out] buffs
+ *   Array of count pointers, one 512 byte buffer per sector
+ *
+ * @param[in] sector
+ *   Start sector in LBA
+ *
+ * @param[in] count
+ *   Number of sectors to read
+ *
+ * @return Status of Disk Functions
+ ******************************************************************************/
+dresult_t sd_card_disk_read_vector(BYTE *const *buffs,
+                                   LBA_t sector,
+                                   UINT count);
+
 /***************************************************************************//**
  * @brief
  *   Write Sector(s) to SD Card.
@@ -101,6 +124,40 @@ dresult_t sd_card_disk_read(BYTE *buff, LBA_t sector, UINT count);
  ******************************************************************************/
 dresult_t sd_card_disk_write(const BYTE *buff, LBA_t sector, UINT count);
 
+/***************************************************************************//**
+ * @brief
+ *   Write consecutive sectors held in separate buffers to SD Card.
+ *
+ * @details
+ *   The sectors are sent in a single multiple block write (CMD25) even
+ *   though their data is not contiguous in RAM.
+ *
+ * @param[in] buffs
+ *   Array of count pointers, one 512 byte buffer per sector
+ *
+ * @param[in] sector
+ *   Start sector in LBA
+ *
+ * @param[in] count
+ *   Number of sectors to write
+ *
+ * @return Status of Disk Functions
+ ******************************************************************************/
+dresult_t sd_card_disk_write_vector(const BYTE *const *buffs,
+                                    LBA_t sector,
+                                    UINT count);
+
+/***************************************************************************//**
+ * @brief
+ *   Get the number of data blocks rejected for a CRC mismatch.
+ *   Only counts while MIKROE_MICROSD_CRC_ENABLE is set, this includes
+ *   read blocks that were recovered by a retry.
+ *
+ * @return
+ *   Number of CRC errors since power up
+ ******************************************************************************/
+uint32_t sd_card_get_crc_error_count(void);
+
 /***************************************************************************//**
  * @brief
  *   Miscellaneous Functions.
@@ -33,6 +33,7 @@
  * at the sole discretion of Silicon Labs.
  ******************************************************************************/
 #include "sl_sdc_sd_card.h"
+#include "sl_sdc_crc.h"
 #include "mikroe_microsd_config.h"
 
 typedef struct {
@@ -99,10 +100,13 @@ static Ecode_t GetSpiPins(SPIDRV_Handle_t handle, SPI_Pins_t *pins);
 #define CMD49         (49)    // WRITE_EXTR_SINGLE
 #define CMD55         (55)    // APP_CMD
 #define CMD58         (58)    // READ_OCR
+#define CMD59         (59)    // CRC_ON_OFF
 
 static volatile DSTATUS sd_card_status = STA_NOINIT; // Disk status
 static BYTE sd_card_type; // Card type flags
 static volatile UINT sd_card_timer_1, sd_card_timer_2; // 1kHz decrement timer
+static bool sd_card_crc_on; // Data block CRC checked by card and host
+static uint32_t sd_card_crc_errors; // Data blocks rejected for a CRC mismatch
 
 static SPIDRV_Handle_t sdc_spi_handle = NULL;
 static sl_sleeptimer_timer_handle_t disk_timerproc_timer_handle;
@@ -194,6 +198,7 @@ static bool select(void)
 static bool rcvr_datablock(BYTE *buff, UINT btr)
 {
   BYTE token;
+  BYTE crc[2];
 
   sd_card_timer_1 = 100;
   do { // Wait for data packet in timeout of 100ms
@@ -207,10 +212,16 @@ static bool rcvr_datablock(BYTE *buff, UINT btr)
 
   sdc_rcvr_spi_multi(sdc_spi_handle, buff, btr); // Receive the data block into
                                                  //   buffer
-  // Discard 2 byte-CRC.
+  // Receive 2 byte-CRC, only checked in CRC mode.
   // Refer to http://elm-chan.org/docs/mmc/mmc_e.html#dataxfer for details"
-  sdc_xchg_spi(sdc_spi_handle, 0xff, &token);
-  sdc_xchg_spi(sdc_spi_handle, 0xff, &token);
+  sdc_xchg_spi(sdc_spi_handle, 0xff, &crc[0]);
+  sdc_xchg_spi(sdc_spi_handle, 0xff, &crc[1]);
+
+  if (sd_card_crc_on
+      && (sd_card_crc16(0, buff, btr) != (((WORD)crc[0] << 8) | crc[1]))) {
+    sd_card_crc_errors++;
+    return 0;
+  }
 
   return 1;
 }
@@ -231,22 +242,31 @@ static bool rcvr_datablock(BYTE *buff, UINT btr)
 static bool xmit_datablock(const BYTE *buff, BYTE token)
 {
   BYTE data;
+  WORD crc = 0xffff; // Dummy CRC, ignored by the card unless in CRC mode
 
   if (!wait_ready(500)) {
     return 0;
   }
 
+  if ((token != 0xfd) && sd_card_crc_on) {
+    // Computed before the token so the card is not kept waiting mid-block
+    crc = sd_card_crc16(0, buff, 512);
+  }
+
   sdc_xchg_spi(sdc_spi_handle, token, &data);      // Xmit a token
   if (token != 0xfd) {             // Not StopTran token
     sdc_xmit_spi_multi(sdc_spi_handle, buff, 512); // Xmit the data block to the
                                                    //   MMC
-    // Discard 2 byte-CRC.
+    // Xmit 2 byte-CRC.
     // Refer to http://elm-chan.org/docs/mmc/mmc_e.html#dataxfer for details"
-    sdc_xchg_spi(sdc_spi_handle, 0xff, &data);
-    sdc_xchg_spi(sdc_spi_handle, 0xff, &data);
+    sdc_xchg_spi(sdc_spi_handle, (BYTE)(crc >> 8), &data);
+    sdc_xchg_spi(sdc_spi_handle, (BYTE)crc, &data);
     sdc_xchg_spi(sdc_spi_handle, 0xff, &data);     // Receive a data response
     // If not accepted, return with error
     if ((data & 0x1F) != 0x05) {
+      if ((data & 0x1F) == 0x0B) { // Data rejected due to a CRC error
+        sd_card_crc_errors++;
+      }
       return 0;
     }
   }
@@ -271,6 +291,7 @@ static bool xmit_datablock(const BYTE *buff, BYTE token)
 static BYTE send_cmd(BYTE cmd, DWORD arg)
 {
   BYTE n, data;
+  BYTE packet[5];
 
   // ACMD<n> is the command sequense of CMD55-CMD<n>
   if (cmd & 0x80) {
@@ -290,20 +311,17 @@ static BYTE send_cmd(BYTE cmd, DWORD arg)
   }
 
   // Send command packet
-  sdc_xchg_spi(sdc_spi_handle, 0x40 | cmd, &data); // Start + Command index
-  sdc_xchg_spi(sdc_spi_handle, ((BYTE)(arg >> 24)), &data); // Argument[31..24]
-  sdc_xchg_spi(sdc_spi_handle, ((BYTE)(arg >> 16)), &data); // Argument[23..16]
-  sdc_xchg_spi(sdc_spi_handle, ((BYTE)(arg >> 8)), &data);  // Argument[15..8]
-  sdc_xchg_spi(sdc_spi_handle, (BYTE)(arg), &data);         // Argument[7..0]
-
-  n = 0x01;           // Dummy CRC + Stop
-  if (cmd == CMD0) {
-    n = 0x95;         // Valid CRC for CMD0(0) + Stop
+  packet[0] = 0x40 | cmd;           // Start + Command index
+  packet[1] = (BYTE)(arg >> 24);    // Argument[31..24]
+  packet[2] = (BYTE)(arg >> 16);    // Argument[23..16]
+  packet[3] = (BYTE)(arg >> 8);     // Argument[15..8]
+  packet[4] = (BYTE)(arg);          // Argument[7..0]
+  for (n = 0; n < 5; n++) {
+    sdc_xchg_spi(sdc_spi_handle, packet[n], &data);
   }
-  if (cmd == CMD8) {
-    n = 0x87;         // Valid CRC for CMD8(0x1AA) + Stop
-  }
-  sdc_xchg_spi(sdc_spi_handle, n, &data);
+
+  // Valid CRC + Stop for every command, so CRC mode can be enabled
+  sdc_xchg_spi(sdc_spi_handle, sd_card_crc7(packet, 5), &data);
 
   // Receive command response
   if (cmd == CMD12) {
@@ -337,6 +355,7 @@ DSTATUS sd_card_disk_initialize(void)
   }
 
   ty = 0;
+  sd_card_crc_on = false;             // CMD0 turns the card CRC mode off
   if (send_cmd(CMD0, 0) == 1) {       // Put the card SPI mode
     sd_card_timer_1 = 1000;           // Initialization timeout = 1 sec
     if (send_cmd(CMD8, 0x1aa) == 1) { // Is the card SDv2?
@@ -379,6 +398,11 @@ DSTATUS sd_card_disk_initialize(void)
     }
   }
   sd_card_type = ty;   // Card type
+#if MIKROE_MICROSD_CRC_ENABLE
+  if (ty && (send_cmd(CMD59, 1) == 0)) {  // CRC_ON_OFF: on
+    sd_card_crc_on = true;
+  }
+#endif
   deselect();
 
   if (ty) {        // OK
@@ -400,11 +424,32 @@ DSTATUS sd_card_disk_status(void)
 }
 
 /***************************************************************************//**
- * Read Sector(s) from SD Card.
+ * @brief
+ *   Read consecutive sectors from SD Card.
+ *
+ * @param[out] buffs
+ *   Array of one buffer pointer per sector, or NULL to use buff
+ *
+ * @param[out] buff
+ *   Pointer to contiguous sector buffer, used when buffs is NULL
+ *
+ * @param[in] sector
+ *   Start sector in LBA
+ *
+ * @param[in] count
+ *   Number of sectors to read
+ *
+ * @return Status of Disk Functions
  ******************************************************************************/
-dresult_t sd_card_disk_read(BYTE *buff, LBA_t sector, UINT count)
+static dresult_t read_sectors(BYTE *const *buffs,
+                              BYTE *buff,
+                              LBA_t sector,
+                              UINT count)
 {
   DWORD sect = (DWORD)sector;
+  uint32_t crc_errors;
+  UINT retry;
+  UINT left;
 
   // Check parameter
   if (!count) {
@@ -421,36 +466,92 @@ dresult_t sd_card_disk_read(BYTE *buff, LBA_t sector, UINT count)
     sect *= 512;
   }
 
-  // Single block read
-  if (count == 1) {
-    if ((send_cmd(CMD17, sect) == 0)  // READ_SINGLE_BLOCK
-        && rcvr_datablock(buff, 512)) {
-      count = 0;
+  // Blocks corrupted on the bus are read again from the failed one on
+  for (retry = 0; ; retry++) {
+    crc_errors = sd_card_crc_errors;
+    left = count;
+
+    // Single block read
+    if (left == 1) {
+      if ((send_cmd(CMD17, sect) == 0)  // READ_SINGLE_BLOCK
+          && rcvr_datablock(buffs ? buffs[0] : buff, 512)) {
+        left = 0;
+      }
+    } else { // Multiple block read
+      if (send_cmd(CMD18, sect) == 0) { // READ_MULTIPLE_BLOCK
+        do {
+          if (!rcvr_datablock(buffs ? buffs[0] : buff, 512)) {
+            break;
+          }
+          if (buffs) {
+            buffs++;
+          } else {
+            buff += 512;
+          }
+          sect += (sd_card_type & CT_BLOCK) ? 1 : 512;
+        } while (--left);
+        send_cmd(CMD12, 0); // STOP_TRANSMISSION
+      }
     }
-  } else { // Multiple block read
-    if (send_cmd(CMD18, sect) == 0) { // READ_MULTIPLE_BLOCK
-      do {
-        if (!rcvr_datablock(buff, 512)) {
-          break;
-        }
-        buff += 512;
-      } while (--count);
-      send_cmd(CMD12, 0); // STOP_TRANSMISSION
+    deselect();
+
+    if (!left || (sd_card_crc_errors == crc_errors)
+        || (retry >= MIKROE_MICROSD_CRC_RETRY)) {
+      break;
     }
+    count = left;
   }
-  deselect();
 
-  return count ? RES_ERROR : RES_OK;
+  return left ? RES_ERROR : RES_OK;
 }
 
 /***************************************************************************//**
- * Write Sector(s) to SD Card.
+ * Read Sector(s) from SD Card.
+ ******************************************************************************/
+dresult_t sd_card_disk_read(BYTE *buff, LBA_t sector, UINT count)
+{
+  return read_sectors(NULL, buff, sector, count);
+}
+
+/***************************************************************************//**
+ * Read consecutive sectors into separate buffers from SD Card.
+ ******************************************************************************/
+dresult_t sd_card_disk_read_vector(BYTE *const *buffs,
+                                   LBA_t sector,
+                                   UINT count)
+{
+  return read_sectors(buffs, NULL, sector, count);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Write consecutive sectors to SD Card.
+ *
+ * @param[in] buffs
+ *   Array of one buffer pointer per sector, or NULL to use buff
+ *
+ * @param[in] buff
+ *   Pointer to contiguous sector data, used when buffs is NULL
+ *
+ * @param[in] sector
+ *   Start sector in LBA
+ *
+ * @param[in] count
+ *   Number of sectors to write
+ *
+ * @return Status of Disk Functions
  ******************************************************************************/
 #if FF_FS_READONLY == 0
-dresult_t sd_card_disk_write(const BYTE *buff, LBA_t sector, UINT count)
+static dresult_t write_sectors(const BYTE *const *buffs,
+                               const BYTE *buff,
+                               LBA_t sector,
+                               UINT count)
 {
   DWORD sect = (DWORD)sector;
 
+  if (!count) {
+    return RES_PARERR;
+  }
   if (sd_card_status & STA_NOINIT) { // Check drive status
     return RES_NOTRDY;
   }
@@ -465,7 +566,7 @@ dresult_t sd_card_disk_write(const BYTE *buff, LBA_t sector, UINT count)
 
   if (count == 1) { // Single sector write
     if ((send_cmd(CMD24, sect) == 0)  // WRITE_BLOCK
-        && xmit_datablock(buff, 0xFE)) {
+        && xmit_datablock(buffs ? buffs[0] : buff, 0xFE)) {
       count = 0;
     }
   } else { // Multiple sector write
@@ -474,10 +575,12 @@ dresult_t sd_card_disk_write(const BYTE *buff, LBA_t sector, UINT count)
     }
     if (send_cmd(CMD25, sect) == 0) { // WRITE_MULTIPLE_BLOCK
       do {
-        if (!xmit_datablock(buff, 0xFC)) {
+        if (!xmit_datablock(buffs ? *buffs++ : buff, 0xFC)) {
           break;
         }
-        buff += 512;
+        if (!buffs) {
+          buff += 512;
+        }
       } while (--count);
 
       if (!xmit_datablock(0, 0xFD)) { // STOP_TRAN token
@@ -490,6 +593,24 @@ dresult_t sd_card_disk_write(const BYTE *buff, LBA_t sector, UINT count)
   return count ? RES_ERROR : RES_OK;
 }
 
+/***************************************************************************//**
+ * Write Sector(s) to SD Card.
+ ******************************************************************************/
+dresult_t sd_card_disk_write(const BYTE *buff, LBA_t sector, UINT count)
+{
+  return write_sectors(NULL, buff, sector, count);
+}
+
+/***************************************************************************//**
+ * Write consecutive sectors held in separate buffers to SD Card.
+ ******************************************************************************/
+dresult_t sd_card_disk_write_vector(const BYTE *const *buffs,
+                                    LBA_t sector,
+                                    UINT count)
+{
+  return write_sectors(buffs, NULL, sector, count);
+}
+
 #endif
 
 /***************************************************************************//**
@@ -645,6 +766,15 @@ dresult_t sd_card_disk_ioctl(BYTE cmd, void *buff)
       deselect();
       break;
 
+    // Check if the card finished programming without waiting (1 byte)
+    case MMC_GET_READY:
+      // The SPI driver asserts CS for the exchange, so the card drives DO
+      sdc_xchg_spi(sdc_spi_handle, 0xff, &data);
+      *ptr = (data == 0xff) ? 1 : 0;
+      deselect();
+      res = RES_OK;
+      break;
+
     // Receive SD status as a data block (64 bytes)
     case MMC_GET_SDSTAT:
       // SD_STATUS
@@ -665,6 +795,14 @@ dresult_t sd_card_disk_ioctl(BYTE cmd, void *buff)
   return res;
 }
 
+/***************************************************************************//**
+ * Get the number of data blocks rejected for a CRC mismatch.
+ ******************************************************************************/
+uint32_t sd_card_get_crc_error_count(void)
+{
+  return sd_card_crc_errors;
+}
+
 /***************************************************************************//**
  * @brief Initialize SPI interface for SD Card.
  ******************************************************************************/
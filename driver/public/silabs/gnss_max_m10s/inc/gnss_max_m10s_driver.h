@@ -109,8 +109,19 @@ extern "C" {
 #define UBX_NAV_VELNED             0x12                   ///< Value for message ID of UBX_NAV_VELNED type UBX message
 #define FILE_BUFFER_SIZE           MAX_PAYLOAD_SIZE       ///< Value for the UBX buffer size
 #define I2C_TRANSACTION_SIZE       32                     ///< Value for I2C transaction size
+#define I2C_READ_SIZE              128                    ///< Value for maximum length of an I2C stream read
+#define UBLOX_REG_BYTES_AVAILABLE  0xFD                   ///< Value for address of the available bytes registers (0xFD MSB, 0xFE LSB)
 #define I2C_POLLING_WAIT           100                    ///< Value to poll the I2C data
 #define NMEA_MAX_BYTE_COUNT        100                    ///< Value for default maximum NMEA byte count
+#define NAV_PVT_MAX_AGE            1000                   ///< Value for default maximum age (ms) of the cached UBX-NAV-PVT epoch
+#define UBX_CALLBACK_COUNT         4                      ///< Value for maximum number of user UBX message callbacks
+#define UBX_ACK_NACK               0x00                   ///< Value for message ID for NAK of ACK class
+#define UBX_ACK_PENDING_COUNT      4                      ///< Value for maximum number of asynchronous commands waiting for completion
+#define UBLOX_CFG_TXREADY_ENABLED  0x10a20001             ///< Value to enable the TX-ready pin
+#define UBLOX_CFG_TXREADY_POLARITY 0x10a20002             ///< Value for the TX-ready pin polarity (0 = active high)
+#define UBLOX_CFG_TXREADY_PIN      0x20a20003             ///< Value for the PIO used as TX-ready pin
+#define UBLOX_CFG_TXREADY_THRESHOLD 0x30a20004            ///< Value for the TX-ready threshold, in units of 8 bytes
+#define UBLOX_CFG_TXREADY_INTERFACE 0x20a20005            ///< Value for the interface monitored by the TX-ready pin (0 = I2C)
 
 /*******************************************************************************
  ********************************   ENUMS   ************************************
@@ -217,6 +228,57 @@ typedef struct sl_max_m10s_ubx_packet
   sl_max_m10s_ublox_packet_validity_e class_and_id_match;  ///< Goes from NOT_DEFINED to VALID or NOT_VALID when the Class and ID match the requestedClass and requestedID
 }sl_max_m10s_ubx_packet_t;
 
+/// @brief User callback called with every valid UBX message of the registered class and ID
+typedef void (*sl_max_m10s_ubx_callback_t)(sl_max_m10s_ubx_packet_t *msg);
+
+/// @brief to store a user callback registered for a UBX message
+typedef struct sl_max_m10s_ubx_user_callback
+{
+  uint8_t cls;                                             ///< class of the UBX message
+  uint8_t id;                                              ///< ID of the UBX message
+  sl_max_m10s_ubx_callback_t callback;                     ///< Callback to call with the message
+}sl_max_m10s_ubx_user_callback_t;
+
+/// @brief Completion callback of a command sent with gnss_max_m10s_send_command_async()
+typedef void (*sl_max_m10s_ubx_ack_callback_t)(uint8_t cls,
+                                               uint8_t id,
+                                               sl_max_m10s_ublox_status_e status,
+                                               void *context);
+
+/// @brief to store an asynchronous command waiting for its completion
+typedef struct sl_max_m10s_ubx_pending_ack
+{
+  uint8_t cls;                                             ///< class of the command
+  uint8_t id;                                              ///< ID of the command
+  bool expect_ack;                                         ///< Completed by ACK/NAK if true, by a response of the same class and ID otherwise
+  bool tx_ready;                                           ///< The command configures the TX-ready pin
+  bool tx_ready_enable;                                    ///< TX-ready state requested by the command
+  uint16_t max_wait;                                       ///< Timeout (ms) of the command
+  uint32_t start_time;                                     ///< Time (ms) the command was sent
+  sl_max_m10s_ubx_ack_callback_t callback;                 ///< Callback to call on completion, NULL if none
+  void *context;                                           ///< User context passed to the callback
+}sl_max_m10s_ubx_pending_ack_t;
+
+/// @brief Lock-free single producer/single consumer queue of received UBX and NMEA frames
+typedef struct sl_max_m10s_frame_queue
+{
+  uint8_t *buffer;                                         ///< Queue storage provided by the user, NULL if the queue is disabled
+  uint16_t size;                                           ///< Size of the queue storage
+  volatile uint16_t head;                                  ///< End of the last complete frame, only written by the reader of the receiver
+  volatile uint16_t tail;                                  ///< Start of the oldest frame, only written by gnss_max_m10s_read_frame()
+  uint16_t write;                                          ///< Write position in the frame being received
+  uint16_t frame_len;                                      ///< Number of bytes received in the current frame
+  uint16_t payload_len;                                    ///< Payload length of the UBX frame being received
+  uint8_t state;                                           ///< Framing state
+  uint8_t checksum_a;                                      ///< Rolling UBX checksum A or NMEA XOR checksum
+  uint8_t checksum_b;                                      ///< Rolling UBX checksum B or received NMEA checksum
+  uint8_t cls;                                             ///< class of the UBX frame being received
+  uint8_t id;                                              ///< ID of the UBX frame being received
+  uint8_t ack_payload[2];                                  ///< First two payload bytes, class and ID of an ACK/NAK
+  bool overflow;                                           ///< The current frame does not fit in the queue
+  uint32_t dropped;                                        ///< Number of frames dropped because the queue was full
+}sl_max_m10s_frame_queue_t;
+
 /// @brief to store the different types of pay load from UBX packets.
 typedef struct sl_max_m10s_msg_data
 {
@@ -244,6 +306,7 @@ typedef struct sl_max_m10s_cfg_data
   uint16_t           file_buffer_tail;                             ///< Value for ending of file buffer
   uint16_t           file_buffer_max_avail;                        ///< Value for maximum available size in file buffer
   uint16_t           ubx_frame_counter;                            ///< Counter for UBX frame data
+  uint16_t           nav_pvt_max_age;                              ///< Age (ms) after which the cached UBX-NAV-PVT epoch is refreshed
   sl_max_m10s_gnss_status_e status;                                ///< Status of the driver function
   sl_max_m10s_protocol_type_e protocol_type;                       ///< To check the protocol type
   sl_max_m10s_ublox_sentence_types_e current_sentence;             ///< To show the current sentence type
@@ -263,6 +326,13 @@ typedef struct sl_max_m10s_cfg_data
   sl_max_m10s_ubx_nav_posllh_t *packetUBXNAVPOSLLH;                ///< UBX_NAV_POSLLH type UBX packet
   sl_max_m10s_ubx_nav_velned_t *packetUBXNAVVELNED;                ///< UBX_NAV_VELNED UBX packet
   sl_max_m10s_ubx_unique_id_t *packetUBXUNIQID;                    ///< UBX_SEC_UNIQID UBX packet
+  sl_max_m10s_ubx_user_callback_t ubx_callbacks[UBX_CALLBACK_COUNT]; ///< User callbacks for UBX messages
+  uint8_t            ubx_callback_count;                           ///< Number of registered user callbacks
+  sl_max_m10s_ubx_pending_ack_t pending_acks[UBX_ACK_PENDING_COUNT]; ///< Asynchronous commands waiting for completion
+  uint8_t            pending_ack_count;                            ///< Number of asynchronous commands waiting for completion
+  sl_max_m10s_frame_queue_t frame_queue;                           ///< Queue of the received UBX and NMEA frames
+  volatile bool      tx_ready_pending;                             ///< Set by the TX-ready pin interrupt, data is waiting in the receiver
+  bool               tx_ready_enabled;                             ///< The receiver drives the TX-ready pin
   sl_max_m10s_nmea_gga_t *storageNMEAGPGGA;                        ///< GPGGA type NMEA sentence
   sl_max_m10s_nmea_gga_t *storageNMEAGNGGA;                        ///< GNGGA type NMEA sentence
   sl_max_m10s_nmea_rmc_t *storageNMEAGPRMC;                        ///< GPRMC type NMEA sentence
@@ -274,7 +344,6 @@ typedef struct sl_max_m10s_cfg_data
   sl_max_m10s_ubx_packet_t packet_buf;                             ///< structure to store the UBX message as buffer
   sl_max_m10s_ubx_packet_t packet_auto;                            ///< structure to store automatic type UBX message
   sl_max_m10s_ubx_packet_t packet_cfg;                             ///< structure to store config type UBX message
-  char                nmea_buffer[100];                            ///< Buffer to store NMEA sentence.
   uint8_t            nmea_address_field[6];                        ///< NMEA address field
 } sl_max_m10s_cfg_data_t;
 
@@ -354,6 +423,149 @@ void gnss_max_m10s_add_to_checksum(sl_max_m10s_cfg_data_t *gnss_cfg_data,
 bool gnss_max_m10s_auto_lookup(sl_max_m10s_cfg_data_t *gnss_cfg_data,
                                uint16_t *max_size);
 
+/**************************************************************************//**
+ * @brief Register a callback for a UBX message class and ID
+ * @param[in] gnss_cfg_data : pointer to the structure containing GNSS configuration data.
+ * @param[in] cls : class of the UBX message.
+ * @param[in] id : ID of the UBX message.
+ * @param[in] callback : function called with every valid message, NULL to unregister.
+ * @return The following values are returned:
+ * - \ref SL_STATUS_OK on success.
+ * - \ref SL_STATUS_FULL if UBX_CALLBACK_COUNT callbacks are already registered.
+ * @note 1. The callback runs from gnss_max_m10s_check_ublox_internal() context.
+ *       2. Messages the driver does not decode itself are stored for the callback,
+ *          so it sees the complete payload of any registered message.
+ *****************************************************************************/
+sl_status_t gnss_max_m10s_set_ubx_callback(
+  sl_max_m10s_cfg_data_t *gnss_cfg_data,
+  uint8_t cls,
+  uint8_t id,
+  sl_max_m10s_ubx_callback_t callback);
+
+/**************************************************************************//**
+ * @brief Sends the active UBX packet without waiting for the receiver.
+ * @param[in] gnss_cfg_data : pointer to the structure containing GNSS configuration data.
+ * @param[in] max_wait : Timeout value (ms), 0 to not track the completion.
+ * @param[in] callback : function called on completion, may be NULL.
+ * @param[in] context : user context passed to the callback.
+ * @return The following values are returned:
+ * - \ref SL_STATUS_OK if the packet was sent.
+ * - \ref SL_STATUS_NULL_POINTER if gnss_cfg_data is NULL.
+ * - \ref SL_STATUS_FULL if UBX_ACK_PENDING_COUNT commands are already pending.
+ * - \ref SL_STATUS_FAIL on I2C failure.
+ * @note 1. CFG class commands complete with
+ *          SL_MAX_M10S_UBLOX_STATUS_DATA_SENT on ACK or
+ *          SL_MAX_M10S_UBLOX_STATUS_COMMAND_NACK on NAK, other commands
+ *          complete with SL_MAX_M10S_UBLOX_STATUS_DATA_RECEIVED when a
+ *          message of the same class and ID is received.
+ *       2. Commands not completed within max_wait complete with
+ *          SL_MAX_M10S_UBLOX_STATUS_TIMEOUT.
+ *       3. The callback runs from the context reading the receiver, usually
+ *          gnss_max_m10s_process_action().
+ *****************************************************************************/
+sl_status_t gnss_max_m10s_send_command_async(
+  sl_max_m10s_cfg_data_t *gnss_cfg_data,
+  uint16_t max_wait,
+  sl_max_m10s_ubx_ack_callback_t callback,
+  void *context);
+
+/**************************************************************************//**
+ * @brief Background processing of the receiver, to call from the application
+ *        main loop.
+ *        When the TX-ready pin is enabled, the receiver backlog is only read
+ *        after gnss_max_m10s_tx_ready_irq_handler() signaled it, otherwise it
+ *        is read on every call. The backlog is read in bulk, complete frames
+ *        are pushed to the frame queue and asynchronous commands are
+ *        completed or timed out.
+ * @param[in] gnss_cfg_data : pointer to the structure containing GNSS configuration data.
+ * @return The following values are returned:
+ * - \ref SL_STATUS_OK on success.
+ * - \ref SL_STATUS_NULL_POINTER if gnss_cfg_data is NULL.
+ * - \ref SL_STATUS_FAIL on I2C failure.
+ * @note This function never waits for the receiver.
+ *****************************************************************************/
+sl_status_t gnss_max_m10s_process_action(sl_max_m10s_cfg_data_t *gnss_cfg_data);
+
+/**************************************************************************//**
+ * @brief Signals that the receiver asserted its TX-ready pin.
+ * @param[in] gnss_cfg_data : pointer to the structure containing GNSS configuration data.
+ * @note 1. Safe to call from interrupt context, it only flags the data for
+ *          the next gnss_max_m10s_process_action().
+ *       2. Call it from the rising edge interrupt of the pin connected to
+ *          the TX-ready PIO, e.g. from a GPIOINT callback:
+ *          static void tx_ready_callback(uint8_t pin)
+ *          {
+ *            (void)pin;
+ *            gnss_max_m10s_tx_ready_irq_handler(&gnss_cfg_data);
+ *          }
+ *****************************************************************************/
+void gnss_max_m10s_tx_ready_irq_handler(sl_max_m10s_cfg_data_t *gnss_cfg_data);
+
+/**************************************************************************//**
+ * @brief Configures the TX-ready pin of the receiver for the I2C interface.
+ * @param[in] gnss_cfg_data : pointer to the structure containing GNSS configuration data.
+ * @param[in] enable : true to enable the TX-ready pin, false to disable it.
+ * @param[in] pio : PIO of the receiver used as TX-ready pin (active high).
+ * @param[in] threshold : number of bytes waiting before the pin is asserted,
+ *                        rounded down to a multiple of 8.
+ * @param[in] callback : function called on completion, may be NULL.
+ * @param[in] context : user context passed to the callback.
+ * @return The following values are returned:
+ * - \ref SL_STATUS_OK if the configuration was sent.
+ * - \ref SL_STATUS_NULL_POINTER if gnss_cfg_data is NULL.
+ * - \ref SL_STATUS_FULL if UBX_ACK_PENDING_COUNT commands are already pending.
+ * - \ref SL_STATUS_FAIL on failure.
+ * @note The configuration is sent with gnss_max_m10s_send_command_async(),
+ *       gnss_max_m10s_process_action() waits for the pin once the receiver
+ *       acknowledged it.
+ *****************************************************************************/
+sl_status_t gnss_max_m10s_set_tx_ready(sl_max_m10s_cfg_data_t *gnss_cfg_data,
+                                       bool enable,
+                                       uint8_t pio,
+                                       uint16_t threshold,
+                                       sl_max_m10s_ubx_ack_callback_t callback,
+                                       void *context);
+
+/**************************************************************************//**
+ * @brief Sets the storage of the frame queue.
+ *        Every complete UBX frame and NMEA sentence with a valid checksum is
+ *        then stored in the queue, from sync characters to checksum.
+ * @param[in] gnss_cfg_data : pointer to the structure containing GNSS configuration data.
+ * @param[in] buffer : queue storage, NULL to disable the queue.
+ * @param[in] size : size of the queue storage.
+ * @return The following values are returned:
+ * - \ref SL_STATUS_OK on success.
+ * - \ref SL_STATUS_NULL_POINTER if gnss_cfg_data is NULL.
+ * - \ref SL_STATUS_INVALID_PARAMETER if size is too small to hold a frame.
+ * @note 1. User must call this function after calling begin function.
+ *       2. Each frame takes two extra bytes in the queue for its length.
+ *****************************************************************************/
+sl_status_t gnss_max_m10s_set_frame_queue(sl_max_m10s_cfg_data_t *gnss_cfg_data,
+                                          uint8_t *buffer,
+                                          uint16_t size);
+
+/**************************************************************************//**
+ * @brief Gets the oldest frame from the frame queue.
+ * @param[in] gnss_cfg_data : pointer to the structure containing GNSS configuration data.
+ * @param[out] frame : buffer to copy the frame to.
+ * @param[in] size : size of the frame buffer.
+ * @param[out] len : length of the frame.
+ * @return The following values are returned:
+ * - \ref SL_STATUS_OK on success.
+ * - \ref SL_STATUS_NULL_POINTER if a pointer is NULL.
+ * - \ref SL_STATUS_NOT_INITIALIZED if the frame queue is disabled.
+ * - \ref SL_STATUS_EMPTY if the frame queue is empty.
+ * - \ref SL_STATUS_WOULD_OVERFLOW if the frame is larger than size, the
+ *         frame stays in the queue and len holds its length.
+ * @note The queue has a single producer and a single consumer and takes no
+ *       lock, this function may run in another task than the one reading
+ *       the receiver.
+ *****************************************************************************/
+sl_status_t gnss_max_m10s_read_frame(sl_max_m10s_cfg_data_t *gnss_cfg_data,
+                                     uint8_t *frame,
+                                     uint16_t size,
+                                     uint16_t *len);
+
 /**************************************************************************//**
  * @brief Add a UBX packet to the file buffer
  * @param[in] gnss_cfg_data : pointer to the structure containing GNSS configuration data.
@@ -1001,6 +1213,33 @@ sl_status_t gnss_max_m10s_get_speed_accuracy(
 sl_status_t gnss_max_m10s_get_nav_pvt(sl_max_m10s_cfg_data_t *gnss_cfg_data,
                                       uint16_t max_wait);
 
+/**************************************************************************//**
+ * @brief Get a consistent copy of the current UBX-NAV-PVT epoch
+ * @param[in] gnss_cfg_data : pointer to the structure containing GNSS configuration data.
+ * @param[in] max_wait : Timeout value.
+ * @param[out] snapshot : pointer to store the navigation solution, identified by its iTOW,
+ *                        together with its receive time and age.
+ * @return following values
+ * - \ref SL_STATUS_OK if data is available.
+ * - \ref SL_STATUS_FAIL if data is not available.
+ * - \ref SL_STATUS_NULL_POINTER if snapshot is NULL.
+ * @note 1. The receiver is only polled when the cached epoch is older than
+ *          nav_pvt_max_age, the position getters share the same cache.
+ *       2. Can be used with UBX protocol only.
+ *****************************************************************************/
+sl_status_t gnss_max_m10s_get_nav_snapshot(
+  sl_max_m10s_cfg_data_t *gnss_cfg_data,
+  uint16_t max_wait,
+  sl_max_m10s_ubx_nav_pvt_snapshot_t *snapshot);
+
+/**************************************************************************//**
+ * @brief Set the age after which the cached UBX-NAV-PVT epoch is refreshed
+ * @param[in] gnss_cfg_data : pointer to the structure containing GNSS configuration data.
+ * @param[in] max_age : Maximum age in milliseconds, typically the measurement period.
+ *****************************************************************************/
+void gnss_max_m10s_set_nav_max_age(sl_max_m10s_cfg_data_t *gnss_cfg_data,
+                                   uint16_t max_age);
+
 /**************************************************************************//**
  * @brief Get the UBX-NAV-STATUS type data from UBX packet
  * @param[in] gnss_cfg_data : pointer to the structure containing GNSS configuration data.
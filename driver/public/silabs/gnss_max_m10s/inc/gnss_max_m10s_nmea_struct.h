@@ -42,6 +42,7 @@ extern "C" {
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "sl_nmea_parser.h"
 
 /******************************************************************************/
 
@@ -132,7 +133,6 @@ typedef struct
 /// @brief to store the data used in micro-NMEA library and data parsed from NMEA sentence
 typedef struct sl_max_m10s_nmea_data
 {
-  uint8_t buffer_len;     ///< NMEA sentence buffer length
   uint8_t month;          ///< Current month in UTC format
   uint8_t day;            ///< Current day in UTC format
   uint8_t hour;           ///< Current hour in UTC format
@@ -153,9 +153,7 @@ typedef struct sl_max_m10s_nmea_data
   int32_t altitude;       ///< Altitude from mean sea level in milli-metres
   int32_t speed;          ///< Speed over ground in knots
   int32_t course;         ///< Course over ground in degrees
-  char *buffer;           ///< Pointer to the start of the buffer
-  char *ptr;              ///< Pointer to track the current position in NMEA sentence buffer.
-  char message_id[6];     ///< message ID of the NMEA sentence
+  sl_nmea_tokenizer_t tokenizer; ///< Tokenizer of the incoming NMEA sentences
 } sl_max_m10s_nmea_data_t;
 
 #ifdef __cplusplus
@@ -52,6 +52,17 @@ extern "C" {
  ********************************   ENUMS   ************************************
  ******************************************************************************/
 
+/// @brief Entry of the UBX message dispatch table
+typedef struct sl_max_m10s_ubx_msg_entry
+{
+  uint16_t key;                                            ///< (class << 8) | ID, the table is sorted on it
+  uint16_t len;                                            ///< Payload length, the maximum one for variable length messages
+  bool variable_len;                                       ///< Payload length depends on the number of repeated blocks
+  size_t storage;                                          ///< Offset of the packet pointer in sl_max_m10s_cfg_data_t
+  void (*handler)(sl_max_m10s_cfg_data_t *gnss_cfg_data,
+                  sl_max_m10s_ubx_packet_t *msg);          ///< Decoder of the message
+} sl_max_m10s_ubx_msg_entry_t;
+
 // -----------------------------------------------------------------------------
 // Prototypes
 
@@ -63,6 +74,36 @@ extern "C" {
 void gnss_max_m10s_process_ubx_packet(sl_max_m10s_cfg_data_t *gnss_cfg_data,
                                       sl_max_m10s_ubx_packet_t *msg);
 
+/**************************************************************************//**
+ * @brief Find a UBX message in the dispatch table.
+ * @param[in] cls : class of the UBX message.
+ * @param[in] id : ID of the UBX message.
+ * @return pointer to the table entry, NULL if the driver does not decode it.
+ *****************************************************************************/
+const sl_max_m10s_ubx_msg_entry_t *gnss_max_m10s_ubx_find_msg(uint8_t cls,
+                                                              uint8_t id);
+
+/**************************************************************************//**
+ * @brief Check if storage is allocated for a message of the dispatch table.
+ * @param[in] gnss_cfg_data : pointer to the GNSS config data.
+ * @param[in] entry : table entry of the message.
+ * @return true if the message has been enabled, false otherwise.
+ *****************************************************************************/
+bool gnss_max_m10s_ubx_msg_enabled(sl_max_m10s_cfg_data_t *gnss_cfg_data,
+                                   const sl_max_m10s_ubx_msg_entry_t *entry);
+
+/**************************************************************************//**
+ * @brief Find the user callback registered for a UBX message.
+ * @param[in] gnss_cfg_data : pointer to the GNSS config data.
+ * @param[in] cls : class of the UBX message.
+ * @param[in] id : ID of the UBX message.
+ * @return the callback, NULL if none is registered.
+ *****************************************************************************/
+sl_max_m10s_ubx_callback_t gnss_max_m10s_ubx_find_callback(
+  sl_max_m10s_cfg_data_t *gnss_cfg_data,
+  uint8_t cls,
+  uint8_t id);
+
 /**************************************************************************//**
  * @brief To process all the data from the UBX_NAV_STATUS packet.
  * @param[in] gnss_cfg_data : pointer to the GNSS config data.
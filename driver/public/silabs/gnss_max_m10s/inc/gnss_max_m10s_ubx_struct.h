@@ -40,6 +40,9 @@
 extern "C" {
 #endif
 
+#include <stdint.h>
+#include <stdbool.h>
+
 /******************************************************************************/
 
 /*******************************************************************************
@@ -149,10 +152,20 @@ typedef struct sl_max_m10s_ubx_nav_pvt
 {
   sl_max_m10s_ubx_automatic_flags_t automatic_flags;                ///< To store automatic flags for the UBX packet
   sl_max_m10s_ubx_nav_pvt_data_t data;                              ///< To store the data for the UBX packet
+  uint32_t timestamp;                                               ///< gnss_max_m10s_milli_sec() when data was received
+  bool data_valid;                                                  ///< Set once data holds a received epoch
   void (*callback_pointer_ptr)(sl_max_m10s_ubx_nav_pvt_data_t *);   ///< To store the callback pointer for UBX packet
   sl_max_m10s_ubx_nav_pvt_data_t *callback_data;                    ///< To get the callback data
 } sl_max_m10s_ubx_nav_pvt_t;
 
+/// @brief To store a copy of a UBX-NAV-PVT epoch with its receive time.
+typedef struct sl_max_m10s_ubx_nav_pvt_snapshot
+{
+  sl_max_m10s_ubx_nav_pvt_data_t data;  ///< Copy of the UBX-NAV-PVT data
+  uint32_t timestamp;                   ///< gnss_max_m10s_milli_sec() when data was received
+  uint32_t age;                         ///< Age of data when the snapshot was taken: ms
+} sl_max_m10s_ubx_nav_pvt_snapshot_t;
+
 /// @brief structure to store the data for UBX-NAV-STATUS
 typedef struct sl_max_m10s_ubx_nav_status_data
 {
@@ -41,6 +41,20 @@
 #include "si91x_device.h"
 #endif
 
+/// Framing states of the frame queue
+enum {
+  FRAME_STATE_IDLE = 0,
+  FRAME_STATE_UBX_SYNC_2,
+  FRAME_STATE_UBX_HEADER,
+  FRAME_STATE_UBX_PAYLOAD,
+  FRAME_STATE_UBX_CHECKSUM_A,
+  FRAME_STATE_UBX_CHECKSUM_B,
+  FRAME_STATE_NMEA,
+  FRAME_STATE_NMEA_CHECKSUM_HI,
+  FRAME_STATE_NMEA_CHECKSUM_LO,
+  FRAME_STATE_NMEA_END
+};
+
 typedef i2c_master_t max_m10s_i2c_t;
 
 static max_m10s_i2c_t max_m10s_i2c;
@@ -268,7 +282,8 @@ static sl_max_m10s_ublox_status_e gnss_max_m10s_wait_for_no_ack_response(
   uint16_t max_time);
 
 /**************************************************************************//**
- * @brief Polls I2C for data, passing any new bytes to gnss_m10s_process()
+ * @brief Polls I2C for data, reading the backlog announced by the available
+ *        bytes registers in blocks and passing it to gnss_m10s_process()
  * @param[in] gnss_cfg_data : pointer to the structure
  *                            containing GNSS configuration data.
  * @param[in] incomingUBX : pointer to incoming UBX packet.
@@ -373,6 +388,81 @@ static sl_status_t gnss_max_m10s_send_cfg_valset(
   sl_max_m10s_cfg_data_t *gnss_cfg_data,
   uint16_t max_wait);
 
+/**************************************************************************//**
+ * @brief Make sure the cached UBX-NAV-PVT epoch is fresh, polling (or
+ *        processing the automatic messages) only once it got older than
+ *        nav_pvt_max_age.
+ * @param[in] gnss_cfg_data : pointer to the structure
+ *                            containing GNSS configuration data.
+ * @param[in] max_wait : Timeout value.
+ * @return The following values are returned:
+ * - \ref SL_STATUS_OK on success.
+ * - \ref SL_STATUS_FAIL if no navigation solution is available.
+ *****************************************************************************/
+static sl_status_t gnss_max_m10s_refresh_nav_pvt(
+  sl_max_m10s_cfg_data_t *gnss_cfg_data,
+  uint16_t max_wait);
+
+/**************************************************************************//**
+ * @brief Get the UBX packet to send according to the active packet buffer.
+ * @param[in] gnss_cfg_data : pointer to the structure
+ *                            containing GNSS configuration data.
+ * @return pointer to the UBX packet.
+ *****************************************************************************/
+static sl_max_m10s_ubx_packet_t *gnss_max_m10s_get_outgoing_packet(
+  sl_max_m10s_cfg_data_t *gnss_cfg_data);
+
+/**************************************************************************//**
+ * @brief Feed a received byte to the framer of the frame queue, stores the
+ *        complete frames and completes the asynchronous commands.
+ * @param[in] gnss_cfg_data : pointer to the structure
+ *                            containing GNSS configuration data.
+ * @param[in] incoming : received byte.
+ *****************************************************************************/
+static void gnss_max_m10s_frame_process(sl_max_m10s_cfg_data_t *gnss_cfg_data,
+                                        uint8_t incoming);
+
+/**************************************************************************//**
+ * @brief Start a new frame in the frame queue.
+ * @param[in] queue : pointer to the frame queue.
+ * @param[in] state : first framing state of the frame.
+ *****************************************************************************/
+static void gnss_max_m10s_frame_start(sl_max_m10s_frame_queue_t *queue,
+                                      uint8_t state);
+
+/**************************************************************************//**
+ * @brief Append a byte to the frame being received.
+ * @param[in] queue : pointer to the frame queue.
+ * @param[in] incoming : received byte.
+ *****************************************************************************/
+static void gnss_max_m10s_frame_put(sl_max_m10s_frame_queue_t *queue,
+                                    uint8_t incoming);
+
+/**************************************************************************//**
+ * @brief Publish the frame being received to the consumer of the queue.
+ * @param[in] queue : pointer to the frame queue.
+ *****************************************************************************/
+static void gnss_max_m10s_frame_commit(sl_max_m10s_frame_queue_t *queue);
+
+/**************************************************************************//**
+ * @brief Complete the asynchronous commands matching a received UBX frame.
+ * @param[in] gnss_cfg_data : pointer to the structure
+ *                            containing GNSS configuration data.
+ *****************************************************************************/
+static void gnss_max_m10s_ubx_frame_done(sl_max_m10s_cfg_data_t *gnss_cfg_data);
+
+/**************************************************************************//**
+ * @brief Remove an asynchronous command and call its completion callback.
+ * @param[in] gnss_cfg_data : pointer to the structure
+ *                            containing GNSS configuration data.
+ * @param[in] index : index of the command in the pending table.
+ * @param[in] status : completion status of the command.
+ *****************************************************************************/
+static void gnss_max_m10s_complete_pending_ack(
+  sl_max_m10s_cfg_data_t *gnss_cfg_data,
+  uint8_t index,
+  sl_max_m10s_ublox_status_e status);
+
 static sl_status_t gnss_max_m10s_init_packet_data(
   sl_max_m10s_cfg_data_t *gnss_cfg_data)
 {
@@ -465,6 +555,12 @@ static sl_status_t gnss_max_m10s_init(sl_max_m10s_cfg_data_t *gnss_cfg_data)
   gnss_cfg_data->file_buffer_max_avail = 0;
   gnss_cfg_data->ignore_this_payload = false;
   gnss_cfg_data->max_nmea_byte_count = SL_MAX_M10S_NMEA_BYTE_COUNT;
+  gnss_cfg_data->nav_pvt_max_age = NAV_PVT_MAX_AGE;
+  gnss_cfg_data->ubx_callback_count = 0;
+  gnss_cfg_data->pending_ack_count = 0;
+  gnss_cfg_data->tx_ready_pending = false;
+  gnss_cfg_data->tx_ready_enabled = false;
+  memset(&gnss_cfg_data->frame_queue, 0, sizeof(gnss_cfg_data->frame_queue));
   gnss_cfg_data->packetUBXNAVPVT = NULL;
   gnss_cfg_data->packetUBXNAVCLOCK = NULL;
   gnss_cfg_data->packetUBXNAVDOP = NULL;
@@ -497,6 +593,12 @@ sl_status_t gnss_max_m10s_deinit(sl_max_m10s_cfg_data_t *gnss_cfg_data)
 {
   sl_status_t status = SL_STATUS_OK;
 
+  if (gnss_cfg_data->msg_data.payload_auto != NULL) {
+    free(gnss_cfg_data->msg_data.payload_auto);
+    gnss_cfg_data->msg_data.payload_auto = NULL;
+    gnss_cfg_data->packet_auto.payload = NULL;
+  }
+
   if (gnss_cfg_data->packetUBXNAVPVT != NULL) {
     free(gnss_cfg_data->packetUBXNAVPVT);
     gnss_cfg_data->packetUBXNAVPVT = NULL;
@@ -840,15 +942,7 @@ sl_max_m10s_ublox_status_e gnss_max_m10s_send_command(
   sl_max_m10s_ubx_packet_t *outgoingUBX;
   sl_max_m10s_ublox_status_e ret_val = SL_MAX_M10S_UBLOX_STATUS_SUCCESS;
 
-  if (gnss_cfg_data->active_packet_buffer
-      == SL_MAX_M10S_UBLOX_PACKET_PACKETCFG) {
-    outgoingUBX = &(gnss_cfg_data->packet_cfg);
-  } else if (gnss_cfg_data->active_packet_buffer
-             == SL_MAX_M10S_UBLOX_PACKET_PACKETAUTO) {
-    outgoingUBX = &(gnss_cfg_data->packet_auto);
-  } else {
-    outgoingUBX = &(gnss_cfg_data->packet_buf);
-  }
+  outgoingUBX = gnss_max_m10s_get_outgoing_packet(gnss_cfg_data);
 
   gnss_max_m10s_calc_checksum(outgoingUBX);
 
@@ -877,6 +971,66 @@ sl_max_m10s_ublox_status_e gnss_max_m10s_send_command(
   return ret_val;
 }
 
+sl_status_t gnss_max_m10s_send_command_async(
+  sl_max_m10s_cfg_data_t *gnss_cfg_data,
+  uint16_t max_wait,
+  sl_max_m10s_ubx_ack_callback_t callback,
+  void *context)
+{
+  sl_max_m10s_ubx_packet_t *outgoingUBX;
+  sl_max_m10s_ubx_pending_ack_t *pending;
+
+  if (gnss_cfg_data == NULL) {
+    return SL_STATUS_NULL_POINTER;
+  }
+
+  if ((max_wait > 0)
+      && (gnss_cfg_data->pending_ack_count == UBX_ACK_PENDING_COUNT)) {
+    return SL_STATUS_FULL;
+  }
+
+  outgoingUBX = gnss_max_m10s_get_outgoing_packet(gnss_cfg_data);
+
+  gnss_max_m10s_calc_checksum(outgoingUBX);
+
+  if (gnss_max_m10s_send_i2c_command(gnss_cfg_data, outgoingUBX)
+      != SL_MAX_M10S_UBLOX_STATUS_SUCCESS) {
+    return SL_STATUS_FAIL;
+  }
+
+  if (max_wait == 0) {
+    return SL_STATUS_OK;
+  }
+
+  /// The completion is detected by gnss_max_m10s_frame_process()
+  pending = &gnss_cfg_data->pending_acks[gnss_cfg_data->pending_ack_count++];
+  pending->cls = outgoingUBX->cls;
+  pending->id = outgoingUBX->id;
+  pending->expect_ack = (outgoingUBX->cls == UBX_CLASS_CFG);
+  pending->tx_ready = false;
+  pending->tx_ready_enable = false;
+  pending->max_wait = max_wait;
+  pending->start_time = gnss_max_m10s_milli_sec();
+  pending->callback = callback;
+  pending->context = context;
+
+  return SL_STATUS_OK;
+}
+
+static sl_max_m10s_ubx_packet_t *gnss_max_m10s_get_outgoing_packet(
+  sl_max_m10s_cfg_data_t *gnss_cfg_data)
+{
+  if (gnss_cfg_data->active_packet_buffer
+      == SL_MAX_M10S_UBLOX_PACKET_PACKETCFG) {
+    return &(gnss_cfg_data->packet_cfg);
+  } else if (gnss_cfg_data->active_packet_buffer
+             == SL_MAX_M10S_UBLOX_PACKET_PACKETAUTO) {
+    return &(gnss_cfg_data->packet_auto);
+  }
+
+  return &(gnss_cfg_data->packet_buf);
+}
+
 static void gnss_max_m10s_calc_checksum(sl_max_m10s_ubx_packet_t *msg)
 {
   msg->checksum_a = 0;
@@ -1190,123 +1344,592 @@ static sl_status_t gnss_max_m10s_check_ublox_i2c(
   uint8_t requested_class,
   uint8_t requested_id)
 {
+  uint8_t reg = UBLOX_REG_BYTES_AVAILABLE;
+  uint8_t bytes_available_buf[2];
+  uint8_t rx_buf[I2C_READ_SIZE];
+  uint16_t bytes_available;
   uint16_t bytes_to_read;
-  uint8_t bytes_returned;
-  uint8_t rx_byte = 0;
-  bool bytes_valid = true;
+  uint16_t i;
 
-  bytes_to_read = 1;
+  if (NULL == gnss_cfg_data->i2c_instance) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
 
-  while (bytes_valid) {
-    bytes_returned = gnss_max_m10s_read_bytes(gnss_cfg_data, &rx_byte,
-                                              (uint8_t)bytes_to_read);
+  // The size of the backlog is held in 0xFD (MSB) and 0xFE (LSB), the
+  // register pointer then rests on the 0xFF stream register
+  if (I2C_MASTER_SUCCESS != i2c_master_write_then_read(&max_m10s_i2c,
+                                                       &reg,
+                                                       1,
+                                                       bytes_available_buf,
+                                                       2)) {
+    if (gnss_cfg_data->reset_current_sentence_on_bus_error) {
+      gnss_cfg_data->current_sentence = SL_MAX_M10S_UBLOX_SENTENCE_TYPE_NONE;
+    }
+    return SL_STATUS_FAIL;
+  }
 
-    if (bytes_returned) {
-      gnss_max_m10s_process(gnss_cfg_data, rx_byte, incomingUBX,
-                            requested_class, requested_id);
+  bytes_available = ((uint16_t)bytes_available_buf[0] << 8)
+                    | bytes_available_buf[1];
 
-      if (rx_byte == 0xFF) {
-        bytes_valid = false;
-      }
-    } else {
+  // The receiver reports an LSB of 0xFF while the count is not ready yet
+  if (bytes_available_buf[1] == 0xFF) {
+    bytes_available = 0;
+  }
+
+  while (bytes_available > 0) {
+    bytes_to_read = bytes_available;
+
+    if (bytes_to_read > I2C_READ_SIZE) {
+      bytes_to_read = I2C_READ_SIZE;
+    }
+
+    if (gnss_max_m10s_read_bytes(gnss_cfg_data, rx_buf,
+                                 (uint8_t)bytes_to_read) != bytes_to_read) {
       if (gnss_cfg_data->reset_current_sentence_on_bus_error) {
         gnss_cfg_data->current_sentence = SL_MAX_M10S_UBLOX_SENTENCE_TYPE_NONE;
-        return SL_STATUS_FAIL;
       }
+      return SL_STATUS_FAIL;
+    }
+
+    for (i = 0; i < bytes_to_read; i++) {
+      gnss_max_m10s_frame_process(gnss_cfg_data, rx_buf[i]);
+      gnss_max_m10s_process(gnss_cfg_data, rx_buf[i], incomingUBX,
+                            requested_class, requested_id);
     }
+
+    bytes_available -= bytes_to_read;
   }
 
   return SL_STATUS_OK;
 }
 
-bool gnss_max_m10s_auto_lookup(sl_max_m10s_cfg_data_t *gnss_cfg_data,
-                               uint16_t *max_size)
+static void gnss_max_m10s_frame_process(sl_max_m10s_cfg_data_t *gnss_cfg_data,
+                                        uint8_t incoming)
 {
-  uint8_t ID;
+  sl_max_m10s_frame_queue_t *queue = &gnss_cfg_data->frame_queue;
+  uint16_t offset;
+  uint8_t digit;
 
-  if (gnss_cfg_data->active_packet_buffer
-      == SL_MAX_M10S_UBLOX_PACKET_PACKETCFG) {
-    ID = gnss_cfg_data->packet_cfg.id;
-  } else if (gnss_cfg_data->active_packet_buffer
-             == SL_MAX_M10S_UBLOX_PACKET_PACKETAUTO) {
-    ID = gnss_cfg_data->packet_auto.id;
-  } else {
-    ID = gnss_cfg_data->packet_buf.id;
+  switch (queue->state) {
+    case FRAME_STATE_IDLE:
+      if (incoming == UBX_SYNCH_1) {
+        gnss_max_m10s_frame_start(queue, FRAME_STATE_UBX_SYNC_2);
+      } else if (incoming == '$') {
+        gnss_max_m10s_frame_start(queue, FRAME_STATE_NMEA);
+      } else {
+        return;
+      }
+      break;
+
+    case FRAME_STATE_UBX_SYNC_2:
+      if (incoming != UBX_SYNCH_2) {
+        queue->state = FRAME_STATE_IDLE;
+        return;
+      }
+      queue->state = FRAME_STATE_UBX_HEADER;
+      break;
+
+    case FRAME_STATE_UBX_HEADER:
+      queue->checksum_a += incoming;
+      queue->checksum_b += queue->checksum_a;
+
+      if (queue->frame_len == 2) {
+        queue->cls = incoming;
+      } else if (queue->frame_len == 3) {
+        queue->id = incoming;
+      } else if (queue->frame_len == 4) {
+        queue->payload_len = incoming;
+      } else {
+        queue->payload_len |= (uint16_t)incoming << 8;
+        if (queue->payload_len > UBX_MAX_LENGTH) {
+          queue->state = FRAME_STATE_IDLE;
+          return;
+        }
+        queue->state = (queue->payload_len > 0)
+                       ? FRAME_STATE_UBX_PAYLOAD : FRAME_STATE_UBX_CHECKSUM_A;
+      }
+      break;
+
+    case FRAME_STATE_UBX_PAYLOAD:
+      queue->checksum_a += incoming;
+      queue->checksum_b += queue->checksum_a;
+
+      offset = queue->frame_len - 6;
+      if (offset < sizeof(queue->ack_payload)) {
+        queue->ack_payload[offset] = incoming;
+      }
+      if ((offset + 1) == queue->payload_len) {
+        queue->state = FRAME_STATE_UBX_CHECKSUM_A;
+      }
+      break;
+
+    case FRAME_STATE_UBX_CHECKSUM_A:
+      if (incoming != queue->checksum_a) {
+        queue->state = FRAME_STATE_IDLE;
+        return;
+      }
+      queue->state = FRAME_STATE_UBX_CHECKSUM_B;
+      break;
+
+    case FRAME_STATE_UBX_CHECKSUM_B:
+      queue->state = FRAME_STATE_IDLE;
+      if (incoming != queue->checksum_b) {
+        return;
+      }
+      gnss_max_m10s_frame_put(queue, incoming);
+      gnss_max_m10s_frame_commit(queue);
+      gnss_max_m10s_ubx_frame_done(gnss_cfg_data);
+      return;
+
+    case FRAME_STATE_NMEA:
+      if ((incoming == '$') || (incoming == '\r') || (incoming == '\n')
+          || (queue->frame_len >= NMEA_MAX_BYTE_COUNT)) {
+        /// Truncated sentence, resynchronize on the next start character
+        queue->state = FRAME_STATE_IDLE;
+        if (incoming != '$') {
+          return;
+        }
+        gnss_max_m10s_frame_start(queue, FRAME_STATE_NMEA);
+      } else if (incoming == '*') {
+        queue->state = FRAME_STATE_NMEA_CHECKSUM_HI;
+      } else {
+        queue->checksum_a ^= incoming;
+      }
+      break;
+
+    case FRAME_STATE_NMEA_CHECKSUM_HI:
+    case FRAME_STATE_NMEA_CHECKSUM_LO:
+      if ((incoming >= '0') && (incoming <= '9')) {
+        digit = incoming - '0';
+      } else if ((incoming >= 'A') && (incoming <= 'F')) {
+        digit = incoming - 'A' + 10;
+      } else {
+        queue->state = FRAME_STATE_IDLE;
+        return;
+      }
+
+      if (queue->state == FRAME_STATE_NMEA_CHECKSUM_HI) {
+        queue->checksum_b = (uint8_t)(digit << 4);
+        queue->state = FRAME_STATE_NMEA_CHECKSUM_LO;
+      } else if ((queue->checksum_b | digit) == queue->checksum_a) {
+        queue->state = FRAME_STATE_NMEA_END;
+      } else {
+        queue->state = FRAME_STATE_IDLE;
+        return;
+      }
+      break;
+
+    case FRAME_STATE_NMEA_END:
+      if (incoming == '\n') {
+        queue->state = FRAME_STATE_IDLE;
+        gnss_max_m10s_frame_put(queue, incoming);
+        gnss_max_m10s_frame_commit(queue);
+        return;
+      }
+      if (incoming != '\r') {
+        queue->state = FRAME_STATE_IDLE;
+        return;
+      }
+      break;
+
+    default:
+      queue->state = FRAME_STATE_IDLE;
+      return;
   }
 
-  if (max_size != NULL) {
-    *max_size = 0;
+  gnss_max_m10s_frame_put(queue, incoming);
+}
+
+static void gnss_max_m10s_frame_start(sl_max_m10s_frame_queue_t *queue,
+                                      uint8_t state)
+{
+  uint16_t used;
+
+  queue->state = state;
+  queue->frame_len = 0;
+  queue->checksum_a = 0;
+  queue->checksum_b = 0;
+  queue->overflow = (queue->buffer == NULL);
+
+  if (queue->overflow) {
+    return;
   }
 
-  if (ID == UBX_NAV_PVT) {
-    if (max_size != NULL) {
-      *max_size = UBX_NAV_PVT_LEN;
-    }
+  /// The length of the frame, one data byte and the free byte must fit
+  used = (uint16_t)(((uint32_t)queue->head + queue->size - queue->tail)
+                    % queue->size);
+  if ((queue->size - used) < 4) {
+    queue->overflow = true;
+    return;
+  }
 
-    return (gnss_cfg_data->packetUBXNAVPVT != NULL);
-  } else if (ID == UBX_NAV_CLOCK) {
-    if (max_size != NULL) {
-      *max_size = UBX_NAV_CLOCK_LEN;
-    }
+  /// Leave room for the length of the frame, written on commit
+  queue->write = (uint16_t)((queue->head + 2) % queue->size);
+}
 
-    return (gnss_cfg_data->packetUBXNAVCLOCK != NULL);
-  } else if (ID == UBX_NAV_DOP) {
-    if (max_size != NULL) {
-      *max_size = UBX_NAV_DOP_LEN;
-    }
+static void gnss_max_m10s_frame_put(sl_max_m10s_frame_queue_t *queue,
+                                    uint8_t incoming)
+{
+  uint16_t used;
 
-    return (gnss_cfg_data->packetUBXNAVDOP != NULL);
-  } else if (ID == UBX_NAV_EOE) {
-    if (max_size != NULL) {
-      *max_size = UBX_NAV_EOE_LEN;
-    }
+  queue->frame_len++;
+
+  if (queue->overflow) {
+    return;
+  }
+
+  /// One byte is kept free to tell a full queue from an empty one
+  used = (uint16_t)(((uint32_t)queue->write + queue->size - queue->tail)
+                    % queue->size);
+  if (used >= (queue->size - 1)) {
+    queue->overflow = true;
+    return;
+  }
 
-    return (gnss_cfg_data->packetUBXNAVEOE != NULL);
-  } else if (ID == UBX_NAV_POSLLH) {
-    if (max_size != NULL) {
-      *max_size = UBX_NAV_POSLLH_LEN;
+  queue->buffer[queue->write] = incoming;
+  queue->write = (uint16_t)((queue->write + 1) % queue->size);
+}
+
+static void gnss_max_m10s_frame_commit(sl_max_m10s_frame_queue_t *queue)
+{
+  uint16_t head = queue->head;
+
+  if (queue->overflow) {
+    if (queue->buffer != NULL) {
+      queue->dropped++;
     }
+    return;
+  }
 
-    return (gnss_cfg_data->packetUBXNAVPOSLLH != NULL);
-  } else if (ID == UBX_NAV_SAT) {
-    if (max_size != NULL) {
-      *max_size = UBX_NAV_SAT_LEN;
+  queue->buffer[head] = queue->frame_len & 0xFF;
+  queue->buffer[(head + 1) % queue->size] = queue->frame_len >> 8;
+
+  /// The frame is complete in the buffer before the consumer can see it
+  queue->head = queue->write;
+}
+
+static void gnss_max_m10s_ubx_frame_done(sl_max_m10s_cfg_data_t *gnss_cfg_data)
+{
+  sl_max_m10s_frame_queue_t *queue = &gnss_cfg_data->frame_queue;
+  sl_max_m10s_ubx_pending_ack_t *pending;
+  bool is_ack = (queue->cls == UBX_CLASS_ACK) && (queue->payload_len == 2);
+
+  for (uint8_t i = 0; i < gnss_cfg_data->pending_ack_count; i++) {
+    pending = &gnss_cfg_data->pending_acks[i];
+
+    if (is_ack && pending->expect_ack
+        && (pending->cls == queue->ack_payload[0])
+        && (pending->id == queue->ack_payload[1])) {
+      gnss_max_m10s_complete_pending_ack(gnss_cfg_data, i,
+                                         (queue->id == UBX_ACK_ACK)
+                                         ? SL_MAX_M10S_UBLOX_STATUS_DATA_SENT
+                                         : SL_MAX_M10S_UBLOX_STATUS_COMMAND_NACK);
+      return;
     }
 
-    return (gnss_cfg_data->packetUBXNAVSAT != NULL);
-  } else if (ID == UBX_NAV_SIG) {
-    if (max_size != NULL) {
-      *max_size = UBX_NAV_SIG_MAX_LEN;
+    if (!is_ack && !pending->expect_ack
+        && (pending->cls == queue->cls) && (pending->id == queue->id)) {
+      gnss_max_m10s_complete_pending_ack(gnss_cfg_data, i,
+                                         SL_MAX_M10S_UBLOX_STATUS_DATA_RECEIVED);
+      return;
     }
+  }
+}
+
+static void gnss_max_m10s_complete_pending_ack(
+  sl_max_m10s_cfg_data_t *gnss_cfg_data,
+  uint8_t index,
+  sl_max_m10s_ublox_status_e status)
+{
+  sl_max_m10s_ubx_pending_ack_t pending = gnss_cfg_data->pending_acks[index];
+
+  /// Keep the table packed, the order of the pending commands does not matter
+  gnss_cfg_data->pending_ack_count--;
+  gnss_cfg_data->pending_acks[index] =
+    gnss_cfg_data->pending_acks[gnss_cfg_data->pending_ack_count];
+
+  if (pending.tx_ready && (status == SL_MAX_M10S_UBLOX_STATUS_DATA_SENT)) {
+    gnss_cfg_data->tx_ready_enabled = pending.tx_ready_enable;
+    /// Data may already be waiting, the pin will not see a new edge for it
+    gnss_cfg_data->tx_ready_pending = true;
+  }
+
+  if (pending.callback != NULL) {
+    pending.callback(pending.cls, pending.id, status, pending.context);
+  }
+}
+
+sl_status_t gnss_max_m10s_process_action(sl_max_m10s_cfg_data_t *gnss_cfg_data)
+{
+  sl_status_t status = SL_STATUS_OK;
+  uint32_t now;
+  uint8_t i;
+
+  if (gnss_cfg_data == NULL) {
+    return SL_STATUS_NULL_POINTER;
+  }
 
-    return (gnss_cfg_data->packetUBXNAVSIG != NULL);
-  } else if (ID == UBX_NAV_STATUS) {
-    if (max_size != NULL) {
-      *max_size = UBX_NAV_STATUS_LEN;
+  if (!gnss_cfg_data->tx_ready_enabled || gnss_cfg_data->tx_ready_pending) {
+    /// Cleared first so that an edge during the read is not lost
+    gnss_cfg_data->tx_ready_pending = false;
+
+    status = gnss_max_m10s_check_ublox_internal(gnss_cfg_data,
+                                                &(gnss_cfg_data->packet_cfg),
+                                                0,
+                                                0);
+    if (status != SL_STATUS_OK) {
+      /// The pin stays asserted without a new edge, retry on the next call
+      gnss_cfg_data->tx_ready_pending = true;
     }
+  }
 
-    return (gnss_cfg_data->packetUBXNAVSTATUS != NULL);
-  } else if (ID == UBX_NAV_TIMELS) {
-    if (max_size != NULL) {
-      *max_size = UBX_NAV_TIMELS_LEN;
+  now = gnss_max_m10s_milli_sec();
+  i = gnss_cfg_data->pending_ack_count;
+  while (i-- > 0) {
+    if ((now - gnss_cfg_data->pending_acks[i].start_time)
+        >= gnss_cfg_data->pending_acks[i].max_wait) {
+      gnss_max_m10s_complete_pending_ack(gnss_cfg_data, i,
+                                         SL_MAX_M10S_UBLOX_STATUS_TIMEOUT);
     }
+  }
+
+  return status;
+}
+
+void gnss_max_m10s_tx_ready_irq_handler(sl_max_m10s_cfg_data_t *gnss_cfg_data)
+{
+  gnss_cfg_data->tx_ready_pending = true;
+}
+
+sl_status_t gnss_max_m10s_set_tx_ready(sl_max_m10s_cfg_data_t *gnss_cfg_data,
+                                       bool enable,
+                                       uint8_t pio,
+                                       uint16_t threshold,
+                                       sl_max_m10s_ubx_ack_callback_t callback,
+                                       void *context)
+{
+  sl_max_m10s_ubx_pending_ack_t *pending;
+  sl_status_t status;
+  uint8_t value;
+  uint8_t threshold_value[2];
+
+  if (gnss_cfg_data == NULL) {
+    return SL_STATUS_NULL_POINTER;
+  }
+
+  if (gnss_cfg_data->pending_ack_count == UBX_ACK_PENDING_COUNT) {
+    return SL_STATUS_FULL;
+  }
+
+  /// The threshold is set in units of 8 bytes
+  threshold_value[0] = (threshold / 8) & 0xFF;
+  threshold_value[1] = (threshold / 8) >> 8;
+
+  status = gnss_max_m10s_new_cfg_valset(gnss_cfg_data, VAL_LAYER_RAM);
+
+  value = enable ? 1 : 0;
+  if (status == SL_STATUS_OK) {
+    status = gnss_max_m10s_add_cfg_valset(gnss_cfg_data,
+                                          UBLOX_CFG_TXREADY_ENABLED,
+                                          &value, 1);
+  }
+
+  /// Active high, the host interrupts on the rising edge
+  value = 0;
+  if (status == SL_STATUS_OK) {
+    status = gnss_max_m10s_add_cfg_valset(gnss_cfg_data,
+                                          UBLOX_CFG_TXREADY_POLARITY,
+                                          &value, 1);
+  }
+
+  if (status == SL_STATUS_OK) {
+    status = gnss_max_m10s_add_cfg_valset(gnss_cfg_data,
+                                          UBLOX_CFG_TXREADY_PIN,
+                                          &pio, 1);
+  }
+
+  if (status == SL_STATUS_OK) {
+    status = gnss_max_m10s_add_cfg_valset(gnss_cfg_data,
+                                          UBLOX_CFG_TXREADY_THRESHOLD,
+                                          threshold_value, 2);
+  }
+
+  /// The pin reports the data waiting on the I2C interface
+  value = 0;
+  if (status == SL_STATUS_OK) {
+    status = gnss_max_m10s_add_cfg_valset(gnss_cfg_data,
+                                          UBLOX_CFG_TXREADY_INTERFACE,
+                                          &value, 1);
+  }
+
+  if (status != SL_STATUS_OK) {
+    return SL_STATUS_FAIL;
+  }
+
+  /// Poll on every call until the receiver acknowledged the new setting
+  gnss_cfg_data->tx_ready_enabled = false;
+
+  gnss_cfg_data->active_packet_buffer = SL_MAX_M10S_UBLOX_PACKET_PACKETCFG;
+  status = gnss_max_m10s_send_command_async(gnss_cfg_data,
+                                            GNSS_POLL_MAX_TIMEOUT,
+                                            callback,
+                                            context);
+  gnss_cfg_data->num_cfg_keys = 0;
+
+  if (status == SL_STATUS_OK) {
+    pending = &gnss_cfg_data->pending_acks[gnss_cfg_data->pending_ack_count - 1];
+    pending->tx_ready = true;
+    pending->tx_ready_enable = enable;
+  }
+
+  return status;
+}
+
+sl_status_t gnss_max_m10s_set_frame_queue(sl_max_m10s_cfg_data_t *gnss_cfg_data,
+                                          uint8_t *buffer,
+                                          uint16_t size)
+{
+  sl_max_m10s_frame_queue_t *queue;
+
+  if (gnss_cfg_data == NULL) {
+    return SL_STATUS_NULL_POINTER;
+  }
+
+  /// Room for a length, a frame byte and the free byte
+  if ((buffer != NULL) && (size < 4)) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  queue = &gnss_cfg_data->frame_queue;
+  queue->buffer = buffer;
+  queue->size = size;
+  queue->head = 0;
+  queue->tail = 0;
+  queue->dropped = 0;
+  queue->state = FRAME_STATE_IDLE;
+
+  return SL_STATUS_OK;
+}
+
+sl_status_t gnss_max_m10s_read_frame(sl_max_m10s_cfg_data_t *gnss_cfg_data,
+                                     uint8_t *frame,
+                                     uint16_t size,
+                                     uint16_t *len)
+{
+  sl_max_m10s_frame_queue_t *queue;
+  uint16_t tail;
+  uint16_t frame_len;
+  uint16_t bytes_before_wrapped_around;
+
+  if ((gnss_cfg_data == NULL) || (frame == NULL) || (len == NULL)) {
+    return SL_STATUS_NULL_POINTER;
+  }
+
+  queue = &gnss_cfg_data->frame_queue;
+  if (queue->buffer == NULL) {
+    return SL_STATUS_NOT_INITIALIZED;
+  }
+
+  tail = queue->tail;
+  if (tail == queue->head) {
+    return SL_STATUS_EMPTY;
+  }
+
+  frame_len = queue->buffer[tail]
+              | ((uint16_t)queue->buffer[(tail + 1) % queue->size] << 8);
+  *len = frame_len;
+
+  if (frame_len > size) {
+    return SL_STATUS_WOULD_OVERFLOW;
+  }
+
+  tail = (uint16_t)((tail + 2) % queue->size);
+  bytes_before_wrapped_around = queue->size - tail;
+
+  if (bytes_before_wrapped_around > frame_len) {
+    bytes_before_wrapped_around = frame_len;
+  }
+
+  memcpy(frame, &queue->buffer[tail], bytes_before_wrapped_around);
+  memcpy(&frame[bytes_before_wrapped_around],
+         queue->buffer,
+         frame_len - bytes_before_wrapped_around);
 
-    return (gnss_cfg_data->packetUBXNAVTIMELS != NULL);
-  } else if (ID == UBX_NAV_TIMEUTC) {
-    if (max_size != NULL) {
-      *max_size = UBX_NAV_TIMEUTC_LEN;
+  /// The frame is copied out before the producer can reuse its space
+  queue->tail = (uint16_t)(((uint32_t)tail + frame_len) % queue->size);
+
+  return SL_STATUS_OK;
+}
+
+bool gnss_max_m10s_auto_lookup(sl_max_m10s_cfg_data_t *gnss_cfg_data,
+                               uint16_t *max_size)
+{
+  sl_max_m10s_ubx_packet_t *packet;
+  const sl_max_m10s_ubx_msg_entry_t *entry;
+
+  if (gnss_cfg_data->active_packet_buffer
+      == SL_MAX_M10S_UBLOX_PACKET_PACKETCFG) {
+    packet = &gnss_cfg_data->packet_cfg;
+  } else if (gnss_cfg_data->active_packet_buffer
+             == SL_MAX_M10S_UBLOX_PACKET_PACKETAUTO) {
+    packet = &gnss_cfg_data->packet_auto;
+  } else {
+    packet = &gnss_cfg_data->packet_buf;
+  }
+
+  entry = gnss_max_m10s_ubx_find_msg(packet->cls, packet->id);
+
+  if (max_size != NULL) {
+    *max_size = (entry != NULL) ? entry->len : UBX_MAX_LENGTH;
+  }
+
+  if ((entry != NULL) && gnss_max_m10s_ubx_msg_enabled(gnss_cfg_data, entry)) {
+    return true;
+  }
+
+  /// Messages with a user callback are stored as well, so it gets the payload
+  return (gnss_cfg_data->ubx_callback_count > 0)
+         && (gnss_max_m10s_ubx_find_callback(gnss_cfg_data, packet->cls,
+                                             packet->id) != NULL);
+}
+
+sl_status_t gnss_max_m10s_set_ubx_callback(
+  sl_max_m10s_cfg_data_t *gnss_cfg_data,
+  uint8_t cls,
+  uint8_t id,
+  sl_max_m10s_ubx_callback_t callback)
+{
+  uint8_t i;
+
+  for (i = 0; i < gnss_cfg_data->ubx_callback_count; i++) {
+    if ((gnss_cfg_data->ubx_callbacks[i].cls == cls)
+        && (gnss_cfg_data->ubx_callbacks[i].id == id)) {
+      break;
     }
+  }
 
-    return (gnss_cfg_data->packetUBXNAVTIMEUTC != NULL);
-  } else if (ID == UBX_NAV_VELNED) {
-    if (max_size != NULL) {
-      *max_size = UBX_NAV_VELNED_LEN;
+  if (callback == NULL) {
+    if (i < gnss_cfg_data->ubx_callback_count) {
+      gnss_cfg_data->ubx_callback_count--;
+      gnss_cfg_data->ubx_callbacks[i] =
+        gnss_cfg_data->ubx_callbacks[gnss_cfg_data->ubx_callback_count];
     }
+    return SL_STATUS_OK;
+  }
+
+  if (i == UBX_CALLBACK_COUNT) {
+    return SL_STATUS_FULL;
+  }
 
-    return (gnss_cfg_data->packetUBXNAVVELNED != NULL);
+  gnss_cfg_data->ubx_callbacks[i].cls = cls;
+  gnss_cfg_data->ubx_callbacks[i].id = id;
+  gnss_cfg_data->ubx_callbacks[i].callback = callback;
+
+  if (i == gnss_cfg_data->ubx_callback_count) {
+    gnss_cfg_data->ubx_callback_count++;
   }
 
-  return false;
+  return SL_STATUS_OK;
 }
 
 static void gnss_max_m10s_process(sl_max_m10s_cfg_data_t *gnss_cfg_data,
@@ -1389,6 +2012,9 @@ static void gnss_max_m10s_process(sl_max_m10s_cfg_data_t *gnss_cfg_data,
 
           gnss_cfg_data->packet_auto.payload = (uint8_t *)malloc(
             maxPayload * sizeof(uint8_t));
+          // Owned by msg_data so it is released once the frame is handled
+          gnss_cfg_data->msg_data.payload_auto =
+            gnss_cfg_data->packet_auto.payload;
 
           if (gnss_cfg_data->packet_auto.payload == NULL) {
             gnss_cfg_data->active_packet_buffer =
@@ -1833,6 +2459,69 @@ sl_status_t gnss_max_m10s_get_nav_pvt(sl_max_m10s_cfg_data_t *gnss_cfg_data,
   }
 }
 
+static sl_status_t gnss_max_m10s_refresh_nav_pvt(
+  sl_max_m10s_cfg_data_t *gnss_cfg_data,
+  uint16_t max_wait)
+{
+  sl_max_m10s_ubx_nav_pvt_t *pvt = gnss_cfg_data->packetUBXNAVPVT;
+  sl_status_t status;
+
+  /// All getters of an epoch are served from the same solution, the receiver
+  /// is only asked again once the cached one got stale.
+  if ((pvt != NULL) && pvt->data_valid
+      && ((uint32_t)(gnss_max_m10s_milli_sec() - pvt->timestamp)
+          < gnss_cfg_data->nav_pvt_max_age)) {
+    return SL_STATUS_OK;
+  }
+
+  status = gnss_max_m10s_get_navpvt_ubx(gnss_cfg_data, max_wait);
+
+  if (status != SL_STATUS_OK) {
+    return status;
+  }
+
+  pvt = gnss_cfg_data->packetUBXNAVPVT;
+
+  if ((pvt == NULL) || !pvt->data_valid) {
+    return SL_STATUS_FAIL;
+  }
+
+  return SL_STATUS_OK;
+}
+
+sl_status_t gnss_max_m10s_get_nav_snapshot(
+  sl_max_m10s_cfg_data_t *gnss_cfg_data,
+  uint16_t max_wait,
+  sl_max_m10s_ubx_nav_pvt_snapshot_t *snapshot)
+{
+  sl_status_t status;
+
+  if (snapshot == NULL) {
+    return SL_STATUS_NULL_POINTER;
+  }
+
+  if (gnss_cfg_data->protocol_type == SL_MAX_M10S_PROTOCOL_NMEA) {
+    return SL_STATUS_NOT_AVAILABLE;
+  }
+
+  status = gnss_max_m10s_refresh_nav_pvt(gnss_cfg_data, max_wait);
+
+  if (status == SL_STATUS_OK) {
+    memcpy(&snapshot->data, &gnss_cfg_data->packetUBXNAVPVT->data,
+           sizeof(sl_max_m10s_ubx_nav_pvt_data_t));
+    snapshot->timestamp = gnss_cfg_data->packetUBXNAVPVT->timestamp;
+    snapshot->age = gnss_max_m10s_milli_sec() - snapshot->timestamp;
+  }
+
+  return status;
+}
+
+void gnss_max_m10s_set_nav_max_age(sl_max_m10s_cfg_data_t *gnss_cfg_data,
+                                   uint16_t max_age)
+{
+  gnss_cfg_data->nav_pvt_max_age = max_age;
+}
+
 sl_status_t gnss_max_m10s_get_navstatus(sl_max_m10s_cfg_data_t *gnss_cfg_data,
                                         uint16_t max_wait)
 {
@@ -1953,9 +2642,11 @@ sl_status_t gnss_max_m10s_get_fix_type(sl_max_m10s_cfg_data_t *gnss_cfg_data,
   sl_status_t status = SL_STATUS_OK;
 
   if (gnss_cfg_data->protocol_type != SL_MAX_M10S_PROTOCOL_NMEA) {
-    status = gnss_max_m10s_get_navpvt_ubx(gnss_cfg_data, max_wait);
+    status = gnss_max_m10s_refresh_nav_pvt(gnss_cfg_data, max_wait);
 
-    *fix_type = gnss_cfg_data->packetUBXNAVPVT->data.fixType;
+    if (status == SL_STATUS_OK) {
+      *fix_type = gnss_cfg_data->packetUBXNAVPVT->data.fixType;
+    }
   } else {
     status = gnss_max_m10s_get_quality_nmea(gnss_cfg_data, fix_type, max_wait);
   }
@@ -1971,9 +2662,11 @@ sl_status_t gnss_max_m10s_get_satellite_number(
   sl_status_t status;
 
   if (gnss_cfg_data->protocol_type != SL_MAX_M10S_PROTOCOL_NMEA) {
-    status = gnss_max_m10s_get_navpvt_ubx(gnss_cfg_data, max_wait);
+    status = gnss_max_m10s_refresh_nav_pvt(gnss_cfg_data, max_wait);
 
-    *satellite = gnss_cfg_data->packetUBXNAVPVT->data.numSV;
+    if (status == SL_STATUS_OK) {
+      *satellite = gnss_cfg_data->packetUBXNAVPVT->data.numSV;
+    }
   } else {
     status =
       gnss_max_m10s_get_satellite_nmea(gnss_cfg_data, satellite, max_wait);
@@ -1988,9 +2681,11 @@ sl_status_t gnss_max_m10s_get_longitude(sl_max_m10s_cfg_data_t *gnss_cfg_data,
   sl_status_t status;
 
   if (gnss_cfg_data->protocol_type != SL_MAX_M10S_PROTOCOL_NMEA) {
-    status = gnss_max_m10s_get_navpvt_ubx(gnss_cfg_data, max_wait);
+    status = gnss_max_m10s_refresh_nav_pvt(gnss_cfg_data, max_wait);
 
-    *longitude = gnss_cfg_data->packetUBXNAVPVT->data.lon;
+    if (status == SL_STATUS_OK) {
+      *longitude = gnss_cfg_data->packetUBXNAVPVT->data.lon;
+    }
   } else {
     status =
       gnss_max_m10s_get_longitude_nmea(gnss_cfg_data, longitude, max_wait);
@@ -2005,9 +2700,11 @@ sl_status_t gnss_max_m10s_get_latitude(sl_max_m10s_cfg_data_t *gnss_cfg_data,
   sl_status_t status;
 
   if (gnss_cfg_data->protocol_type != SL_MAX_M10S_PROTOCOL_NMEA) {
-    status = gnss_max_m10s_get_navpvt_ubx(gnss_cfg_data, max_wait);
+    status = gnss_max_m10s_refresh_nav_pvt(gnss_cfg_data, max_wait);
 
-    *latitude = gnss_cfg_data->packetUBXNAVPVT->data.lat;
+    if (status == SL_STATUS_OK) {
+      *latitude = gnss_cfg_data->packetUBXNAVPVT->data.lat;
+    }
   } else {
     status = gnss_max_m10s_get_latitude_nmea(gnss_cfg_data, latitude, max_wait);
   }
@@ -2023,9 +2720,11 @@ sl_status_t gnss_max_m10s_get_altitude_msl(
   sl_status_t status;
 
   if (gnss_cfg_data->protocol_type != SL_MAX_M10S_PROTOCOL_NMEA) {
-    status = gnss_max_m10s_get_navpvt_ubx(gnss_cfg_data, max_wait);
+    status = gnss_max_m10s_refresh_nav_pvt(gnss_cfg_data, max_wait);
 
-    *altitude_msl = gnss_cfg_data->packetUBXNAVPVT->data.hMSL;
+    if (status == SL_STATUS_OK) {
+      *altitude_msl = gnss_cfg_data->packetUBXNAVPVT->data.hMSL;
+    }
   } else {
     status = gnss_max_m10s_get_altitude_msl_nmea(gnss_cfg_data,
                                                  altitude_msl,
@@ -2041,9 +2740,11 @@ sl_status_t gnss_max_m10s_get_altitude(sl_max_m10s_cfg_data_t *gnss_cfg_data,
   sl_status_t status;
 
   if (gnss_cfg_data->protocol_type != SL_MAX_M10S_PROTOCOL_NMEA) {
-    status = gnss_max_m10s_get_navpvt_ubx(gnss_cfg_data, max_wait);
+    status = gnss_max_m10s_refresh_nav_pvt(gnss_cfg_data, max_wait);
 
-    *altitude = gnss_cfg_data->packetUBXNAVPVT->data.height;
+    if (status == SL_STATUS_OK) {
+      *altitude = gnss_cfg_data->packetUBXNAVPVT->data.height;
+    }
   } else {
     status = SL_STATUS_NOT_AVAILABLE;
   }
@@ -2058,10 +2759,12 @@ sl_status_t gnss_max_m10s_get_carrier_solution(
   sl_status_t status;
 
   if (gnss_cfg_data->protocol_type != SL_MAX_M10S_PROTOCOL_NMEA) {
-    status = gnss_max_m10s_get_navpvt_ubx(gnss_cfg_data, max_wait);
+    status = gnss_max_m10s_refresh_nav_pvt(gnss_cfg_data, max_wait);
 
-    *carrier_solution =
-      gnss_cfg_data->packetUBXNAVPVT->data.solution_flags.bits.carrSoln;
+    if (status == SL_STATUS_OK) {
+      *carrier_solution =
+        gnss_cfg_data->packetUBXNAVPVT->data.solution_flags.bits.carrSoln;
+    }
   } else {
     status = SL_STATUS_NOT_AVAILABLE;
   }
@@ -2076,10 +2779,12 @@ sl_status_t gnss_max_m10s_get_differential_solution(
   sl_status_t status;
 
   if (gnss_cfg_data->protocol_type != SL_MAX_M10S_PROTOCOL_NMEA) {
-    status = gnss_max_m10s_get_navpvt_ubx(gnss_cfg_data, max_wait);
+    status = gnss_max_m10s_refresh_nav_pvt(gnss_cfg_data, max_wait);
 
-    *differential_solution =
-      (bool)gnss_cfg_data->packetUBXNAVPVT->data.solution_flags.bits.diffSoln;
+    if (status == SL_STATUS_OK) {
+      *differential_solution =
+        (bool)gnss_cfg_data->packetUBXNAVPVT->data.solution_flags.bits.diffSoln;
+    }
   } else {
     status = SL_STATUS_NOT_AVAILABLE;
   }
@@ -2094,11 +2799,13 @@ sl_status_t gnss_max_m10s_get_head_vehicle_valid(
   sl_status_t status;
 
   if (gnss_cfg_data->protocol_type != SL_MAX_M10S_PROTOCOL_NMEA) {
-    status = gnss_max_m10s_get_navpvt_ubx(gnss_cfg_data, max_wait);
+    status = gnss_max_m10s_refresh_nav_pvt(gnss_cfg_data, max_wait);
 
-    *head_vehicle_valid =
-      (bool)gnss_cfg_data->packetUBXNAVPVT->data.solution_flags.bits.
-      headVehValid;
+    if (status == SL_STATUS_OK) {
+      *head_vehicle_valid =
+        (bool)gnss_cfg_data->packetUBXNAVPVT->data.solution_flags.bits.
+        headVehValid;
+    }
   } else {
     status = SL_STATUS_NOT_AVAILABLE;
   }
@@ -2112,10 +2819,13 @@ sl_status_t gnss_max_m10s_get_gnss_fix_ok(sl_max_m10s_cfg_data_t *gnss_cfg_data,
   sl_status_t status;
 
   if (gnss_cfg_data->protocol_type != SL_MAX_M10S_PROTOCOL_NMEA) {
-    status = gnss_max_m10s_get_navpvt_ubx(gnss_cfg_data, max_wait);
+    status = gnss_max_m10s_refresh_nav_pvt(gnss_cfg_data, max_wait);
 
-    *gnss_fix_ok =
-      (bool)gnss_cfg_data->packetUBXNAVPVT->data.solution_flags.bits.gnssFixOK;
+    if (status == SL_STATUS_OK) {
+      *gnss_fix_ok =
+        (bool)gnss_cfg_data->packetUBXNAVPVT->data.solution_flags.bits.
+        gnssFixOK;
+    }
   } else {
     status = SL_STATUS_NOT_AVAILABLE;
   }
@@ -2130,11 +2840,13 @@ sl_status_t gnss_max_m10s_get_confirm_time(
   sl_status_t status;
 
   if (gnss_cfg_data->protocol_type != SL_MAX_M10S_PROTOCOL_NMEA) {
-    status = gnss_max_m10s_get_navpvt_ubx(gnss_cfg_data, max_wait);
+    status = gnss_max_m10s_refresh_nav_pvt(gnss_cfg_data, max_wait);
 
-    *confirm_time =
-      (bool)gnss_cfg_data->packetUBXNAVPVT->data.confirm_flags.confirm_data.
-      confirmed_time;
+    if (status == SL_STATUS_OK) {
+      *confirm_time =
+        (bool)gnss_cfg_data->packetUBXNAVPVT->data.confirm_flags.confirm_data.
+        confirmed_time;
+    }
   } else {
     status = SL_STATUS_NOT_AVAILABLE;
   }
@@ -2149,11 +2861,13 @@ sl_status_t gnss_max_m10s_get_confirm_date(
   sl_status_t status;
 
   if (gnss_cfg_data->protocol_type != SL_MAX_M10S_PROTOCOL_NMEA) {
-    status = gnss_max_m10s_get_navpvt_ubx(gnss_cfg_data, max_wait);
+    status = gnss_max_m10s_refresh_nav_pvt(gnss_cfg_data, max_wait);
 
-    *confirm_date =
-      (bool)gnss_cfg_data->packetUBXNAVPVT->data.confirm_flags.confirm_data.
-      confirmed_date;
+    if (status == SL_STATUS_OK) {
+      *confirm_date =
+        (bool)gnss_cfg_data->packetUBXNAVPVT->data.confirm_flags.confirm_data.
+        confirmed_date;
+    }
   } else {
     status = SL_STATUS_NOT_AVAILABLE;
   }
@@ -2168,10 +2882,12 @@ sl_status_t gnss_max_m10s_get_fully_resolved(
   sl_status_t status;
 
   if (gnss_cfg_data->protocol_type != SL_MAX_M10S_PROTOCOL_NMEA) {
-    status = gnss_max_m10s_get_navpvt_ubx(gnss_cfg_data, max_wait);
+    status = gnss_max_m10s_refresh_nav_pvt(gnss_cfg_data, max_wait);
 
-    *fully_resolved =
-      (bool)gnss_cfg_data->packetUBXNAVPVT->data.valid.bits.fullyResolved;
+    if (status == SL_STATUS_OK) {
+      *fully_resolved =
+        (bool)gnss_cfg_data->packetUBXNAVPVT->data.valid.bits.fullyResolved;
+    }
   } else {
     status = SL_STATUS_NOT_AVAILABLE;
   }
@@ -2186,11 +2902,13 @@ sl_status_t gnss_max_m10s_get_invalid_data(
   sl_status_t status;
 
   if (gnss_cfg_data->protocol_type != SL_MAX_M10S_PROTOCOL_NMEA) {
-    status = gnss_max_m10s_get_navpvt_ubx(gnss_cfg_data, max_wait);
+    status = gnss_max_m10s_refresh_nav_pvt(gnss_cfg_data, max_wait);
 
-    *invalid_data =
-      (bool)gnss_cfg_data->packetUBXNAVPVT->data.correction_flags.bits.
-      invalidLlh;
+    if (status == SL_STATUS_OK) {
+      *invalid_data =
+        (bool)gnss_cfg_data->packetUBXNAVPVT->data.correction_flags.bits.
+        invalidLlh;
+    }
   } else {
     status = SL_STATUS_NOT_AVAILABLE;
   }
@@ -2205,9 +2923,11 @@ sl_status_t gnss_max_m10s_get_time_of_week(
   sl_status_t status;
 
   if (gnss_cfg_data->protocol_type != SL_MAX_M10S_PROTOCOL_NMEA) {
-    status = gnss_max_m10s_get_navpvt_ubx(gnss_cfg_data, max_wait);
+    status = gnss_max_m10s_refresh_nav_pvt(gnss_cfg_data, max_wait);
 
-    *time_of_week = gnss_cfg_data->packetUBXNAVPVT->data.iTOW;
+    if (status == SL_STATUS_OK) {
+      *time_of_week = gnss_cfg_data->packetUBXNAVPVT->data.iTOW;
+    }
   } else {
     status = SL_STATUS_NOT_AVAILABLE;
   }
@@ -2222,9 +2942,11 @@ sl_status_t gnss_max_m10s_get_horizontal_accuracy(
   sl_status_t status;
 
   if (gnss_cfg_data->protocol_type != SL_MAX_M10S_PROTOCOL_NMEA) {
-    status = gnss_max_m10s_get_navpvt_ubx(gnss_cfg_data, max_wait);
+    status = gnss_max_m10s_refresh_nav_pvt(gnss_cfg_data, max_wait);
 
-    *horizontal_accuracy = gnss_cfg_data->packetUBXNAVPVT->data.hAcc;
+    if (status == SL_STATUS_OK) {
+      *horizontal_accuracy = gnss_cfg_data->packetUBXNAVPVT->data.hAcc;
+    }
   } else {
     status = SL_STATUS_NOT_AVAILABLE;
   }
@@ -2239,9 +2961,11 @@ sl_status_t gnss_max_m10s_get_vertical_accuracy(
   sl_status_t status;
 
   if (gnss_cfg_data->protocol_type != SL_MAX_M10S_PROTOCOL_NMEA) {
-    status = gnss_max_m10s_get_navpvt_ubx(gnss_cfg_data, max_wait);
+    status = gnss_max_m10s_refresh_nav_pvt(gnss_cfg_data, max_wait);
 
-    *vertical_accuracy = gnss_cfg_data->packetUBXNAVPVT->data.vAcc;
+    if (status == SL_STATUS_OK) {
+      *vertical_accuracy = gnss_cfg_data->packetUBXNAVPVT->data.vAcc;
+    }
   } else {
     status = SL_STATUS_NOT_AVAILABLE;
   }
@@ -2255,9 +2979,11 @@ sl_status_t gnss_max_m10s_get_ned_north(sl_max_m10s_cfg_data_t *gnss_cfg_data,
   sl_status_t status;
 
   if (gnss_cfg_data->protocol_type != SL_MAX_M10S_PROTOCOL_NMEA) {
-    status = gnss_max_m10s_get_navpvt_ubx(gnss_cfg_data, max_wait);
+    status = gnss_max_m10s_refresh_nav_pvt(gnss_cfg_data, max_wait);
 
-    *ned_north = gnss_cfg_data->packetUBXNAVPVT->data.velN;
+    if (status == SL_STATUS_OK) {
+      *ned_north = gnss_cfg_data->packetUBXNAVPVT->data.velN;
+    }
   } else {
     status = SL_STATUS_NOT_AVAILABLE;
   }
@@ -2271,9 +2997,11 @@ sl_status_t gnss_max_m10s_get_ned_east(sl_max_m10s_cfg_data_t *gnss_cfg_data,
   sl_status_t status;
 
   if (gnss_cfg_data->protocol_type != SL_MAX_M10S_PROTOCOL_NMEA) {
-    status = gnss_max_m10s_get_navpvt_ubx(gnss_cfg_data, max_wait);
+    status = gnss_max_m10s_refresh_nav_pvt(gnss_cfg_data, max_wait);
 
-    *ned_east = gnss_cfg_data->packetUBXNAVPVT->data.velE;
+    if (status == SL_STATUS_OK) {
+      *ned_east = gnss_cfg_data->packetUBXNAVPVT->data.velE;
+    }
   } else {
     status = SL_STATUS_NOT_AVAILABLE;
   }
@@ -2287,9 +3015,11 @@ sl_status_t gnss_max_m10s_get_ned_down(sl_max_m10s_cfg_data_t *gnss_cfg_data,
   sl_status_t status;
 
   if (gnss_cfg_data->protocol_type != SL_MAX_M10S_PROTOCOL_NMEA) {
-    status = gnss_max_m10s_get_navpvt_ubx(gnss_cfg_data, max_wait);
+    status = gnss_max_m10s_refresh_nav_pvt(gnss_cfg_data, max_wait);
 
-    *ned_down = gnss_cfg_data->packetUBXNAVPVT->data.velD;
+    if (status == SL_STATUS_OK) {
+      *ned_down = gnss_cfg_data->packetUBXNAVPVT->data.velD;
+    }
   } else {
     status = SL_STATUS_NOT_AVAILABLE;
   }
@@ -2304,9 +3034,11 @@ sl_status_t gnss_max_m10s_get_magnetic_declination(
   sl_status_t status;
 
   if (gnss_cfg_data->protocol_type != SL_MAX_M10S_PROTOCOL_NMEA) {
-    status = gnss_max_m10s_get_navpvt_ubx(gnss_cfg_data, max_wait);
+    status = gnss_max_m10s_refresh_nav_pvt(gnss_cfg_data, max_wait);
 
-    *magnetic_declination = gnss_cfg_data->packetUBXNAVPVT->data.magDec;
+    if (status == SL_STATUS_OK) {
+      *magnetic_declination = gnss_cfg_data->packetUBXNAVPVT->data.magDec;
+    }
   } else {
     status = SL_STATUS_NOT_AVAILABLE;
   }
@@ -2321,9 +3053,11 @@ sl_status_t gnss_max_m10s_get_magnetic_declination_accuracy(
   sl_status_t status;
 
   if (gnss_cfg_data->protocol_type != SL_MAX_M10S_PROTOCOL_NMEA) {
-    status = gnss_max_m10s_get_navpvt_ubx(gnss_cfg_data, max_wait);
+    status = gnss_max_m10s_refresh_nav_pvt(gnss_cfg_data, max_wait);
 
-    *magnetic_accuracy = gnss_cfg_data->packetUBXNAVPVT->data.magAcc;
+    if (status == SL_STATUS_OK) {
+      *magnetic_accuracy = gnss_cfg_data->packetUBXNAVPVT->data.magAcc;
+    }
   } else {
     status = SL_STATUS_NOT_AVAILABLE;
   }
@@ -2338,9 +3072,11 @@ sl_status_t gnss_max_m10s_get_heading_of_motion(
   sl_status_t status;
 
   if (gnss_cfg_data->protocol_type != SL_MAX_M10S_PROTOCOL_NMEA) {
-    status = gnss_max_m10s_get_navpvt_ubx(gnss_cfg_data, max_wait);
+    status = gnss_max_m10s_refresh_nav_pvt(gnss_cfg_data, max_wait);
 
-    *head_of_motion = gnss_cfg_data->packetUBXNAVPVT->data.headMot;
+    if (status == SL_STATUS_OK) {
+      *head_of_motion = gnss_cfg_data->packetUBXNAVPVT->data.headMot;
+    }
   } else {
     status = SL_STATUS_NOT_AVAILABLE;
   }
@@ -2355,9 +3091,11 @@ sl_status_t gnss_max_m10s_get_ground_speed(
   sl_status_t status;
 
   if (gnss_cfg_data->protocol_type != SL_MAX_M10S_PROTOCOL_NMEA) {
-    status = gnss_max_m10s_get_navpvt_ubx(gnss_cfg_data, max_wait);
+    status = gnss_max_m10s_refresh_nav_pvt(gnss_cfg_data, max_wait);
 
-    *ground_speed = gnss_cfg_data->packetUBXNAVPVT->data.gSpeed;
+    if (status == SL_STATUS_OK) {
+      *ground_speed = gnss_cfg_data->packetUBXNAVPVT->data.gSpeed;
+    }
   } else {
     status =
       gnss_max_m10s_get_speed_nmea(gnss_cfg_data, ground_speed, max_wait);
@@ -2373,9 +3111,11 @@ sl_status_t gnss_max_m10s_get_speed_accuracy(
   sl_status_t status;
 
   if (gnss_cfg_data->protocol_type != SL_MAX_M10S_PROTOCOL_NMEA) {
-    status = gnss_max_m10s_get_navpvt_ubx(gnss_cfg_data, max_wait);
+    status = gnss_max_m10s_refresh_nav_pvt(gnss_cfg_data, max_wait);
 
-    *speed_accuracy = gnss_cfg_data->packetUBXNAVPVT->data.sAcc;
+    if (status == SL_STATUS_OK) {
+      *speed_accuracy = gnss_cfg_data->packetUBXNAVPVT->data.sAcc;
+    }
   } else {
     status = SL_STATUS_NOT_AVAILABLE;
   }
@@ -2390,9 +3130,11 @@ sl_status_t gnss_max_m10s_get_heading_accuracy(
   sl_status_t status;
 
   if (gnss_cfg_data->protocol_type != SL_MAX_M10S_PROTOCOL_NMEA) {
-    status = gnss_max_m10s_get_navpvt_ubx(gnss_cfg_data, max_wait);
+    status = gnss_max_m10s_refresh_nav_pvt(gnss_cfg_data, max_wait);
 
-    *heading_accuracy = gnss_cfg_data->packetUBXNAVPVT->data.headAcc;
+    if (status == SL_STATUS_OK) {
+      *heading_accuracy = gnss_cfg_data->packetUBXNAVPVT->data.headAcc;
+    }
   } else {
     status = SL_STATUS_NOT_AVAILABLE;
   }
@@ -2407,9 +3149,11 @@ sl_status_t gnss_max_m10s_get_positional_dillution(
   sl_status_t status;
 
   if (gnss_cfg_data->protocol_type != SL_MAX_M10S_PROTOCOL_NMEA) {
-    status = gnss_max_m10s_get_navpvt_ubx(gnss_cfg_data, max_wait);
+    status = gnss_max_m10s_refresh_nav_pvt(gnss_cfg_data, max_wait);
 
-    *position_dillution = gnss_cfg_data->packetUBXNAVPVT->data.pDOP;
+    if (status == SL_STATUS_OK) {
+      *position_dillution = gnss_cfg_data->packetUBXNAVPVT->data.pDOP;
+    }
   } else {
     status = SL_STATUS_NOT_AVAILABLE;
   }
@@ -2424,9 +3168,11 @@ sl_status_t gnss_max_m10s_get_head_vehicle(
   sl_status_t status;
 
   if (gnss_cfg_data->protocol_type != SL_MAX_M10S_PROTOCOL_NMEA) {
-    status = gnss_max_m10s_get_navpvt_ubx(gnss_cfg_data, max_wait);
+    status = gnss_max_m10s_refresh_nav_pvt(gnss_cfg_data, max_wait);
 
-    *head_vehicle = gnss_cfg_data->packetUBXNAVPVT->data.headVeh;
+    if (status == SL_STATUS_OK) {
+      *head_vehicle = gnss_cfg_data->packetUBXNAVPVT->data.headVeh;
+    }
   } else {
     status = SL_STATUS_NOT_AVAILABLE;
   }
@@ -2440,9 +3186,11 @@ sl_status_t gnss_max_m10s_get_day(sl_max_m10s_cfg_data_t *gnss_cfg_data,
   sl_status_t status;
 
   if (gnss_cfg_data->protocol_type != SL_MAX_M10S_PROTOCOL_NMEA) {
-    status = gnss_max_m10s_get_navpvt_ubx(gnss_cfg_data, max_wait);
+    status = gnss_max_m10s_refresh_nav_pvt(gnss_cfg_data, max_wait);
 
-    *day = gnss_cfg_data->packetUBXNAVPVT->data.day;
+    if (status == SL_STATUS_OK) {
+      *day = gnss_cfg_data->packetUBXNAVPVT->data.day;
+    }
   } else {
     status = gnss_max_m10s_get_day_nmea(gnss_cfg_data, day, max_wait);
   }
@@ -2456,9 +3204,11 @@ sl_status_t gnss_max_m10s_get_month(sl_max_m10s_cfg_data_t *gnss_cfg_data,
   sl_status_t status;
 
   if (gnss_cfg_data->protocol_type != SL_MAX_M10S_PROTOCOL_NMEA) {
-    status = gnss_max_m10s_get_navpvt_ubx(gnss_cfg_data, max_wait);
+    status = gnss_max_m10s_refresh_nav_pvt(gnss_cfg_data, max_wait);
 
-    *month = gnss_cfg_data->packetUBXNAVPVT->data.month;
+    if (status == SL_STATUS_OK) {
+      *month = gnss_cfg_data->packetUBXNAVPVT->data.month;
+    }
   } else {
     status = gnss_max_m10s_get_month_nmea(gnss_cfg_data, month, max_wait);
   }
@@ -2472,9 +3222,11 @@ sl_status_t gnss_max_m10s_get_year(sl_max_m10s_cfg_data_t *gnss_cfg_data,
   sl_status_t status;
 
   if (gnss_cfg_data->protocol_type != SL_MAX_M10S_PROTOCOL_NMEA) {
-    status = gnss_max_m10s_get_navpvt_ubx(gnss_cfg_data, max_wait);
+    status = gnss_max_m10s_refresh_nav_pvt(gnss_cfg_data, max_wait);
 
-    *year = gnss_cfg_data->packetUBXNAVPVT->data.year;
+    if (status == SL_STATUS_OK) {
+      *year = gnss_cfg_data->packetUBXNAVPVT->data.year;
+    }
   } else {
     status = gnss_max_m10s_get_year_nmea(gnss_cfg_data, year, max_wait);
   }
@@ -2488,9 +3240,11 @@ sl_status_t gnss_max_m10s_get_hour(sl_max_m10s_cfg_data_t *gnss_cfg_data,
   sl_status_t status;
 
   if (gnss_cfg_data->protocol_type != SL_MAX_M10S_PROTOCOL_NMEA) {
-    status = gnss_max_m10s_get_navpvt_ubx(gnss_cfg_data, max_wait);
+    status = gnss_max_m10s_refresh_nav_pvt(gnss_cfg_data, max_wait);
 
-    *hour = gnss_cfg_data->packetUBXNAVPVT->data.hour;
+    if (status == SL_STATUS_OK) {
+      *hour = gnss_cfg_data->packetUBXNAVPVT->data.hour;
+    }
   } else {
     status = gnss_max_m10s_get_hour_nmea(gnss_cfg_data, hour, max_wait);
   }
@@ -2504,9 +3258,11 @@ sl_status_t gnss_max_m10s_get_minute(sl_max_m10s_cfg_data_t *gnss_cfg_data,
   sl_status_t status;
 
   if (gnss_cfg_data->protocol_type != SL_MAX_M10S_PROTOCOL_NMEA) {
-    status = gnss_max_m10s_get_navpvt_ubx(gnss_cfg_data, max_wait);
+    status = gnss_max_m10s_refresh_nav_pvt(gnss_cfg_data, max_wait);
 
-    *minute = gnss_cfg_data->packetUBXNAVPVT->data.min;
+    if (status == SL_STATUS_OK) {
+      *minute = gnss_cfg_data->packetUBXNAVPVT->data.min;
+    }
   } else {
     status = gnss_max_m10s_get_min_nmea(gnss_cfg_data, minute, max_wait);
   }
@@ -2520,9 +3276,11 @@ sl_status_t gnss_max_m10s_get_seconds(sl_max_m10s_cfg_data_t *gnss_cfg_data,
   sl_status_t status;
 
   if (gnss_cfg_data->protocol_type != SL_MAX_M10S_PROTOCOL_NMEA) {
-    status = gnss_max_m10s_get_navpvt_ubx(gnss_cfg_data, max_wait);
+    status = gnss_max_m10s_refresh_nav_pvt(gnss_cfg_data, max_wait);
 
-    *seconds = gnss_cfg_data->packetUBXNAVPVT->data.sec;
+    if (status == SL_STATUS_OK) {
+      *seconds = gnss_cfg_data->packetUBXNAVPVT->data.sec;
+    }
   } else {
     status = gnss_max_m10s_get_second_nmea(gnss_cfg_data, seconds, max_wait);
   }
@@ -2537,9 +3295,11 @@ sl_status_t gnss_max_m10s_get_milliseconds(
   sl_status_t status;
 
   if (gnss_cfg_data->protocol_type != SL_MAX_M10S_PROTOCOL_NMEA) {
-    status = gnss_max_m10s_get_navpvt_ubx(gnss_cfg_data, max_wait);
+    status = gnss_max_m10s_refresh_nav_pvt(gnss_cfg_data, max_wait);
 
-    *milli_seconds = gnss_cfg_data->packetUBXNAVPVT->data.iTOW % 1000;
+    if (status == SL_STATUS_OK) {
+      *milli_seconds = gnss_cfg_data->packetUBXNAVPVT->data.iTOW % 1000;
+    }
   } else {
     status = SL_STATUS_NOT_AVAILABLE;
   }
@@ -2553,9 +3313,11 @@ sl_status_t gnss_max_m10s_get_nanoseconds(sl_max_m10s_cfg_data_t *gnss_cfg_data,
   sl_status_t status;
 
   if (gnss_cfg_data->protocol_type != SL_MAX_M10S_PROTOCOL_NMEA) {
-    status = gnss_max_m10s_get_navpvt_ubx(gnss_cfg_data, max_wait);
+    status = gnss_max_m10s_refresh_nav_pvt(gnss_cfg_data, max_wait);
 
-    *nano = gnss_cfg_data->packetUBXNAVPVT->data.nano;
+    if (status == SL_STATUS_OK) {
+      *nano = gnss_cfg_data->packetUBXNAVPVT->data.nano;
+    }
   } else {
     status = SL_STATUS_NOT_AVAILABLE;
   }
@@ -2569,9 +3331,11 @@ sl_status_t gnss_max_m10s_valid_time(sl_max_m10s_cfg_data_t *gnss_cfg_data,
   sl_status_t status;
 
   if (gnss_cfg_data->protocol_type != SL_MAX_M10S_PROTOCOL_NMEA) {
-    status = gnss_max_m10s_get_navpvt_ubx(gnss_cfg_data, max_wait);
+    status = gnss_max_m10s_refresh_nav_pvt(gnss_cfg_data, max_wait);
 
-    *valid_time = gnss_cfg_data->packetUBXNAVPVT->data.valid.bits.valid_time;
+    if (status == SL_STATUS_OK) {
+      *valid_time = gnss_cfg_data->packetUBXNAVPVT->data.valid.bits.valid_time;
+    }
   } else {
     status = SL_STATUS_NOT_AVAILABLE;
   }
@@ -2585,9 +3349,11 @@ sl_status_t gnss_max_m10s_valid_date(sl_max_m10s_cfg_data_t *gnss_cfg_data,
   sl_status_t status;
 
   if (gnss_cfg_data->protocol_type != SL_MAX_M10S_PROTOCOL_NMEA) {
-    status = gnss_max_m10s_get_navpvt_ubx(gnss_cfg_data, max_wait);
+    status = gnss_max_m10s_refresh_nav_pvt(gnss_cfg_data, max_wait);
 
-    *valid_date = gnss_cfg_data->packetUBXNAVPVT->data.valid.bits.valid_date;
+    if (status == SL_STATUS_OK) {
+      *valid_date = gnss_cfg_data->packetUBXNAVPVT->data.valid.bits.valid_date;
+    }
   } else {
     status = SL_STATUS_NOT_AVAILABLE;
   }
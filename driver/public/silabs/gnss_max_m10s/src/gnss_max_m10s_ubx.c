@@ -33,9 +33,44 @@
  * as a demonstration for evaluation purposes only. This code will be maintained
  * at the sole discretion of Silicon Labs.
  ******************************************************************************/
+#include <stddef.h>
 #include <stdlib.h>
 #include "gnss_max_m10s_ubx.h"
 
+#define UBX_MSG_KEY(cls, id)  ((uint16_t)(((cls) << 8) | (id)))
+
+#define UBX_MSG(cls, id, len, variable_len, storage, handler) \
+  { UBX_MSG_KEY(cls, id), len, variable_len,                  \
+    offsetof(sl_max_m10s_cfg_data_t, storage), handler }
+
+/// Messages decoded by the driver, sorted on class and ID for the lookup.
+static const sl_max_m10s_ubx_msg_entry_t ubx_msg_table[] = {
+  UBX_MSG(UBX_CLASS_NAV, UBX_NAV_POSLLH, UBX_NAV_POSLLH_LEN, false,
+          packetUBXNAVPOSLLH, sl_max_m10s_ubx_navposllh_process),
+  UBX_MSG(UBX_CLASS_NAV, UBX_NAV_STATUS, UBX_NAV_STATUS_LEN, false,
+          packetUBXNAVSTATUS, sl_max_m10s_ubx_navstatus_process),
+  UBX_MSG(UBX_CLASS_NAV, UBX_NAV_DOP, UBX_NAV_DOP_LEN, false,
+          packetUBXNAVDOP, sl_max_m10s_ubx_navdop_process),
+  UBX_MSG(UBX_CLASS_NAV, UBX_NAV_PVT, UBX_NAV_PVT_LEN, false,
+          packetUBXNAVPVT, sl_max_m10s_ubx_navpvt_process),
+  UBX_MSG(UBX_CLASS_NAV, UBX_NAV_VELNED, UBX_NAV_VELNED_LEN, false,
+          packetUBXNAVVELNED, sl_max_m10s_ubx_navvelned_process),
+  UBX_MSG(UBX_CLASS_NAV, UBX_NAV_TIMEUTC, UBX_NAV_TIMEUTC_LEN, false,
+          packetUBXNAVTIMEUTC, sl_max_m10s_ubx_navtimeutc_process),
+  UBX_MSG(UBX_CLASS_NAV, UBX_NAV_CLOCK, UBX_NAV_CLOCK_LEN, false,
+          packetUBXNAVCLOCK, sl_max_m10s_ubx_navclock_process),
+  UBX_MSG(UBX_CLASS_NAV, UBX_NAV_TIMELS, UBX_NAV_TIMELS_LEN, false,
+          packetUBXNAVTIMELS, sl_max_m10s_ubx_navtimels_process),
+  UBX_MSG(UBX_CLASS_NAV, UBX_NAV_SAT, UBX_NAV_SAT_LEN, true,
+          packetUBXNAVSAT, sl_max_m10s_ubx_navsat_process),
+  UBX_MSG(UBX_CLASS_NAV, UBX_NAV_SIG, UBX_NAV_SIG_MAX_LEN, true,
+          packetUBXNAVSIG, sl_max_m10s_ubx_navsig_process),
+  UBX_MSG(UBX_CLASS_NAV, UBX_NAV_EOE, UBX_NAV_EOE_LEN, false,
+          packetUBXNAVEOE, sl_max_m10s_ubx_navepoch_process),
+};
+
+#define UBX_MSG_TABLE_SIZE  (sizeof(ubx_msg_table) / sizeof(ubx_msg_table[0]))
+
 /**************************************************************************//**
  * @brief initializes packet for UBXNAVPVT packet.
  * @param[in] gnss_cfg_data : pointer to the structure
@@ -488,32 +523,69 @@ void gnss_max_m10s_process_ubx(sl_max_m10s_cfg_data_t *gnss_cfg_data,
   incomingUBX->counter++;
 }
 
+const sl_max_m10s_ubx_msg_entry_t *gnss_max_m10s_ubx_find_msg(uint8_t cls,
+                                                              uint8_t id)
+{
+  uint16_t key = UBX_MSG_KEY(cls, id);
+  uint8_t low = 0;
+  uint8_t high = UBX_MSG_TABLE_SIZE;
+
+  while (low < high) {
+    uint8_t mid = (low + high) / 2;
+
+    if (ubx_msg_table[mid].key == key) {
+      return &ubx_msg_table[mid];
+    } else if (ubx_msg_table[mid].key < key) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+
+  return NULL;
+}
+
+bool gnss_max_m10s_ubx_msg_enabled(sl_max_m10s_cfg_data_t *gnss_cfg_data,
+                                   const sl_max_m10s_ubx_msg_entry_t *entry)
+{
+  return *(void **)((uint8_t *)gnss_cfg_data + entry->storage) != NULL;
+}
+
+sl_max_m10s_ubx_callback_t gnss_max_m10s_ubx_find_callback(
+  sl_max_m10s_cfg_data_t *gnss_cfg_data,
+  uint8_t cls,
+  uint8_t id)
+{
+  for (uint8_t i = 0; i < gnss_cfg_data->ubx_callback_count; i++) {
+    if ((gnss_cfg_data->ubx_callbacks[i].cls == cls)
+        && (gnss_cfg_data->ubx_callbacks[i].id == id)) {
+      return gnss_cfg_data->ubx_callbacks[i].callback;
+    }
+  }
+
+  return NULL;
+}
+
 void gnss_max_m10s_process_ubx_packet(sl_max_m10s_cfg_data_t *gnss_cfg_data,
                                       sl_max_m10s_ubx_packet_t *msg)
 {
-  if ((msg->id == UBX_NAV_PVT) && (msg->len == UBX_NAV_PVT_LEN)) {
-    sl_max_m10s_ubx_navpvt_process(gnss_cfg_data, msg);
-  } else if ((msg->id == UBX_NAV_STATUS) && (msg->len == UBX_NAV_STATUS_LEN)) {
-    sl_max_m10s_ubx_navstatus_process(gnss_cfg_data, msg);
-  } else if ((msg->id == UBX_NAV_DOP) && (msg->len == UBX_NAV_DOP_LEN)) {
-    sl_max_m10s_ubx_navdop_process(gnss_cfg_data, msg);
-  } else if ((msg->id == UBX_NAV_CLOCK) && (msg->len == UBX_NAV_CLOCK_LEN)) {
-    sl_max_m10s_ubx_navclock_process(gnss_cfg_data, msg);
-  } else if ((msg->id == UBX_NAV_EOE) && (msg->len == UBX_NAV_EOE_LEN)) {
-    sl_max_m10s_ubx_navepoch_process(gnss_cfg_data, msg);
-  } else if (msg->id == UBX_NAV_SAT) {
-    sl_max_m10s_ubx_navsat_process(gnss_cfg_data, msg);
-  } else if ((msg->id == UBX_NAV_TIMELS) && (msg->len == UBX_NAV_TIMELS_LEN)) {
-    sl_max_m10s_ubx_navtimels_process(gnss_cfg_data, msg);
-  } else if ((msg->id == UBX_NAV_TIMEUTC)
-             && (msg->len == UBX_NAV_TIMEUTC_LEN)) {
-    sl_max_m10s_ubx_navtimeutc_process(gnss_cfg_data, msg);
-  } else if (msg->id == UBX_NAV_SIG) {
-    sl_max_m10s_ubx_navsig_process(gnss_cfg_data, msg);
-  } else if ((msg->id == UBX_NAV_POSLLH) && (msg->len == UBX_NAV_POSLLH_LEN)) {
-    sl_max_m10s_ubx_navposllh_process(gnss_cfg_data, msg);
-  } else if ((msg->id == UBX_NAV_VELNED) && (msg->len == UBX_NAV_VELNED_LEN)) {
-    sl_max_m10s_ubx_navvelned_process(gnss_cfg_data, msg);
+  const sl_max_m10s_ubx_msg_entry_t *entry =
+    gnss_max_m10s_ubx_find_msg(msg->cls, msg->id);
+  sl_max_m10s_ubx_callback_t callback;
+
+  if ((entry != NULL)
+      && (entry->variable_len || (msg->len == entry->len))) {
+    entry->handler(gnss_cfg_data, msg);
+  }
+
+  if (gnss_cfg_data->ubx_callback_count > 0) {
+    callback = gnss_max_m10s_ubx_find_callback(gnss_cfg_data,
+                                               msg->cls,
+                                               msg->id);
+
+    if (callback != NULL) {
+      callback(msg);
+    }
   }
 }
 
@@ -1009,6 +1081,8 @@ void sl_max_m10s_ubx_navpvt_process(sl_max_m10s_cfg_data_t *gnss_cfg_data,
   bool added_to_file_buffer = false;
 
   if (gnss_cfg_data->packetUBXNAVPVT != NULL) {
+    gnss_cfg_data->packetUBXNAVPVT->data.iTOW = gnss_max_m10s_extract_long(msg,
+                                                                           0);
     gnss_cfg_data->packetUBXNAVPVT->data.fixType = gnss_max_m10s_extract_byte(
       msg,
       20);
@@ -1074,6 +1148,8 @@ void sl_max_m10s_ubx_navpvt_process(sl_max_m10s_cfg_data_t *gnss_cfg_data,
       gnss_max_m10s_extract_byte(msg, 21);
     gnss_cfg_data->packetUBXNAVPVT->data.correction_flags.all =
       gnss_max_m10s_extract_byte(msg, 78);
+    gnss_cfg_data->packetUBXNAVPVT->timestamp = gnss_max_m10s_milli_sec();
+    gnss_cfg_data->packetUBXNAVPVT->data_valid = true;
 
     if ((gnss_cfg_data->packetUBXNAVPVT->callback_data != NULL)
         && (gnss_cfg_data->packetUBXNAVPVT->automatic_flags.flags.bits.
@@ -1347,6 +1423,8 @@ static sl_status_t gnss_max_m10s_init_packet_ubxnavpvt(
   gnss_cfg_data->packetUBXNAVPVT->automatic_flags.flags.all = 0;
   gnss_cfg_data->packetUBXNAVPVT->callback_pointer_ptr = NULL;
   gnss_cfg_data->packetUBXNAVPVT->callback_data = NULL;
+  gnss_cfg_data->packetUBXNAVPVT->timestamp = 0;
+  gnss_cfg_data->packetUBXNAVPVT->data_valid = false;
 
   return SL_STATUS_OK;
 }
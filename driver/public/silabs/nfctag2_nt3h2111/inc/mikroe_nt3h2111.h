@@ -79,7 +79,13 @@
 #define NT3H2111_NS_REG_MASK_RF_FIELD_PRESENT            0x01
 
 #define NT3H2111_BLOCK_SIZE                              16
+#define NT3H2111_MEM_BLOCK_COUNT                         256
+#define NT3H2111_SRAM_SIZE                               \
+  (NT3H2111_MEM_SRAM_BLOCKS * NT3H2111_BLOCK_SIZE)
 #define NT3H2111_WRITE_DELAY_MS                          10
+#define NT3H2111_WRITE_TIMEOUT_MS                        15
+#define NT3H2111_EEPROM_POLL_INTERVAL_MS                 1
+#define NT3H2111_STREAM_POLL_INTERVAL_MS                 2
 
 #define BIT7_MASK                                        0x80
 #define BIT6_MASK                                        0x40
@@ -265,6 +271,21 @@ typedef struct {
   nt3h2111_i2c_ns_reg_t           ns_reg;
 } nt3h2111_session_reg_t;
 
+/// Pass-through stream statistics type.
+typedef struct {
+  /* Payload bytes transferred. */
+  uint32_t bytes;
+
+  /* SRAM frames transferred. */
+  uint32_t frames;
+
+  /* Duration of the transfer, from the pass-through mode activation. */
+  uint32_t elapsed_ms;
+
+  /* Achieved throughput. */
+  uint32_t bytes_per_sec;
+} nt3h2111_stream_stats_t;
+
 /***************************************************************************//**
  * @brief
  *   Initialize the NT3H2111 driver with the values provided in the
@@ -412,6 +433,177 @@ sl_status_t nt3h2111_read_block(uint8_t mema, uint8_t *data);
  *****************************************************************************/
 sl_status_t nt3h2111_write_block(uint8_t mema, const uint8_t *data);
 
+/**************************************************************************//**
+ * @brief
+ *  Read consecutive memory blocks from NT3H2111 into a buffer, without
+ *  intermediate copies.
+ *
+ * @param[in] mema
+ *  The address of the first block of memory (SRAM or EEPROM)
+ *  that is intended to be read
+ *
+ * @param[out] data
+ *  Data buffer of count * NT3H2111_BLOCK_SIZE bytes to hold the result
+ *
+ * @param[in] count
+ *  Number of blocks to be read
+ *
+ * @returns
+ *  I2C transfer status, SL_STATUS_INVALID_RANGE if the blocks exceed the
+ *  memory map.
+ *****************************************************************************/
+sl_status_t nt3h2111_read_blocks(uint8_t mema, uint8_t *data, uint16_t count);
+
+/**************************************************************************//**
+ * @brief
+ *  Write consecutive memory blocks to NT3H2111. Each EEPROM block write is
+ *  followed by an adaptive wait for the end of the write cycle.
+ *
+ * @param[in] mema
+ *  The address of the first block of memory (SRAM or EEPROM)
+ *  that is intended to be written
+ *
+ * @param[in] data
+ *  count * NT3H2111_BLOCK_SIZE bytes to be written
+ *
+ * @param[in] count
+ *  Number of blocks to be written
+ *
+ * @returns
+ *  I2C transfer status, SL_STATUS_INVALID_RANGE if the blocks exceed the
+ *  memory map.
+ *****************************************************************************/
+sl_status_t nt3h2111_write_blocks(uint8_t mema,
+                                  const uint8_t *data,
+                                  uint16_t count);
+
+/**************************************************************************//**
+ * @brief
+ *  Read the SRAM (NT3H2111_SRAM_SIZE bytes) of NT3H2111.
+ *
+ * @param[out] data
+ *  Data buffer to hold the result
+ *
+ * @returns
+ *  I2C transfer status.
+ *
+ * @note
+ *  In pass-through mode, reading the last SRAM block hands the SRAM back to
+ *  the NFC interface.
+ *****************************************************************************/
+sl_status_t nt3h2111_read_sram(uint8_t *data);
+
+/**************************************************************************//**
+ * @brief
+ *  Write the SRAM (NT3H2111_SRAM_SIZE bytes) of NT3H2111.
+ *
+ * @param[in] data
+ *  Data to be written
+ *
+ * @returns
+ *  I2C transfer status.
+ *
+ * @note
+ *  In pass-through mode, writing the last SRAM block hands the SRAM over to
+ *  the NFC interface.
+ *****************************************************************************/
+sl_status_t nt3h2111_write_sram(const uint8_t *data);
+
+/**************************************************************************//**
+ * @brief
+ *  Enable or disable the SRAM pass-through mode of NT3H2111.
+ *
+ * @param[in] enable
+ *  true to enable the pass-through mode
+ *
+ * @param[in] transfer_dir
+ *  TRANSFER_DIR_I2C_TO_NFC or TRANSFER_DIR_NFC_TO_I2C
+ *
+ * @returns
+ *  I2C transfer status.
+ *
+ * @note
+ *  Details for pass-through mode, please refer to NT3H2111_2211 product
+ *  data sheet section 8.3.11.
+ *****************************************************************************/
+sl_status_t nt3h2111_set_pass_through(bool enable, bool transfer_dir);
+
+/**************************************************************************//**
+ * @brief
+ *  Stream data from I2C to an NFC reader through the SRAM in pass-through
+ *  mode, NT3H2111_SRAM_SIZE bytes per frame. The last frame is padded with
+ *  zeros.
+ *
+ * @param[in] data
+ *  Data to be sent
+ *
+ * @param[in] len
+ *  Number of bytes to be sent
+ *
+ * @param[in] timeout_ms
+ *  Maximum time to wait for the NFC field and for each frame to be read by
+ *  the NFC reader
+ *
+ * @param[out] stats
+ *  Statistics of the transfer, can be NULL
+ *
+ * @returns
+ *  SL_STATUS_OK if all the frames have been read by the NFC reader,
+ *  SL_STATUS_TIMEOUT, SL_STATUS_ABORT if the NFC field has been lost or I2C
+ *  transfer status.
+ *
+ * @note
+ *  The frames are handed over with NS_REG.SRAM_RF_READY. If the FD pin is
+ *  configured and the mikroe_nfctag2_fd_int component is installed, it
+ *  signals the SRAM release (FD_ON = FD_OFF = 11b), the MCU sleeps in EM1
+ *  until it is asserted and NS_REG is only read then. Otherwise NS_REG is
+ *  polled every NT3H2111_STREAM_POLL_INTERVAL_MS. The FD configuration of
+ *  NC_REG is restored when the transfer ends.
+ *
+ * @note
+ *  The call blocks until the transfer ends and keeps the MCU in EM1 while
+ *  waiting for the NFC reader, through sl_power_manager_sleep() when the
+ *  power manager is present and EMU_EnterEM1() otherwise. Interrupts of the
+ *  application are served, but its main loop does not run meanwhile.
+ *****************************************************************************/
+sl_status_t nt3h2111_stream_send(const uint8_t *data,
+                                 uint32_t len,
+                                 uint32_t timeout_ms,
+                                 nt3h2111_stream_stats_t *stats);
+
+/**************************************************************************//**
+ * @brief
+ *  Stream data from an NFC reader to I2C through the SRAM in pass-through
+ *  mode, NT3H2111_SRAM_SIZE bytes per frame. The bytes beyond len in the
+ *  last frame are dropped.
+ *
+ * @param[out] data
+ *  Data buffer to hold the result
+ *
+ * @param[in] len
+ *  Number of bytes to be received
+ *
+ * @param[in] timeout_ms
+ *  Maximum time to wait for the NFC field and for each frame to be written by
+ *  the NFC reader
+ *
+ * @param[out] stats
+ *  Statistics of the transfer, can be NULL
+ *
+ * @returns
+ *  SL_STATUS_OK if all the frames have been received, SL_STATUS_TIMEOUT,
+ *  SL_STATUS_ABORT if the NFC field has been lost or I2C transfer status.
+ *
+ * @note
+ *  The frames are handed over with NS_REG.SRAM_I2C_READY, see
+ *  nt3h2111_stream_send() for the use of the FD pin and the sleep while
+ *  waiting.
+ *****************************************************************************/
+sl_status_t nt3h2111_stream_receive(uint8_t *data,
+                                    uint32_t len,
+                                    uint32_t timeout_ms,
+                                    nt3h2111_stream_stats_t *stats);
+
 /***************************************************************************//**
  * @brief Write byte(s) to the selected device
  *
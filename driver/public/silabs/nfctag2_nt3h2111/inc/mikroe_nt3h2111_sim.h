@@ -0,0 +1,165 @@
+/***************************************************************************//**
+* @file   mikroe_nt3h2111_sim.h
+* @brief  Simulated NT3H2111 tag and NDEF update benchmark.
+********************************************************************************
+* # License
+* <b>Copyright 2026 Silicon Laboratories Inc. www.silabs.com</b>
+********************************************************************************
+*
+* SPDX-License-Identifier: Zlib
+*
+* The licensor of this software is Silicon Laboratories Inc.
+*
+* This software is provided \'as-is\', without any express or implied
+* warranty. In no event will the authors be held liable for any damages
+* arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented; you must not
+*    claim that you wrote the original software. If you use this software
+*    in a product, an acknowledgment in the product documentation would be
+*    appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+*    misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*
+********************************************************************************
+* # Evaluation Quality
+* This code has been minimally tested to ensure that it builds and is suitable
+* as a demonstration for evaluation purposes only. This code will be maintained
+* at the sole discretion of Silicon Labs.
+*******************************************************************************/
+
+#ifndef _MIKROE_NT3H2111_SIM_H_
+#define _MIKROE_NT3H2111_SIM_H_
+
+#include <stdint.h>
+#include "sl_status.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************************************************************//**
+ * @addtogroup NT3H2111 Driver
+ * @brief NT3H2111 Simulated Tag.
+ * @details
+ *  With this component the I2C transfers of the driver go to a tag model in
+ *  RAM instead of the bus. The model keeps the 256 memory blocks, the
+ *  configuration and session registers, and reports NS_REG.EEPROM_WR_BUSY
+ *  for the configured EEPROM write time after each EEPROM block write. Memory
+ *  accesses are refused meanwhile, like the device NAKs them, the session
+ *  registers stay accessible. The write time is
+ *  measured with the sleeptimer, so the driver's waits are part of the
+ *  result. I2C bus time is not modelled, it is counted in transfers.
+ * @{
+ ******************************************************************************/
+
+/// Counters of the simulated tag
+typedef struct {
+  uint32_t i2c_transfers;   ///< I2C read and write transfers
+  uint32_t eeprom_writes;   ///< EEPROM block writes
+  uint32_t busy_polls;      ///< NS_REG reads that found the EEPROM busy
+  uint32_t nak_count;       ///< Memory accesses refused during an EEPROM write
+} nt3h2111_sim_stats_t;
+
+/// Result of an NDEF update benchmark
+typedef struct {
+  uint32_t bytes;           ///< Payload bytes written
+  uint32_t time_ms;         ///< Time spent in nt3h2111_write_bytes()
+  uint32_t bytes_per_sec;   ///< Payload throughput
+  nt3h2111_sim_stats_t sim; ///< Tag counters of the run
+} nt3h2111_benchmark_result_t;
+
+/***************************************************************************//**
+ * @brief
+ *  Reset the simulated tag.
+ *
+ * @param[in] eeprom_write_time_ms
+ *  Time an EEPROM block write keeps the tag busy, 4 ms on the device
+ ******************************************************************************/
+void nt3h2111_sim_init(uint32_t eeprom_write_time_ms);
+
+/***************************************************************************//**
+ * @brief
+ *  Get the counters of the simulated tag since nt3h2111_sim_init().
+ *
+ * @param[out] stats
+ *  Counters
+ ******************************************************************************/
+void nt3h2111_sim_get_stats(nt3h2111_sim_stats_t *stats);
+
+/***************************************************************************//**
+ * @brief
+ *  Handle an I2C write transfer to the simulated tag.
+ *
+ * @param[in] size
+ *  Number of bytes written
+ *
+ * @param[in] pdata
+ *  Written bytes, starting with the memory address
+ *
+ * @returns
+ *  SL_STATUS_OK, or SL_STATUS_TRANSMIT if the tag refuses the transfer.
+ ******************************************************************************/
+sl_status_t nt3h2111_sim_i2c_write(uint32_t size, const uint8_t *pdata);
+
+/***************************************************************************//**
+ * @brief
+ *  Handle an I2C read transfer from the simulated tag.
+ *
+ * @param[in] size
+ *  Number of bytes read
+ *
+ * @param[out] pdata
+ *  Buffer to store the read bytes
+ *
+ * @returns
+ *  SL_STATUS_OK, or SL_STATUS_TRANSMIT if the tag refuses the transfer.
+ ******************************************************************************/
+sl_status_t nt3h2111_sim_i2c_read(uint32_t size, uint8_t *pdata);
+
+/***************************************************************************//**
+ * @brief
+ *  Measure the NDEF update throughput against the simulated tag.
+ *
+ * @details
+ *  The tag is reset with the given EEPROM write time, then a pattern of len
+ *  bytes is written iterations times at addr with nt3h2111_write_bytes().
+ *  Unaligned addr and len exercise the read-modify-write of the edge blocks.
+ *  The driver must be initialized with nt3h2111_init().
+ *
+ * @param[in] addr
+ *  Byte address of the NDEF message, 16 or above to keep block 0
+ *
+ * @param[in] len
+ *  Bytes per update
+ *
+ * @param[in] iterations
+ *  Number of updates
+ *
+ * @param[in] eeprom_write_time_ms
+ *  EEPROM write time of the simulated tag
+ *
+ * @param[out] result
+ *  Benchmark result
+ *
+ * @returns
+ *  SL_STATUS_OK, SL_STATUS_INVALID_PARAMETER or the error of the failed
+ *  write.
+ ******************************************************************************/
+sl_status_t nt3h2111_benchmark_ndef_update(uint8_t addr,
+                                           uint16_t len,
+                                           uint16_t iterations,
+                                           uint32_t eeprom_write_time_ms,
+                                           nt3h2111_benchmark_result_t *result);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} (end addtogroup NT3H2111 Driver) */
+#endif // _MIKROE_NT3H2111_SIM_H_
@@ -37,10 +37,24 @@
  ******************************************************************************/
 
 #include <string.h>
+#include "sl_component_catalog.h"
+#include "em_core.h"
+#include "em_emu.h"
 #include "em_gpio.h"
 #include "sl_sleeptimer.h"
 #include "mikroe_nt3h2111.h"
 
+#if defined(SL_CATALOG_POWER_MANAGER_PRESENT)
+#include "sl_power_manager.h"
+#endif
+
+// The FD interrupt needs the FD interrupt component on top of the pin
+#if defined(SL_CATALOG_MIKROE_NFCTAG2_FD_INT_PRESENT) \
+  && defined(MIKROE_NT3H211_FD_PORT) && defined(MIKROE_NT3H211_FD_PIN)
+#include "gpiointerrupt.h"
+#define NT3H2111_FD_INT
+#endif
+
 #if !defined (min)
 #define min(a, b) (((a) < (b)) ? (a) : (b))
 #endif
@@ -49,6 +63,36 @@
 static sl_i2cspm_t  *nt3h2111_i2cspm_instance = NULL;
 static bool nt3h2111_is_initialized = false;
 
+// Delay before the first NS_REG poll after an EEPROM write, adapted to the
+// write time of the device.
+static uint32_t nt3h2111_eeprom_write_time_ms = NT3H2111_WRITE_DELAY_MS / 2;
+
+// Number of FD pin assertions, updated from the GPIO interrupt.
+static volatile uint32_t nt3h2111_fd_event_count = 0;
+
+// Set by the sleeptimer that ends a stream sleep.
+static volatile bool nt3h2111_stream_timer_expired = false;
+
+static sl_status_t nt3h2111_wait_eeprom_ready(void);
+static sl_status_t nt3h2111_stream_begin(bool transfer_dir,
+                                         uint32_t timeout_ms,
+                                         uint8_t *nc_reg);
+static sl_status_t nt3h2111_stream_end(uint8_t nc_reg);
+static sl_status_t nt3h2111_stream_wait(uint8_t ns_mask,
+                                        uint8_t ns_value,
+                                        uint32_t timeout_ms);
+static void nt3h2111_stream_sleep(uint32_t fd_event_count,
+                                  uint32_t sleep_ms);
+static void nt3h2111_stream_timer_callback(sl_sleeptimer_timer_handle_t *handle,
+                                           void *data);
+static void nt3h2111_stream_stats_update(nt3h2111_stream_stats_t *stats,
+                                         uint32_t start_tick,
+                                         uint32_t bytes,
+                                         uint32_t frames);
+#if defined(NT3H2111_FD_INT)
+static void nt3h2111_fd_callback(uint8_t int_no);
+#endif
+
 /**************************************************************************//**
  * @brief
  *  Initialize NT3H2111 peripherals.
@@ -77,6 +121,12 @@ sl_status_t nt3h2111_init(sl_i2cspm_t *i2cspm)
                   1);
 #endif
 
+#if defined(NT3H2111_FD_INT)
+  // The FD interrupt is only enabled while streaming through the SRAM
+  GPIOINT_Init();
+  GPIOINT_CallbackRegister(MIKROE_NT3H211_FD_PIN, nt3h2111_fd_callback);
+#endif
+
   return SL_STATUS_OK;
 }
 
@@ -90,6 +140,15 @@ sl_status_t nt3h2111_deinit(void)
   }
 
   // De-initialization tasks
+#if defined(NT3H2111_FD_INT)
+  GPIO_ExtIntConfig(MIKROE_NT3H211_FD_PORT,
+                    MIKROE_NT3H211_FD_PIN,
+                    MIKROE_NT3H211_FD_PIN,
+                    false,
+                    true,
+                    false);
+  GPIOINT_CallbackUnRegister(MIKROE_NT3H211_FD_PIN);
+#endif
 #if defined(MIKROE_NT3H211_FD_PORT) && defined(MIKROE_NT3H211_FD_PIN)
   GPIO_PinModeSet(MIKROE_NT3H211_FD_PORT,
                   MIKROE_NT3H211_FD_PIN,
@@ -260,8 +319,6 @@ sl_status_t nt3h2111_read_block(uint8_t mema, uint8_t *data)
 sl_status_t nt3h2111_write_block(uint8_t mema, const uint8_t *data)
 {
   sl_status_t result = SL_STATUS_OK;
-  uint32_t timeout = NT3H2111_WRITE_DELAY_MS / 5 + 1;
-  uint8_t ns_reg;
   uint8_t buff[NT3H2111_BLOCK_SIZE + 1];
 
   if (NULL == data) {
@@ -290,23 +347,522 @@ sl_status_t nt3h2111_write_block(uint8_t mema, const uint8_t *data)
   }
 
   /* Wait for completion */
-  do {
-    sl_sleeptimer_delay_millisecond(5);
+  return nt3h2111_wait_eeprom_ready();
+}
+
+/***************************************************************************//**
+ *  Wait for the end of an EEPROM write cycle.
+ *
+ *  The first poll of NS_REG happens after the write time observed so far,
+ *  the following ones every NT3H2111_EEPROM_POLL_INTERVAL_MS. The expected
+ *  write time is lowered when the first poll finds the EEPROM ready and raised
+ *  to the measured time otherwise.
+ ******************************************************************************/
+static sl_status_t nt3h2111_wait_eeprom_ready(void)
+{
+  sl_status_t result;
+  uint32_t elapsed_ms = nt3h2111_eeprom_write_time_ms;
+  uint8_t ns_reg;
+
+  sl_sleeptimer_delay_millisecond(elapsed_ms);
+
+  while (true) {
     result = nt3h2111_get_session(SESSION_NS_REG, &ns_reg);
+    if (result != SL_STATUS_OK) {
+      return result;
+    }
+
+    if (!(ns_reg & NT3H2111_NS_REG_MASK_EEPROM_WR_BUSY)) {
+      break;
+    }
+
+    if (elapsed_ms >= NT3H2111_WRITE_TIMEOUT_MS) {
+      return SL_STATUS_TIMEOUT;
+    }
+
+    sl_sleeptimer_delay_millisecond(NT3H2111_EEPROM_POLL_INTERVAL_MS);
+    elapsed_ms += NT3H2111_EEPROM_POLL_INTERVAL_MS;
+  }
+
+  if (elapsed_ms > nt3h2111_eeprom_write_time_ms) {
+    nt3h2111_eeprom_write_time_ms = elapsed_ms;
+  } else if (nt3h2111_eeprom_write_time_ms > 1) {
+    nt3h2111_eeprom_write_time_ms--;
+  }
+
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ *  Read consecutive memory blocks from NT3H2111.
+ ******************************************************************************/
+sl_status_t nt3h2111_read_blocks(uint8_t mema, uint8_t *data, uint16_t count)
+{
+  sl_status_t result = SL_STATUS_OK;
+
+  if (NULL == data) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  if ((uint16_t) mema + count > NT3H2111_MEM_BLOCK_COUNT) {
+    return SL_STATUS_INVALID_RANGE;
+  }
+
+  /* The device returns one block per I2C read, each one lands directly in
+   * the caller's buffer. */
+  for (uint16_t i = 0; i < count; i++) {
+    result = nt3h2111_read_block(mema + i, &data[i * NT3H2111_BLOCK_SIZE]);
+    if (result != SL_STATUS_OK) {
+      break;
+    }
+  }
+
+  return result;
+}
+
+/***************************************************************************//**
+ *  Write consecutive memory blocks to NT3H2111.
+ ******************************************************************************/
+sl_status_t nt3h2111_write_blocks(uint8_t mema,
+                                  const uint8_t *data,
+                                  uint16_t count)
+{
+  sl_status_t result = SL_STATUS_OK;
+
+  if (NULL == data) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  if ((uint16_t) mema + count > NT3H2111_MEM_BLOCK_COUNT) {
+    return SL_STATUS_INVALID_RANGE;
+  }
+
+  for (uint16_t i = 0; i < count; i++) {
+    result = nt3h2111_write_block(mema + i, &data[i * NT3H2111_BLOCK_SIZE]);
+    if (result != SL_STATUS_OK) {
+      break;
+    }
+  }
+
+  return result;
+}
+
+/***************************************************************************//**
+ *  Read the 64 bytes of the SRAM of NT3H2111.
+ ******************************************************************************/
+sl_status_t nt3h2111_read_sram(uint8_t *data)
+{
+  return nt3h2111_read_blocks(NT3H2111_MEM_BLOCK_START_SRAM,
+                              data,
+                              NT3H2111_MEM_SRAM_BLOCKS);
+}
+
+/***************************************************************************//**
+ *  Write the 64 bytes of the SRAM of NT3H2111.
+ ******************************************************************************/
+sl_status_t nt3h2111_write_sram(const uint8_t *data)
+{
+  return nt3h2111_write_blocks(NT3H2111_MEM_BLOCK_START_SRAM,
+                               data,
+                               NT3H2111_MEM_SRAM_BLOCKS);
+}
+
+/***************************************************************************//**
+ *  Enable or disable the SRAM pass-through mode of NT3H2111.
+ ******************************************************************************/
+sl_status_t nt3h2111_set_pass_through(bool enable, bool transfer_dir)
+{
+  sl_status_t result;
+
+  if (!enable) {
+    return nt3h2111_set_session(SESSION_NC_REG,
+                                NT3H2111_NC_REG_MASK_PTHRU_ON_OFF,
+                                0);
+  }
+
+  /* The direction can only be changed while pass-through is disabled. */
+  result = nt3h2111_set_session(SESSION_NC_REG,
+                                NT3H2111_NC_REG_MASK_PTHRU_ON_OFF
+                                | NT3H2111_NC_REG_MASK_TRANSFER_DIR,
+                                transfer_dir
+                                ? NT3H2111_NC_REG_MASK_TRANSFER_DIR : 0);
+  if (result != SL_STATUS_OK) {
+    return result;
+  }
+
+  return nt3h2111_set_session(SESSION_NC_REG,
+                              NT3H2111_NC_REG_MASK_PTHRU_ON_OFF,
+                              NT3H2111_NC_REG_MASK_PTHRU_ON_OFF);
+}
+
+/***************************************************************************//**
+ *  Stream data from I2C to NFC through the SRAM.
+ ******************************************************************************/
+sl_status_t nt3h2111_stream_send(const uint8_t *data,
+                                 uint32_t len,
+                                 uint32_t timeout_ms,
+                                 nt3h2111_stream_stats_t *stats)
+{
+  sl_status_t result;
+  sl_status_t end_result;
+  uint8_t frame[NT3H2111_SRAM_SIZE];
+  uint32_t bytes_sent = 0;
+  uint32_t frames = 0;
+  uint32_t start_tick;
+  uint8_t nc_reg;
+
+  if ((NULL == data) && (len > 0)) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  result = nt3h2111_stream_begin(TRANSFER_DIR_I2C_TO_NFC, timeout_ms, &nc_reg);
+  if (result != SL_STATUS_OK) {
+    return result;
+  }
+
+  start_tick = sl_sleeptimer_get_tick_count();
+
+  while (bytes_sent < len) {
+    uint32_t frame_len = min(len - bytes_sent, NT3H2111_SRAM_SIZE);
+
+    /* The previous frame must have been read by the NFC reader. */
+    result = nt3h2111_stream_wait(NT3H2111_NS_REG_MASK_SRAM_RF_READY,
+                                  0,
+                                  timeout_ms);
+    if (result != SL_STATUS_OK) {
+      break;
+    }
+
+    if (frame_len < NT3H2111_SRAM_SIZE) {
+      /* Pad the last frame. */
+      memset(frame, 0, sizeof(frame));
+      memcpy(frame, &data[bytes_sent], frame_len);
+      result = nt3h2111_write_sram(frame);
+    } else {
+      result = nt3h2111_write_sram(&data[bytes_sent]);
+    }
+    if (result != SL_STATUS_OK) {
+      break;
+    }
+
+    bytes_sent += frame_len;
+    frames++;
+  }
+
+  if (SL_STATUS_OK == result) {
+    /* Wait for the last frame to be read. */
+    result = nt3h2111_stream_wait(NT3H2111_NS_REG_MASK_SRAM_RF_READY,
+                                  0,
+                                  timeout_ms);
+  }
+
+  nt3h2111_stream_stats_update(stats, start_tick, bytes_sent, frames);
+
+  end_result = nt3h2111_stream_end(nc_reg);
+  return (result != SL_STATUS_OK) ? result : end_result;
+}
+
+/***************************************************************************//**
+ *  Stream data from NFC to I2C through the SRAM.
+ ******************************************************************************/
+sl_status_t nt3h2111_stream_receive(uint8_t *data,
+                                    uint32_t len,
+                                    uint32_t timeout_ms,
+                                    nt3h2111_stream_stats_t *stats)
+{
+  sl_status_t result;
+  sl_status_t end_result;
+  uint8_t frame[NT3H2111_SRAM_SIZE];
+  uint32_t bytes_received = 0;
+  uint32_t frames = 0;
+  uint32_t start_tick;
+  uint8_t nc_reg;
+
+  if ((NULL == data) && (len > 0)) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  result = nt3h2111_stream_begin(TRANSFER_DIR_NFC_TO_I2C, timeout_ms, &nc_reg);
+  if (result != SL_STATUS_OK) {
+    return result;
+  }
+
+  start_tick = sl_sleeptimer_get_tick_count();
+
+  while (bytes_received < len) {
+    uint32_t frame_len = min(len - bytes_received, NT3H2111_SRAM_SIZE);
+
+    /* Wait for a frame written by the NFC reader. */
+    result = nt3h2111_stream_wait(NT3H2111_NS_REG_MASK_SRAM_I2C_READY,
+                                  NT3H2111_NS_REG_MASK_SRAM_I2C_READY,
+                                  timeout_ms);
     if (result != SL_STATUS_OK) {
       break;
     }
 
-    timeout--;
-  } while (timeout && (ns_reg & NT3H2111_NS_REG_MASK_EEPROM_WR_BUSY));
+    /* The whole SRAM is read to hand it back to the NFC interface. */
+    if (frame_len < NT3H2111_SRAM_SIZE) {
+      result = nt3h2111_read_sram(frame);
+      memcpy(&data[bytes_received], frame, frame_len);
+    } else {
+      result = nt3h2111_read_sram(&data[bytes_received]);
+    }
+    if (result != SL_STATUS_OK) {
+      break;
+    }
 
-  if (0 == timeout) {
-    return SL_STATUS_TIMEOUT;
+    bytes_received += frame_len;
+    frames++;
+  }
+
+  nt3h2111_stream_stats_update(stats, start_tick, bytes_received, frames);
+
+  end_result = nt3h2111_stream_end(nc_reg);
+  return (result != SL_STATUS_OK) ? result : end_result;
+}
+
+/***************************************************************************//**
+ *  Wait for the NFC field and switch to pass-through mode with the FD pin
+ *  signalling the SRAM hand-over.
+ ******************************************************************************/
+static sl_status_t nt3h2111_stream_begin(bool transfer_dir,
+                                         uint32_t timeout_ms,
+                                         uint8_t *nc_reg)
+{
+  sl_status_t result;
+
+  result = nt3h2111_get_session(SESSION_NC_REG, nc_reg);
+  if (result != SL_STATUS_OK) {
+    return result;
+  }
+
+  /* Pass-through mode can only be enabled while the field is present. The
+   * FD pin is not used here as its behavior depends on the application
+   * configuration. */
+  result = nt3h2111_stream_wait(NT3H2111_NS_REG_MASK_RF_FIELD_PRESENT,
+                                NT3H2111_NS_REG_MASK_RF_FIELD_PRESENT,
+                                timeout_ms);
+  if (result != SL_STATUS_OK) {
+    return result;
+  }
+
+  /* FD_OFF = FD_ON = 11b: FD is pulled low when the SRAM is available to the
+   * I2C interface and released once the I2C side has handed it over. */
+  result = nt3h2111_set_session(SESSION_NC_REG,
+                                NT3H2111_NC_REG_MASK_FD_OFF
+                                | NT3H2111_NC_REG_MASK_FD_ON,
+                                NT3H2111_NC_REG_MASK_FD_OFF
+                                | NT3H2111_NC_REG_MASK_FD_ON);
+  if (result != SL_STATUS_OK) {
+    // The write may still have reached the device
+    nt3h2111_stream_end(*nc_reg);
+    return result;
+  }
+
+#if defined(NT3H2111_FD_INT)
+  GPIO_ExtIntConfig(MIKROE_NT3H211_FD_PORT,
+                    MIKROE_NT3H211_FD_PIN,
+                    MIKROE_NT3H211_FD_PIN,
+                    false,
+                    true,
+                    true);
+#endif
+
+  result = nt3h2111_set_pass_through(true, transfer_dir);
+  if (result != SL_STATUS_OK) {
+    nt3h2111_stream_end(*nc_reg);
   }
 
   return result;
 }
 
+/***************************************************************************//**
+ *  Leave pass-through mode and restore the FD configuration.
+ ******************************************************************************/
+static sl_status_t nt3h2111_stream_end(uint8_t nc_reg)
+{
+  sl_status_t result;
+
+#if defined(NT3H2111_FD_INT)
+  GPIO_ExtIntConfig(MIKROE_NT3H211_FD_PORT,
+                    MIKROE_NT3H211_FD_PIN,
+                    MIKROE_NT3H211_FD_PIN,
+                    false,
+                    true,
+                    false);
+#endif
+
+  result = nt3h2111_set_pass_through(false, TRANSFER_DIR_I2C_TO_NFC);
+  if (result != SL_STATUS_OK) {
+    return result;
+  }
+
+  return nt3h2111_set_session(SESSION_NC_REG,
+                              NT3H2111_NC_REG_MASK_FD_OFF
+                              | NT3H2111_NC_REG_MASK_FD_ON,
+                              nc_reg);
+}
+
+/***************************************************************************//**
+ *  Wait until (NS_REG & ns_mask) == ns_value.
+ *
+ *  When waiting for the SRAM and the FD pin is available, the MCU sleeps until
+ *  FD is asserted and NS_REG is only read then. Otherwise NS_REG is polled
+ *  every NT3H2111_STREAM_POLL_INTERVAL_MS.
+ ******************************************************************************/
+static sl_status_t nt3h2111_stream_wait(uint8_t ns_mask,
+                                        uint8_t ns_value,
+                                        uint32_t timeout_ms)
+{
+  sl_status_t result;
+  uint32_t start_tick = sl_sleeptimer_get_tick_count();
+  uint32_t timeout_tick = sl_sleeptimer_ms_to_tick(timeout_ms);
+  uint32_t elapsed_tick;
+  uint32_t fd_event_count = nt3h2111_fd_event_count;
+  uint8_t ns_reg;
+  bool sram_wait = (ns_mask != NT3H2111_NS_REG_MASK_RF_FIELD_PRESENT);
+#if defined(NT3H2111_FD_INT)
+  bool check = true;
+#endif
+
+  while (true) {
+#if defined(NT3H2111_FD_INT)
+    if (sram_wait
+        && !check
+        && (fd_event_count == nt3h2111_fd_event_count)
+        && GPIO_PinInGet(MIKROE_NT3H211_FD_PORT, MIKROE_NT3H211_FD_PIN)) {
+      elapsed_tick = sl_sleeptimer_get_tick_count() - start_tick;
+      if (elapsed_tick >= timeout_tick) {
+        return SL_STATUS_TIMEOUT;
+      }
+      nt3h2111_stream_sleep(fd_event_count,
+                            sl_sleeptimer_tick_to_ms(timeout_tick
+                                                     - elapsed_tick) + 1);
+      continue;
+    }
+    check = false;
+#endif
+    fd_event_count = nt3h2111_fd_event_count;
+
+    result = nt3h2111_get_session(SESSION_NS_REG, &ns_reg);
+    if (result != SL_STATUS_OK) {
+      return result;
+    }
+
+    if ((ns_reg & ns_mask) == ns_value) {
+      return SL_STATUS_OK;
+    }
+
+    /* Pass-through mode is left by the device when the field is lost. */
+    if (sram_wait && !(ns_reg & NT3H2111_NS_REG_MASK_RF_FIELD_PRESENT)) {
+      return SL_STATUS_ABORT;
+    }
+
+    elapsed_tick = sl_sleeptimer_get_tick_count() - start_tick;
+    if (elapsed_tick >= timeout_tick) {
+      return SL_STATUS_TIMEOUT;
+    }
+
+    nt3h2111_stream_sleep(fd_event_count, NT3H2111_STREAM_POLL_INTERVAL_MS);
+  }
+}
+
+/***************************************************************************//**
+ *  Sleep in EM1 for sleep_ms or until the FD interrupt fires.
+ *
+ *  With the power manager, EM1 is requested and the power manager puts the
+ *  MCU to sleep. An FD interrupt between the check and the sleep is only
+ *  seen on the next wake-up, so the sleep is cut into poll intervals.
+ ******************************************************************************/
+static void nt3h2111_stream_sleep(uint32_t fd_event_count,
+                                  uint32_t sleep_ms)
+{
+  sl_sleeptimer_timer_handle_t timer;
+#if !defined(SL_CATALOG_POWER_MANAGER_PRESENT)
+  CORE_DECLARE_IRQ_STATE;
+#else
+  sleep_ms = min(sleep_ms, NT3H2111_STREAM_POLL_INTERVAL_MS);
+#endif
+
+  nt3h2111_stream_timer_expired = false;
+  if (sl_sleeptimer_start_timer_ms(&timer,
+                                   sleep_ms,
+                                   nt3h2111_stream_timer_callback,
+                                   NULL,
+                                   0,
+                                   0) != SL_STATUS_OK) {
+    return;
+  }
+
+#if defined(SL_CATALOG_POWER_MANAGER_PRESENT)
+  sl_power_manager_add_em_requirement(SL_POWER_MANAGER_EM1);
+  while (!nt3h2111_stream_timer_expired
+         && (fd_event_count == nt3h2111_fd_event_count)) {
+    sl_power_manager_sleep();
+  }
+  sl_power_manager_remove_em_requirement(SL_POWER_MANAGER_EM1);
+#else
+  while (true) {
+    // The interrupts are only served after the check, so none is missed
+    CORE_ENTER_ATOMIC();
+    if (nt3h2111_stream_timer_expired
+        || (fd_event_count != nt3h2111_fd_event_count)) {
+      CORE_EXIT_ATOMIC();
+      break;
+    }
+    EMU_EnterEM1();
+    CORE_EXIT_ATOMIC();
+  }
+#endif
+
+  sl_sleeptimer_stop_timer(&timer);
+}
+
+/***************************************************************************//**
+ *  Stream sleep timer callback.
+ ******************************************************************************/
+static void nt3h2111_stream_timer_callback(sl_sleeptimer_timer_handle_t *handle,
+                                           void *data)
+{
+  (void)handle;
+  (void)data;
+  nt3h2111_stream_timer_expired = true;
+}
+
+/***************************************************************************//**
+ *  Fill in the statistics of a stream transfer.
+ ******************************************************************************/
+static void nt3h2111_stream_stats_update(nt3h2111_stream_stats_t *stats,
+                                         uint32_t start_tick,
+                                         uint32_t bytes,
+                                         uint32_t frames)
+{
+  if (NULL == stats) {
+    return;
+  }
+
+  stats->bytes = bytes;
+  stats->frames = frames;
+  stats->elapsed_ms =
+    sl_sleeptimer_tick_to_ms(sl_sleeptimer_get_tick_count() - start_tick);
+  stats->bytes_per_sec = (stats->elapsed_ms > 0)
+                         ? (uint32_t)(((uint64_t)bytes * 1000)
+                                      / stats->elapsed_ms)
+                         : 0;
+}
+
+#if defined(NT3H2111_FD_INT)
+/***************************************************************************//**
+ *  FD pin interrupt callback.
+ ******************************************************************************/
+static void nt3h2111_fd_callback(uint8_t int_no)
+{
+  (void)int_no;
+  nt3h2111_fd_event_count++;
+}
+
+#endif
+
 /***************************************************************************//**
  * Read byte(s) from the selected device
  ******************************************************************************/
@@ -323,7 +879,7 @@ sl_status_t nt3h2111_read_bytes(uint8_t addr, uint8_t *bytes, uint16_t len)
   while (bytes_read < len) {
     uint8_t current_block = (addr + bytes_read) / NT3H2111_BLOCK_SIZE;
     uint8_t begin = (addr + bytes_read) % NT3H2111_BLOCK_SIZE;
-    uint8_t current_len =
+    uint16_t current_len =
       min((len - bytes_read), (NT3H2111_BLOCK_SIZE - begin));
 
     if (current_len < NT3H2111_BLOCK_SIZE) {
@@ -340,11 +896,16 @@ sl_status_t nt3h2111_read_bytes(uint8_t addr, uint8_t *bytes, uint16_t len)
         bytes[bytes_read + i] = rx_buff[begin + i];
       }
     } else {
-      /* Full block read */
-      result = nt3h2111_read_block(current_block, bytes + bytes_read);
+      /* All the fully covered blocks at once */
+      uint16_t block_count = (len - bytes_read) / NT3H2111_BLOCK_SIZE;
+
+      result = nt3h2111_read_blocks(current_block,
+                                    bytes + bytes_read,
+                                    block_count);
       if (result != SL_STATUS_OK) {
         break;
       }
+      current_len = block_count * NT3H2111_BLOCK_SIZE;
     }
 
     bytes_read += current_len;
@@ -370,7 +931,8 @@ sl_status_t nt3h2111_write_bytes(uint8_t addr,
   while (bytes_written < len) {
     uint8_t current_block = (addr + bytes_written) / NT3H2111_BLOCK_SIZE;
     uint8_t begin = (addr + bytes_written) % NT3H2111_BLOCK_SIZE;
-    uint8_t current_len = min(len - bytes_written, NT3H2111_BLOCK_SIZE - begin);
+    uint16_t current_len =
+      min(len - bytes_written, NT3H2111_BLOCK_SIZE - begin);
 
     if (current_len < NT3H2111_BLOCK_SIZE) {
       size_t i = 0;
@@ -401,12 +963,16 @@ sl_status_t nt3h2111_write_bytes(uint8_t addr,
         break;
       }
     } else {
-      /* Full block write */
-      result = nt3h2111_write_block(current_block,
-                                    (bytes + bytes_written));
+      /* All the fully covered blocks at once, without reading them first */
+      uint16_t block_count = (len - bytes_written) / NT3H2111_BLOCK_SIZE;
+
+      result = nt3h2111_write_blocks(current_block,
+                                     (bytes + bytes_written),
+                                     block_count);
       if (result != SL_STATUS_OK) {
         break;
       }
+      current_len = block_count * NT3H2111_BLOCK_SIZE;
     }
 
     bytes_written += current_len;
@@ -34,8 +34,13 @@
 *******************************************************************************/
 
 #include <string.h>
+#include "sl_component_catalog.h"
 #include "mikroe_nt3h2111_i2c.h"
 
+#if defined(SL_CATALOG_MIKROE_NFCTAG2_SIM_PRESENT)
+#include "mikroe_nt3h2111_sim.h"
+#endif
+
 /**************************************************************************//**
  * @brief
  *  Read data through I2C.
@@ -60,6 +65,11 @@ sl_status_t nt3h2111_i2c_read_bytes(sl_i2cspm_t *i2c_handle,
                                     uint32_t size,
                                     uint8_t *pdata)
 {
+#if defined(SL_CATALOG_MIKROE_NFCTAG2_SIM_PRESENT)
+  (void) i2c_handle;
+  (void) i2c_addr;
+  return nt3h2111_sim_i2c_read(size, pdata);
+#else
   I2C_TransferSeq_TypeDef    seq;
   I2C_TransferReturn_TypeDef result;
 
@@ -76,6 +86,7 @@ sl_status_t nt3h2111_i2c_read_bytes(sl_i2cspm_t *i2c_handle,
   }
 
   return SL_STATUS_OK;
+#endif
 }
 
 /**************************************************************************//**
@@ -102,6 +113,11 @@ sl_status_t nt3h2111_i2c_write_bytes(sl_i2cspm_t *i2c_handle,
                                      uint32_t size,
                                      uint8_t *pdata)
 {
+#if defined(SL_CATALOG_MIKROE_NFCTAG2_SIM_PRESENT)
+  (void) i2c_handle;
+  (void) i2c_addr;
+  return nt3h2111_sim_i2c_write(size, pdata);
+#else
   I2C_TransferSeq_TypeDef    seq;
   I2C_TransferReturn_TypeDef result;
 
@@ -118,4 +134,5 @@ sl_status_t nt3h2111_i2c_write_bytes(sl_i2cspm_t *i2c_handle,
   }
 
   return SL_STATUS_OK;
+#endif
 }
@@ -0,0 +1,250 @@
+/***************************************************************************//**
+* @file   mikroe_nt3h2111_sim.c
+* @brief  Simulated NT3H2111 tag and NDEF update benchmark.
+********************************************************************************
+* # License
+* <b>Copyright 2026 Silicon Laboratories Inc. www.silabs.com</b>
+********************************************************************************
+*
+* SPDX-License-Identifier: Zlib
+*
+* The licensor of this software is Silicon Laboratories Inc.
+*
+* This software is provided \'as-is\', without any express or implied
+* warranty. In no event will the authors be held liable for any damages
+* arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented; you must not
+*    claim that you wrote the original software. If you use this software
+*    in a product, an acknowledgment in the product documentation would be
+*    appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+*    misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*
+*******************************************************************************
+* # Evaluation Quality
+* This code has been minimally tested to ensure that it builds and is suitable
+* as a demonstration for evaluation purposes only. This code will be maintained
+* at the sole discretion of Silicon Labs.
+*******************************************************************************/
+
+#include <stdbool.h>
+#include <string.h>
+#include "sl_sleeptimer.h"
+#include "mikroe_nt3h2111.h"
+#include "mikroe_nt3h2111_sim.h"
+
+#define NT3H2111_SIM_MEM_BLOCK_COUNT  256
+
+static uint8_t sim_mem[NT3H2111_SIM_MEM_BLOCK_COUNT][NT3H2111_BLOCK_SIZE];
+static uint8_t sim_mema;
+static uint8_t sim_rega;
+static bool sim_reg_access;
+static bool sim_busy;
+static uint32_t sim_busy_start;
+static uint32_t sim_write_time_tick;
+static nt3h2111_sim_stats_t sim_stats;
+
+static bool nt3h2111_sim_is_busy(void);
+static bool nt3h2111_sim_is_register(uint8_t mema);
+
+/***************************************************************************//**
+ *  Reset the simulated tag.
+ ******************************************************************************/
+void nt3h2111_sim_init(uint32_t eeprom_write_time_ms)
+{
+  memset(sim_mem, 0, sizeof(sim_mem));
+  memset(&sim_stats, 0, sizeof(sim_stats));
+
+  /* Block 0 starts with the I2C address */
+  sim_mem[0][0] = MIKROE_NT3H211_ADDR;
+
+  sim_mema = 0;
+  sim_rega = 0;
+  sim_reg_access = false;
+  sim_busy = false;
+  sim_write_time_tick = sl_sleeptimer_ms_to_tick(eeprom_write_time_ms);
+}
+
+/***************************************************************************//**
+ *  Get the counters of the simulated tag.
+ ******************************************************************************/
+void nt3h2111_sim_get_stats(nt3h2111_sim_stats_t *stats)
+{
+  if (stats != NULL) {
+    *stats = sim_stats;
+  }
+}
+
+/***************************************************************************//**
+ *  Handle an I2C write transfer to the simulated tag.
+ ******************************************************************************/
+sl_status_t nt3h2111_sim_i2c_write(uint32_t size, const uint8_t *pdata)
+{
+  uint8_t mema;
+
+  if ((pdata == NULL) || (size == 0)) {
+    return SL_STATUS_TRANSMIT;
+  }
+
+  sim_stats.i2c_transfers++;
+  mema = pdata[0];
+
+  if (nt3h2111_sim_is_register(mema) && ((size == 2) || (size == 4))) {
+    /* Register address, followed by mask and data on a write */
+    if (pdata[1] >= NT3H2111_BLOCK_SIZE) {
+      return SL_STATUS_TRANSMIT;
+    }
+    sim_mema = mema;
+    sim_rega = pdata[1];
+    sim_reg_access = true;
+    if (size == 4) {
+      sim_mem[mema][sim_rega] = (sim_mem[mema][sim_rega] & ~pdata[2])
+                                | (pdata[3] & pdata[2]);
+    }
+    return SL_STATUS_OK;
+  }
+
+  if ((size != 1) && (size != NT3H2111_BLOCK_SIZE + 1)) {
+    return SL_STATUS_TRANSMIT;
+  }
+
+  /* The memory is not accessible while the EEPROM is written */
+  if (nt3h2111_sim_is_busy()) {
+    sim_stats.nak_count++;
+    return SL_STATUS_TRANSMIT;
+  }
+
+  sim_mema = mema;
+  sim_reg_access = false;
+  if (size == 1) {
+    return SL_STATUS_OK;
+  }
+
+  memcpy(sim_mem[mema], &pdata[1], NT3H2111_BLOCK_SIZE);
+
+  /* The SRAM is written at once, the EEPROM keeps the tag busy */
+  if ((mema < NT3H2111_MEM_BLOCK_START_SRAM)
+      || (mema >= NT3H2111_MEM_BLOCK_START_SRAM + NT3H2111_MEM_SRAM_BLOCKS)) {
+    sim_stats.eeprom_writes++;
+    sim_busy = true;
+    sim_busy_start = sl_sleeptimer_get_tick_count();
+  }
+
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ *  Handle an I2C read transfer from the simulated tag.
+ ******************************************************************************/
+sl_status_t nt3h2111_sim_i2c_read(uint32_t size, uint8_t *pdata)
+{
+  if (pdata == NULL) {
+    return SL_STATUS_TRANSMIT;
+  }
+
+  sim_stats.i2c_transfers++;
+
+  if (sim_reg_access) {
+    if (size != 1) {
+      return SL_STATUS_TRANSMIT;
+    }
+    *pdata = sim_mem[sim_mema][sim_rega];
+    if ((sim_mema == NT3H2111_SESSION_REG_ADDR)
+        && (sim_rega == SESSION_NS_REG)) {
+      if (nt3h2111_sim_is_busy()) {
+        sim_stats.busy_polls++;
+        *pdata |= NT3H2111_NS_REG_MASK_EEPROM_WR_BUSY;
+      } else {
+        *pdata &= ~NT3H2111_NS_REG_MASK_EEPROM_WR_BUSY;
+      }
+    }
+    return SL_STATUS_OK;
+  }
+
+  if (size != NT3H2111_BLOCK_SIZE) {
+    return SL_STATUS_TRANSMIT;
+  }
+
+  if (nt3h2111_sim_is_busy()) {
+    sim_stats.nak_count++;
+    return SL_STATUS_TRANSMIT;
+  }
+
+  memcpy(pdata, sim_mem[sim_mema], NT3H2111_BLOCK_SIZE);
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ *  Measure the NDEF update throughput against the simulated tag.
+ ******************************************************************************/
+sl_status_t nt3h2111_benchmark_ndef_update(uint8_t addr,
+                                           uint16_t len,
+                                           uint16_t iterations,
+                                           uint32_t eeprom_write_time_ms,
+                                           nt3h2111_benchmark_result_t *result)
+{
+  uint8_t pattern[NT3H2111_SIM_MEM_BLOCK_COUNT];
+  sl_status_t status = SL_STATUS_OK;
+  uint32_t start_tick;
+  uint32_t elapsed_tick;
+  uint16_t i, j;
+
+  if ((result == NULL) || (len == 0)
+      || (addr < NT3H2111_BLOCK_SIZE) || ((uint16_t) addr + len > 0xFF)) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  memset(result, 0, sizeof(*result));
+  nt3h2111_sim_init(eeprom_write_time_ms);
+
+  start_tick = sl_sleeptimer_get_tick_count();
+  for (i = 0; i < iterations; i++) {
+    /* A different content on every update, like a changing NDEF record */
+    for (j = 0; j < len; j++) {
+      pattern[j] = (uint8_t)(i + j);
+    }
+    status = nt3h2111_write_bytes(addr, pattern, len);
+    if (status != SL_STATUS_OK) {
+      break;
+    }
+    result->bytes += len;
+  }
+  elapsed_tick = sl_sleeptimer_get_tick_count() - start_tick;
+
+  result->time_ms = sl_sleeptimer_tick_to_ms(elapsed_tick);
+  if (result->time_ms != 0) {
+    result->bytes_per_sec = (uint32_t)((uint64_t) result->bytes * 1000
+                                       / result->time_ms);
+  }
+  nt3h2111_sim_get_stats(&result->sim);
+
+  return status;
+}
+
+/***************************************************************************//**
+ *  Check if an EEPROM write is still running.
+ ******************************************************************************/
+static bool nt3h2111_sim_is_busy(void)
+{
+  if (sim_busy
+      && ((sl_sleeptimer_get_tick_count() - sim_busy_start)
+          >= sim_write_time_tick)) {
+    sim_busy = false;
+  }
+  return sim_busy;
+}
+
+/***************************************************************************//**
+ *  Check if a memory address selects the configuration or session registers.
+ ******************************************************************************/
+static bool nt3h2111_sim_is_register(uint8_t mema)
+{
+  return (mema == NT3H2111_CONFIG_REG_ADDR)
+         || (mema == NT3H2111_SESSION_REG_ADDR);
+}
@@ -38,6 +38,9 @@
  ******************************************************************************/
 #ifndef FFCONF_H_
 #define FFCONF_H_
+
+#include "sl_component_catalog.h"
+
 /*---------------------------------------------------------------------------/
 /  Configurations of FatFs Module
 /---------------------------------------------------------------------------*/
@@ -389,6 +392,23 @@
 // </h>
 // <<< end of configuration section >>>
 
+// The data logging file helper relies on fast seek and f_expand()
+#if defined(SL_CATALOG_FATFS_LOG_FILE_PRESENT)
+#undef FF_USE_FASTSEEK
+#define FF_USE_FASTSEEK 1
+#undef FF_USE_EXPAND
+#define FF_USE_EXPAND 1
+#endif
+
+// Each physical drive is mounted as the volume of the same number
+#if defined(SL_CATALOG_FATFS_STORAGE_DEVICE_RAM_DISK_PRESENT)
+#include "sl_sdc_ram_disk_config.h"
+#if (FF_VOLUMES <= SL_SDC_RAM_DISK_PDRV) && !FF_MULTI_PARTITION
+#undef FF_VOLUMES
+#define FF_VOLUMES (SL_SDC_RAM_DISK_PDRV + 1)
+#endif
+#endif
+
 #ifdef __cplusplus
 }
 #endif
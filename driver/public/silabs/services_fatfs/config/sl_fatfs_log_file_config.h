@@ -0,0 +1,57 @@
+/***************************************************************************//**
+ * @file sl_fatfs_log_file_config.h
+ * @brief FatFs data logging file configuration
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ ********************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided \'as-is\', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+#ifndef SL_FATFS_LOG_FILE_CONFIG_H
+#define SL_FATFS_LOG_FILE_CONFIG_H
+
+// <<< Use Configuration Wizard in Context Menu >>>
+// <h> Data logging file
+
+// <o SL_FATFS_LOG_FILE_CHUNK_SIZE> Write chunk size in bytes <512-32768>
+// <i> Appended data is staged and written in chunks aligned to this size so
+// <i> FatFs transfers whole sectors straight to the media. Must be a
+// <i> multiple of FF_MAX_SS.
+// <i> Default: 2048
+#define SL_FATFS_LOG_FILE_CHUNK_SIZE      2048
+
+// <o SL_FATFS_LOG_FILE_CLMT_SIZE> Cluster link map table size in items <4-256>
+// <i> Each contiguous fragment of the file takes two items, plus two items
+// <i> of overhead. A file kept in a single contiguous extent needs 4.
+// <i> Default: 32
+#define SL_FATFS_LOG_FILE_CLMT_SIZE       32
+
+// </h>
+// <<< end of configuration section >>>
+
+#endif // SL_FATFS_LOG_FILE_CONFIG_H
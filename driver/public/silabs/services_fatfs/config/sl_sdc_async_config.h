@@ -0,0 +1,58 @@
+/***************************************************************************//**
+ * @file sl_sdc_async_config.h
+ * @brief Storage Device Controls asynchronous media access configuration
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ ********************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided \'as-is\', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+#ifndef SL_SDC_ASYNC_CONFIG_H
+#define SL_SDC_ASYNC_CONFIG_H
+
+// <<< Use Configuration Wizard in Context Menu >>>
+// <e SL_SDC_ASYNC_ENABLE> Asynchronous media access
+// <i> Media requests are queued and started only once the card has finished
+// <i> programming, instead of busy-waiting in the card driver. FatFs keeps
+// <i> using the blocking disk functions through a synchronous shim.
+// <i> Default: 0
+#define SL_SDC_ASYNC_ENABLE               0
+
+// <o SL_SDC_ASYNC_MAX_MERGE> Maximum sectors per merged request <1-64>
+// <i> Queued requests to adjacent sectors are merged into a single multiple
+// <i> block transfer of up to this many sectors.
+// <i> Default: 16
+#define SL_SDC_ASYNC_MAX_MERGE            16
+
+// <o SL_SDC_ASYNC_BUSY_TIMEOUT_MS> Card busy timeout in milliseconds
+// <i> Default: 500
+#define SL_SDC_ASYNC_BUSY_TIMEOUT_MS      500
+// </e>
+// <<< end of configuration section >>>
+
+#endif // SL_SDC_ASYNC_CONFIG_H
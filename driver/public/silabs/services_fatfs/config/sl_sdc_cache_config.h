@@ -0,0 +1,83 @@
+/***************************************************************************//**
+ * @file sl_sdc_cache_config.h
+ * @brief Storage Device Controls sector cache configuration
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ ********************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided \'as-is\', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+#ifndef SL_SDC_CACHE_CONFIG_H
+#define SL_SDC_CACHE_CONFIG_H
+
+// <<< Use Configuration Wizard in Context Menu >>>
+// <e SL_SDC_CACHE_ENABLE> Sector cache between FatFs and the storage device
+// <i> Keeps recently used sectors in RAM so FAT-chain walks and directory
+// <i> lookups do not go to the card every time.
+// <i> Default: 0
+#define SL_SDC_CACHE_ENABLE               0
+
+// <o SL_SDC_CACHE_SECTOR_COUNT> Number of cached sectors <2-64>
+// <i> Each entry occupies FF_MAX_SS bytes of RAM.
+// <i> Default: 8
+#define SL_SDC_CACHE_SECTOR_COUNT         8
+
+// <q SL_SDC_CACHE_WRITE_BACK> Write-back mode
+// <i> 1: single sector writes are held in the cache and written back on
+// <i>    eviction or CTRL_SYNC as multiple block runs.
+// <i> 0: write-through, the media is always written immediately.
+// <i> Default: 1
+#define SL_SDC_CACHE_WRITE_BACK           1
+
+// <o SL_SDC_CACHE_MAX_WRITE_RUN> Maximum sectors per write-back run <1-64>
+// <i> Default: 8
+#define SL_SDC_CACHE_MAX_WRITE_RUN        8
+
+// <q SL_SDC_CACHE_PIN_METADATA> Pin FAT and directory sectors
+// <i> FAT and root directory regions are detected from the boot sector when
+// <i> a volume is mounted. Sectors in these regions are evicted only when no
+// <i> other entry can be reused.
+// <i> Default: 1
+#define SL_SDC_CACHE_PIN_METADATA         1
+
+// <o SL_SDC_CACHE_MAX_PINNED> Maximum pinned sectors <0-64>
+// <i> Must be lower than SL_SDC_CACHE_SECTOR_COUNT to leave room for data.
+// <i> Default: 4
+#define SL_SDC_CACHE_MAX_PINNED           4
+
+// <o SL_SDC_CACHE_PIN_REGION_COUNT> Number of pinned sector regions <1-16>
+// <i> Default: 4
+#define SL_SDC_CACHE_PIN_REGION_COUNT     4
+
+// <q SL_SDC_CACHE_STATISTICS> Collect hit/miss statistics
+// <i> Default: 1
+#define SL_SDC_CACHE_STATISTICS           1
+// </e>
+// <<< end of configuration section >>>
+
+#endif // SL_SDC_CACHE_CONFIG_H
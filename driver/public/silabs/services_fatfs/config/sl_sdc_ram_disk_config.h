@@ -0,0 +1,91 @@
+/***************************************************************************//**
+ * @file sl_sdc_ram_disk_config.h
+ * @brief Storage Device Controls RAM disk configuration
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ ********************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided \'as-is\', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+#ifndef SL_SDC_RAM_DISK_CONFIG_H
+#define SL_SDC_RAM_DISK_CONFIG_H
+
+// <<< Use Configuration Wizard in Context Menu >>>
+// <h> RAM disk
+
+// <o SL_SDC_RAM_DISK_PDRV> Physical drive number <0-9>
+// <i> Must not be used by another storage device of the project, drive 0 is
+// <i> the SD card and drive 1 the flash storage. FF_VOLUMES is raised to
+// <i> cover this drive.
+// <i> Default: 2
+#define SL_SDC_RAM_DISK_PDRV                  2
+
+// <o SL_SDC_RAM_DISK_SECTOR_COUNT> Number of sectors in the built-in image <0-65536>
+// <i> Each sector occupies FF_MAX_SS bytes of RAM. FatFs needs at least 128
+// <i> sectors to create a volume. Set to 0 to use only an image attached
+// <i> with sl_sdc_ram_disk_attach().
+// <i> Default: 128
+#define SL_SDC_RAM_DISK_SECTOR_COUNT          128
+
+// <o SL_SDC_RAM_DISK_BLOCK_SIZE> Erase block size in sectors <1-32768>
+// <i> Reported by GET_BLOCK_SIZE and used by f_mkfs() for data alignment.
+// <i> Default: 1
+#define SL_SDC_RAM_DISK_BLOCK_SIZE            1
+// </h>
+
+// <h> Latency model
+// <i> Every command advances a simulated clock which is reported in the
+// <i> statistics. Latencies can be changed at run time with
+// <i> sl_sdc_ram_disk_set_latency().
+
+// <o SL_SDC_RAM_DISK_COMMAND_US> Command overhead [us]
+// <i> Default: 0
+#define SL_SDC_RAM_DISK_COMMAND_US            0
+
+// <o SL_SDC_RAM_DISK_READ_BLOCK_US> Transfer time of a read sector [us]
+// <i> Default: 0
+#define SL_SDC_RAM_DISK_READ_BLOCK_US         0
+
+// <o SL_SDC_RAM_DISK_WRITE_BLOCK_US> Transfer time of a written sector [us]
+// <i> Default: 0
+#define SL_SDC_RAM_DISK_WRITE_BLOCK_US        0
+
+// <o SL_SDC_RAM_DISK_PROGRAM_BUSY_US> Program busy time after a written sector [us]
+// <i> The disk is busy for this time after each written sector. The next
+// <i> command waits for it, MMC_GET_READY reports it.
+// <i> Default: 0
+#define SL_SDC_RAM_DISK_PROGRAM_BUSY_US       0
+
+// <o SL_SDC_RAM_DISK_POLL_US> Busy poll time [us]
+// <i> Time consumed by one MMC_GET_READY request.
+// <i> Default: 10
+#define SL_SDC_RAM_DISK_POLL_US               10
+// </h>
+// <<< end of configuration section >>>
+
+#endif // SL_SDC_RAM_DISK_CONFIG_H
@@ -64,6 +64,7 @@
 #define MMC_GET_CID       12  // Get CID
 #define MMC_GET_OCR       13  // Get OCR
 #define MMC_GET_SDSTAT    14  // Get SD status
+#define MMC_GET_READY     15  // Check if the card is ready without waiting
 #define ISDIO_READ        55  // Read data form SD iSDIO register
 #define ISDIO_WRITE       56  // Write data to SD iSDIO register
 #define ISDIO_MRITE       57  // Masked write data to SD iSDIO register
@@ -0,0 +1,114 @@
+/***************************************************************************//**
+ * @file sl_fatfs_benchmark.h
+ * @brief FatFs throughput benchmark on the RAM disk
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ ********************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided \'as-is\', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+#ifndef SL_FATFS_BENCHMARK_H
+#define SL_FATFS_BENCHMARK_H
+
+#include "ff.h"
+#include "sl_sdc_ram_disk.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Benchmark phases, run in this order
+typedef enum {
+  SL_FATFS_BENCHMARK_SEQ_WRITE = 0,  ///< Create the file sequentially
+  SL_FATFS_BENCHMARK_SEQ_READ,       ///< Read the file sequentially
+  SL_FATFS_BENCHMARK_RANDOM_READ,    ///< Read io_size blocks at random offsets
+  SL_FATFS_BENCHMARK_RANDOM_WRITE,   ///< Overwrite io_size blocks at random
+                                     ///<   offsets
+  SL_FATFS_BENCHMARK_PHASE_COUNT
+} sl_fatfs_benchmark_phase_t;
+
+/// Benchmark parameters
+typedef struct {
+  const TCHAR *path;      ///< Test file, created on the mounted RAM disk volume
+  uint32_t file_size;     ///< Size of the test file in bytes
+  uint32_t io_size;       ///< Bytes per f_read()/f_write() call
+  uint32_t random_ops;    ///< Calls of each random phase
+  uint32_t seed;          ///< Seed of the random offsets
+#if FF_USE_MKFS
+  uint32_t cluster_size;  ///< Cluster size for f_mkfs() in bytes, 0 keeps the
+                          ///<   current volume. Only with FF_USE_MKFS.
+#endif
+} sl_fatfs_benchmark_config_t;
+
+/// Result of one benchmark phase
+typedef struct {
+  uint32_t bytes;           ///< Payload bytes transferred
+  uint32_t fatfs_calls;     ///< FatFs API calls, including f_lseek and f_sync
+  uint32_t media_commands;  ///< Read and write commands seen by the disk
+  uint32_t media_sectors;   ///< Sectors read and written by the disk
+  uint64_t time_us;         ///< Simulated time of the disk
+  uint32_t throughput_kbps; ///< Payload throughput in KiB/s
+  uint32_t iops;            ///< f_read()/f_write() calls per second
+  uint32_t sectors_per_call_x100; ///< media_sectors per FatFs call, times 100
+} sl_fatfs_benchmark_result_t;
+
+/***************************************************************************//**
+ * @brief
+ *   Run the benchmark on the RAM disk.
+ *
+ * @details
+ *   Throughput and IOPS are based on the simulated clock of the RAM disk, so
+ *   they reflect its latency model and not the speed of the host. The
+ *   FatFs options of the build (FF_FS_TINY, FF_USE_FASTSEEK, ...) and the
+ *   sector cache configuration are what is measured; run the benchmark
+ *   once per build to compare them. With FF_USE_MKFS the volume can be
+ *   formatted with another cluster size at run time, otherwise the volume
+ *   already on the RAM disk is used. The volume is unmounted when the
+ *   benchmark returns.
+ *
+ * @param[in] config
+ *   Benchmark parameters
+ *
+ * @param[in] buff
+ *   Work buffer of config->io_size bytes, at least FF_MAX_SS bytes when
+ *   config->cluster_size is set (FF_USE_MKFS only)
+ *
+ * @param[out] results
+ *   Array of SL_FATFS_BENCHMARK_PHASE_COUNT results
+ *
+ * @return FatFs result of the first failed call, or FR_OK
+ ******************************************************************************/
+FRESULT sl_fatfs_benchmark_run(const sl_fatfs_benchmark_config_t *config,
+                               BYTE *buff,
+                               sl_fatfs_benchmark_result_t *results);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SL_FATFS_BENCHMARK_H
@@ -0,0 +1,193 @@
+/***************************************************************************//**
+ * @file sl_fatfs_log_file.h
+ * @brief FatFs data logging file
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ ********************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided \'as-is\', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+#ifndef SL_FATFS_LOG_FILE_H
+#define SL_FATFS_LOG_FILE_H
+
+#include "ff.h"
+#include "sl_fatfs_log_file_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************************************************************//**
+ * @addtogroup fatfs_log_file FatFs data logging file
+ * @brief
+ *   Append-only file helper for long running data loggers.
+ *
+ * @details
+ *   The file is pre-allocated in contiguous extents with f_expand() and
+ *   accessed in fast seek mode, so neither appending nor seeking walks the
+ *   FAT chain, except once per extent when the file grows. Appended data is written in chunks aligned to
+ *   SL_FATFS_LOG_FILE_CHUNK_SIZE, which FatFs passes to the media as multiple
+ *   sector transfers.
+ *
+ *   The file starts with a header of FF_MAX_SS bytes that records the size
+ *   of the logged data, updated by sl_fatfs_log_file_sync() and
+ *   sl_fatfs_log_file_close(). The file keeps its pre-allocated size until
+ *   it is closed, when it is truncated to the logged data. After an unclean
+ *   shutdown, sl_fatfs_log_file_open() truncates the file to the size in the
+ *   header, dropping the data appended after the last sync and the unused
+ *   pre-allocated space. Readers of the file on other systems must skip the
+ *   header.
+ *
+ *   FF_USE_FASTSEEK and FF_USE_EXPAND are enabled in ffconf.h when this
+ *   component is installed.
+ * @{
+ ******************************************************************************/
+
+/// Data logging file object
+typedef struct {
+  FIL fil;                                  ///< FatFs file object
+  FSIZE_t data_size;                        ///< Bytes of logged data
+  FSIZE_t extent_size;                      ///< Allocation unit of the file
+  DWORD clmt[SL_FATFS_LOG_FILE_CLMT_SIZE];  ///< Cluster link map table
+  UINT chunk_len;                           ///< Bytes staged in chunk
+  BYTE chunk[SL_FATFS_LOG_FILE_CHUNK_SIZE]; ///< Staging for aligned writes
+} sl_fatfs_log_file_t;
+
+/***************************************************************************//**
+ * @brief
+ *   Open or create a data logging file.
+ *
+ * @details
+ *   A new or empty file is pre-allocated with one contiguous extent. An
+ *   existing file is truncated to the logged data recorded in its header and
+ *   opened for appending after it.
+ *
+ * @param[out] log
+ *   Pointer to the data logging file object
+ *
+ * @param[in] path
+ *   Pointer to the file name
+ *
+ * @param[in] extent_size
+ *   Bytes allocated each time the file runs out of space. Larger extents
+ *   keep the file in fewer fragments.
+ *
+ * @return FatFs function common result code, FR_INVALID_OBJECT if the file
+ *   is not a data logging file
+ ******************************************************************************/
+FRESULT sl_fatfs_log_file_open(sl_fatfs_log_file_t *log,
+                               const TCHAR *path,
+                               FSIZE_t extent_size);
+
+/***************************************************************************//**
+ * @brief
+ *   Append data to the end of the file.
+ *
+ * @param[in] log
+ *   Pointer to the data logging file object
+ *
+ * @param[in] data
+ *   Pointer to the data to be appended
+ *
+ * @param[in] len
+ *   Number of bytes to append
+ *
+ * @return FatFs function common result code, FR_DENIED if the volume is full
+ ******************************************************************************/
+FRESULT sl_fatfs_log_file_append(sl_fatfs_log_file_t *log,
+                                 const void *data,
+                                 UINT len);
+
+/***************************************************************************//**
+ * @brief
+ *   Read logged data from an offset.
+ *
+ * @param[in] log
+ *   Pointer to the data logging file object
+ *
+ * @param[in] ofs
+ *   Offset in the logged data
+ *
+ * @param[out] buff
+ *   Pointer to the data buffer
+ *
+ * @param[in] len
+ *   Number of bytes to read
+ *
+ * @param[out] br
+ *   Number of bytes read, less than len at the end of the logged data
+ *
+ * @return FatFs function common result code
+ ******************************************************************************/
+FRESULT sl_fatfs_log_file_read(sl_fatfs_log_file_t *log,
+                               FSIZE_t ofs,
+                               void *buff,
+                               UINT len,
+                               UINT *br);
+
+/***************************************************************************//**
+ * @brief
+ *   Write staged data and flush the cached information of the file.
+ *
+ * @param[in] log
+ *   Pointer to the data logging file object
+ *
+ * @return FatFs function common result code
+ ******************************************************************************/
+FRESULT sl_fatfs_log_file_sync(sl_fatfs_log_file_t *log);
+
+/***************************************************************************//**
+ * @brief
+ *   Write staged data, release the unused pre-allocated space and close the
+ *   file.
+ *
+ * @param[in] log
+ *   Pointer to the data logging file object
+ *
+ * @return FatFs function common result code
+ ******************************************************************************/
+FRESULT sl_fatfs_log_file_close(sl_fatfs_log_file_t *log);
+
+/***************************************************************************//**
+ * @brief
+ *   Get the number of logged bytes, including staged data.
+ *
+ * @param[in] log
+ *   Pointer to the data logging file object
+ *
+ * @return Size of the logged data
+ ******************************************************************************/
+FSIZE_t sl_fatfs_log_file_size(const sl_fatfs_log_file_t *log);
+
+/** @} (end addtogroup fatfs_log_file) */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SL_FATFS_LOG_FILE_H
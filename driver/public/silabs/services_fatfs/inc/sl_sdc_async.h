@@ -0,0 +1,244 @@
+/***************************************************************************//**
+ * @file sl_sdc_async.h
+ * @brief Storage Device Controls asynchronous media access
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ ********************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided \'as-is\', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+#ifndef SL_SDC_ASYNC_H
+#define SL_SDC_ASYNC_H
+
+#include <stdbool.h>
+#include "ff.h"
+#include "diskio.h"
+#include "sl_sdc_async_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************************************************************//**
+ * @addtogroup sdc_async Asynchronous media access
+ * @brief
+ *   Queued, non-blocking access to the storage device.
+ *
+ * @details
+ *   Requests are owned by the caller and stay in the queue until their
+ *   completion callback has been called. sl_sdc_async_process() advances the
+ *   queue: while the card is busy programming it returns immediately, so the
+ *   application can do other work instead of spinning in the card driver.
+ *   Queued requests of the same kind to adjacent sectors are merged into a
+ *   single multiple block transfer.
+ *
+ *   The data transfer of a started request is still done by the blocking SPI
+ *   driver, only the card busy time is given back to the application.
+ *
+ *   All functions must be called from the same thread, not from interrupts.
+ * @{
+ ******************************************************************************/
+
+/// Request operation
+typedef enum {
+  SL_SDC_ASYNC_READ = 0,  ///< Read sectors into buff
+  SL_SDC_ASYNC_WRITE,     ///< Write sectors from buff
+  SL_SDC_ASYNC_SYNC       ///< Complete once all previous writes are programmed
+} sl_sdc_async_op_t;
+
+typedef struct sl_sdc_async_request sl_sdc_async_request_t;
+
+/// Request completion callback
+typedef void (*sl_sdc_async_callback_t)(sl_sdc_async_request_t *req);
+
+/// Card busy state callback, called when the card enters or leaves busy state
+typedef void (*sl_sdc_async_busy_callback_t)(BYTE pdrv, bool busy);
+
+/// Media request
+struct sl_sdc_async_request {
+  sl_sdc_async_op_t op;             ///< Operation
+  BYTE pdrv;                        ///< Physical drive number
+  BYTE *buff;                       ///< Sector data, count * FF_MAX_SS bytes
+  BYTE *const *buffs;               ///< Per sector buffers, used if buff is NULL
+  LBA_t sector;                     ///< Start sector in LBA
+  UINT count;                       ///< Number of sectors
+  sl_sdc_async_callback_t callback; ///< Completion callback, may be NULL
+  void *context;                    ///< User context
+  volatile dresult_t result;        ///< Result, valid once done is set
+  volatile bool done;               ///< Set when the request is completed
+  sl_sdc_async_request_t *next;     ///< Internal: next queued request
+  sl_sdc_async_request_t *merged;   ///< Internal: next request of the run
+};
+
+/***************************************************************************//**
+ * @brief
+ *   Queue a request.
+ *
+ * @details
+ *   op, pdrv, buff or buffs, sector, count, callback and context must be
+ *   filled in. The request and its buffers must stay valid until it is
+ *   completed.
+ *
+ * @param[in] req
+ *   Pointer to the request
+ *
+ * @return Status of Disk Functions, RES_PARERR if the request is invalid
+ ******************************************************************************/
+dresult_t sl_sdc_async_submit(sl_sdc_async_request_t *req);
+
+/***************************************************************************//**
+ * @brief
+ *   Advance the request queue.
+ *
+ * @details
+ *   Starts the next queued request if the card is ready. Completion callbacks
+ *   are called from this function.
+ *
+ * @return true if requests are still pending
+ ******************************************************************************/
+bool sl_sdc_async_process(void);
+
+/***************************************************************************//**
+ * @brief
+ *   Check if requests are pending.
+ *
+ * @return true if the queue is not empty
+ ******************************************************************************/
+bool sl_sdc_async_busy(void);
+
+/***************************************************************************//**
+ * @brief
+ *   Register a callback for card busy state changes.
+ *
+ * @param[in] callback
+ *   Callback function, NULL to disable
+ ******************************************************************************/
+void sl_sdc_async_set_busy_callback(sl_sdc_async_busy_callback_t callback);
+
+/***************************************************************************//**
+ * @brief
+ *   Called repeatedly while a blocking request waits for the card.
+ *
+ * @details
+ *   Weak default does nothing. Override it to run other work or to yield to
+ *   other tasks while FatFs waits for the card. It must not call FatFs or
+ *   the blocking functions of this module.
+ ******************************************************************************/
+void sl_sdc_async_wait_hook(void);
+
+/***************************************************************************//**
+ * @brief
+ *   Blocking read through the request queue.
+ *
+ * @param[in] pdrv
+ *   Physical drive number to identify the drive
+ *
+ * @param[out] buff
+ *   Pointer to the Data buffer to store read data
+ *
+ * @param[in] sector
+ *   Start sector in LBA
+ *
+ * @param[in] count
+ *   Number of sectors to read
+ *
+ * @return Status of Disk Functions
+ ******************************************************************************/
+dresult_t sl_sdc_async_read(BYTE pdrv, BYTE *buff, LBA_t sector, UINT count);
+
+/***************************************************************************//**
+ * @brief
+ *   Blocking write through the request queue.
+ *
+ * @param[in] pdrv
+ *   Physical drive number to identify the drive
+ *
+ * @param[in] buff
+ *   Pointer to the Data buffer to be written
+ *
+ * @param[in] sector
+ *   Start sector in LBA
+ *
+ * @param[in] count
+ *   Number of sectors to write
+ *
+ * @return Status of Disk Functions
+ ******************************************************************************/
+dresult_t sl_sdc_async_write(BYTE pdrv,
+                             const BYTE *buff,
+                             LBA_t sector,
+                             UINT count);
+
+/***************************************************************************//**
+ * @brief
+ *   Blocking write of consecutive sectors held in separate buffers through
+ *   the request queue.
+ *
+ * @param[in] pdrv
+ *   Physical drive number to identify the drive
+ *
+ * @param[in] buffs
+ *   Array of count pointers, one sector buffer per sector
+ *
+ * @param[in] sector
+ *   Start sector in LBA
+ *
+ * @param[in] count
+ *   Number of sectors to write
+ *
+ * @return Status of Disk Functions
+ ******************************************************************************/
+dresult_t sl_sdc_async_write_vector(BYTE pdrv,
+                                    const BYTE *const *buffs,
+                                    LBA_t sector,
+                                    UINT count);
+
+/***************************************************************************//**
+ * @brief
+ *   Blocking device control, issued once the queue has drained.
+ *
+ * @param[in] pdrv
+ *   Physical drive number to identify the drive
+ *
+ * @param[in] cmd
+ *   Control code
+ *
+ * @param[in] buff
+ *   Buffer to send/receive control data
+ *
+ * @return Status of Disk Functions
+ ******************************************************************************/
+dresult_t sl_sdc_async_ioctl(BYTE pdrv, BYTE cmd, void *buff);
+
+/** @} (end addtogroup sdc_async) */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SL_SDC_ASYNC_H
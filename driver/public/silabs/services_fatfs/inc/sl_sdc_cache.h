@@ -0,0 +1,184 @@
+/***************************************************************************//**
+ * @file sl_sdc_cache.h
+ * @brief Storage Device Controls sector cache
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ ********************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided \'as-is\', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+#ifndef SL_SDC_CACHE_H
+#define SL_SDC_CACHE_H
+
+#include "ff.h"
+#include "diskio.h"
+#include "sl_sdc_cache_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Sector cache statistics
+typedef struct {
+  uint32_t read_hits;         ///< Single sector reads served from the cache
+  uint32_t read_misses;       ///< Single sector reads loaded from the media
+  uint32_t write_hits;        ///< Single sector writes to a cached sector
+  uint32_t write_misses;      ///< Single sector writes to an uncached sector
+  uint32_t bypass_sectors;    ///< Sectors of multiple sector transfers
+  uint32_t evictions;         ///< Valid entries replaced
+  uint32_t writeback_runs;    ///< Media writes issued by write-back
+  uint32_t writeback_sectors; ///< Sectors written by write-back
+} sl_sdc_cache_stats_t;
+
+/***************************************************************************//**
+ * @brief
+ *   Read Sector(s) through the cache.
+ *
+ * @param[in] pdrv
+ *   Physical drive number to identify the drive
+ *
+ * @param[out] buff
+ *   Pointer to the Data buffer to store read data
+ *
+ * @param[in] sector
+ *   Start sector in LBA
+ *
+ * @param[in] count
+ *   Number of sectors to read
+ *
+ * @return Status of Disk Functions
+ ******************************************************************************/
+dresult_t sl_sdc_cache_read(BYTE pdrv, BYTE *buff, LBA_t sector, UINT count);
+
+/***************************************************************************//**
+ * @brief
+ *   Write Sector(s) through the cache.
+ *
+ * @param[in] pdrv
+ *   Physical drive number to identify the drive
+ *
+ * @param[in] buff
+ *   Pointer to the Data buffer to be written
+ *
+ * @param[in] sector
+ *   Start sector in LBA
+ *
+ * @param[in] count
+ *   Number of sectors to write
+ *
+ * @return Status of Disk Functions
+ ******************************************************************************/
+dresult_t sl_sdc_cache_write(BYTE pdrv,
+                             const BYTE *buff,
+                             LBA_t sector,
+                             UINT count);
+
+/***************************************************************************//**
+ * @brief
+ *   Device specific control through the cache.
+ *
+ * @details
+ *   CTRL_SYNC writes back all dirty sectors of the drive before it is passed
+ *   to the media. CTRL_TRIM drops cached copies of the trimmed sectors.
+ *
+ * @param[in] pdrv
+ *   Physical drive number to identify the drive
+ *
+ * @param[in] cmd
+ *   Control code
+ *
+ * @param[in] buff
+ *   Buffer to send/receive control data
+ *
+ * @return Status of Disk Functions
+ ******************************************************************************/
+dresult_t sl_sdc_cache_ioctl(BYTE pdrv, BYTE cmd, void *buff);
+
+/***************************************************************************//**
+ * @brief
+ *   Write back all dirty sectors of a drive.
+ *
+ * @param[in] pdrv
+ *   Physical drive number to identify the drive
+ *
+ * @return Status of Disk Functions
+ ******************************************************************************/
+dresult_t sl_sdc_cache_sync(BYTE pdrv);
+
+/***************************************************************************//**
+ * @brief
+ *   Drop every cached sector and pinned region of a drive without writing
+ *   anything back.
+ *
+ * @param[in] pdrv
+ *   Physical drive number to identify the drive
+ ******************************************************************************/
+void sl_sdc_cache_invalidate(BYTE pdrv);
+
+/***************************************************************************//**
+ * @brief
+ *   Pin a sector region in the cache.
+ *
+ * @details
+ *   Regions found in the boot sector are pinned automatically when
+ *   SL_SDC_CACHE_PIN_METADATA is enabled. This function adds regions the
+ *   application knows to be hot, e.g. a frequently updated index file.
+ *
+ * @param[in] pdrv
+ *   Physical drive number to identify the drive
+ *
+ * @param[in] sector
+ *   First sector of the region in LBA
+ *
+ * @param[in] count
+ *   Number of sectors in the region
+ *
+ * @return Status of Disk Functions, RES_ERROR if the region table is full
+ ******************************************************************************/
+dresult_t sl_sdc_cache_pin_range(BYTE pdrv, LBA_t sector, LBA_t count);
+
+/***************************************************************************//**
+ * @brief
+ *   Get the cache statistics.
+ *
+ * @param[out] stats
+ *   Pointer to the statistics to be filled
+ ******************************************************************************/
+void sl_sdc_cache_get_stats(sl_sdc_cache_stats_t *stats);
+
+/***************************************************************************//**
+ * @brief
+ *   Clear the cache statistics.
+ ******************************************************************************/
+void sl_sdc_cache_reset_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SL_SDC_CACHE_H
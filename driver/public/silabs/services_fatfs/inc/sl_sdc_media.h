@@ -0,0 +1,163 @@
+/***************************************************************************//**
+ * @file sl_sdc_media.h
+ * @brief Storage Device Controls raw media access
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ ********************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided \'as-is\', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+#ifndef SL_SDC_MEDIA_H
+#define SL_SDC_MEDIA_H
+
+#include "ff.h"
+#include "diskio.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************************************************************//**
+ * @brief
+ *   Read Sector(s) directly from the storage device, bypassing the cache.
+ *
+ * @param[in] pdrv
+ *   Physical drive number to identify the drive
+ *
+ * @param[out] buff
+ *   Pointer to the Data buffer to store read data
+ *
+ * @param[in] sector
+ *   Start sector in LBA
+ *
+ * @param[in] count
+ *   Number of sectors to read
+ *
+ * @return Status of Disk Functions
+ ******************************************************************************/
+dresult_t sl_sdc_media_read(BYTE pdrv, BYTE *buff, LBA_t sector, UINT count);
+
+/***************************************************************************//**
+ * @brief
+ *   Write Sector(s) directly to the storage device, bypassing the cache.
+ *
+ * @param[in] pdrv
+ *   Physical drive number to identify the drive
+ *
+ * @param[in] buff
+ *   Pointer to the Data buffer to be written
+ *
+ * @param[in] sector
+ *   Start sector in LBA
+ *
+ * @param[in] count
+ *   Number of sectors to write
+ *
+ * @return Status of Disk Functions
+ ******************************************************************************/
+dresult_t sl_sdc_media_write(BYTE pdrv,
+                             const BYTE *buff,
+                             LBA_t sector,
+                             UINT count);
+
+/***************************************************************************//**
+ * @brief
+ *   Read consecutive sectors into separate buffers.
+ *
+ * @details
+ *   Devices that support it issue a single multiple block read for the
+ *   whole run, other devices are read one sector at a time.
+ *
+ * @param[in] pdrv
+ *   Physical drive number to identify the drive
+ *
+ * @param[out] buffs
+ *   Array of count pointers, one sector buffer per sector
+ *
+ * @param[in] sector
+ *   Start sector in LBA
+ *
+ * @param[in] count
+ *   Number of sectors to read
+ *
+ * @return Status of Disk Functions
+ ******************************************************************************/
+dresult_t sl_sdc_media_read_vector(BYTE pdrv,
+                                   BYTE *const *buffs,
+                                   LBA_t sector,
+                                   UINT count);
+
+/***************************************************************************//**
+ * @brief
+ *   Write consecutive sectors held in separate buffers.
+ *
+ * @details
+ *   Devices that support it issue a single multiple block write for the
+ *   whole run, other devices are written one sector at a time.
+ *
+ * @param[in] pdrv
+ *   Physical drive number to identify the drive
+ *
+ * @param[in] buffs
+ *   Array of count pointers, one sector buffer per sector
+ *
+ * @param[in] sector
+ *   Start sector in LBA
+ *
+ * @param[in] count
+ *   Number of sectors to write
+ *
+ * @return Status of Disk Functions
+ ******************************************************************************/
+dresult_t sl_sdc_media_write_vector(BYTE pdrv,
+                                    const BYTE *const *buffs,
+                                    LBA_t sector,
+                                    UINT count);
+
+/***************************************************************************//**
+ * @brief
+ *   Device specific control of the storage device, bypassing the cache.
+ *
+ * @param[in] pdrv
+ *   Physical drive number to identify the drive
+ *
+ * @param[in] cmd
+ *   Control code
+ *
+ * @param[in] buff
+ *   Buffer to send/receive control data
+ *
+ * @return Status of Disk Functions
+ ******************************************************************************/
+dresult_t sl_sdc_media_ioctl(BYTE pdrv, BYTE cmd, void *buff);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SL_SDC_MEDIA_H
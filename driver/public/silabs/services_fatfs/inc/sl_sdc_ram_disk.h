@@ -0,0 +1,249 @@
+/***************************************************************************//**
+ * @file sl_sdc_ram_disk.h
+ * @brief Storage Device Controls RAM disk
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ ********************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided \'as-is\', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+#ifndef SL_SDC_RAM_DISK_H
+#define SL_SDC_RAM_DISK_H
+
+#include <stdbool.h>
+#include "ff.h"
+#include "diskio.h"
+#include "sl_sdc_ram_disk_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Physical drive number of the RAM disk
+#define RAM_DISK          SL_SDC_RAM_DISK_PDRV
+
+/// RAM disk latency model, all times in microseconds
+typedef struct {
+  uint32_t command_us;      ///< Overhead of every read or write command
+  uint32_t read_block_us;   ///< Transfer time of a read sector
+  uint32_t write_block_us;  ///< Transfer time of a written sector
+  uint32_t program_busy_us; ///< Busy time after a written sector
+  uint32_t poll_us;         ///< Time consumed by one MMC_GET_READY request
+} sl_sdc_ram_disk_latency_t;
+
+/// RAM disk statistics
+typedef struct {
+  uint32_t read_commands;   ///< Read commands, any number of sectors
+  uint32_t write_commands;  ///< Write commands, any number of sectors
+  uint32_t read_sectors;    ///< Sectors read
+  uint32_t write_sectors;   ///< Sectors written
+  uint32_t sync_commands;   ///< CTRL_SYNC requests
+  uint32_t trim_commands;   ///< CTRL_TRIM requests
+  uint32_t busy_polls;      ///< MMC_GET_READY requests answered busy
+  uint32_t power_losses;    ///< Injected power losses
+  uint64_t elapsed_us;      ///< Simulated time spent by the disk
+} sl_sdc_ram_disk_stats_t;
+
+/***************************************************************************//**
+ * @brief
+ *   Get Drive Status.
+ *
+ * @return Status of Disk Functions
+ ******************************************************************************/
+DSTATUS sl_sdc_ram_disk_status(void);
+
+/***************************************************************************//**
+ * @brief
+ *   Initialize the RAM disk.
+ *
+ * @details
+ *   Restores the power after an injected power loss. The image content is
+ *   kept, so a volume survives a re-initialization like on a real card.
+ *
+ * @return Status of Disk Functions
+ ******************************************************************************/
+DSTATUS sl_sdc_ram_disk_initialize(void);
+
+/***************************************************************************//**
+ * @brief
+ *   Read Sector(s) from the RAM disk.
+ *
+ * @param[out] buff
+ *   Pointer to the Data buffer to store read data
+ *
+ * @param[in] sector
+ *   Start sector in LBA
+ *
+ * @param[in] count
+ *   Number of sectors to read
+ *
+ * @return Status of Disk Functions
+ ******************************************************************************/
+dresult_t sl_sdc_ram_disk_read(BYTE *buff, LBA_t sector, UINT count);
+
+/***************************************************************************//**
+ * @brief
+ *   Write Sector(s) to the RAM disk.
+ *
+ * @param[in] buff
+ *   Pointer to the Data buffer to be written
+ *
+ * @param[in] sector
+ *   Start sector in LBA
+ *
+ * @param[in] count
+ *   Number of sectors to write
+ *
+ * @return Status of Disk Functions
+ ******************************************************************************/
+dresult_t sl_sdc_ram_disk_write(const BYTE *buff, LBA_t sector, UINT count);
+
+/***************************************************************************//**
+ * @brief
+ *   Read consecutive sectors into separate buffers with one command.
+ *
+ * @param[out] buffs
+ *   Array of count sector buffers
+ *
+ * @param[in] sector
+ *   Start sector in LBA
+ *
+ * @param[in] count
+ *   Number of sectors to read
+ *
+ * @return Status of Disk Functions
+ ******************************************************************************/
+dresult_t sl_sdc_ram_disk_read_vector(BYTE *const *buffs,
+                                      LBA_t sector,
+                                      UINT count);
+
+/***************************************************************************//**
+ * @brief
+ *   Write consecutive sectors held in separate buffers with one command.
+ *
+ * @param[in] buffs
+ *   Array of count sector buffers
+ *
+ * @param[in] sector
+ *   Start sector in LBA
+ *
+ * @param[in] count
+ *   Number of sectors to write
+ *
+ * @return Status of Disk Functions
+ ******************************************************************************/
+dresult_t sl_sdc_ram_disk_write_vector(const BYTE *const *buffs,
+                                       LBA_t sector,
+                                       UINT count);
+
+/***************************************************************************//**
+ * @brief
+ *   Miscellaneous Functions of the RAM disk.
+ *
+ * @param[in] cmd
+ *   Control code
+ *
+ * @param[in] buff
+ *   Buffer to send/receive control data
+ *
+ * @return Status of Disk Functions
+ ******************************************************************************/
+dresult_t sl_sdc_ram_disk_ioctl(BYTE cmd, void *buff);
+
+/***************************************************************************//**
+ * @brief
+ *   Replace the built-in image with an application provided one.
+ *
+ * @details
+ *   On a host build the image can be a memory mapped file, so volumes can be
+ *   prepared or inspected with PC tools. Passing NULL restores the built-in
+ *   image. The drive must be initialized again after the image is changed.
+ *
+ * @param[in] image
+ *   Image of sector_count * FF_MAX_SS bytes, or NULL
+ *
+ * @param[in] sector_count
+ *   Number of sectors in the image
+ ******************************************************************************/
+void sl_sdc_ram_disk_attach(BYTE *image, LBA_t sector_count);
+
+/***************************************************************************//**
+ * @brief
+ *   Change the latency model.
+ *
+ * @param[in] latency
+ *   New latencies, NULL restores the configured ones
+ ******************************************************************************/
+void sl_sdc_ram_disk_set_latency(const sl_sdc_ram_disk_latency_t *latency);
+
+/***************************************************************************//**
+ * @brief
+ *   Inject a power loss.
+ *
+ * @details
+ *   The power is lost during the write of the given sector, counted from
+ *   now across all write commands. The sectors written before it are
+ *   kept. With torn set, the first half of the interrupted sector is
+ *   programmed; otherwise its old content is kept. From then on every
+ *   request fails with RES_NOTRDY until the drive is initialized again.
+ *
+ * @param[in] sectors_before
+ *   Number of sectors that are still written completely, 0 fails the next
+ *   written sector
+ *
+ * @param[in] torn
+ *   Program the interrupted sector partially
+ ******************************************************************************/
+void sl_sdc_ram_disk_inject_power_loss(uint32_t sectors_before, bool torn);
+
+/***************************************************************************//**
+ * @brief
+ *   Cancel a pending power loss injection.
+ ******************************************************************************/
+void sl_sdc_ram_disk_cancel_power_loss(void);
+
+/***************************************************************************//**
+ * @brief
+ *   Get the RAM disk statistics.
+ *
+ * @param[out] stats
+ *   Pointer to the statistics to be filled
+ ******************************************************************************/
+void sl_sdc_ram_disk_get_stats(sl_sdc_ram_disk_stats_t *stats);
+
+/***************************************************************************//**
+ * @brief
+ *   Clear the RAM disk statistics and the simulated clock.
+ ******************************************************************************/
+void sl_sdc_ram_disk_reset_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SL_SDC_RAM_DISK_H
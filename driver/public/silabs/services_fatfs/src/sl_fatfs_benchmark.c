@@ -0,0 +1,207 @@
+/***************************************************************************//**
+ * @file sl_fatfs_benchmark.c
+ * @brief FatFs throughput benchmark on the RAM disk
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ ********************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided \'as-is\', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+#include <string.h>
+#include "sl_fatfs_benchmark.h"
+
+// -----------------------------------------------------------------------------
+// Local Variables
+
+static FATFS benchmark_fs;
+static uint32_t benchmark_random;
+static sl_sdc_ram_disk_stats_t benchmark_start;
+
+// -----------------------------------------------------------------------------
+// Local Functions
+
+/***************************************************************************//**
+ * Get the next io_size aligned random offset inside the file.
+ ******************************************************************************/
+static FSIZE_t random_offset(const sl_fatfs_benchmark_config_t *config)
+{
+  uint32_t blocks = config->file_size / config->io_size;
+
+  // Numerical Recipes LCG, good enough to scatter the accesses
+  benchmark_random = benchmark_random * 1664525u + 1013904223u;
+  return (FSIZE_t)((benchmark_random >> 8) % blocks) * config->io_size;
+}
+
+/***************************************************************************//**
+ * Start measuring a phase.
+ ******************************************************************************/
+static void phase_start(sl_fatfs_benchmark_result_t *result)
+{
+  memset(result, 0, sizeof(*result));
+  sl_sdc_ram_disk_get_stats(&benchmark_start);
+}
+
+/***************************************************************************//**
+ * Finish measuring a phase and derive the rates.
+ ******************************************************************************/
+static void phase_end(sl_fatfs_benchmark_result_t *result, uint32_t io_calls)
+{
+  sl_sdc_ram_disk_stats_t now;
+
+  sl_sdc_ram_disk_get_stats(&now);
+  result->media_commands =
+    (now.read_commands - benchmark_start.read_commands)
+    + (now.write_commands - benchmark_start.write_commands);
+  result->media_sectors =
+    (now.read_sectors - benchmark_start.read_sectors)
+    + (now.write_sectors - benchmark_start.write_sectors);
+  result->time_us = now.elapsed_us - benchmark_start.elapsed_us;
+
+  if (result->time_us) {
+    result->throughput_kbps =
+      (uint32_t)(((uint64_t)result->bytes * 1000000u / 1024u)
+                 / result->time_us);
+    result->iops = (uint32_t)((uint64_t)io_calls * 1000000u / result->time_us);
+  }
+  if (result->fatfs_calls) {
+    result->sectors_per_call_x100 =
+      (uint32_t)((uint64_t)result->media_sectors * 100u / result->fatfs_calls);
+  }
+}
+
+/***************************************************************************//**
+ * Run one phase on the open file.
+ ******************************************************************************/
+static FRESULT run_phase(const sl_fatfs_benchmark_config_t *config,
+                         FIL *fp,
+                         BYTE *buff,
+                         sl_fatfs_benchmark_phase_t phase,
+                         sl_fatfs_benchmark_result_t *result)
+{
+  bool random = (phase == SL_FATFS_BENCHMARK_RANDOM_READ)
+                || (phase == SL_FATFS_BENCHMARK_RANDOM_WRITE);
+  bool write = (phase == SL_FATFS_BENCHMARK_SEQ_WRITE)
+               || (phase == SL_FATFS_BENCHMARK_RANDOM_WRITE);
+  uint32_t calls = random ? config->random_ops
+                   : config->file_size / config->io_size;
+  uint32_t i;
+  UINT bx;
+  FRESULT res = FR_OK;
+
+  phase_start(result);
+
+  if (!random) {
+    res = f_lseek(fp, 0);
+    result->fatfs_calls++;
+  }
+  for (i = 0; (i < calls) && (res == FR_OK); i++) {
+    if (random) {
+      res = f_lseek(fp, random_offset(config));
+      result->fatfs_calls++;
+      if (res != FR_OK) {
+        break;
+      }
+    }
+    if (write) {
+      memset(buff, (int)(i & 0xff), config->io_size);
+      res = f_write(fp, buff, config->io_size, &bx);
+    } else {
+      res = f_read(fp, buff, config->io_size, &bx);
+    }
+    result->fatfs_calls++;
+    if ((res == FR_OK) && (bx != config->io_size)) {
+      res = FR_DENIED;
+    }
+    result->bytes += bx;
+  }
+  if ((res == FR_OK) && write) {
+    // Data still held by FatFs or the sector cache belongs to the phase
+    res = f_sync(fp);
+    result->fatfs_calls++;
+  }
+
+  phase_end(result, calls);
+  return res;
+}
+
+// -----------------------------------------------------------------------------
+// Global Functions
+
+/***************************************************************************//**
+ * Run the benchmark on the RAM disk.
+ ******************************************************************************/
+FRESULT sl_fatfs_benchmark_run(const sl_fatfs_benchmark_config_t *config,
+                               BYTE *buff,
+                               sl_fatfs_benchmark_result_t *results)
+{
+  TCHAR drive[3] = { (TCHAR)('0' + RAM_DISK), ':', 0 };
+  sl_fatfs_benchmark_phase_t phase;
+  FIL fil;
+  FRESULT res;
+
+  if (!config || !buff || !results || !config->io_size
+      || (config->file_size < config->io_size)) {
+    return FR_INVALID_PARAMETER;
+  }
+
+#if FF_USE_MKFS
+  if (config->cluster_size) {
+    MKFS_PARM opt = { FM_ANY, 0, 0, 0, config->cluster_size };
+
+    // The work area is only needed during f_mkfs(), borrow the file buffer
+    res = f_mkfs(drive, &opt, buff, config->io_size);
+    if (res != FR_OK) {
+      return res;
+    }
+  }
+#endif
+
+  res = f_mount(&benchmark_fs, drive, 1);
+  if (res != FR_OK) {
+    return res;
+  }
+  res = f_open(&fil, config->path, FA_CREATE_ALWAYS | FA_READ | FA_WRITE);
+  if (res != FR_OK) {
+    return res;
+  }
+
+  benchmark_random = config->seed;
+  for (phase = SL_FATFS_BENCHMARK_SEQ_WRITE;
+       (phase < SL_FATFS_BENCHMARK_PHASE_COUNT) && (res == FR_OK);
+       phase++) {
+    res = run_phase(config, &fil, buff, phase, &results[phase]);
+  }
+
+  if (res == FR_OK) {
+    res = f_close(&fil);
+  } else {
+    f_close(&fil);
+  }
+  f_mount(NULL, drive, 0);
+  return res;
+}
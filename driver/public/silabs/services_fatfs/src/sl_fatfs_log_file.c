@@ -0,0 +1,420 @@
+/***************************************************************************//**
+ * @file sl_fatfs_log_file.c
+ * @brief FatFs data logging file
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ ********************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided \'as-is\', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+#include <stdint.h>
+#include <string.h>
+#include "sl_fatfs_log_file.h"
+
+#if FF_USE_FASTSEEK && FF_USE_EXPAND && !FF_FS_READONLY
+
+#if (SL_FATFS_LOG_FILE_CHUNK_SIZE % FF_MAX_SS) != 0
+#error "SL_FATFS_LOG_FILE_CHUNK_SIZE must be a multiple of FF_MAX_SS"
+#endif
+
+// The header takes a whole sector to keep the data sector aligned
+#define LOG_FILE_HEADER_SIZE   FF_MAX_SS
+#define LOG_FILE_HEADER_MAGIC  0x474F4C53UL  // "SLOG"
+#define LOG_FILE_HEADER_LEN    12            // Magic and 64-bit data size
+
+static FRESULT log_file_build_clmt(sl_fatfs_log_file_t *log);
+static FRESULT log_file_reserve(sl_fatfs_log_file_t *log, FSIZE_t end);
+static FRESULT log_file_write(sl_fatfs_log_file_t *log,
+                              const BYTE *data,
+                              UINT len);
+static FRESULT log_file_flush(sl_fatfs_log_file_t *log);
+static FRESULT log_file_read_header(sl_fatfs_log_file_t *log);
+static FRESULT log_file_write_header(sl_fatfs_log_file_t *log);
+
+/***************************************************************************//**
+ * Open or create a data logging file.
+ ******************************************************************************/
+FRESULT sl_fatfs_log_file_open(sl_fatfs_log_file_t *log,
+                               const TCHAR *path,
+                               FSIZE_t extent_size)
+{
+  FRESULT res;
+
+  if ((log == NULL) || (extent_size == 0)) {
+    return FR_INVALID_PARAMETER;
+  }
+
+  res = f_open(&log->fil, path, FA_OPEN_ALWAYS | FA_READ | FA_WRITE);
+  if (res != FR_OK) {
+    return res;
+  }
+
+  log->extent_size = extent_size;
+  log->data_size = 0;
+  log->chunk_len = 0;
+
+  if (f_size(&log->fil) == 0) {
+    // Allocate the first extent in one contiguous block. If the volume is
+    // too fragmented for that, the file grows cluster by cluster instead.
+    res = f_expand(&log->fil, LOG_FILE_HEADER_SIZE + extent_size, 1);
+    if ((res == FR_OK) || (res == FR_DENIED)) {
+      res = log_file_write_header(log);
+    }
+  } else {
+    res = log_file_read_header(log);
+    if ((res == FR_OK)
+        && (f_size(&log->fil) > LOG_FILE_HEADER_SIZE + log->data_size)) {
+      // Drop the data written after the last sync and the unused space
+      // pre-allocated before an unclean shutdown
+      res = f_lseek(&log->fil, LOG_FILE_HEADER_SIZE + log->data_size);
+      if (res == FR_OK) {
+        res = f_truncate(&log->fil);
+      }
+    }
+  }
+
+  if (res == FR_OK) {
+    res = log_file_build_clmt(log);
+  }
+  if (res != FR_OK) {
+    f_close(&log->fil);
+  }
+  return res;
+}
+
+/***************************************************************************//**
+ * Append data to the end of the file.
+ ******************************************************************************/
+FRESULT sl_fatfs_log_file_append(sl_fatfs_log_file_t *log,
+                                 const void *data,
+                                 UINT len)
+{
+  const BYTE *src = data;
+  FRESULT res;
+  UINT n;
+
+  while (len) {
+    // Bytes up to the next chunk boundary of the file
+    n = SL_FATFS_LOG_FILE_CHUNK_SIZE
+        - (UINT)((log->data_size + log->chunk_len)
+                 % SL_FATFS_LOG_FILE_CHUNK_SIZE);
+
+    if ((log->chunk_len == 0) && (n == SL_FATFS_LOG_FILE_CHUNK_SIZE)
+        && (len >= SL_FATFS_LOG_FILE_CHUNK_SIZE)) {
+      // Aligned whole chunks go straight from the caller's buffer
+      n = len - (len % SL_FATFS_LOG_FILE_CHUNK_SIZE);
+      res = log_file_write(log, src, n);
+      if (res != FR_OK) {
+        return res;
+      }
+    } else {
+      if (n > len) {
+        n = len;
+      }
+      memcpy(log->chunk + log->chunk_len, src, n);
+      log->chunk_len += n;
+      if (((log->data_size + log->chunk_len)
+           % SL_FATFS_LOG_FILE_CHUNK_SIZE) == 0) {
+        res = log_file_flush(log);
+        if (res != FR_OK) {
+          return res;
+        }
+      }
+    }
+    src += n;
+    len -= n;
+  }
+
+  return FR_OK;
+}
+
+/***************************************************************************//**
+ * Read logged data from an offset.
+ ******************************************************************************/
+FRESULT sl_fatfs_log_file_read(sl_fatfs_log_file_t *log,
+                               FSIZE_t ofs,
+                               void *buff,
+                               UINT len,
+                               UINT *br)
+{
+  FRESULT res;
+
+  *br = 0;
+
+  // Staged data must be on the media before it can be read back
+  res = log_file_flush(log);
+  if (res != FR_OK) {
+    return res;
+  }
+  if (ofs >= log->data_size) {
+    return FR_OK;
+  }
+  if (len > log->data_size - ofs) {
+    len = (UINT)(log->data_size - ofs);
+  }
+
+  res = f_lseek(&log->fil, LOG_FILE_HEADER_SIZE + ofs);
+  if (res != FR_OK) {
+    return res;
+  }
+  return f_read(&log->fil, buff, len, br);
+}
+
+/***************************************************************************//**
+ * Write staged data and flush the cached information of the file.
+ ******************************************************************************/
+FRESULT sl_fatfs_log_file_sync(sl_fatfs_log_file_t *log)
+{
+  FRESULT res;
+
+  res = log_file_flush(log);
+  if (res == FR_OK) {
+    res = log_file_write_header(log);
+  }
+  if (res != FR_OK) {
+    return res;
+  }
+  return f_sync(&log->fil);
+}
+
+/***************************************************************************//**
+ * Write staged data, release the unused space and close the file.
+ ******************************************************************************/
+FRESULT sl_fatfs_log_file_close(sl_fatfs_log_file_t *log)
+{
+  FRESULT res;
+
+  res = log_file_flush(log);
+
+  if (res == FR_OK) {
+    res = log_file_write_header(log);
+  }
+  if (res == FR_OK) {
+    // Truncation changes the cluster chain, leave fast seek mode first
+    log->fil.cltbl = NULL;
+    res = f_lseek(&log->fil, LOG_FILE_HEADER_SIZE + log->data_size);
+  }
+  if (res == FR_OK) {
+    res = f_truncate(&log->fil);
+  }
+  if (res == FR_OK) {
+    res = f_close(&log->fil);
+  } else {
+    f_close(&log->fil);
+  }
+
+  return res;
+}
+
+/***************************************************************************//**
+ * Get the number of logged bytes, including staged data.
+ ******************************************************************************/
+FSIZE_t sl_fatfs_log_file_size(const sl_fatfs_log_file_t *log)
+{
+  return log->data_size + log->chunk_len;
+}
+
+/***************************************************************************//**
+ * Create the cluster link map table and enter fast seek mode.
+ ******************************************************************************/
+static FRESULT log_file_build_clmt(sl_fatfs_log_file_t *log)
+{
+  FRESULT res;
+
+  if (f_size(&log->fil) == 0) {
+    // Nothing allocated yet, the table is built once the file grows
+    log->fil.cltbl = NULL;
+    return FR_OK;
+  }
+
+  log->clmt[0] = SL_FATFS_LOG_FILE_CLMT_SIZE;
+  log->fil.cltbl = log->clmt;
+  res = f_lseek(&log->fil, CREATE_LINKMAP);
+  if (res == FR_NOT_ENOUGH_CORE) {
+    // Too fragmented for the table, fall back to following the FAT chain
+    log->fil.cltbl = NULL;
+    res = FR_OK;
+  }
+  return res;
+}
+
+/***************************************************************************//**
+ * Make sure the file is allocated up to an offset.
+ ******************************************************************************/
+static FRESULT log_file_reserve(sl_fatfs_log_file_t *log, FSIZE_t end)
+{
+  FSIZE_t size = f_size(&log->fil);
+  FRESULT res;
+
+  if (end <= size) {
+    return FR_OK;
+  }
+  while (size < end) {
+    size += log->extent_size;
+  }
+
+  // The file cannot grow in fast seek mode. Stretch the cluster chain with a
+  // normal seek beyond the end, then rebuild the table for the new layout.
+  // The chain is only walked once per extent.
+  log->fil.cltbl = NULL;
+  res = f_lseek(&log->fil, size);
+  if (res != FR_OK) {
+    return res;
+  }
+
+  res = log_file_build_clmt(log);
+  if ((res == FR_OK) && (f_tell(&log->fil) != size)) {
+    // Volume full, the file keeps what could be allocated
+    res = FR_DENIED;
+  }
+  return res;
+}
+
+/***************************************************************************//**
+ * Write data at the end of the logged data.
+ ******************************************************************************/
+static FRESULT log_file_write(sl_fatfs_log_file_t *log,
+                              const BYTE *data,
+                              UINT len)
+{
+  FRESULT res;
+  UINT bw;
+
+  res = log_file_reserve(log, LOG_FILE_HEADER_SIZE + log->data_size + len);
+  if (res != FR_OK) {
+    return res;
+  }
+  if (f_tell(&log->fil) != LOG_FILE_HEADER_SIZE + log->data_size) {
+    res = f_lseek(&log->fil, LOG_FILE_HEADER_SIZE + log->data_size);
+    if (res != FR_OK) {
+      return res;
+    }
+  }
+
+  res = f_write(&log->fil, data, len, &bw);
+  log->data_size += bw;
+  if ((res == FR_OK) && (bw != len)) {
+    res = FR_DENIED;
+  }
+  return res;
+}
+
+/***************************************************************************//**
+ * Write the staged data.
+ ******************************************************************************/
+static FRESULT log_file_flush(sl_fatfs_log_file_t *log)
+{
+  FSIZE_t start = log->data_size;
+  FRESULT res;
+  UINT written;
+
+  if (log->chunk_len == 0) {
+    return FR_OK;
+  }
+  res = log_file_write(log, log->chunk, log->chunk_len);
+
+  // Keep whatever could not be written for the next attempt
+  written = (UINT)(log->data_size - start);
+  log->chunk_len -= written;
+  if (log->chunk_len) {
+    memmove(log->chunk, log->chunk + written, log->chunk_len);
+  }
+  return res;
+}
+
+/***************************************************************************//**
+ * Get the size of the logged data from the header of the file.
+ ******************************************************************************/
+static FRESULT log_file_read_header(sl_fatfs_log_file_t *log)
+{
+  BYTE header[LOG_FILE_HEADER_LEN];
+  uint64_t data_size = 0;
+  DWORD magic = 0;
+  FRESULT res;
+  UINT br;
+  int i;
+
+  res = f_lseek(&log->fil, 0);
+  if (res == FR_OK) {
+    res = f_read(&log->fil, header, sizeof(header), &br);
+  }
+  if (res != FR_OK) {
+    return res;
+  }
+  if (br != sizeof(header)) {
+    return FR_INVALID_OBJECT;
+  }
+
+  for (i = 3; i >= 0; i--) {
+    magic = (magic << 8) | header[i];
+  }
+  for (i = 11; i >= 4; i--) {
+    data_size = (data_size << 8) | header[i];
+  }
+
+  // Not a data logging file, or a size beyond the end of the file
+  if ((magic != LOG_FILE_HEADER_MAGIC)
+      || ((data_size != 0)
+          && (LOG_FILE_HEADER_SIZE + data_size > f_size(&log->fil)))) {
+    return FR_INVALID_OBJECT;
+  }
+
+  log->data_size = (FSIZE_t)data_size;
+  return FR_OK;
+}
+
+/***************************************************************************//**
+ * Record the size of the logged data in the header of the file.
+ ******************************************************************************/
+static FRESULT log_file_write_header(sl_fatfs_log_file_t *log)
+{
+  BYTE header[LOG_FILE_HEADER_LEN];
+  uint64_t data_size = log->data_size;
+  FRESULT res;
+  UINT bw;
+  int i;
+
+  for (i = 0; i < 4; i++) {
+    header[i] = (BYTE)(LOG_FILE_HEADER_MAGIC >> (8 * i));
+  }
+  for (i = 4; i < 12; i++) {
+    header[i] = (BYTE)data_size;
+    data_size >>= 8;
+  }
+
+  res = f_lseek(&log->fil, 0);
+  if (res == FR_OK) {
+    res = f_write(&log->fil, header, sizeof(header), &bw);
+  }
+  if ((res == FR_OK) && (bw != sizeof(header))) {
+    res = FR_DENIED;
+  }
+  return res;
+}
+
+#endif // FF_USE_FASTSEEK && FF_USE_EXPAND && !FF_FS_READONLY
@@ -0,0 +1,372 @@
+/***************************************************************************//**
+ * @file sl_sdc_async.c
+ * @brief Storage Device Controls asynchronous media access
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ ********************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided \'as-is\', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+#include <stddef.h>
+#include "sl_common.h"
+#include "sl_sleeptimer.h"
+#include "sl_sdc_async.h"
+#include "sl_sdc_media.h"
+
+#if SL_SDC_ASYNC_ENABLE
+
+static sl_sdc_async_request_t *queue_head;
+static sl_sdc_async_request_t *queue_tail;
+static sl_sdc_async_busy_callback_t busy_callback;
+static bool card_busy;
+static bool card_waiting;
+static uint32_t card_wait_start;
+static BYTE *run_buff[SL_SDC_ASYNC_MAX_MERGE];
+
+static bool async_try_merge(sl_sdc_async_request_t *req);
+static bool async_card_ready(BYTE pdrv);
+static dresult_t async_execute(sl_sdc_async_request_t *run);
+static void async_complete(sl_sdc_async_request_t *run, dresult_t result);
+static dresult_t async_wait(sl_sdc_async_request_t *req);
+
+/***************************************************************************//**
+ * Queue a request.
+ ******************************************************************************/
+dresult_t sl_sdc_async_submit(sl_sdc_async_request_t *req)
+{
+  if ((req == NULL) || (req->op > SL_SDC_ASYNC_SYNC)) {
+    return RES_PARERR;
+  }
+  if ((req->op != SL_SDC_ASYNC_SYNC)
+      && ((!req->buff && !req->buffs) || !req->count)) {
+    return RES_PARERR;
+  }
+
+  req->result = RES_OK;
+  req->done = false;
+  req->next = NULL;
+  req->merged = NULL;
+
+  if (async_try_merge(req)) {
+    return RES_OK;
+  }
+
+  if (queue_tail) {
+    queue_tail->next = req;
+  } else {
+    queue_head = req;
+  }
+  queue_tail = req;
+
+  return RES_OK;
+}
+
+/***************************************************************************//**
+ * Advance the request queue.
+ ******************************************************************************/
+bool sl_sdc_async_process(void)
+{
+  sl_sdc_async_request_t *run = queue_head;
+  dresult_t result;
+
+  if (run == NULL) {
+    return false;
+  }
+
+  if (!async_card_ready(run->pdrv)) {
+    return true;
+  }
+
+  // Take the run off the queue before completing it, so callbacks may submit
+  // new requests, including the completed ones.
+  queue_head = run->next;
+  if (queue_head == NULL) {
+    queue_tail = NULL;
+  }
+  result = async_execute(run);
+  async_complete(run, result);
+
+  return queue_head != NULL;
+}
+
+/***************************************************************************//**
+ * Check if requests are pending.
+ ******************************************************************************/
+bool sl_sdc_async_busy(void)
+{
+  return queue_head != NULL;
+}
+
+/***************************************************************************//**
+ * Register a callback for card busy state changes.
+ ******************************************************************************/
+void sl_sdc_async_set_busy_callback(sl_sdc_async_busy_callback_t callback)
+{
+  busy_callback = callback;
+}
+
+/***************************************************************************//**
+ * Called repeatedly while a blocking request waits for the card.
+ ******************************************************************************/
+SL_WEAK void sl_sdc_async_wait_hook(void)
+{
+}
+
+/***************************************************************************//**
+ * Blocking read through the request queue.
+ ******************************************************************************/
+dresult_t sl_sdc_async_read(BYTE pdrv, BYTE *buff, LBA_t sector, UINT count)
+{
+  sl_sdc_async_request_t req = {
+    .op = SL_SDC_ASYNC_READ,
+    .pdrv = pdrv,
+    .buff = buff,
+    .sector = sector,
+    .count = count,
+  };
+
+  return async_wait(&req);
+}
+
+/***************************************************************************//**
+ * Blocking write through the request queue.
+ ******************************************************************************/
+dresult_t sl_sdc_async_write(BYTE pdrv,
+                             const BYTE *buff,
+                             LBA_t sector,
+                             UINT count)
+{
+  sl_sdc_async_request_t req = {
+    .op = SL_SDC_ASYNC_WRITE,
+    .pdrv = pdrv,
+    .buff = (BYTE *)buff, // Not written to by write requests
+    .sector = sector,
+    .count = count,
+  };
+
+  return async_wait(&req);
+}
+
+/***************************************************************************//**
+ * Blocking write of sectors held in separate buffers through the queue.
+ ******************************************************************************/
+dresult_t sl_sdc_async_write_vector(BYTE pdrv,
+                                    const BYTE *const *buffs,
+                                    LBA_t sector,
+                                    UINT count)
+{
+  sl_sdc_async_request_t req = {
+    .op = SL_SDC_ASYNC_WRITE,
+    .pdrv = pdrv,
+    .buffs = (BYTE *const *)buffs, // Not written to by write requests
+    .sector = sector,
+    .count = count,
+  };
+
+  return async_wait(&req);
+}
+
+/***************************************************************************//**
+ * Blocking device control, issued once the queue has drained.
+ ******************************************************************************/
+dresult_t sl_sdc_async_ioctl(BYTE pdrv, BYTE cmd, void *buff)
+{
+  sl_sdc_async_request_t req = {
+    .op = SL_SDC_ASYNC_SYNC,
+    .pdrv = pdrv,
+  };
+
+  if (cmd == CTRL_SYNC) {
+    // Wait for the card to finish programming without spinning in the driver
+    return async_wait(&req);
+  }
+
+  while (queue_head) {
+    if (sl_sdc_async_process()) {
+      sl_sdc_async_wait_hook();
+    }
+  }
+  return sl_sdc_media_ioctl(pdrv, cmd, buff);
+}
+
+/***************************************************************************//**
+ * Merge a request into the last queued run if it continues it.
+ ******************************************************************************/
+static bool async_try_merge(sl_sdc_async_request_t *req)
+{
+  sl_sdc_async_request_t *last;
+  UINT total;
+
+  if ((queue_tail == NULL)
+      || (req->op == SL_SDC_ASYNC_SYNC)
+      || (queue_tail->op != req->op)
+      || (queue_tail->pdrv != req->pdrv)) {
+    return false;
+  }
+
+  total = 0;
+  for (last = queue_tail; ; last = last->merged) {
+    total += last->count;
+    if (last->merged == NULL) {
+      break;
+    }
+  }
+  if ((last->sector + last->count != req->sector)
+      || (total + req->count > SL_SDC_ASYNC_MAX_MERGE)) {
+    return false;
+  }
+
+  last->merged = req;
+  return true;
+}
+
+/***************************************************************************//**
+ * Poll the card without waiting and report busy state changes.
+ ******************************************************************************/
+static bool async_card_ready(BYTE pdrv)
+{
+  BYTE ready = 1;
+  uint32_t elapsed;
+
+  if (!card_waiting) {
+    card_waiting = true;
+    card_wait_start = sl_sleeptimer_get_tick_count();
+  }
+
+  // Devices without a ready probe are always considered ready
+  if (sl_sdc_media_ioctl(pdrv, MMC_GET_READY, &ready) != RES_OK) {
+    ready = 1;
+  }
+
+  if (!ready) {
+    elapsed = sl_sleeptimer_get_tick_count() - card_wait_start;
+    if (elapsed < sl_sleeptimer_ms_to_tick(SL_SDC_ASYNC_BUSY_TIMEOUT_MS)) {
+      if (!card_busy) {
+        card_busy = true;
+        if (busy_callback) {
+          busy_callback(pdrv, true);
+        }
+      }
+      return false;
+    }
+    // Timed out, the request is started anyway and fails in the driver
+  }
+
+  card_waiting = false;
+  if (card_busy) {
+    card_busy = false;
+    if (busy_callback) {
+      busy_callback(pdrv, false);
+    }
+  }
+  return true;
+}
+
+/***************************************************************************//**
+ * Transfer a run of merged requests.
+ ******************************************************************************/
+static dresult_t async_execute(sl_sdc_async_request_t *run)
+{
+  sl_sdc_async_request_t *req;
+  BYTE *const *buffs;
+  UINT n = 0;
+  UINT i;
+
+  if (run->op == SL_SDC_ASYNC_SYNC) {
+    return sl_sdc_media_ioctl(run->pdrv, CTRL_SYNC, NULL);
+  }
+
+  if ((run->merged == NULL) && run->buff) {
+    if (run->op == SL_SDC_ASYNC_READ) {
+      return sl_sdc_media_read(run->pdrv, run->buff, run->sector, run->count);
+    }
+    return sl_sdc_media_write(run->pdrv, run->buff, run->sector, run->count);
+  }
+
+  if (run->merged == NULL) {
+    buffs = run->buffs;
+    n = run->count;
+  } else {
+    // Merged runs never exceed SL_SDC_ASYNC_MAX_MERGE sectors
+    for (req = run; req; req = req->merged) {
+      for (i = 0; i < req->count; i++) {
+        run_buff[n++] = req->buff ? req->buff + i * FF_MAX_SS : req->buffs[i];
+      }
+    }
+    buffs = run_buff;
+  }
+
+  if (run->op == SL_SDC_ASYNC_READ) {
+    return sl_sdc_media_read_vector(run->pdrv, buffs, run->sector, n);
+  }
+  return sl_sdc_media_write_vector(run->pdrv,
+                                   (const BYTE *const *)buffs,
+                                   run->sector,
+                                   n);
+}
+
+/***************************************************************************//**
+ * Complete every request of a run.
+ ******************************************************************************/
+static void async_complete(sl_sdc_async_request_t *run, dresult_t result)
+{
+  sl_sdc_async_request_t *req = run;
+  sl_sdc_async_request_t *next;
+
+  while (req) {
+    // The callback may reuse the request, read the link first
+    next = req->merged;
+    req->result = result;
+    req->done = true;
+    if (req->callback) {
+      req->callback(req);
+    }
+    req = next;
+  }
+}
+
+/***************************************************************************//**
+ * Queue a request and wait for its completion.
+ ******************************************************************************/
+static dresult_t async_wait(sl_sdc_async_request_t *req)
+{
+  dresult_t res;
+
+  res = sl_sdc_async_submit(req);
+  if (res != RES_OK) {
+    return res;
+  }
+  while (!req->done) {
+    if (sl_sdc_async_process() && !req->done) {
+      sl_sdc_async_wait_hook();
+    }
+  }
+  return req->result;
+}
+
+#endif // SL_SDC_ASYNC_ENABLE
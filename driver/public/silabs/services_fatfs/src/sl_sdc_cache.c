@@ -0,0 +1,727 @@
+/***************************************************************************//**
+ * @file sl_sdc_cache.c
+ * @brief Storage Device Controls sector cache
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ ********************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided \'as-is\', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+#include <stdbool.h>
+#include <string.h>
+#include "sl_sdc_cache.h"
+#include "sl_sdc_media.h"
+#include "sl_sdc_async.h"
+
+#if SL_SDC_CACHE_ENABLE
+
+#if FF_MAX_SS != FF_MIN_SS
+#error "The sector cache requires a fixed sector size (FF_MAX_SS == FF_MIN_SS)"
+#endif
+
+#if SL_SDC_CACHE_MAX_PINNED >= SL_SDC_CACHE_SECTOR_COUNT
+#error "SL_SDC_CACHE_MAX_PINNED must be lower than SL_SDC_CACHE_SECTOR_COUNT"
+#endif
+
+// Cache entry flags
+#define CACHE_VALID       0x01
+#define CACHE_DIRTY       0x02
+#define CACHE_PINNED      0x04
+
+#define CACHE_NONE        (-1)
+
+// Primary partitions of an MBR, where boot sectors are looked for
+#define CACHE_PART_COUNT  4
+
+#if SL_SDC_ASYNC_ENABLE
+// Go through the request queue so the card busy time is spent in
+// sl_sdc_async_wait_hook() rather than in the card driver
+#define cache_media_read          sl_sdc_async_read
+#define cache_media_write         sl_sdc_async_write
+#define cache_media_write_vector  sl_sdc_async_write_vector
+#define cache_media_ioctl         sl_sdc_async_ioctl
+#else
+#define cache_media_read          sl_sdc_media_read
+#define cache_media_write         sl_sdc_media_write
+#define cache_media_write_vector  sl_sdc_media_write_vector
+#define cache_media_ioctl         sl_sdc_media_ioctl
+#endif
+
+#if SL_SDC_CACHE_STATISTICS
+#define CACHE_STAT_ADD(field, n)  (cache_stats.field += (n))
+#else
+#define CACHE_STAT_ADD(field, n)
+#endif
+
+typedef struct {
+  LBA_t sector;       // Cached sector in LBA
+  uint32_t last_use;  // LRU time stamp
+  BYTE pdrv;          // Physical drive hosting the sector
+  BYTE flags;         // CACHE_VALID, CACHE_DIRTY, CACHE_PINNED
+} cache_entry_t;
+
+typedef struct {
+  LBA_t start;        // First sector of the region
+  LBA_t count;        // Number of sectors, 0: unused
+  BYTE pdrv;          // Physical drive hosting the region
+  bool automatic;     // Found in a boot sector
+} cache_pin_region_t;
+
+typedef struct {
+  LBA_t start;        // First sector of the partition, 0: unused
+  BYTE pdrv;          // Physical drive hosting the partition
+} cache_part_t;
+
+static cache_entry_t cache_entry[SL_SDC_CACHE_SECTOR_COUNT];
+static BYTE cache_buff[SL_SDC_CACHE_SECTOR_COUNT][FF_MAX_SS];
+static cache_pin_region_t cache_pin_region[SL_SDC_CACHE_PIN_REGION_COUNT];
+static uint32_t cache_clock;
+static UINT cache_pinned_count;
+
+#if SL_SDC_CACHE_STATISTICS
+static sl_sdc_cache_stats_t cache_stats;
+#endif
+
+#if SL_SDC_CACHE_PIN_METADATA
+static cache_part_t cache_part[CACHE_PART_COUNT];
+#endif
+
+static int cache_find(BYTE pdrv, LBA_t sector);
+static bool cache_sector_is_pinned(BYTE pdrv, LBA_t sector);
+static void cache_set_pinned(int idx, bool pinned);
+static void cache_drop(int idx);
+static dresult_t cache_write_back(int idx);
+static dresult_t cache_alloc(BYTE pdrv, LBA_t sector, int *idx);
+static void cache_touch(int idx);
+#if SL_SDC_CACHE_PIN_METADATA
+static void cache_detect_volume(BYTE pdrv, LBA_t sector, const BYTE *buff);
+static void cache_detect_partitions(BYTE pdrv, const BYTE *buff);
+
+#endif
+static dresult_t cache_add_region(BYTE pdrv,
+                                  LBA_t start,
+                                  LBA_t count,
+                                  bool automatic);
+
+/***************************************************************************//**
+ * Read Sector(s) through the cache.
+ ******************************************************************************/
+dresult_t sl_sdc_cache_read(BYTE pdrv, BYTE *buff, LBA_t sector, UINT count)
+{
+  dresult_t res;
+  int idx;
+
+  if (!count) {
+    return RES_PARERR;
+  }
+
+  if (count > 1) {
+    // Large transfers go straight to the media so they do not flush the
+    // working set, only dirty cached copies must be merged in.
+    res = cache_media_read(pdrv, buff, sector, count);
+    if (res != RES_OK) {
+      return res;
+    }
+    CACHE_STAT_ADD(bypass_sectors, count);
+    for (idx = 0; idx < SL_SDC_CACHE_SECTOR_COUNT; idx++) {
+      if ((cache_entry[idx].flags & CACHE_DIRTY)
+          && (cache_entry[idx].pdrv == pdrv)
+          && (cache_entry[idx].sector >= sector)
+          && (cache_entry[idx].sector < sector + count)) {
+        memcpy(buff + (cache_entry[idx].sector - sector) * FF_MAX_SS,
+               cache_buff[idx],
+               FF_MAX_SS);
+      }
+    }
+    return RES_OK;
+  }
+
+  idx = cache_find(pdrv, sector);
+  if (idx != CACHE_NONE) {
+    CACHE_STAT_ADD(read_hits, 1);
+  } else {
+    CACHE_STAT_ADD(read_misses, 1);
+    res = cache_alloc(pdrv, sector, &idx);
+    if (res != RES_OK) {
+      return res;
+    }
+    res = cache_media_read(pdrv, cache_buff[idx], sector, 1);
+    if (res != RES_OK) {
+      cache_drop(idx);
+      return res;
+    }
+#if SL_SDC_CACHE_PIN_METADATA
+    cache_detect_volume(pdrv, sector, cache_buff[idx]);
+#endif
+  }
+
+  cache_touch(idx);
+  memcpy(buff, cache_buff[idx], FF_MAX_SS);
+  return RES_OK;
+}
+
+/***************************************************************************//**
+ * Write Sector(s) through the cache.
+ ******************************************************************************/
+dresult_t sl_sdc_cache_write(BYTE pdrv,
+                             const BYTE *buff,
+                             LBA_t sector,
+                             UINT count)
+{
+  dresult_t res;
+  int idx;
+
+  if (!count) {
+    return RES_PARERR;
+  }
+
+#if SL_SDC_CACHE_WRITE_BACK
+  if (count == 1) {
+    idx = cache_find(pdrv, sector);
+    if (idx != CACHE_NONE) {
+      CACHE_STAT_ADD(write_hits, 1);
+    } else {
+      CACHE_STAT_ADD(write_misses, 1);
+      // The whole sector is overwritten, no need to read it first
+      res = cache_alloc(pdrv, sector, &idx);
+      if (res != RES_OK) {
+        return res;
+      }
+    }
+    memcpy(cache_buff[idx], buff, FF_MAX_SS);
+    cache_entry[idx].flags |= CACHE_DIRTY;
+    cache_touch(idx);
+#if SL_SDC_CACHE_PIN_METADATA
+    cache_detect_volume(pdrv, sector, buff);
+#endif
+    return RES_OK;
+  }
+#endif
+
+  res = cache_media_write(pdrv, buff, sector, count);
+  if (res != RES_OK) {
+    return res;
+  }
+  CACHE_STAT_ADD(bypass_sectors, count);
+
+  // Keep cached copies coherent with what is now on the media
+  for (idx = 0; idx < SL_SDC_CACHE_SECTOR_COUNT; idx++) {
+    if ((cache_entry[idx].flags & CACHE_VALID)
+        && (cache_entry[idx].pdrv == pdrv)
+        && (cache_entry[idx].sector >= sector)
+        && (cache_entry[idx].sector < sector + count)) {
+      memcpy(cache_buff[idx],
+             buff + (cache_entry[idx].sector - sector) * FF_MAX_SS,
+             FF_MAX_SS);
+      cache_entry[idx].flags &= ~CACHE_DIRTY;
+    }
+  }
+#if SL_SDC_CACHE_PIN_METADATA
+  if (count == 1) {
+    cache_detect_volume(pdrv, sector, buff);
+  }
+#endif
+
+  return RES_OK;
+}
+
+/***************************************************************************//**
+ * Device specific control through the cache.
+ ******************************************************************************/
+dresult_t sl_sdc_cache_ioctl(BYTE pdrv, BYTE cmd, void *buff)
+{
+  dresult_t res;
+  LBA_t *range;
+  int idx;
+
+  switch (cmd) {
+    case CTRL_SYNC:
+      res = sl_sdc_cache_sync(pdrv);
+      if (res != RES_OK) {
+        return res;
+      }
+      break;
+
+    case CTRL_TRIM:
+      // Trimmed sectors are no longer in use, drop them even when dirty
+      range = buff;
+      for (idx = 0; idx < SL_SDC_CACHE_SECTOR_COUNT; idx++) {
+        if ((cache_entry[idx].flags & CACHE_VALID)
+            && (cache_entry[idx].pdrv == pdrv)
+            && (cache_entry[idx].sector >= range[0])
+            && (cache_entry[idx].sector <= range[1])) {
+          cache_drop(idx);
+        }
+      }
+      break;
+
+    default:
+      break;
+  }
+
+  return cache_media_ioctl(pdrv, cmd, buff);
+}
+
+/***************************************************************************//**
+ * Write back all dirty sectors of a drive.
+ ******************************************************************************/
+dresult_t sl_sdc_cache_sync(BYTE pdrv)
+{
+  dresult_t res;
+  int idx;
+  int first;
+
+  // Write back in ascending sector order so every run starts at its lowest
+  // sector and extends upwards.
+  for (;; ) {
+    first = CACHE_NONE;
+    for (idx = 0; idx < SL_SDC_CACHE_SECTOR_COUNT; idx++) {
+      if ((cache_entry[idx].flags & CACHE_DIRTY)
+          && (cache_entry[idx].pdrv == pdrv)
+          && ((first == CACHE_NONE)
+              || (cache_entry[idx].sector < cache_entry[first].sector))) {
+        first = idx;
+      }
+    }
+    if (first == CACHE_NONE) {
+      return RES_OK;
+    }
+    res = cache_write_back(first);
+    if (res != RES_OK) {
+      return res;
+    }
+  }
+}
+
+/***************************************************************************//**
+ * Drop every cached sector and pinned region of a drive.
+ ******************************************************************************/
+void sl_sdc_cache_invalidate(BYTE pdrv)
+{
+  int idx;
+
+  for (idx = 0; idx < SL_SDC_CACHE_SECTOR_COUNT; idx++) {
+    if ((cache_entry[idx].flags & CACHE_VALID)
+        && (cache_entry[idx].pdrv == pdrv)) {
+      cache_drop(idx);
+    }
+  }
+  for (idx = 0; idx < SL_SDC_CACHE_PIN_REGION_COUNT; idx++) {
+    if (cache_pin_region[idx].pdrv == pdrv) {
+      cache_pin_region[idx].count = 0;
+    }
+  }
+}
+
+/***************************************************************************//**
+ * Pin a sector region in the cache.
+ ******************************************************************************/
+dresult_t sl_sdc_cache_pin_range(BYTE pdrv, LBA_t sector, LBA_t count)
+{
+  if (!count) {
+    return RES_PARERR;
+  }
+  return cache_add_region(pdrv, sector, count, false);
+}
+
+/***************************************************************************//**
+ * Get the cache statistics.
+ ******************************************************************************/
+void sl_sdc_cache_get_stats(sl_sdc_cache_stats_t *stats)
+{
+#if SL_SDC_CACHE_STATISTICS
+  *stats = cache_stats;
+#else
+  memset(stats, 0, sizeof(*stats));
+#endif
+}
+
+/***************************************************************************//**
+ * Clear the cache statistics.
+ ******************************************************************************/
+void sl_sdc_cache_reset_stats(void)
+{
+#if SL_SDC_CACHE_STATISTICS
+  memset(&cache_stats, 0, sizeof(cache_stats));
+#endif
+}
+
+/***************************************************************************//**
+ * Find a cached sector, returns its entry index or CACHE_NONE.
+ ******************************************************************************/
+static int cache_find(BYTE pdrv, LBA_t sector)
+{
+  int idx;
+
+  for (idx = 0; idx < SL_SDC_CACHE_SECTOR_COUNT; idx++) {
+    if ((cache_entry[idx].flags & CACHE_VALID)
+        && (cache_entry[idx].sector == sector)
+        && (cache_entry[idx].pdrv == pdrv)) {
+      return idx;
+    }
+  }
+  return CACHE_NONE;
+}
+
+/***************************************************************************//**
+ * Check if a sector belongs to a pinned region.
+ ******************************************************************************/
+static bool cache_sector_is_pinned(BYTE pdrv, LBA_t sector)
+{
+  int i;
+
+  for (i = 0; i < SL_SDC_CACHE_PIN_REGION_COUNT; i++) {
+    if (cache_pin_region[i].count
+        && (cache_pin_region[i].pdrv == pdrv)
+        && (sector >= cache_pin_region[i].start)
+        && (sector - cache_pin_region[i].start < cache_pin_region[i].count)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/***************************************************************************//**
+ * Update the pinned flag of an entry within the pinned sector budget.
+ ******************************************************************************/
+static void cache_set_pinned(int idx, bool pinned)
+{
+  if (pinned && !(cache_entry[idx].flags & CACHE_PINNED)) {
+    if (cache_pinned_count < SL_SDC_CACHE_MAX_PINNED) {
+      cache_entry[idx].flags |= CACHE_PINNED;
+      cache_pinned_count++;
+    }
+  } else if (!pinned && (cache_entry[idx].flags & CACHE_PINNED)) {
+    cache_entry[idx].flags &= ~CACHE_PINNED;
+    cache_pinned_count--;
+  }
+}
+
+/***************************************************************************//**
+ * Release an entry without writing it back.
+ ******************************************************************************/
+static void cache_drop(int idx)
+{
+  cache_set_pinned(idx, false);
+  cache_entry[idx].flags = 0;
+}
+
+/***************************************************************************//**
+ * Write back the run of consecutive dirty sectors containing an entry.
+ ******************************************************************************/
+static dresult_t cache_write_back(int idx)
+{
+  const BYTE *run_buff[SL_SDC_CACHE_MAX_WRITE_RUN];
+  int run_idx[SL_SDC_CACHE_MAX_WRITE_RUN];
+  BYTE pdrv = cache_entry[idx].pdrv;
+  LBA_t first = cache_entry[idx].sector;
+  UINT count = 1;
+  UINT i;
+  int next;
+  dresult_t res;
+
+  // Extend the run downwards, then upwards, as long as neighbours are dirty
+  while ((first > 0) && (count < SL_SDC_CACHE_MAX_WRITE_RUN)) {
+    next = cache_find(pdrv, first - 1);
+    if ((next == CACHE_NONE) || !(cache_entry[next].flags & CACHE_DIRTY)) {
+      break;
+    }
+    first--;
+    count++;
+  }
+  count = 0;
+  while (count < SL_SDC_CACHE_MAX_WRITE_RUN) {
+    next = cache_find(pdrv, first + count);
+    if ((next == CACHE_NONE) || !(cache_entry[next].flags & CACHE_DIRTY)) {
+      break;
+    }
+    run_idx[count] = next;
+    run_buff[count] = cache_buff[next];
+    count++;
+  }
+
+  res = cache_media_write_vector(pdrv, run_buff, first, count);
+  if (res != RES_OK) {
+    return res;
+  }
+  for (i = 0; i < count; i++) {
+    cache_entry[run_idx[i]].flags &= ~CACHE_DIRTY;
+  }
+  CACHE_STAT_ADD(writeback_runs, 1);
+  CACHE_STAT_ADD(writeback_sectors, count);
+
+  return RES_OK;
+}
+
+/***************************************************************************//**
+ * Allocate an entry for a sector, evicting the least recently used one.
+ ******************************************************************************/
+static dresult_t cache_alloc(BYTE pdrv, LBA_t sector, int *idx)
+{
+  int victim = CACHE_NONE;
+  int i;
+  dresult_t res;
+
+  for (i = 0; i < SL_SDC_CACHE_SECTOR_COUNT; i++) {
+    if (!(cache_entry[i].flags & CACHE_VALID)) {
+      victim = i;
+      break;
+    }
+    // Unpinned entries are always preferred over pinned ones
+    if ((victim == CACHE_NONE)
+        || ((cache_entry[victim].flags & CACHE_PINNED)
+            && !(cache_entry[i].flags & CACHE_PINNED))
+        || (((cache_entry[victim].flags ^ cache_entry[i].flags)
+             & CACHE_PINNED) == 0
+            && (cache_entry[i].last_use < cache_entry[victim].last_use))) {
+      victim = i;
+    }
+  }
+
+  if (cache_entry[victim].flags & CACHE_VALID) {
+    if (cache_entry[victim].flags & CACHE_DIRTY) {
+      res = cache_write_back(victim);
+      if (res != RES_OK) {
+        return res;
+      }
+    }
+    CACHE_STAT_ADD(evictions, 1);
+    cache_drop(victim);
+  }
+
+  cache_entry[victim].pdrv = pdrv;
+  cache_entry[victim].sector = sector;
+  cache_entry[victim].flags = CACHE_VALID;
+  cache_set_pinned(victim, cache_sector_is_pinned(pdrv, sector));
+  *idx = victim;
+
+  return RES_OK;
+}
+
+/***************************************************************************//**
+ * Mark an entry as most recently used.
+ ******************************************************************************/
+static void cache_touch(int idx)
+{
+  int i;
+
+  if (++cache_clock == 0) {
+    // Time stamp wrapped, restart every entry from the same age
+    for (i = 0; i < SL_SDC_CACHE_SECTOR_COUNT; i++) {
+      cache_entry[i].last_use = 0;
+    }
+    cache_clock = 1;
+  }
+  cache_entry[idx].last_use = cache_clock;
+}
+
+/***************************************************************************//**
+ * Add a pinned region and pin the sectors of it already in the cache.
+ ******************************************************************************/
+static dresult_t cache_add_region(BYTE pdrv,
+                                  LBA_t start,
+                                  LBA_t count,
+                                  bool automatic)
+{
+  int i;
+
+  for (i = 0; i < SL_SDC_CACHE_PIN_REGION_COUNT; i++) {
+    if (!cache_pin_region[i].count) {
+      cache_pin_region[i].pdrv = pdrv;
+      cache_pin_region[i].start = start;
+      cache_pin_region[i].count = count;
+      cache_pin_region[i].automatic = automatic;
+      break;
+    }
+  }
+  if (i == SL_SDC_CACHE_PIN_REGION_COUNT) {
+    return RES_ERROR;
+  }
+
+  for (i = 0; i < SL_SDC_CACHE_SECTOR_COUNT; i++) {
+    if ((cache_entry[i].flags & CACHE_VALID)
+        && (cache_entry[i].pdrv == pdrv)
+        && (cache_entry[i].sector >= start)
+        && (cache_entry[i].sector - start < count)) {
+      cache_set_pinned(i, true);
+    }
+  }
+
+  return RES_OK;
+}
+
+#if SL_SDC_CACHE_PIN_METADATA
+
+/***************************************************************************//**
+ * Load a little-endian word/double word from a sector buffer.
+ ******************************************************************************/
+static WORD cache_ld_word(const BYTE *ptr)
+{
+  return (WORD)ptr[0] | ((WORD)ptr[1] << 8);
+}
+
+static DWORD cache_ld_dword(const BYTE *ptr)
+{
+  return (DWORD)ptr[0] | ((DWORD)ptr[1] << 8)
+         | ((DWORD)ptr[2] << 16) | ((DWORD)ptr[3] << 24);
+}
+
+/***************************************************************************//**
+ * Record the partition starts of an MBR, where boot sectors are looked for.
+ * GPT partitions are not followed.
+ ******************************************************************************/
+static void cache_detect_partitions(BYTE pdrv, const BYTE *buff)
+{
+  const BYTE *entry;
+  LBA_t start;
+  int i, j;
+
+  for (i = 0; i < CACHE_PART_COUNT; i++) {
+    if (cache_part[i].pdrv == pdrv) {
+      cache_part[i].start = 0;
+    }
+  }
+  if (buff == NULL) {
+    return;
+  }
+
+  for (j = 0; j < CACHE_PART_COUNT; j++) {
+    entry = buff + 446 + 16 * j;
+    start = cache_ld_dword(entry + 8);
+    if ((entry[4] == 0x00) || (entry[4] == 0xEE) || (start == 0)) {
+      continue;
+    }
+    for (i = 0; i < CACHE_PART_COUNT; i++) {
+      if (cache_part[i].start == 0) {
+        cache_part[i].start = start;
+        cache_part[i].pdrv = pdrv;
+        break;
+      }
+    }
+  }
+}
+
+/***************************************************************************//**
+ * Pin the FAT and root directory regions described by a boot sector.
+ * Only sector 0 and the partition starts found in the MBR are checked.
+ * Refer to http://elm-chan.org/docs/fat_e.html for the boot sector layout.
+ ******************************************************************************/
+static void cache_detect_volume(BYTE pdrv, LBA_t sector, const BYTE *buff)
+{
+  LBA_t fat_base;
+  LBA_t data_base;
+  DWORD fat_size;
+  DWORD root_clust;
+  WORD root_ent;
+  WORD cluster_size;
+  int i;
+
+  if (sector != 0) {
+    for (i = 0; i < CACHE_PART_COUNT; i++) {
+      if ((cache_part[i].start == sector) && (cache_part[i].pdrv == pdrv)) {
+        break;
+      }
+    }
+    if (i == CACHE_PART_COUNT) {
+      return;
+    }
+  }
+
+  if (cache_ld_word(buff + 510) != 0xAA55) {
+    if (sector == 0) {
+      cache_detect_partitions(pdrv, NULL);
+    }
+    return;
+  }
+
+  if (memcmp(buff + 3, "EXFAT   ", 8) == 0) {
+    fat_base = sector + cache_ld_dword(buff + 80);
+    fat_size = cache_ld_dword(buff + 84);
+    data_base = sector + cache_ld_dword(buff + 88);
+    root_clust = cache_ld_dword(buff + 96);
+    cluster_size = (WORD)(1u << buff[109]);
+    root_ent = 0;
+  } else if (((buff[0] == 0xEB) || (buff[0] == 0xE9) || (buff[0] == 0xE8))
+             && (cache_ld_word(buff + 11) == FF_MAX_SS)
+             && buff[13] && !(buff[13] & (buff[13] - 1))
+             && ((buff[16] == 1) || (buff[16] == 2))
+             && cache_ld_word(buff + 14)) {
+    fat_size = cache_ld_word(buff + 22);
+    if (!fat_size) {
+      fat_size = cache_ld_dword(buff + 36);
+    }
+    fat_base = sector + cache_ld_word(buff + 14);
+    fat_size *= buff[16];
+    root_ent = cache_ld_word(buff + 17);
+    data_base = fat_base + fat_size
+                + (LBA_t)root_ent * 32 / FF_MAX_SS;
+    root_clust = cache_ld_dword(buff + 44);
+    cluster_size = buff[13];
+  } else {
+    if (sector == 0) {
+      cache_detect_partitions(pdrv, buff);
+    }
+    return;
+  }
+
+  if (sector == 0) {
+    // Volume without a partition table
+    cache_detect_partitions(pdrv, NULL);
+  }
+
+  // A new volume replaces the regions found for the previous one
+  for (i = 0; i < SL_SDC_CACHE_PIN_REGION_COUNT; i++) {
+    if (cache_pin_region[i].automatic && (cache_pin_region[i].pdrv == pdrv)) {
+      cache_pin_region[i].count = 0;
+    }
+  }
+  for (i = 0; i < SL_SDC_CACHE_SECTOR_COUNT; i++) {
+    if ((cache_entry[i].flags & CACHE_VALID) && (cache_entry[i].pdrv == pdrv)) {
+      cache_set_pinned(i, cache_sector_is_pinned(pdrv, cache_entry[i].sector));
+    }
+  }
+
+  cache_add_region(pdrv, fat_base, fat_size, true);
+  if (root_ent) {
+    // FAT12/16: fixed root directory between the FAT and the data area
+    cache_add_region(pdrv,
+                     fat_base + fat_size,
+                     (LBA_t)root_ent * 32 / FF_MAX_SS,
+                     true);
+  } else if (root_clust >= 2) {
+    // FAT32/exFAT: first cluster of the root directory
+    cache_add_region(pdrv,
+                     data_base + (LBA_t)(root_clust - 2) * cluster_size,
+                     cluster_size,
+                     true);
+  }
+}
+
+#endif // SL_SDC_CACHE_PIN_METADATA
+
+#endif // SL_SDC_CACHE_ENABLE
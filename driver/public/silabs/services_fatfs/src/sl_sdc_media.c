@@ -34,6 +34,9 @@
  ******************************************************************************/
 #include "ff.h"
 #include "diskio.h"
+#include "sl_sdc_media.h"
+#include "sl_sdc_cache.h"
+#include "sl_sdc_async.h"
 #include "sl_sleeptimer.h"
 #include "sl_component_catalog.h"
 
@@ -45,6 +48,20 @@
 #include "sl_sdc_flash.h"
 #endif
 
+#if defined(SL_CATALOG_FATFS_STORAGE_DEVICE_RAM_DISK_PRESENT)
+#include "sl_sdc_ram_disk.h"
+
+#if defined(SL_CATALOG_FATFS_STORAGE_DEVICE_SDCARD_PRESENT) \
+  && (RAM_DISK == SD_CARD_MMC)
+#error "SL_SDC_RAM_DISK_PDRV is the drive number of the SD card"
+#endif
+
+#if defined(SL_CATALOG_FATFS_STORAGE_DEVICE_FLASH_PRESENT) \
+  && (RAM_DISK == FLASH)
+#error "SL_SDC_RAM_DISK_PDRV is the drive number of the flash storage"
+#endif
+#endif
+
 /***************************************************************************//**
  * Get Drive Status.
  ******************************************************************************/
@@ -61,6 +78,11 @@ DSTATUS disk_status(BYTE pdrv)
       return flash_disk_status();
 #endif
 
+#if defined(SL_CATALOG_FATFS_STORAGE_DEVICE_RAM_DISK_PRESENT)
+    case RAM_DISK:
+      return sl_sdc_ram_disk_status();
+#endif
+
     default:
       break;
   }
@@ -72,6 +94,11 @@ DSTATUS disk_status(BYTE pdrv)
  ******************************************************************************/
 DSTATUS disk_initialize(BYTE pdrv)
 {
+#if SL_SDC_CACHE_ENABLE
+  // Whatever was cached belongs to the previous medium
+  sl_sdc_cache_invalidate(pdrv);
+#endif
+
   switch (pdrv) {
 #if defined(SL_CATALOG_FATFS_STORAGE_DEVICE_SDCARD_PRESENT)
     case SD_CARD_MMC:
@@ -83,6 +110,11 @@ DSTATUS disk_initialize(BYTE pdrv)
       return flash_disk_initialize();
 #endif
 
+#if defined(SL_CATALOG_FATFS_STORAGE_DEVICE_RAM_DISK_PRESENT)
+    case RAM_DISK:
+      return sl_sdc_ram_disk_initialize();
+#endif
+
     default:
       break;
   }
@@ -90,9 +122,9 @@ DSTATUS disk_initialize(BYTE pdrv)
 }
 
 /***************************************************************************//**
- * Read Sector(s).
+ * Read Sector(s) directly from the storage device.
  ******************************************************************************/
-dresult_t disk_read(BYTE pdrv, BYTE *buff, LBA_t sector, UINT count)
+dresult_t sl_sdc_media_read(BYTE pdrv, BYTE *buff, LBA_t sector, UINT count)
 {
   switch (pdrv) {
 #if defined(SL_CATALOG_FATFS_STORAGE_DEVICE_SDCARD_PRESENT)
@@ -105,6 +137,11 @@ dresult_t disk_read(BYTE pdrv, BYTE *buff, LBA_t sector, UINT count)
       return flash_disk_read(buff, sector, count);
 #endif
 
+#if defined(SL_CATALOG_FATFS_STORAGE_DEVICE_RAM_DISK_PRESENT)
+    case RAM_DISK:
+      return sl_sdc_ram_disk_read(buff, sector, count);
+#endif
+
     default:
       break;
   }
@@ -112,9 +149,12 @@ dresult_t disk_read(BYTE pdrv, BYTE *buff, LBA_t sector, UINT count)
 }
 
 /***************************************************************************//**
- * Write Sector(s).
+ * Write Sector(s) directly to the storage device.
  ******************************************************************************/
-dresult_t disk_write(BYTE pdrv, const BYTE *buff, LBA_t sector, UINT count)
+dresult_t sl_sdc_media_write(BYTE pdrv,
+                             const BYTE *buff,
+                             LBA_t sector,
+                             UINT count)
 {
   switch (pdrv) {
 #if defined(SL_CATALOG_FATFS_STORAGE_DEVICE_SDCARD_PRESENT)
@@ -127,6 +167,11 @@ dresult_t disk_write(BYTE pdrv, const BYTE *buff, LBA_t sector, UINT count)
       return flash_disk_write(buff, sector, count);
 #endif
 
+#if defined(SL_CATALOG_FATFS_STORAGE_DEVICE_RAM_DISK_PRESENT)
+    case RAM_DISK:
+      return sl_sdc_ram_disk_write(buff, sector, count);
+#endif
+
     default:
       break;
   }
@@ -134,10 +179,79 @@ dresult_t disk_write(BYTE pdrv, const BYTE *buff, LBA_t sector, UINT count)
 }
 
 /***************************************************************************//**
- *  The disk_ioctl function is called to control device specific features
- *  and miscellaneous functions other than generic read/write.
+ * Read consecutive sectors into separate buffers.
  ******************************************************************************/
-dresult_t disk_ioctl(BYTE pdrv, BYTE cmd, void *buff)
+dresult_t sl_sdc_media_read_vector(BYTE pdrv,
+                                   BYTE *const *buffs,
+                                   LBA_t sector,
+                                   UINT count)
+{
+  dresult_t res;
+
+  switch (pdrv) {
+#if defined(SL_CATALOG_FATFS_STORAGE_DEVICE_SDCARD_PRESENT)
+    case SD_CARD_MMC:
+      return sd_card_disk_read_vector(buffs, sector, count);
+#endif
+
+#if defined(SL_CATALOG_FATFS_STORAGE_DEVICE_RAM_DISK_PRESENT)
+    case RAM_DISK:
+      return sl_sdc_ram_disk_read_vector(buffs, sector, count);
+#endif
+
+    default:
+      break;
+  }
+
+  // No multiple buffer support in the device, read sector by sector
+  for (; count; count--) {
+    res = sl_sdc_media_read(pdrv, *buffs++, sector++, 1);
+    if (res != RES_OK) {
+      return res;
+    }
+  }
+  return RES_OK;
+}
+
+/***************************************************************************//**
+ * Write consecutive sectors held in separate buffers.
+ ******************************************************************************/
+dresult_t sl_sdc_media_write_vector(BYTE pdrv,
+                                    const BYTE *const *buffs,
+                                    LBA_t sector,
+                                    UINT count)
+{
+  dresult_t res;
+
+  switch (pdrv) {
+#if defined(SL_CATALOG_FATFS_STORAGE_DEVICE_SDCARD_PRESENT)
+    case SD_CARD_MMC:
+      return sd_card_disk_write_vector(buffs, sector, count);
+#endif
+
+#if defined(SL_CATALOG_FATFS_STORAGE_DEVICE_RAM_DISK_PRESENT)
+    case RAM_DISK:
+      return sl_sdc_ram_disk_write_vector(buffs, sector, count);
+#endif
+
+    default:
+      break;
+  }
+
+  // No multiple buffer support in the device, write sector by sector
+  for (; count; count--) {
+    res = sl_sdc_media_write(pdrv, *buffs++, sector++, 1);
+    if (res != RES_OK) {
+      return res;
+    }
+  }
+  return RES_OK;
+}
+
+/***************************************************************************//**
+ * Device specific control of the storage device.
+ ******************************************************************************/
+dresult_t sl_sdc_media_ioctl(BYTE pdrv, BYTE cmd, void *buff)
 {
   switch (pdrv) {
 #if defined(SL_CATALOG_FATFS_STORAGE_DEVICE_SDCARD_PRESENT)
@@ -150,12 +264,60 @@ dresult_t disk_ioctl(BYTE pdrv, BYTE cmd, void *buff)
       return flash_disk_ioctl(cmd, buff);
 #endif
 
+#if defined(SL_CATALOG_FATFS_STORAGE_DEVICE_RAM_DISK_PRESENT)
+    case RAM_DISK:
+      return sl_sdc_ram_disk_ioctl(cmd, buff);
+#endif
+
     default:
       break;
   }
   return RES_PARERR;
 }
 
+/***************************************************************************//**
+ * Read Sector(s).
+ ******************************************************************************/
+dresult_t disk_read(BYTE pdrv, BYTE *buff, LBA_t sector, UINT count)
+{
+#if SL_SDC_CACHE_ENABLE
+  return sl_sdc_cache_read(pdrv, buff, sector, count);
+#elif SL_SDC_ASYNC_ENABLE
+  return sl_sdc_async_read(pdrv, buff, sector, count);
+#else
+  return sl_sdc_media_read(pdrv, buff, sector, count);
+#endif
+}
+
+/***************************************************************************//**
+ * Write Sector(s).
+ ******************************************************************************/
+dresult_t disk_write(BYTE pdrv, const BYTE *buff, LBA_t sector, UINT count)
+{
+#if SL_SDC_CACHE_ENABLE
+  return sl_sdc_cache_write(pdrv, buff, sector, count);
+#elif SL_SDC_ASYNC_ENABLE
+  return sl_sdc_async_write(pdrv, buff, sector, count);
+#else
+  return sl_sdc_media_write(pdrv, buff, sector, count);
+#endif
+}
+
+/***************************************************************************//**
+ *  The disk_ioctl function is called to control device specific features
+ *  and miscellaneous functions other than generic read/write.
+ ******************************************************************************/
+dresult_t disk_ioctl(BYTE pdrv, BYTE cmd, void *buff)
+{
+#if SL_SDC_CACHE_ENABLE
+  return sl_sdc_cache_ioctl(pdrv, cmd, buff);
+#elif SL_SDC_ASYNC_ENABLE
+  return sl_sdc_async_ioctl(pdrv, cmd, buff);
+#else
+  return sl_sdc_media_ioctl(pdrv, cmd, buff);
+#endif
+}
+
 /***************************************************************************//**
  * @brief
  *   Get current time.
@@ -0,0 +1,348 @@
+/***************************************************************************//**
+ * @file sl_sdc_ram_disk.c
+ * @brief Storage Device Controls RAM disk
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ ********************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided \'as-is\', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+#include <string.h>
+#include "sl_sdc_ram_disk.h"
+
+// -----------------------------------------------------------------------------
+// Local Variables
+
+#if SL_SDC_RAM_DISK_SECTOR_COUNT > 0
+static BYTE ram_disk_builtin[SL_SDC_RAM_DISK_SECTOR_COUNT][FF_MAX_SS];
+#define RAM_DISK_BUILTIN_IMAGE   ((BYTE *)ram_disk_builtin)
+#else
+#define RAM_DISK_BUILTIN_IMAGE   NULL
+#endif
+
+static BYTE *ram_disk_image = RAM_DISK_BUILTIN_IMAGE;
+static LBA_t ram_disk_sector_count = SL_SDC_RAM_DISK_SECTOR_COUNT;
+static DSTATUS ram_disk_status = STA_NOINIT;
+
+static sl_sdc_ram_disk_latency_t ram_disk_latency = {
+  .command_us = SL_SDC_RAM_DISK_COMMAND_US,
+  .read_block_us = SL_SDC_RAM_DISK_READ_BLOCK_US,
+  .write_block_us = SL_SDC_RAM_DISK_WRITE_BLOCK_US,
+  .program_busy_us = SL_SDC_RAM_DISK_PROGRAM_BUSY_US,
+  .poll_us = SL_SDC_RAM_DISK_POLL_US,
+};
+
+static sl_sdc_ram_disk_stats_t ram_disk_stats;
+static uint64_t ram_disk_busy_until; // Simulated time the programming ends
+
+static bool ram_disk_power_loss_armed;
+static bool ram_disk_power_loss_torn;
+static uint32_t ram_disk_power_loss_countdown;
+
+// -----------------------------------------------------------------------------
+// Local Functions
+
+/***************************************************************************//**
+ * Start a command, waiting for the end of a previous programming.
+ ******************************************************************************/
+static dresult_t start_command(LBA_t sector, UINT count)
+{
+  if (ram_disk_status & STA_NOINIT) {
+    return RES_NOTRDY;
+  }
+  if (!count || (sector >= ram_disk_sector_count)
+      || (count > ram_disk_sector_count - sector)) {
+    return RES_PARERR;
+  }
+
+  if (ram_disk_stats.elapsed_us < ram_disk_busy_until) {
+    ram_disk_stats.elapsed_us = ram_disk_busy_until;
+  }
+  ram_disk_stats.elapsed_us += ram_disk_latency.command_us;
+  return RES_OK;
+}
+
+/***************************************************************************//**
+ * Program one sector, or lose the power while doing so.
+ ******************************************************************************/
+static bool program_sector(const BYTE *buff, LBA_t sector)
+{
+  BYTE *dst = ram_disk_image + (size_t)sector * FF_MAX_SS;
+
+  if (ram_disk_power_loss_armed && !ram_disk_power_loss_countdown--) {
+    if (ram_disk_power_loss_torn) {
+      memcpy(dst, buff, FF_MAX_SS / 2);
+    }
+    ram_disk_power_loss_armed = false;
+    ram_disk_status |= STA_NOINIT;
+    ram_disk_stats.power_losses++;
+    return false;
+  }
+
+  memcpy(dst, buff, FF_MAX_SS);
+  ram_disk_stats.write_sectors++;
+  ram_disk_stats.elapsed_us += ram_disk_latency.write_block_us;
+  ram_disk_busy_until = ram_disk_stats.elapsed_us
+                        + ram_disk_latency.program_busy_us;
+  return true;
+}
+
+/***************************************************************************//**
+ * Read sectors into one buffer or separate buffers.
+ ******************************************************************************/
+static dresult_t read_sectors(BYTE *const *buffs,
+                              BYTE *buff,
+                              LBA_t sector,
+                              UINT count)
+{
+  dresult_t res = start_command(sector, count);
+
+  if (res != RES_OK) {
+    return res;
+  }
+  ram_disk_stats.read_commands++;
+
+  for (; count; count--, sector++) {
+    memcpy(buffs ? *buffs++ : buff,
+           ram_disk_image + (size_t)sector * FF_MAX_SS,
+           FF_MAX_SS);
+    if (!buffs) {
+      buff += FF_MAX_SS;
+    }
+    ram_disk_stats.read_sectors++;
+    ram_disk_stats.elapsed_us += ram_disk_latency.read_block_us;
+  }
+  return RES_OK;
+}
+
+/***************************************************************************//**
+ * Write sectors from one buffer or separate buffers.
+ ******************************************************************************/
+static dresult_t write_sectors(const BYTE *const *buffs,
+                               const BYTE *buff,
+                               LBA_t sector,
+                               UINT count)
+{
+  dresult_t res = start_command(sector, count);
+
+  if (res != RES_OK) {
+    return res;
+  }
+  ram_disk_stats.write_commands++;
+
+  for (; count; count--, sector++) {
+    // Each sector of a multiple block write waits for the previous one
+    if (ram_disk_stats.elapsed_us < ram_disk_busy_until) {
+      ram_disk_stats.elapsed_us = ram_disk_busy_until;
+    }
+    if (!program_sector(buffs ? *buffs++ : buff, sector)) {
+      return RES_NOTRDY;
+    }
+    if (!buffs) {
+      buff += FF_MAX_SS;
+    }
+  }
+  return RES_OK;
+}
+
+// -----------------------------------------------------------------------------
+// Global Functions
+
+/***************************************************************************//**
+ * Get Drive Status.
+ ******************************************************************************/
+DSTATUS sl_sdc_ram_disk_status(void)
+{
+  return ram_disk_status;
+}
+
+/***************************************************************************//**
+ * Initialize the RAM disk.
+ ******************************************************************************/
+DSTATUS sl_sdc_ram_disk_initialize(void)
+{
+  if (ram_disk_image && (ram_disk_sector_count > 0)) {
+    ram_disk_status &= ~STA_NOINIT;
+  }
+  return ram_disk_status;
+}
+
+/***************************************************************************//**
+ * Read Sector(s) from the RAM disk.
+ ******************************************************************************/
+dresult_t sl_sdc_ram_disk_read(BYTE *buff, LBA_t sector, UINT count)
+{
+  return read_sectors(NULL, buff, sector, count);
+}
+
+/***************************************************************************//**
+ * Write Sector(s) to the RAM disk.
+ ******************************************************************************/
+dresult_t sl_sdc_ram_disk_write(const BYTE *buff, LBA_t sector, UINT count)
+{
+  return write_sectors(NULL, buff, sector, count);
+}
+
+/***************************************************************************//**
+ * Read consecutive sectors into separate buffers with one command.
+ ******************************************************************************/
+dresult_t sl_sdc_ram_disk_read_vector(BYTE *const *buffs,
+                                      LBA_t sector,
+                                      UINT count)
+{
+  return read_sectors(buffs, NULL, sector, count);
+}
+
+/***************************************************************************//**
+ * Write consecutive sectors held in separate buffers with one command.
+ ******************************************************************************/
+dresult_t sl_sdc_ram_disk_write_vector(const BYTE *const *buffs,
+                                       LBA_t sector,
+                                       UINT count)
+{
+  return write_sectors(buffs, NULL, sector, count);
+}
+
+/***************************************************************************//**
+ * Miscellaneous Functions of the RAM disk.
+ ******************************************************************************/
+dresult_t sl_sdc_ram_disk_ioctl(BYTE cmd, void *buff)
+{
+  LBA_t *range;
+
+  if (ram_disk_status & STA_NOINIT) {
+    return RES_NOTRDY;
+  }
+
+  switch (cmd) {
+    case CTRL_SYNC:
+      ram_disk_stats.sync_commands++;
+      if (ram_disk_stats.elapsed_us < ram_disk_busy_until) {
+        ram_disk_stats.elapsed_us = ram_disk_busy_until;
+      }
+      return RES_OK;
+
+    case GET_SECTOR_COUNT:
+      *(LBA_t *)buff = ram_disk_sector_count;
+      return RES_OK;
+
+    case GET_SECTOR_SIZE:
+      *(WORD *)buff = FF_MAX_SS;
+      return RES_OK;
+
+    case GET_BLOCK_SIZE:
+      *(DWORD *)buff = SL_SDC_RAM_DISK_BLOCK_SIZE;
+      return RES_OK;
+
+    case CTRL_TRIM:
+      range = (LBA_t *)buff;
+      if ((range[0] > range[1]) || (range[1] >= ram_disk_sector_count)) {
+        return RES_PARERR;
+      }
+      ram_disk_stats.trim_commands++;
+      return RES_OK;
+
+    case MMC_GET_READY:
+      ram_disk_stats.elapsed_us += ram_disk_latency.poll_us;
+      *(BYTE *)buff = ram_disk_stats.elapsed_us >= ram_disk_busy_until;
+      if (!*(BYTE *)buff) {
+        ram_disk_stats.busy_polls++;
+      }
+      return RES_OK;
+
+    default:
+      break;
+  }
+  return RES_PARERR;
+}
+
+/***************************************************************************//**
+ * Replace the built-in image with an application provided one.
+ ******************************************************************************/
+void sl_sdc_ram_disk_attach(BYTE *image, LBA_t sector_count)
+{
+  if (image) {
+    ram_disk_image = image;
+    ram_disk_sector_count = sector_count;
+  } else {
+    ram_disk_image = RAM_DISK_BUILTIN_IMAGE;
+    ram_disk_sector_count = SL_SDC_RAM_DISK_SECTOR_COUNT;
+  }
+  ram_disk_status = STA_NOINIT;
+}
+
+/***************************************************************************//**
+ * Change the latency model.
+ ******************************************************************************/
+void sl_sdc_ram_disk_set_latency(const sl_sdc_ram_disk_latency_t *latency)
+{
+  if (latency) {
+    ram_disk_latency = *latency;
+  } else {
+    ram_disk_latency.command_us = SL_SDC_RAM_DISK_COMMAND_US;
+    ram_disk_latency.read_block_us = SL_SDC_RAM_DISK_READ_BLOCK_US;
+    ram_disk_latency.write_block_us = SL_SDC_RAM_DISK_WRITE_BLOCK_US;
+    ram_disk_latency.program_busy_us = SL_SDC_RAM_DISK_PROGRAM_BUSY_US;
+    ram_disk_latency.poll_us = SL_SDC_RAM_DISK_POLL_US;
+  }
+}
+
+/***************************************************************************//**
+ * Inject a power loss.
+ ******************************************************************************/
+void sl_sdc_ram_disk_inject_power_loss(uint32_t sectors_before, bool torn)
+{
+  ram_disk_power_loss_countdown = sectors_before;
+  ram_disk_power_loss_torn = torn;
+  ram_disk_power_loss_armed = true;
+}
+
+/***************************************************************************//**
+ * Cancel a pending power loss injection.
+ ******************************************************************************/
+void sl_sdc_ram_disk_cancel_power_loss(void)
+{
+  ram_disk_power_loss_armed = false;
+}
+
+/***************************************************************************//**
+ * Get the RAM disk statistics.
+ ******************************************************************************/
+void sl_sdc_ram_disk_get_stats(sl_sdc_ram_disk_stats_t *stats)
+{
+  *stats = ram_disk_stats;
+}
+
+/***************************************************************************//**
+ * Clear the RAM disk statistics and the simulated clock.
+ ******************************************************************************/
+void sl_sdc_ram_disk_reset_stats(void)
+{
+  memset(&ram_disk_stats, 0, sizeof(ram_disk_stats));
+  ram_disk_busy_until = 0;
+}
@@ -47,6 +47,20 @@
 // <i> Default: 0
 #define NFC_NCI_TML_DBG       0
 
+// <o NFC_NCI_PACKET_QUEUE_SIZE> Number of received packets buffered
+// <i> Packets are read from the NFCC as soon as it signals them and wait
+// <i> in this queue until they are returned as events.
+// <i> Default: 4
+#define NFC_NCI_PACKET_QUEUE_SIZE         4
+
+// <o NFC_NCI_DATA_MESSAGE_MAX_LEN> Maximum length of a segmented data message
+// <i> Size of the buffers used to reassemble the received data messages and
+// <i> to hold the segments of a data message waiting for credits. Must hold
+// <i> at least one data packet payload (255 bytes).
+// <i> Default: 512
+// <255-65535>
+#define NFC_NCI_DATA_MESSAGE_MAX_LEN      512
+
 // </h>
 // <<< end of configuration section >>>
 
@@ -78,6 +78,10 @@ extern "C" {
 #define NCI_PACKET_OID_M                                    (0x3F)
 #define NCI_PACKET_OID_SHIFT                                (0)
 
+#define NCI_CONN_ID_STATIC_RF                               (0)
+#define NCI_CONN_ID_MAX_NUM                                 (16)
+#define NCI_CONN_CREDITS_FLOW_CONTROL_OFF                   (0xFF)
+
 #define NCI_NFCEE_ID_DH_NFCEE                               (0)
 
 #define NCI_RF_LMR_POWER_STATE_BATTERY_OFF_M                (0x04)
@@ -369,7 +373,7 @@ typedef struct {
 typedef struct {
   uint8_t  pbf;
   uint8_t  conn_id;
-  uint8_t  payload_len;
+  uint16_t payload_len;
   uint8_t *payload;
 } nci_data_packet_t;
 
@@ -378,6 +382,11 @@ typedef struct {
   uint8_t *payload;
 } nci_rec_data_packet_t;
 
+typedef struct {
+  uint8_t  conn_id;
+  uint16_t unsent_len;
+} nci_dropped_data_packet_t;
+
 /**********************************
 *           Core Reset           *
 **********************************/
@@ -485,6 +494,8 @@ typedef struct {
 **********************************/
 
 typedef struct {
+  uint8_t  num_of_entries;
+  uint8_t *entries;
 } nci_core_conn_credits_ntf_t;
 
 /**********************************
@@ -757,6 +768,7 @@ typedef struct {
 
 typedef union {
   nci_rec_data_packet_t                       rec_data_packet;
+  nci_dropped_data_packet_t                   dropped_data_packet;
 
   /* NCI Core */
   nci_core_reset_rsp_t                        core_reset_rsp;
@@ -795,7 +807,7 @@ typedef union {
 } nci_data_t;
 
 typedef struct {
-  uint8_t                                     len;
+  uint16_t                                    len;
   bool                                        is_terminator_packet;
   union {
     nci_data_t                              nci_data;
@@ -825,6 +837,12 @@ void nci_init(void);
  * @brief
  *  Get current NCI event.
  *
+ * @details
+ *  The packets signaled by the NFCC are read into a queue of
+ *  NFC_NCI_PACKET_QUEUE_SIZE packets and returned one event per call.
+ *  Segmented data messages are returned as one event once reassembled.
+ *  The event and the data it points to are valid until the next call.
+ *
  * @returns
  *  Pointer to current NCI event.
  ******************************************************************************/
@@ -847,15 +865,31 @@ void nci_notify_incoming_packet(void);
  ******************************************************************************/
 bool nci_check_incoming_packet(void);
 
+/***************************************************************************//**
+ * @brief
+ *  Check if a data message is waiting for credits to be sent.
+ *
+ * @returns
+ *  true  - if segments of a data message are not sent yet.
+ *  false - if a new data message can be sent.
+ ******************************************************************************/
+bool nci_check_outgoing_data_packet(void);
+
 /***************************************************************************//**
  * @brief
  *  Encode and send a NCI data packet.
  *
+ * @details
+ *  Payloads up to NFC_NCI_DATA_MESSAGE_MAX_LEN bytes are segmented according
+ *  to the maximum data packet payload size of the connection. The segments
+ *  not covered by the credits of the connection are sent by nci_get_event()
+ *  when CORE_CONN_CREDITS_NTF returns credits.
+ *
  * @param[in] packet
  *  NCI data packet to be sent.
  *
  * @returns
- *  Any error code.
+ *  Any error code, nci_err_busy if the previous data message is not sent yet.
  ******************************************************************************/
 nci_err_t nci_data_packet_send(nci_data_packet_t *packet);
 
@@ -1051,8 +1085,8 @@ nci_err_t nci_nfcee_mode_set(nci_nfcee_mode_set_cmd_t *cmd);
 
 /***************************************************************************//**
  * @brief
- *  Parse the incoming packet header and send to corresponding processing
- *  functions.
+ *  Take the oldest packet of the packet queue and decode it into the NCI
+ *  event.
  *
  * @returns
  *  Any error code.
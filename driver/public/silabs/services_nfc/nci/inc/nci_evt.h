@@ -41,6 +41,7 @@ typedef enum {
   nci_evt_none,
   nci_evt_startup,
   nci_evt_data_packet_rec,
+  nci_evt_data_packet_dropped,
 
   /* NCI Core */
   nci_evt_core_reset_rsp_rec,
@@ -43,18 +43,71 @@
 #define NCI_PACKET_MAX_LEN \
   (NCI_PACKET_HEADER_LEN + NCI_PACKET_PAYLOAD_MAX_LEN)
 
+/* A reassembled message must hold at least one data packet. */
+#if NFC_NCI_DATA_MESSAGE_MAX_LEN < NCI_PACKET_PAYLOAD_MAX_LEN
+#error "NFC_NCI_DATA_MESSAGE_MAX_LEN must be at least 255."
+#endif
+
+/// Flow control state of a logical connection.
+typedef struct {
+  uint8_t credits;
+  uint8_t max_payload_len;
+} nci_conn_t;
+
 static uint16_t nci_tml_mtu = NCI_PACKET_MAX_LEN;
-static uint8_t packet_buff[NCI_PACKET_MAX_LEN];
+static uint8_t *packet_buff;
 static nci_evt_t nci_evt;
-static volatile bool packet_ready = false;
 static bool startup_event_passed = false;
 
+/* Received packets, filled by nci_packet_queue_fill(). */
+static uint8_t packet_queue[NFC_NCI_PACKET_QUEUE_SIZE][NCI_PACKET_MAX_LEN];
+static uint8_t packet_queue_head = 0;
+static uint8_t packet_queue_tail = 0;
+static uint8_t packet_queue_count = 0;
+static bool packet_queue_tail_in_use = false;
+
+/* Only written by the ISR and by the main loop respectively. */
+static volatile uint8_t packet_notify_count = 0;
+static uint8_t packet_receive_count = 0;
+
+static uint8_t tx_packet_buff[NCI_PACKET_MAX_LEN];
+
+/* Reassembly of segmented data messages. */
+static uint8_t rx_message_buff[NFC_NCI_DATA_MESSAGE_MAX_LEN];
+static uint16_t rx_message_len = 0;
+
+/* Segments of a data message waiting for credits. */
+static uint8_t tx_message_buff[NFC_NCI_DATA_MESSAGE_MAX_LEN];
+static uint16_t tx_message_len = 0;
+static uint16_t tx_message_index = 0;
+static uint8_t tx_message_conn_id;
+static uint8_t tx_message_pbf;
+static bool tx_message_pending = false;
+static bool tx_message_dropped = false;
+
+static nci_conn_t nci_conn[NCI_CONN_ID_MAX_NUM];
+
 extern nci_err_t nci_incoming_proprietary_packet_rsp_process(
   uint8_t *packet_buff);
 
 extern nci_err_t nci_incoming_proprietary_packet_ntf_process(
   uint8_t *packet_buff);
 
+static void nci_conn_reset(void);
+static void nci_packet_queue_release(void);
+static nci_err_t nci_packet_queue_fill(void);
+static void nci_flow_control_process(const uint8_t *packet);
+static bool nci_data_packet_reassemble(void);
+static nci_err_t nci_packet_decode(void);
+static nci_err_t nci_data_segments_send(uint8_t conn_id,
+                                        uint8_t pbf,
+                                        const uint8_t *payload,
+                                        uint16_t payload_len,
+                                        uint16_t *index,
+                                        bool *is_sent);
+static nci_err_t nci_data_message_flush(void);
+static void nci_data_message_drop(void);
+
 /***************************************************************************//**
  * @brief
  *  Initialize NCI.
@@ -62,26 +115,74 @@ extern nci_err_t nci_incoming_proprietary_packet_ntf_process(
 void nci_init(void)
 {
   nci_evt.header = nci_evt_startup;
+  startup_event_passed = false;
+
+  packet_queue_head = 0;
+  packet_queue_tail = 0;
+  packet_queue_count = 0;
+  packet_queue_tail_in_use = false;
+  packet_receive_count = packet_notify_count;
+
+  rx_message_len = 0;
+  nci_conn_reset();
+  tx_message_dropped = false;
 }
 
 /***************************************************************************//**
  * @brief
  *  Get current NCI event.
  *
+ * @details
+ *  All the packets signaled by the NFCC are read into the packet queue first,
+ *  so credits are returned and segments are sent as early as possible. Then
+ *  the oldest queued packet is decoded. The returned event and the data it
+ *  points to are valid until the next call.
+ *
+ *  A data message still waiting for credits when the NFCC is reset or the RF
+ *  interface is deactivated or activated again is dropped, and reported with
+ *  nci_evt_data_packet_dropped before the next packet is decoded.
+ *
  * @returns
  *  Pointer to current NCI event.
  ******************************************************************************/
 nci_evt_t *nci_get_event(void)
 {
-  if (startup_event_passed) {
+  if (!startup_event_passed) {
+    startup_event_passed = true;
+    return &nci_evt;
+  }
+
+  /* Release the packet of the previous event. */
+  nci_packet_queue_release();
+
+  if (nci_packet_queue_fill() != nci_err_none) {
+    nci_log_ln("NCI packet receive error.");
+  }
+
+  if (nci_data_message_flush() != nci_err_none) {
+    nci_log_ln("NCI data message send error.");
+  }
+
+  if (tx_message_dropped) {
+    tx_message_dropped = false;
+    nci_evt.header = nci_evt_data_packet_dropped;
+    nci_evt.data.is_terminator_packet = true;
+    nci_evt.data.len = 0;
+    nci_evt.data.payload.nci_data.dropped_data_packet.conn_id
+      = tx_message_conn_id;
+    nci_evt.data.payload.nci_data.dropped_data_packet.unsent_len
+      = tx_message_len - tx_message_index;
+    return &nci_evt;
+  }
+
+  /* Decode packets until one of them completes an event. */
+  do {
     nci_err_t nci_packet_process_err = nci_incoming_packet_process();
 
     if (nci_packet_process_err != nci_err_none) {
       nci_log_ln("NCI packet process error.");
     }
-  } else {
-    startup_event_passed = true;
-  }
+  } while ((nci_evt.header == nci_evt_none) && (packet_queue_count > 0));
 
   return &nci_evt;
 }
@@ -93,7 +194,7 @@ nci_evt_t *nci_get_event(void)
  ******************************************************************************/
 void nci_notify_incoming_packet(void)
 {
-  packet_ready = true;
+  packet_notify_count++;
 }
 
 /***************************************************************************//**
@@ -104,10 +205,41 @@ void nci_notify_incoming_packet(void)
  *  true  - if there is an incoming packet to be read.
  *  false - if there is no incoming packet to be read.
  ******************************************************************************/
-// bool nci_check_incoming_packet(void)
-// {
-//  return packet_incoming;
-// }
+bool nci_check_incoming_packet(void)
+{
+  uint8_t count = packet_queue_count;
+
+  if (packet_queue_tail_in_use) {
+    count--;
+  }
+
+  return (count > 0) || (packet_notify_count != packet_receive_count);
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Check if a data message is waiting for credits to be sent.
+ *
+ * @returns
+ *  true  - if segments of a data message are not sent yet.
+ *  false - if a new data message can be sent.
+ ******************************************************************************/
+bool nci_check_outgoing_data_packet(void)
+{
+  return tx_message_pending;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Get the event being loaded by the packet processing functions.
+ *
+ * @returns
+ *  Pointer to current NCI event.
+ ******************************************************************************/
+nci_evt_t *nci_get_current_event(void)
+{
+  return &nci_evt;
+}
 
 /***************************************************************************//**
  * @brief
@@ -126,28 +258,31 @@ nci_err_t nci_control_packet_send(nci_control_packet_t *packet)
     return nci_err_payload_exceed_mtu;
   }
 
-  packet_buff[NCI_PACKET_MT_INDEX] &= ~NCI_PACKET_MT_M;
-  packet_buff[NCI_PACKET_MT_INDEX] += (packet->mt << NCI_PACKET_MT_SHIFT);
-  packet_buff[NCI_PACKET_PBF_INDEX] &= ~NCI_PACKET_PBF_M;
-  packet_buff[NCI_PACKET_PBF_INDEX] += (packet->pbf << NCI_PACKET_PBF_SHIFT);
-  packet_buff[NCI_PACKET_GID_INDEX] &= ~NCI_PACKET_GID_M;
-  packet_buff[NCI_PACKET_GID_INDEX] += (packet->gid << NCI_PACKET_GID_SHIFT);
-  packet_buff[NCI_PACKET_OID_INDEX] &= ~NCI_PACKET_OID_M;
-  packet_buff[NCI_PACKET_OID_INDEX] += (packet->oid << NCI_PACKET_OID_SHIFT);
-  packet_buff[NCI_PACKET_PAYLOAD_LEN_INDEX] = packet->payload_len;
-
-  memcpy(&packet_buff[NCI_PACKET_PAYLOAD_START_INDEX],
+  tx_packet_buff[NCI_PACKET_MT_INDEX] &= ~NCI_PACKET_MT_M;
+  tx_packet_buff[NCI_PACKET_MT_INDEX] += (packet->mt << NCI_PACKET_MT_SHIFT);
+  tx_packet_buff[NCI_PACKET_PBF_INDEX] &= ~NCI_PACKET_PBF_M;
+  tx_packet_buff[NCI_PACKET_PBF_INDEX]
+    += (packet->pbf << NCI_PACKET_PBF_SHIFT);
+  tx_packet_buff[NCI_PACKET_GID_INDEX] &= ~NCI_PACKET_GID_M;
+  tx_packet_buff[NCI_PACKET_GID_INDEX]
+    += (packet->gid << NCI_PACKET_GID_SHIFT);
+  tx_packet_buff[NCI_PACKET_OID_INDEX] &= ~NCI_PACKET_OID_M;
+  tx_packet_buff[NCI_PACKET_OID_INDEX]
+    += (packet->oid << NCI_PACKET_OID_SHIFT);
+  tx_packet_buff[NCI_PACKET_PAYLOAD_LEN_INDEX] = packet->payload_len;
+
+  memcpy(&tx_packet_buff[NCI_PACKET_PAYLOAD_START_INDEX],
          packet->payload,
          packet->payload_len);
 
-  nci_tml_err_t nci_tml_err = nci_tml_transceive(packet_buff);
+  nci_tml_err_t nci_tml_err = nci_tml_transceive(tx_packet_buff);
 
   if (nci_tml_err != nci_tml_err_none) {
     return nci_err_tml;
   }
 
   nci_tml_log("NCI TML transceive: ");
-  nci_tml_packet_log(packet_buff, packet_buff[2] + 3);
+  nci_tml_packet_log(tx_packet_buff, tx_packet_buff[2] + 3);
   nci_tml_log_ln(" ");
 
   return nci_err_none;
@@ -157,47 +292,329 @@ nci_err_t nci_control_packet_send(nci_control_packet_t *packet)
  * @brief
  *  Encode and send a NCI data packet.
  *
+ * @details
+ *  Payloads larger than the maximum data packet payload size of the connection
+ *  are segmented. As many segments as the credits of the connection allow are
+ *  sent at once, the remaining ones are copied and sent by nci_get_event() as
+ *  CORE_CONN_CREDITS_NTF returns credits. The remaining segments are dropped
+ *  and nci_evt_data_packet_dropped is returned if the connection goes away
+ *  before that.
+ *
  * @param[in] packet
  *  NCI data packet to be sent.
  *
  * @returns
- *  Any error code.
+ *  Any error code, nci_err_busy if the previous data message is not sent yet.
  ******************************************************************************/
 nci_err_t nci_data_packet_send(nci_data_packet_t *packet)
 {
-  if (packet->payload_len > nci_tml_mtu) {
+  uint8_t conn_id = packet->conn_id & NCI_PACKET_CONN_ID_M;
+  uint16_t index = 0;
+  bool is_sent = false;
+
+  if (packet->payload_len > NFC_NCI_DATA_MESSAGE_MAX_LEN) {
     nci_log_ln("NCI error: payload exceed MTU.");
     return nci_err_payload_exceed_mtu;
   }
 
-  packet_buff[NCI_PACKET_MT_INDEX] &= ~NCI_PACKET_MT_M;
-  packet_buff[NCI_PACKET_MT_INDEX]
-    += (nci_packet_data << NCI_PACKET_MT_SHIFT);
-  packet_buff[NCI_PACKET_PBF_INDEX] &= ~NCI_PACKET_PBF_M;
-  packet_buff[NCI_PACKET_PBF_INDEX] += (packet->pbf << NCI_PACKET_PBF_SHIFT);
-  packet_buff[NCI_PACKET_CONN_ID_INDEX] &= ~NCI_PACKET_CONN_ID_M;
-  packet_buff[NCI_PACKET_CONN_ID_INDEX]
-    += (packet->conn_id << NCI_PACKET_CONN_ID_SHIFT);
+  if (tx_message_pending) {
+    return nci_err_busy;
+  }
 
-  /* Clear previous leftover OLD in the buffer. */
-  packet_buff[NCI_PACKET_OID_INDEX] &= ~NCI_PACKET_OID_M;
-  packet_buff[NCI_PACKET_PAYLOAD_LEN_INDEX] = packet->payload_len;
+  /* Send directly from the caller's buffer while there are credits. */
+  nci_err_t nci_err = nci_data_segments_send(conn_id,
+                                             packet->pbf,
+                                             packet->payload,
+                                             packet->payload_len,
+                                             &index,
+                                             &is_sent);
+  if ((nci_err != nci_err_none) || is_sent) {
+    return nci_err;
+  }
 
-  memcpy(&packet_buff[NCI_PACKET_PAYLOAD_START_INDEX],
-         packet->payload,
-         packet->payload_len);
+  /* Out of credits, keep the rest for nci_data_message_flush(). */
+  tx_message_len = packet->payload_len - index;
+  tx_message_index = 0;
+  tx_message_conn_id = conn_id;
+  tx_message_pbf = packet->pbf;
+  tx_message_pending = true;
+  memcpy(tx_message_buff, &packet->payload[index], tx_message_len);
 
-  if (nci_tml_transceive(packet_buff) != nci_tml_err_none) {
-    return nci_err_tml;
+  return nci_err_none;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Send the segments of the pending data message allowed by the credits.
+ *
+ * @returns
+ *  Any error code.
+ ******************************************************************************/
+static nci_err_t nci_data_message_flush(void)
+{
+  bool is_sent = false;
+
+  if (!tx_message_pending) {
+    return nci_err_none;
   }
 
-  nci_tml_log("NCI TML transceive: ");
-  nci_tml_packet_log(packet_buff, packet_buff[2] + 3);
-  nci_tml_log_ln(" ");
+  nci_err_t nci_err = nci_data_segments_send(tx_message_conn_id,
+                                             tx_message_pbf,
+                                             tx_message_buff,
+                                             tx_message_len,
+                                             &tx_message_index,
+                                             &is_sent);
+  if (is_sent) {
+    tx_message_pending = false;
+  }
+
+  return nci_err;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Drop the data message waiting for credits, reported by nci_get_event().
+ ******************************************************************************/
+static void nci_data_message_drop(void)
+{
+  if (tx_message_pending) {
+    tx_message_pending = false;
+    tx_message_dropped = true;
+  }
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Segment a data message and send the segments while the connection has
+ *  credits.
+ *
+ * @param[in] conn_id
+ *  Connection identifier.
+ * @param[in] pbf
+ *  Packet boundary flag of the last segment.
+ * @param[in] payload
+ *  Data message.
+ * @param[in] payload_len
+ *  Length of the data message.
+ * @param[in,out] index
+ *  Index of the next byte to send, updated with the sent segments.
+ * @param[out] is_sent
+ *  Set to true when the last segment is sent.
+ *
+ * @returns
+ *  Any error code.
+ ******************************************************************************/
+static nci_err_t nci_data_segments_send(uint8_t conn_id,
+                                        uint8_t pbf,
+                                        const uint8_t *payload,
+                                        uint16_t payload_len,
+                                        uint16_t *index,
+                                        bool *is_sent)
+{
+  nci_conn_t *conn = &nci_conn[conn_id];
+
+  while (conn->credits > 0) {
+    uint16_t remaining = payload_len - *index;
+    uint8_t len = (remaining > conn->max_payload_len)
+                  ? conn->max_payload_len : (uint8_t) remaining;
+    bool is_last_segment = (len == remaining);
+
+    tx_packet_buff[NCI_PACKET_MT_INDEX]
+      = (nci_packet_data << NCI_PACKET_MT_SHIFT)
+        | ((is_last_segment ? pbf : nci_pbf_segment_msg)
+           << NCI_PACKET_PBF_SHIFT)
+        | (conn_id << NCI_PACKET_CONN_ID_SHIFT);
+
+    /* Clear previous leftover OID in the buffer. */
+    tx_packet_buff[NCI_PACKET_OID_INDEX] = 0;
+    tx_packet_buff[NCI_PACKET_PAYLOAD_LEN_INDEX] = len;
+
+    memcpy(&tx_packet_buff[NCI_PACKET_PAYLOAD_START_INDEX],
+           &payload[*index],
+           len);
+
+    if (nci_tml_transceive(tx_packet_buff) != nci_tml_err_none) {
+      return nci_err_tml;
+    }
+
+    nci_tml_log("NCI TML transceive: ");
+    nci_tml_packet_log(tx_packet_buff, tx_packet_buff[2] + 3);
+    nci_tml_log_ln(" ");
+
+    if (conn->credits != NCI_CONN_CREDITS_FLOW_CONTROL_OFF) {
+      conn->credits--;
+    }
+
+    *index += len;
+    if (is_last_segment) {
+      *is_sent = true;
+      break;
+    }
+  }
+
+  return nci_err_none;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Reset the flow control state of the connections and drop the data message
+ *  waiting for credits.
+ ******************************************************************************/
+static void nci_conn_reset(void)
+{
+  for (uint8_t i = 0; i < NCI_CONN_ID_MAX_NUM; i++) {
+    nci_conn[i].credits = NCI_CONN_CREDITS_FLOW_CONTROL_OFF;
+    nci_conn[i].max_payload_len = NCI_PACKET_PAYLOAD_MAX_LEN;
+  }
+
+  nci_data_message_drop();
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Read the packets signaled by the NFCC into the packet queue.
+ *
+ * @returns
+ *  Any error code.
+ ******************************************************************************/
+static nci_err_t nci_packet_queue_fill(void)
+{
+  while ((packet_receive_count != packet_notify_count)
+         && (packet_queue_count < NFC_NCI_PACKET_QUEUE_SIZE)) {
+    uint8_t *packet = packet_queue[packet_queue_head];
+
+    packet_receive_count++;
+
+    /* Get packet */
+    nci_tml_err_t nci_tml_err = nci_tml_receive(packet);
+    if (nci_tml_err != nci_tml_err_none) {
+      return nci_err_tml;
+    }
+
+    nci_tml_log("NCI TML receive:    ");
+    nci_tml_packet_log(packet, packet[2] + 3);
+    nci_tml_log_ln(" ");
+
+    packet_queue_head = (packet_queue_head + 1) % NFC_NCI_PACKET_QUEUE_SIZE;
+    packet_queue_count++;
+
+    nci_flow_control_process(packet);
+  }
 
   return nci_err_none;
 }
 
+/***************************************************************************//**
+ * @brief
+ *  Release the queued packet of the event returned last.
+ ******************************************************************************/
+static void nci_packet_queue_release(void)
+{
+  if (packet_queue_tail_in_use) {
+    packet_queue_tail_in_use = false;
+    packet_queue_tail = (packet_queue_tail + 1) % NFC_NCI_PACKET_QUEUE_SIZE;
+    packet_queue_count--;
+  }
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Update the credits and the maximum data packet payload size of the
+ *  connections from a received packet.
+ *
+ * @param[in] packet
+ *  Received packet.
+ ******************************************************************************/
+static void nci_flow_control_process(const uint8_t *packet)
+{
+  uint8_t mt = (packet[NCI_PACKET_MT_INDEX] & NCI_PACKET_MT_M)
+               >> NCI_PACKET_MT_SHIFT;
+  uint8_t gid = (packet[NCI_PACKET_GID_INDEX] & NCI_PACKET_GID_M)
+                >> NCI_PACKET_GID_SHIFT;
+  uint8_t oid = (packet[NCI_PACKET_OID_INDEX] & NCI_PACKET_OID_M)
+                >> NCI_PACKET_OID_SHIFT;
+  uint8_t len = packet[NCI_PACKET_PAYLOAD_LEN_INDEX];
+  const uint8_t *payload = &packet[NCI_PACKET_PAYLOAD_START_INDEX];
+
+  if ((mt == nci_packet_control_ntf) && (gid == nci_gid_nci_core)
+      && (oid == nci_oid_core_conn_credits) && (len >= 1)) {
+    /* Number of entries followed by connection id and credits pairs. */
+    for (uint8_t i = 0; (i < payload[0]) && ((2 * i + 2) < len); i++) {
+      nci_conn_t *conn = &nci_conn[payload[2 * i + 1] & NCI_PACKET_CONN_ID_M];
+      uint16_t credits = conn->credits + payload[2 * i + 2];
+
+      if (conn->credits == NCI_CONN_CREDITS_FLOW_CONTROL_OFF) {
+        continue;
+      }
+
+      conn->credits = (credits < NCI_CONN_CREDITS_FLOW_CONTROL_OFF)
+                      ? (uint8_t) credits
+                      : (NCI_CONN_CREDITS_FLOW_CONTROL_OFF - 1);
+    }
+  } else if ((mt == nci_packet_control_ntf)
+             && (gid == nci_gid_rf_management)
+             && (oid == nci_oid_rf_intf_activated) && (len >= 6)) {
+    /* The static RF connection is ready for data exchange. */
+    nci_conn[NCI_CONN_ID_STATIC_RF].max_payload_len = payload[4];
+    nci_conn[NCI_CONN_ID_STATIC_RF].credits = payload[5];
+    if (nci_conn[NCI_CONN_ID_STATIC_RF].max_payload_len == 0) {
+      nci_conn[NCI_CONN_ID_STATIC_RF].max_payload_len
+        = NCI_PACKET_PAYLOAD_MAX_LEN;
+    }
+    nci_data_message_drop();
+  } else if (((mt == nci_packet_control_ntf) || (mt == nci_packet_control_rsp))
+             && (((gid == nci_gid_rf_management)
+                  && (oid == nci_oid_rf_deactivate))
+                 || ((gid == nci_gid_nci_core)
+                     && (oid == nci_oid_core_reset)))) {
+    nci_conn_reset();
+  }
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Append the current data packet to the reassembly buffer.
+ *
+ * @returns
+ *  true  - if the event should be returned.
+ *  false - if more segments are expected.
+ ******************************************************************************/
+static bool nci_data_packet_reassemble(void)
+{
+  bool is_segment = (packet_buff[NCI_PACKET_PBF_INDEX] & NCI_PACKET_PBF_M);
+  uint8_t len = packet_buff[NCI_PACKET_PAYLOAD_LEN_INDEX];
+
+  /* Complete message in a single packet, no copy needed. */
+  if (!is_segment && (rx_message_len == 0)) {
+    return true;
+  }
+
+  /* Reassembly buffer full, hand over what was received so far. The current
+   * packet stays in the queue and starts a new message. */
+  if ((rx_message_len + len) > NFC_NCI_DATA_MESSAGE_MAX_LEN) {
+    nci_evt.data.is_terminator_packet = false;
+    nci_evt.data.len = rx_message_len;
+    nci_evt.data.payload.nci_data.rec_data_packet.payload = rx_message_buff;
+    rx_message_len = 0;
+    packet_queue_tail_in_use = false;
+    return true;
+  }
+
+  memcpy(&rx_message_buff[rx_message_len],
+         &packet_buff[NCI_PACKET_PAYLOAD_START_INDEX],
+         len);
+  rx_message_len += len;
+
+  if (is_segment) {
+    return false;
+  }
+
+  nci_evt.data.len = rx_message_len;
+  nci_evt.data.payload.nci_data.rec_data_packet.payload = rx_message_buff;
+  rx_message_len = 0;
+  return true;
+}
+
 // -----------------------------------------------------------------------------
 // NCI Core
 
@@ -497,6 +914,15 @@ static void nci_core_conn_close_rsp_process(void)
 static void nci_core_conn_credits_ntf_process(void)
 {
   nci_evt.header = nci_evt_core_conn_credits_ntf_rec;
+  nci_evt.data.is_terminator_packet = true;
+  nci_evt.data.len = packet_buff[NCI_PACKET_PAYLOAD_LEN_INDEX];
+
+  uint16_t index = NCI_PACKET_PAYLOAD_START_INDEX;
+
+  nci_evt.data.payload.nci_data.core_conn_credits_ntf.num_of_entries
+    = packet_buff[index++];
+  nci_evt.data.payload.nci_data.core_conn_credits_ntf.entries
+    = &packet_buff[index];
 }
 
 // -------------------------------
@@ -818,6 +1244,9 @@ static void nci_rf_discover_select_rsp_process(void)
  ******************************************************************************/
 static void nci_rf_intf_activated_ntf_process(void)
 {
+  /* Drop the segments left from a previous activation. */
+  rx_message_len = 0;
+
   nci_evt.header = nci_evt_rf_intf_activated_ntf_rec;
   nci_evt.data.is_terminator_packet = true;
   nci_evt.data.len = packet_buff[NCI_PACKET_PAYLOAD_LEN_INDEX];
@@ -1118,35 +1547,46 @@ static void nci_nfcee_mode_set_rsp_process(void)
 
 /***************************************************************************//**
  * @brief
- *  Parse the incoming packet header and send to corresponding processing
- *  functions.
+ *  Take the oldest packet of the packet queue and decode it into the NCI
+ *  event.
  *
  * @returns
  *  Any error code.
  ******************************************************************************/
 nci_err_t nci_incoming_packet_process(void)
 {
-  if (!packet_ready) {
-    /* Clear nci event header */
-    nci_evt.header = nci_evt_none;
+  nci_packet_queue_release();
+
+  /* Clear nci event header */
+  nci_evt.header = nci_evt_none;
+
+  if (packet_queue_count == 0) {
     return nci_err_none;
   }
 
-  packet_ready = false;
+  packet_buff = packet_queue[packet_queue_tail];
+  packet_queue_tail_in_use = true;
 
-  /* Get packet */
-  nci_tml_err_t nci_tml_err = nci_tml_receive(packet_buff);
-  if (nci_tml_err != nci_tml_err_none) {
-    return nci_err_tml;
-  }
+  nci_err_t nci_err = nci_packet_decode();
 
-  nci_tml_log("NCI TML receive:    ");
-  nci_tml_packet_log(packet_buff, packet_buff[2] + 3);
-  nci_tml_log_ln(" ");
+  /* Nothing refers to the packet if it did not complete an event. */
+  if (nci_evt.header == nci_evt_none) {
+    nci_packet_queue_release();
+  }
 
-  /* Clear nci event header */
-  nci_evt.header = nci_evt_none;
+  return nci_err;
+}
 
+/***************************************************************************//**
+ * @brief
+ *  Parse the incoming packet header and send to corresponding processing
+ *  functions.
+ *
+ * @returns
+ *  Any error code.
+ ******************************************************************************/
+static nci_err_t nci_packet_decode(void)
+{
   /* Check Message Type */
   switch ((packet_buff[NCI_PACKET_MT_INDEX] & NCI_PACKET_MT_M)
           >> NCI_PACKET_MT_SHIFT) {
@@ -1171,6 +1611,11 @@ nci_err_t nci_incoming_packet_process(void)
       /* Assign payload pointer */
       nci_evt.data.payload.nci_data.rec_data_packet.payload
         = &packet_buff[NCI_PACKET_PAYLOAD_START_INDEX];
+
+      /* Wait for the last segment of a segmented message */
+      if (!nci_data_packet_reassemble()) {
+        nci_evt.header = nci_evt_none;
+      }
       break;
     }
 
@@ -53,6 +53,9 @@ void nci_evt_print(nci_evt_header_t header)
     case nci_evt_data_packet_rec:
       nci_log_ln("NCI event: data packet received. ");
       break;
+    case nci_evt_data_packet_dropped:
+      nci_log_ln("NCI event: data packet dropped. ");
+      break;
 
     /* NCI Core events. */
     case nci_evt_core_reset_rsp_rec:
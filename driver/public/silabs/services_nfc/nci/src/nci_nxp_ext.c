@@ -51,6 +51,7 @@ typedef enum {
 } nci_oid_nxp_t;
 
 extern nci_err_t nci_control_packet_send (nci_control_packet_t *packet);
+extern nci_evt_t *nci_get_current_event(void);
 
 // -------------------------------
 // NCI_PROPRIETARY_ACT
@@ -81,7 +82,7 @@ nci_err_t nci_proprietary_nxp_act(void)
  *****************************************************************************/
 static void nci_proprietary_nxp_act_rsp_process(uint8_t *packet_buff)
 {
-  nci_evt_t *nci_evt = nci_get_event();
+  nci_evt_t *nci_evt = nci_get_current_event();
 
   nci_evt->header = nci_evt_proprietary_nxp_act_rsp_rec;
   nci_evt->data.is_terminator_packet = true;
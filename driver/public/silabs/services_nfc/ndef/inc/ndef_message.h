@@ -73,9 +73,90 @@ typedef struct {
   ndef_message_validate_error_t err;
 } ndef_message_validate_result_t;
 
+/// NDEF message decode error type.
+typedef enum {
+  ndefMessageDecodeInProgress = 0,
+  ndefMessageDecodeCompleted  = 1,
+  ndefMessageDecodeFail       = -1
+} ndef_message_decode_error_t;
+
+/// NDEF message decoder event type.
+typedef enum {
+  ndefDecoderRecordBegin = 0,   /* Header, TYPE and ID of a record decoded. */
+  ndefDecoderRecordPayload,     /* Fragment of the payload of a record. */
+  ndefDecoderRecordEnd          /* Last payload byte of a record decoded. */
+} ndef_message_decoder_evt_t;
+
+/// Callback of the NDEF message decoder. data and len are only set for
+/// ndefDecoderRecordPayload and point into the buffer being decoded.
+typedef void (*ndef_message_decoder_callback_t)(
+  void *context,
+  ndef_message_decoder_evt_t evt,
+  const ndef_record_t *record,
+  const uint8_t *data,
+  uint32_t len);
+
+/// Incremental NDEF message decoder.
+typedef struct {
+  uint8_t                         state;
+  uint8_t                         length_index;
+  uint32_t                        remaining;
+  ndef_record_t                   record;
+  uint8_t                         *type_id_buff;
+  uint16_t                        type_id_size;
+  ndef_message_decoder_callback_t callback;
+  void                            *context;
+} ndef_message_decoder_t;
+
+/// Flush function of the NDEF chunk writer.
+typedef bool (*ndef_chunk_flush_t)(void *context,
+                                   const uint8_t *chunk,
+                                   uint16_t len);
+
+/// Writer splitting an encoded NDEF message into fixed size chunks,
+/// e.g. T2T blocks or T4T UPDATE BINARY commands.
+typedef struct {
+  uint8_t            *buff;
+  uint16_t           size;
+  uint16_t           len;
+  ndef_chunk_flush_t flush;
+  void               *context;
+} ndef_chunk_writer_t;
+
 ndef_message_encode_result_t ndef_message_encode (uint8_t *message_buff,
                                                   ndef_record_t *message);
 
+uint32_t ndef_message_get_size (const ndef_record_t *message,
+                                uint32_t record_count);
+
+ndef_message_encode_result_t ndef_message_write (const ndef_record_t *message,
+                                                 uint32_t record_count,
+                                                 ndef_sink_t sink,
+                                                 void *context);
+
+void ndef_message_decoder_init (ndef_message_decoder_t *decoder,
+                                uint8_t *type_id_buff,
+                                uint16_t type_id_size,
+                                ndef_message_decoder_callback_t callback,
+                                void *context);
+
+ndef_message_decode_error_t ndef_message_decoder_feed (
+  ndef_message_decoder_t *decoder,
+  const uint8_t *data,
+  uint32_t len);
+
+void ndef_chunk_writer_init (ndef_chunk_writer_t *writer,
+                             uint8_t *buff,
+                             uint16_t size,
+                             ndef_chunk_flush_t flush,
+                             void *context);
+
+bool ndef_chunk_writer_sink (void *context,
+                             const uint8_t *data,
+                             uint32_t len);
+
+bool ndef_chunk_writer_finish (ndef_chunk_writer_t *writer);
+
 #ifdef __cplusplus
 }
 #endif
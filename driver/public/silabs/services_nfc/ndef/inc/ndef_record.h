@@ -139,7 +139,8 @@ typedef enum {
 
 typedef enum {
   ndefRecordEncodeCompleted = 0,
-  ndefRecordEncodeOverflow  = -1
+  ndefRecordEncodeOverflow  = -1,
+  ndefRecordEncodeSinkFail  = -2
 } ndef_record_encode_error_t;
 
 typedef struct {
@@ -213,11 +214,30 @@ typedef struct {
   ndef_record_encode_error_t  err;
 }ndef_record_encode_result_t;
 
+/*
+ * @brief Sink receiving an encoded NDEF record or message in fragments.
+ *        Returns false to abort the encoding.
+ */
+typedef bool (*ndef_sink_t)(void *context,
+                            const uint8_t *data,
+                            uint32_t len);
+
 ndef_record_encode_result_t ndef_record_encode (ndef_record_t record,
                                                 uint8_t *record_buff);
 
 void ndef_record_decode (ndef_record_t *record, uint8_t *record_buff);
 
+uint32_t ndef_record_get_size (const ndef_record_t *record);
+
+ndef_record_encode_result_t ndef_record_header_write (
+  const ndef_record_t *record,
+  ndef_sink_t sink,
+  void *context);
+
+ndef_record_encode_result_t ndef_record_write (const ndef_record_t *record,
+                                               ndef_sink_t sink,
+                                               void *context);
+
 #ifdef __cplusplus
 }
 #endif
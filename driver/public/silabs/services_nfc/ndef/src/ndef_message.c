@@ -33,11 +33,24 @@
  * at the sole discretion of Silicon Labs.
  ******************************************************************************/
 
+#include <string.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include "ndef_message.h"
 #include "ndef_record.h"
 
+/// States of the NDEF message decoder.
+enum {
+  NDEF_DECODER_STATE_HEADER = 0,
+  NDEF_DECODER_STATE_TYPE_LENGTH,
+  NDEF_DECODER_STATE_PAYLOAD_LENGTH,
+  NDEF_DECODER_STATE_ID_LENGTH,
+  NDEF_DECODER_STATE_TYPE_ID,
+  NDEF_DECODER_STATE_PAYLOAD,
+  NDEF_DECODER_STATE_DONE,
+  NDEF_DECODER_STATE_ERROR
+};
+
 /**************************************************************************//**
  * @brief
  *  Validate an NDEF message.
@@ -137,3 +150,406 @@ void ndef_message_decode(uint8_t *ndef_msg_buff, ndef_record_t *message)
   (void) message;
   // Todo
 }
+
+/**************************************************************************//**
+ * @brief
+ *  Get the encoded size of an NDEF message, e.g. to write the length of the
+ *  NDEF message TLV before streaming the message.
+ *
+ * @param[in] message
+ *  Records of the NDEF message
+ *
+ * @param[in] record_count
+ *  Number of records
+ *
+ * @returns
+ *  Size of the encoded message in bytes.
+ *****************************************************************************/
+uint32_t ndef_message_get_size(const ndef_record_t *message,
+                               uint32_t record_count)
+{
+  uint32_t size = 0;
+
+  for (uint32_t index = 0; index < record_count; index++) {
+    size += ndef_record_get_size(&message[index]);
+  }
+
+  return size;
+}
+
+/**************************************************************************//**
+ * @brief
+ *  Write an NDEF message to a sink without building it in RAM. The MB and ME
+ *  flags are set according to the position of the records.
+ *
+ * @param[in] message
+ *  Records of the NDEF message
+ *
+ * @param[in] record_count
+ *  Number of records
+ *
+ * @param[in] sink
+ *  Sink receiving the encoded fragments, e.g. ndef_chunk_writer_sink()
+ *
+ * @param[in] context
+ *  Context passed to the sink
+ *
+ * @returns
+ *  Result of the encoding, including error.
+ *****************************************************************************/
+ndef_message_encode_result_t ndef_message_write(const ndef_record_t *message,
+                                                uint32_t record_count,
+                                                ndef_sink_t sink,
+                                                void *context)
+{
+  ndef_message_encode_result_t result = { .size = 0 };
+
+  for (uint32_t index = 0; index < record_count; index++) {
+    /* Only the header is modified, type, id and payload are referenced. */
+    ndef_record_t record = message[index];
+
+    record.header.mb = (index == 0);
+    record.header.me = (index == (record_count - 1));
+
+    ndef_record_encode_result_t record_encode_result
+      = ndef_record_write(&record, sink, context);
+
+    if (record_encode_result.err != ndefRecordEncodeCompleted) {
+      result.err = ndefMessageEncodeFail;
+      return result;
+    }
+    result.size += record_encode_result.size;
+  }
+
+  result.err = ndefMessageEncodeSuccess;
+  return result;
+}
+
+/**************************************************************************//**
+ * @brief
+ *  Initialize an incremental NDEF message decoder.
+ *
+ * @param[out] decoder
+ *  Decoder to be initialized
+ *
+ * @param[in] type_id_buff
+ *  Buffer holding the TYPE and ID of the current record
+ *
+ * @param[in] type_id_size
+ *  Size of type_id_buff, records with longer TYPE and ID fail the decoding
+ *
+ * @param[in] callback
+ *  Function called with the decoded records
+ *
+ * @param[in] context
+ *  Context passed to the callback
+ *****************************************************************************/
+void ndef_message_decoder_init(ndef_message_decoder_t *decoder,
+                               uint8_t *type_id_buff,
+                               uint16_t type_id_size,
+                               ndef_message_decoder_callback_t callback,
+                               void *context)
+{
+  memset(decoder, 0, sizeof(*decoder));
+  decoder->state = NDEF_DECODER_STATE_HEADER;
+  decoder->type_id_buff = type_id_buff;
+  decoder->type_id_size = type_id_size;
+  decoder->callback = callback;
+  decoder->context = context;
+}
+
+/**************************************************************************//**
+ * @brief
+ *  Report the end of the current record and move to the next one.
+ *
+ * @param[in] decoder
+ *  NDEF message decoder
+ *****************************************************************************/
+static void ndef_message_decoder_record_end(ndef_message_decoder_t *decoder)
+{
+  decoder->callback(decoder->context,
+                    ndefDecoderRecordEnd,
+                    &decoder->record,
+                    NULL,
+                    0);
+
+  decoder->state = decoder->record.header.me
+                   ? NDEF_DECODER_STATE_DONE : NDEF_DECODER_STATE_HEADER;
+}
+
+/**************************************************************************//**
+ * @brief
+ *  Report the beginning of the current record and start its payload.
+ *
+ * @param[in] decoder
+ *  NDEF message decoder
+ *****************************************************************************/
+static void ndef_message_decoder_record_begin(ndef_message_decoder_t *decoder)
+{
+  decoder->callback(decoder->context,
+                    ndefDecoderRecordBegin,
+                    &decoder->record,
+                    NULL,
+                    0);
+
+  decoder->state = NDEF_DECODER_STATE_PAYLOAD;
+  decoder->remaining = decoder->record.payload_length;
+  if (decoder->remaining == 0) {
+    ndef_message_decoder_record_end(decoder);
+  }
+}
+
+/**************************************************************************//**
+ * @brief
+ *  Start collecting the TYPE and ID of the current record.
+ *
+ * @param[in] decoder
+ *  NDEF message decoder
+ *****************************************************************************/
+static void ndef_message_decoder_type_id_begin(ndef_message_decoder_t *decoder)
+{
+  uint16_t type_id_len = decoder->record.type_length
+                         + decoder->record.id_length;
+
+  if (type_id_len > decoder->type_id_size) {
+    decoder->state = NDEF_DECODER_STATE_ERROR;
+    return;
+  }
+
+  decoder->record.type = decoder->type_id_buff;
+  decoder->record.id = &decoder->type_id_buff[decoder->record.type_length];
+  decoder->state = NDEF_DECODER_STATE_TYPE_ID;
+  decoder->remaining = type_id_len;
+  if (decoder->remaining == 0) {
+    ndef_message_decoder_record_begin(decoder);
+  }
+}
+
+/**************************************************************************//**
+ * @brief
+ *  Decode a fragment of an NDEF message, e.g. the data of a tag read. Payloads
+ *  are passed to the callback directly from the fragment, only the TYPE and ID
+ *  of a record are copied.
+ *
+ * @param[in] decoder
+ *  NDEF message decoder
+ *
+ * @param[in] data
+ *  Fragment of the NDEF message
+ *
+ * @param[in] len
+ *  Length of the fragment
+ *
+ * @returns
+ *  ndefMessageDecodeCompleted once the record with ME flag is decoded,
+ *  ndefMessageDecodeInProgress if more data is expected,
+ *  ndefMessageDecodeFail if a record does not fit the decoder.
+ *****************************************************************************/
+ndef_message_decode_error_t ndef_message_decoder_feed(
+  ndef_message_decoder_t *decoder,
+  const uint8_t *data,
+  uint32_t len)
+{
+  uint32_t index = 0;
+  uint32_t count;
+
+  while ((index < len)
+         && (decoder->state != NDEF_DECODER_STATE_DONE)
+         && (decoder->state != NDEF_DECODER_STATE_ERROR)) {
+    switch (decoder->state) {
+      case NDEF_DECODER_STATE_HEADER: {
+        uint8_t header_byte = data[index++];
+
+        memset(&decoder->record, 0, sizeof(decoder->record));
+        decoder->record.header.mb = (header_byte & NDEF_RECORD_HEADER_MB_M);
+        decoder->record.header.me = (header_byte & NDEF_RECORD_HEADER_ME_M);
+        decoder->record.header.cf = (header_byte & NDEF_RECORD_HEADER_CF_M);
+        decoder->record.header.sr = (header_byte & NDEF_RECORD_HEADER_SR_M);
+        decoder->record.header.il = (header_byte & NDEF_RECORD_HEADER_IL_M);
+        decoder->record.header.tnf = (header_byte & NDEF_RECORD_HEADER_TNF_M);
+        decoder->state = NDEF_DECODER_STATE_TYPE_LENGTH;
+        break;
+      }
+
+      case NDEF_DECODER_STATE_TYPE_LENGTH:
+        decoder->record.type_length = data[index++];
+        decoder->length_index = decoder->record.header.sr ? 1 : 4;
+        decoder->state = NDEF_DECODER_STATE_PAYLOAD_LENGTH;
+        break;
+
+      case NDEF_DECODER_STATE_PAYLOAD_LENGTH:
+        decoder->record.payload_length
+          = (decoder->record.payload_length << 8) | data[index++];
+        if (--decoder->length_index == 0) {
+          if (decoder->record.header.il) {
+            decoder->state = NDEF_DECODER_STATE_ID_LENGTH;
+          } else {
+            ndef_message_decoder_type_id_begin(decoder);
+          }
+        }
+        break;
+
+      case NDEF_DECODER_STATE_ID_LENGTH:
+        decoder->record.id_length = data[index++];
+        ndef_message_decoder_type_id_begin(decoder);
+        break;
+
+      case NDEF_DECODER_STATE_TYPE_ID: {
+        uint16_t type_id_len = decoder->record.type_length
+                               + decoder->record.id_length;
+
+        count = len - index;
+        if (count > decoder->remaining) {
+          count = decoder->remaining;
+        }
+        memcpy(&decoder->type_id_buff[type_id_len - decoder->remaining],
+               &data[index],
+               count);
+        index += count;
+        decoder->remaining -= count;
+        if (decoder->remaining == 0) {
+          ndef_message_decoder_record_begin(decoder);
+        }
+        break;
+      }
+
+      case NDEF_DECODER_STATE_PAYLOAD:
+        count = len - index;
+        if (count > decoder->remaining) {
+          count = decoder->remaining;
+        }
+        decoder->callback(decoder->context,
+                          ndefDecoderRecordPayload,
+                          &decoder->record,
+                          &data[index],
+                          count);
+        index += count;
+        decoder->remaining -= count;
+        if (decoder->remaining == 0) {
+          ndef_message_decoder_record_end(decoder);
+        }
+        break;
+
+      default:
+        break;
+    }
+  }
+
+  if (decoder->state == NDEF_DECODER_STATE_DONE) {
+    return ndefMessageDecodeCompleted;
+  } else if (decoder->state == NDEF_DECODER_STATE_ERROR) {
+    return ndefMessageDecodeFail;
+  }
+
+  return ndefMessageDecodeInProgress;
+}
+
+/**************************************************************************//**
+ * @brief
+ *  Initialize a writer splitting an encoded NDEF message into chunks.
+ *
+ * @param[out] writer
+ *  Writer to be initialized
+ *
+ * @param[in] buff
+ *  Buffer holding one chunk
+ *
+ * @param[in] size
+ *  Size of a chunk, e.g. 4 for T2T WRITE
+ *
+ * @param[in] flush
+ *  Function called with each complete chunk
+ *
+ * @param[in] context
+ *  Context passed to the flush function
+ *****************************************************************************/
+void ndef_chunk_writer_init(ndef_chunk_writer_t *writer,
+                            uint8_t *buff,
+                            uint16_t size,
+                            ndef_chunk_flush_t flush,
+                            void *context)
+{
+  writer->buff = buff;
+  writer->size = size;
+  writer->len = 0;
+  writer->flush = flush;
+  writer->context = context;
+}
+
+/**************************************************************************//**
+ * @brief
+ *  Sink function of the chunk writer, to be passed to ndef_message_write()
+ *  with the writer as context. Whole chunks found in the data are flushed
+ *  without being copied into the chunk buffer.
+ *
+ * @param[in] context
+ *  Chunk writer
+ *
+ * @param[in] data
+ *  Fragment of the encoded NDEF message
+ *
+ * @param[in] len
+ *  Length of the fragment
+ *
+ * @returns
+ *  false if the flush function failed.
+ *****************************************************************************/
+bool ndef_chunk_writer_sink(void *context,
+                            const uint8_t *data,
+                            uint32_t len)
+{
+  ndef_chunk_writer_t *writer = (ndef_chunk_writer_t *) context;
+
+  while (len > 0) {
+    uint32_t count;
+
+    if ((writer->len == 0) && (len >= writer->size)) {
+      if (!writer->flush(writer->context, data, writer->size)) {
+        return false;
+      }
+      data += writer->size;
+      len -= writer->size;
+      continue;
+    }
+
+    count = writer->size - writer->len;
+    if (count > len) {
+      count = len;
+    }
+    memcpy(&writer->buff[writer->len], data, count);
+    writer->len += count;
+    data += count;
+    len -= count;
+
+    if (writer->len == writer->size) {
+      writer->len = 0;
+      if (!writer->flush(writer->context, writer->buff, writer->size)) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+/**************************************************************************//**
+ * @brief
+ *  Flush the last partial chunk of the chunk writer.
+ *
+ * @param[in] writer
+ *  Chunk writer
+ *
+ * @returns
+ *  false if the flush function failed.
+ *****************************************************************************/
+bool ndef_chunk_writer_finish(ndef_chunk_writer_t *writer)
+{
+  uint16_t len = writer->len;
+
+  if (len == 0) {
+    return true;
+  }
+
+  writer->len = 0;
+  return writer->flush(writer->context, writer->buff, len);
+}
@@ -359,3 +359,134 @@ void ndef_record_decode(ndef_record_t *record, uint8_t *record_buff)
     memcpy(record->payload, &record_buff[index], record->payload_length);
   }
 }
+
+/**************************************************************************//**
+ * @brief
+ *  Get the encoded size of a NDEF record.
+ *
+ * @param[in] record
+ *  Record to be encoded
+ *
+ * @returns
+ *  Size of the encoded record in bytes.
+ *****************************************************************************/
+uint32_t ndef_record_get_size(const ndef_record_t *record)
+{
+  uint32_t size = record->type_length + record->payload_length + 2;
+
+  /* PAYLOAD LENGTH is 1 byte in short records, 4 bytes otherwise. */
+  size += record->header.sr ? 1 : 4;
+
+  if (record->header.il) {
+    size += 1 + record->id_length;
+  }
+
+  return size;
+}
+
+/**************************************************************************//**
+ * @brief
+ *  Write the header, TYPE and ID of a NDEF record to a sink. The payload is
+ *  expected to be written to the same sink afterwards, it can be split into
+ *  any number of fragments.
+ *
+ * @param[in] record
+ *  Record to be encoded, its payload is not accessed
+ *
+ * @param[in] sink
+ *  Sink receiving the encoded fragments
+ *
+ * @param[in] context
+ *  Context passed to the sink
+ *
+ * @returns
+ *  Result of the record encode process, size includes the payload.
+ *****************************************************************************/
+ndef_record_encode_result_t ndef_record_header_write(
+  const ndef_record_t *record,
+  ndef_sink_t sink,
+  void *context)
+{
+  ndef_record_encode_result_t result;
+  uint8_t header_buff[7];
+  uint32_t index = 0;
+
+  result.size = ndef_record_get_size(record);
+
+  /* Short records can only hold 255 bytes of payload. */
+  if (record->header.sr && (record->payload_length > 0xFF)) {
+    result.err = ndefRecordEncodeOverflow;
+    return result;
+  }
+
+  /* encode HEADER */
+  header_buff[index++] = ndef_record_header_encode(record->header);
+
+  /* encode TYPE LENGTH */
+  header_buff[index++] = record->type_length;
+
+  /* encode PAYLOAD LENGTH */
+  if (record->header.sr) {
+    header_buff[index++] = (uint8_t) record->payload_length;
+  } else {
+    header_buff[index++] = (uint8_t) GET_BIT_31_TO_24(record->payload_length);
+    header_buff[index++] = (uint8_t) GET_BIT_23_TO_16(record->payload_length);
+    header_buff[index++] = (uint8_t) GET_BIT_15_TO_8(record->payload_length);
+    header_buff[index++] = (uint8_t) GET_BIT_7_TO_0(record->payload_length);
+  }
+
+  /* Encode ID LENGTH. */
+  if (record->header.il) {
+    header_buff[index++] = record->id_length;
+  }
+
+  /* TYPE and ID are passed to the sink from the record, not copied. */
+  if (!sink(context, header_buff, index)
+      || ((record->type_length > 0)
+          && !sink(context, record->type, record->type_length))
+      || (record->header.il && (record->id_length > 0)
+          && !sink(context, record->id, record->id_length))) {
+    result.err = ndefRecordEncodeSinkFail;
+    return result;
+  }
+
+  result.err = ndefRecordEncodeCompleted;
+  return result;
+}
+
+/**************************************************************************//**
+ * @brief
+ *  Write a NDEF record to a sink. Unlike ndef_record_encode(), the record is
+ *  not copied into an intermediate buffer.
+ *
+ * @param[in] record
+ *  Record to be encoded
+ *
+ * @param[in] sink
+ *  Sink receiving the encoded fragments
+ *
+ * @param[in] context
+ *  Context passed to the sink
+ *
+ * @returns
+ *  Result of the record encode process.
+ *****************************************************************************/
+ndef_record_encode_result_t ndef_record_write(const ndef_record_t *record,
+                                              ndef_sink_t sink,
+                                              void *context)
+{
+  ndef_record_encode_result_t result
+    = ndef_record_header_write(record, sink, context);
+
+  if (result.err != ndefRecordEncodeCompleted) {
+    return result;
+  }
+
+  /* Encode PAYLOAD. */
+  if ((record->payload_length > 0)
+      && !sink(context, record->payload, record->payload_length)) {
+    result.err = ndefRecordEncodeSinkFail;
+  }
+
+  return result;
+}
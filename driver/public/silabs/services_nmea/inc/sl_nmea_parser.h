@@ -0,0 +1,357 @@
+/***************************************************************************//**
+ * @file sl_nmea_parser.h
+ * @brief Incremental NMEA 0183 sentence tokenizer and decoders.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#ifndef SL_NMEA_PARSER_H_
+#define SL_NMEA_PARSER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sl_status.h"
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define SL_NMEA_MAX_SENTENCE_LENGTH        82   ///< Maximum sentence length from '$' to the end of the checksum
+#define SL_NMEA_MAX_FIELDS                 24   ///< Maximum number of fields, address field included
+#define SL_NMEA_GSA_MAX_SATELLITES         12   ///< Number of satellite ID fields of a GSA sentence
+#define SL_NMEA_GSV_MAX_SATELLITES         4    ///< Maximum number of satellites in a GSV sentence
+
+/*******************************************************************************
+ *************************   ENUMS and Structures  *****************************
+ ******************************************************************************/
+
+/// @brief Sentence types known by the decoders
+typedef enum
+{
+  SL_NMEA_SENTENCE_UNKNOWN = 0,    ///< Any other valid sentence, use the fields directly
+  SL_NMEA_SENTENCE_GGA,            ///< Global positioning system fix data
+  SL_NMEA_SENTENCE_GLL,            ///< Latitude and longitude, with time of position fix and status
+  SL_NMEA_SENTENCE_GSA,            ///< GNSS DOP and active satellites
+  SL_NMEA_SENTENCE_GSV,            ///< GNSS satellites in view
+  SL_NMEA_SENTENCE_RMC,            ///< Recommended minimum data
+  SL_NMEA_SENTENCE_VTG,            ///< Course over ground and ground speed
+} sl_nmea_sentence_type_t;
+
+/// @brief Tokenizer state, fed one byte at a time
+typedef struct
+{
+  char buffer[SL_NMEA_MAX_SENTENCE_LENGTH];   ///< Fields of the sentence, each one null terminated
+  uint8_t length;                             ///< Number of bytes stored in buffer
+  uint8_t field_offset[SL_NMEA_MAX_FIELDS];   ///< Offset of each field in buffer
+  uint8_t field_count;                        ///< Number of fields, address field included
+  uint8_t state;                              ///< Position in the sentence framing
+  uint8_t checksum;                           ///< Running checksum of the received characters
+  uint8_t received_checksum;                  ///< Checksum sent after '*'
+  sl_nmea_sentence_type_t type;               ///< Type of the last complete sentence
+} sl_nmea_tokenizer_t;
+
+/// @brief UTC time of a sentence
+typedef struct
+{
+  uint8_t hour;                    ///< Hour of day, range 0..23
+  uint8_t minute;                  ///< Minute of hour, range 0..59
+  uint8_t second;                  ///< Seconds of minute, range 0..60
+  uint16_t millisecond;            ///< Fraction of the second in ms
+  bool valid;                      ///< The time field was present
+} sl_nmea_time_t;
+
+/// @brief UTC date of a sentence
+typedef struct
+{
+  uint16_t year;                   ///< Year, 2000 based
+  uint8_t month;                   ///< Month, range 1..12
+  uint8_t day;                     ///< Day of month, range 1..31
+  bool valid;                      ///< The date field was present
+} sl_nmea_date_t;
+
+/// @brief Decoded GGA sentence
+typedef struct
+{
+  sl_nmea_time_t time;             ///< UTC time of the fix
+  int32_t latitude;                ///< Latitude: deg * 1e-7
+  int32_t longitude;               ///< Longitude: deg * 1e-7
+  bool position_valid;             ///< Latitude and longitude were present
+  uint8_t quality;                 ///< Quality indicator, 0 = no fix
+  uint8_t num_satellites;          ///< Number of satellites used
+  uint16_t hdop;                   ///< Horizontal dilution of precision * 0.01
+  int32_t altitude;                ///< Altitude above mean sea level: mm
+  bool altitude_valid;             ///< Altitude was present
+  int32_t geoid_separation;        ///< Height of the geoid above the ellipsoid: mm
+  bool geoid_separation_valid;     ///< Geoid separation was present
+} sl_nmea_gga_t;
+
+/// @brief Decoded GLL sentence
+typedef struct
+{
+  int32_t latitude;                ///< Latitude: deg * 1e-7
+  int32_t longitude;               ///< Longitude: deg * 1e-7
+  bool position_valid;             ///< Latitude and longitude were present
+  sl_nmea_time_t time;             ///< UTC time of the fix
+  bool status_valid;               ///< Status is 'A' (data valid)
+  char mode;                       ///< Positioning mode, '\0' if not sent
+} sl_nmea_gll_t;
+
+/// @brief Decoded GSA sentence
+typedef struct
+{
+  char selection_mode;             ///< 'M' manual, 'A' automatic 2D/3D
+  uint8_t fix_type;                ///< 1 = no fix, 2 = 2D fix, 3 = 3D fix
+  uint8_t satellite_count;         ///< Number of entries in satellite_id
+  uint8_t satellite_id[SL_NMEA_GSA_MAX_SATELLITES]; ///< IDs of the satellites used
+  uint16_t pdop;                   ///< Position dilution of precision * 0.01
+  uint16_t hdop;                   ///< Horizontal dilution of precision * 0.01
+  uint16_t vdop;                   ///< Vertical dilution of precision * 0.01
+  uint8_t system_id;               ///< GNSS system ID (NMEA 4.10+), 0 if not sent
+} sl_nmea_gsa_t;
+
+/// @brief One satellite of a GSV sentence
+typedef struct
+{
+  uint8_t id;                      ///< Satellite ID
+  int8_t elevation;                ///< Elevation: deg
+  uint16_t azimuth;                ///< Azimuth: deg
+  int8_t snr;                      ///< Signal strength: dBHz, -1 when not tracked
+} sl_nmea_gsv_satellite_t;
+
+/// @brief Decoded GSV sentence
+typedef struct
+{
+  uint8_t message_count;           ///< Number of GSV sentences of the cycle
+  uint8_t message_number;          ///< Number of this sentence, 1 based
+  uint8_t satellites_in_view;      ///< Total number of satellites in view
+  uint8_t satellite_count;         ///< Number of entries in satellites
+  sl_nmea_gsv_satellite_t satellites[SL_NMEA_GSV_MAX_SATELLITES]; ///< Satellites of this sentence
+} sl_nmea_gsv_t;
+
+/// @brief Decoded RMC sentence
+typedef struct
+{
+  sl_nmea_time_t time;             ///< UTC time of the fix
+  sl_nmea_date_t date;             ///< UTC date of the fix
+  bool status_valid;               ///< Status is 'A' (data valid)
+  int32_t latitude;                ///< Latitude: deg * 1e-7
+  int32_t longitude;               ///< Longitude: deg * 1e-7
+  bool position_valid;             ///< Latitude and longitude were present
+  int32_t speed;                   ///< Speed over ground: knots * 1e-3
+  bool speed_valid;                ///< Speed was present
+  int32_t course;                  ///< Course over ground: deg * 1e-3
+  bool course_valid;               ///< Course was present
+  char mode;                       ///< Positioning mode, '\0' if not sent
+} sl_nmea_rmc_t;
+
+/// @brief Decoded VTG sentence
+typedef struct
+{
+  int32_t course_true;             ///< Course over ground, true: deg * 1e-3
+  bool course_true_valid;          ///< True course was present
+  int32_t course_magnetic;         ///< Course over ground, magnetic: deg * 1e-3
+  bool course_magnetic_valid;      ///< Magnetic course was present
+  int32_t speed_knots;             ///< Speed over ground: knots * 1e-3
+  int32_t speed_kmh;               ///< Speed over ground: km/h * 1e-3
+  bool speed_valid;                ///< Speed was present
+  char mode;                       ///< Positioning mode, '\0' if not sent
+} sl_nmea_vtg_t;
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/**************************************************************************//**
+ * @brief Reset a tokenizer, it waits for the next '$'.
+ * @param[out] tokenizer : tokenizer instance.
+ *****************************************************************************/
+void sl_nmea_tokenizer_init(sl_nmea_tokenizer_t *tokenizer);
+
+/**************************************************************************//**
+ * @brief Feed the next received character.
+ * @param[in] tokenizer : tokenizer instance.
+ * @param[in] c : received character.
+ * @return true when c completed a sentence with a valid checksum, its fields
+ *         stay available until the next '$' is fed.
+ * @note Bytes before a '$', line endings and corrupted or overlong sentences
+ *       are dropped without having to buffer them.
+ *****************************************************************************/
+bool sl_nmea_tokenizer_process(sl_nmea_tokenizer_t *tokenizer, char c);
+
+/**************************************************************************//**
+ * @brief Get the type of the last complete sentence.
+ * @param[in] tokenizer : tokenizer instance.
+ * @return sentence type.
+ *****************************************************************************/
+sl_nmea_sentence_type_t sl_nmea_get_sentence_type(
+  const sl_nmea_tokenizer_t *tokenizer);
+
+/**************************************************************************//**
+ * @brief Get the number of fields of the last complete sentence.
+ * @param[in] tokenizer : tokenizer instance.
+ * @return number of fields, address field included.
+ *****************************************************************************/
+uint8_t sl_nmea_get_field_count(const sl_nmea_tokenizer_t *tokenizer);
+
+/**************************************************************************//**
+ * @brief Get a field of the last complete sentence.
+ * @param[in] tokenizer : tokenizer instance.
+ * @param[in] index : field index, 0 is the address field (e.g. "GPGGA").
+ * @return null terminated field, empty string if the sentence has fewer fields.
+ *****************************************************************************/
+const char *sl_nmea_get_field(const sl_nmea_tokenizer_t *tokenizer,
+                              uint8_t index);
+
+/**************************************************************************//**
+ * @brief Parse an unsigned integer field, a fraction is ignored.
+ * @param[in] field : null terminated field.
+ * @param[out] value : parsed value.
+ * @return true if the field holds a number, false if it is empty.
+ *****************************************************************************/
+bool sl_nmea_parse_uint(const char *field, uint32_t *value);
+
+/**************************************************************************//**
+ * @brief Parse a decimal field into a fixed-point integer.
+ * @param[in] field : null terminated field.
+ * @param[in] decimals : number of decimals kept (at most 7), extra ones are truncated.
+ * @param[out] value : parsed value * 10^decimals.
+ * @return true if the field holds a number, false if it is empty.
+ *****************************************************************************/
+bool sl_nmea_parse_fixed(const char *field, uint8_t decimals, int32_t *value);
+
+/**************************************************************************//**
+ * @brief Parse a (d)ddmm.mmmmm coordinate field, integer arithmetic only.
+ * @param[in] field : null terminated coordinate field.
+ * @param[in] hemisphere : null terminated N/S/E/W field.
+ * @param[out] value : coordinate: deg * 1e-7, negative for S and W.
+ * @return true if the field holds a coordinate, false if it is empty.
+ *****************************************************************************/
+bool sl_nmea_parse_coordinate(const char *field,
+                              const char *hemisphere,
+                              int32_t *value);
+
+/**************************************************************************//**
+ * @brief Parse a hhmmss.sss time field.
+ * @param[in] field : null terminated field.
+ * @param[out] time : parsed time, valid is false if the field is empty.
+ *****************************************************************************/
+void sl_nmea_parse_time(const char *field, sl_nmea_time_t *time);
+
+/**************************************************************************//**
+ * @brief Parse a ddmmyy date field.
+ * @param[in] field : null terminated field.
+ * @param[out] date : parsed date, valid is false if the field is empty.
+ *****************************************************************************/
+void sl_nmea_parse_date(const char *field, sl_nmea_date_t *date);
+
+/**************************************************************************//**
+ * @brief Decode the last complete sentence as GGA.
+ * @param[in] tokenizer : tokenizer instance.
+ * @param[out] gga : decoded sentence.
+ * @return The following values are returned:
+ * - \ref SL_STATUS_OK on success.
+ * - \ref SL_STATUS_NULL_POINTER if an argument is NULL.
+ * - \ref SL_STATUS_INVALID_TYPE if the sentence is not a GGA one.
+ *****************************************************************************/
+sl_status_t sl_nmea_decode_gga(const sl_nmea_tokenizer_t *tokenizer,
+                               sl_nmea_gga_t *gga);
+
+/**************************************************************************//**
+ * @brief Decode the last complete sentence as GLL.
+ * @param[in] tokenizer : tokenizer instance.
+ * @param[out] gll : decoded sentence.
+ * @return The following values are returned:
+ * - \ref SL_STATUS_OK on success.
+ * - \ref SL_STATUS_NULL_POINTER if an argument is NULL.
+ * - \ref SL_STATUS_INVALID_TYPE if the sentence is not a GLL one.
+ *****************************************************************************/
+sl_status_t sl_nmea_decode_gll(const sl_nmea_tokenizer_t *tokenizer,
+                               sl_nmea_gll_t *gll);
+
+/**************************************************************************//**
+ * @brief Decode the last complete sentence as GSA.
+ * @param[in] tokenizer : tokenizer instance.
+ * @param[out] gsa : decoded sentence.
+ * @return The following values are returned:
+ * - \ref SL_STATUS_OK on success.
+ * - \ref SL_STATUS_NULL_POINTER if an argument is NULL.
+ * - \ref SL_STATUS_INVALID_TYPE if the sentence is not a GSA one.
+ *****************************************************************************/
+sl_status_t sl_nmea_decode_gsa(const sl_nmea_tokenizer_t *tokenizer,
+                               sl_nmea_gsa_t *gsa);
+
+/**************************************************************************//**
+ * @brief Decode the last complete sentence as GSV.
+ * @param[in] tokenizer : tokenizer instance.
+ * @param[out] gsv : decoded sentence.
+ * @return The following values are returned:
+ * - \ref SL_STATUS_OK on success.
+ * - \ref SL_STATUS_NULL_POINTER if an argument is NULL.
+ * - \ref SL_STATUS_INVALID_TYPE if the sentence is not a GSV one.
+ *****************************************************************************/
+sl_status_t sl_nmea_decode_gsv(const sl_nmea_tokenizer_t *tokenizer,
+                               sl_nmea_gsv_t *gsv);
+
+/**************************************************************************//**
+ * @brief Decode the last complete sentence as RMC.
+ * @param[in] tokenizer : tokenizer instance.
+ * @param[out] rmc : decoded sentence.
+ * @return The following values are returned:
+ * - \ref SL_STATUS_OK on success.
+ * - \ref SL_STATUS_NULL_POINTER if an argument is NULL.
+ * - \ref SL_STATUS_INVALID_TYPE if the sentence is not a RMC one.
+ *****************************************************************************/
+sl_status_t sl_nmea_decode_rmc(const sl_nmea_tokenizer_t *tokenizer,
+                               sl_nmea_rmc_t *rmc);
+
+/**************************************************************************//**
+ * @brief Decode the last complete sentence as VTG.
+ * @param[in] tokenizer : tokenizer instance.
+ * @param[out] vtg : decoded sentence.
+ * @return The following values are returned:
+ * - \ref SL_STATUS_OK on success.
+ * - \ref SL_STATUS_NULL_POINTER if an argument is NULL.
+ * - \ref SL_STATUS_INVALID_TYPE if the sentence is not a VTG one.
+ *****************************************************************************/
+sl_status_t sl_nmea_decode_vtg(const sl_nmea_tokenizer_t *tokenizer,
+                               sl_nmea_vtg_t *vtg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SL_NMEA_PARSER_H_
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
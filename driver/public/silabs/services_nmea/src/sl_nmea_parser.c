@@ -0,0 +1,576 @@
+/***************************************************************************//**
+ * @file sl_nmea_parser.c
+ * @brief Incremental NMEA 0183 sentence tokenizer and decoders.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+#include <stddef.h>
+#include "sl_nmea_parser.h"
+
+/// Position of the tokenizer in the sentence framing
+#define NMEA_STATE_IDLE          0 ///< Waiting for '$'
+#define NMEA_STATE_DATA          1 ///< Receiving the fields
+#define NMEA_STATE_CHECKSUM_HI   2 ///< Waiting for the first checksum digit
+#define NMEA_STATE_CHECKSUM_LO   3 ///< Waiting for the second checksum digit
+
+/// Sentence formatters, the address field is the talker ID followed by them
+static const struct {
+  char formatter[4];
+  sl_nmea_sentence_type_t type;
+} sentence_types[] = {
+  { "GGA", SL_NMEA_SENTENCE_GGA },
+  { "GLL", SL_NMEA_SENTENCE_GLL },
+  { "GSA", SL_NMEA_SENTENCE_GSA },
+  { "GSV", SL_NMEA_SENTENCE_GSV },
+  { "RMC", SL_NMEA_SENTENCE_RMC },
+  { "VTG", SL_NMEA_SENTENCE_VTG },
+};
+
+static const int32_t nmea_pow10[] = {
+  1, 10, 100, 1000, 10000, 100000, 1000000, 10000000
+};
+
+/**************************************************************************//**
+ * @brief Convert a hexadecimal digit.
+ * @param[in] c : character to convert.
+ * @return value of the digit, -1 if c is not a hexadecimal digit.
+ *****************************************************************************/
+static int8_t nmea_hex_value(char c);
+
+/**************************************************************************//**
+ * @brief Find the sentence type from the address field.
+ * @param[in] address : null terminated address field.
+ * @return sentence type.
+ *****************************************************************************/
+static sl_nmea_sentence_type_t nmea_classify(const char *address);
+
+/**************************************************************************//**
+ * @brief Parse fixed-point digits, stopping at the first other character.
+ * @param[in] s : first digit.
+ * @param[in] decimals : number of decimals kept.
+ * @param[out] value : parsed value * 10^decimals.
+ * @return true if at least one digit was found.
+ *****************************************************************************/
+static bool nmea_parse_digits(const char *s, uint8_t decimals, int32_t *value);
+
+void sl_nmea_tokenizer_init(sl_nmea_tokenizer_t *tokenizer)
+{
+  tokenizer->length = 0;
+  tokenizer->field_count = 0;
+  tokenizer->state = NMEA_STATE_IDLE;
+  tokenizer->checksum = 0;
+  tokenizer->received_checksum = 0;
+  tokenizer->type = SL_NMEA_SENTENCE_UNKNOWN;
+}
+
+bool sl_nmea_tokenizer_process(sl_nmea_tokenizer_t *tokenizer, char c)
+{
+  int8_t digit;
+
+  if (c == '$') {
+    tokenizer->length = 0;
+    tokenizer->field_offset[0] = 0;
+    tokenizer->field_count = 1;
+    tokenizer->checksum = 0;
+    tokenizer->type = SL_NMEA_SENTENCE_UNKNOWN;
+    tokenizer->state = NMEA_STATE_DATA;
+    return false;
+  }
+
+  switch (tokenizer->state) {
+    case NMEA_STATE_DATA:
+      /// Keep room for the terminator of the last field
+      if (tokenizer->length >= (SL_NMEA_MAX_SENTENCE_LENGTH - 1)) {
+        tokenizer->state = NMEA_STATE_IDLE;
+        break;
+      }
+
+      /// Plain field characters are by far the most frequent
+      if ((c != ',') && (c != '*') && (c != '\r') && (c != '\n')) {
+        tokenizer->checksum ^= (uint8_t)c;
+        tokenizer->buffer[tokenizer->length++] = c;
+        break;
+      }
+
+      if (c == ',') {
+        if (tokenizer->field_count == SL_NMEA_MAX_FIELDS) {
+          tokenizer->state = NMEA_STATE_IDLE;
+          break;
+        }
+        tokenizer->checksum ^= (uint8_t)c;
+        tokenizer->buffer[tokenizer->length++] = '\0';
+        tokenizer->field_offset[tokenizer->field_count++] = tokenizer->length;
+      } else if (c == '*') {
+        tokenizer->buffer[tokenizer->length++] = '\0';
+        tokenizer->state = NMEA_STATE_CHECKSUM_HI;
+      } else {
+        /// Sentences without checksum are not accepted
+        tokenizer->state = NMEA_STATE_IDLE;
+      }
+      break;
+
+    case NMEA_STATE_CHECKSUM_HI:
+      digit = nmea_hex_value(c);
+      if (digit < 0) {
+        tokenizer->state = NMEA_STATE_IDLE;
+        break;
+      }
+      tokenizer->received_checksum = (uint8_t)(digit << 4);
+      tokenizer->state = NMEA_STATE_CHECKSUM_LO;
+      break;
+
+    case NMEA_STATE_CHECKSUM_LO:
+      digit = nmea_hex_value(c);
+      tokenizer->state = NMEA_STATE_IDLE;
+      if ((digit < 0)
+          || ((tokenizer->received_checksum | digit) != tokenizer->checksum)) {
+        break;
+      }
+      tokenizer->type = nmea_classify(tokenizer->buffer);
+      return true;
+
+    default:
+      break;
+  }
+
+  return false;
+}
+
+sl_nmea_sentence_type_t sl_nmea_get_sentence_type(
+  const sl_nmea_tokenizer_t *tokenizer)
+{
+  return tokenizer->type;
+}
+
+uint8_t sl_nmea_get_field_count(const sl_nmea_tokenizer_t *tokenizer)
+{
+  return tokenizer->field_count;
+}
+
+const char *sl_nmea_get_field(const sl_nmea_tokenizer_t *tokenizer,
+                              uint8_t index)
+{
+  if (index >= tokenizer->field_count) {
+    return "";
+  }
+
+  return &tokenizer->buffer[tokenizer->field_offset[index]];
+}
+
+bool sl_nmea_parse_uint(const char *field, uint32_t *value)
+{
+  uint32_t r = 0;
+
+  if ((*field < '0') || (*field > '9')) {
+    return false;
+  }
+
+  while ((*field >= '0') && (*field <= '9')) {
+    r = 10 * r + (uint32_t)(*field++ - '0');
+  }
+
+  *value = r;
+  return true;
+}
+
+bool sl_nmea_parse_fixed(const char *field, uint8_t decimals, int32_t *value)
+{
+  bool negative = false;
+
+  if ((*field == '-') || (*field == '+')) {
+    negative = (*field == '-');
+    field++;
+  }
+
+  if (!nmea_parse_digits(field, decimals, value)) {
+    return false;
+  }
+
+  if (negative) {
+    *value = -*value;
+  }
+
+  return true;
+}
+
+bool sl_nmea_parse_coordinate(const char *field,
+                              const char *hemisphere,
+                              int32_t *value)
+{
+  int32_t minutes;
+  int32_t degrees = 0;
+  uint8_t deg_width = 0;
+
+  /// Degrees take all the integer digits but the last two (minutes)
+  while ((field[deg_width] >= '0') && (field[deg_width] <= '9')) {
+    deg_width++;
+  }
+
+  if (deg_width < 2) {
+    return false;
+  }
+  deg_width -= 2;
+
+  for (uint8_t i = 0; i < deg_width; i++) {
+    degrees = 10 * degrees + (field[i] - '0');
+  }
+
+  if (!nmea_parse_digits(&field[deg_width], 5, &minutes)) {
+    return false;
+  }
+
+  /// minutes * 1e5 / 60 * 1e2, rounded to the nearest 1e-7 deg
+  *value = degrees * 10000000L + (minutes * 5 + 1) / 3;
+
+  if ((*hemisphere == 'S') || (*hemisphere == 'W')) {
+    *value = -*value;
+  }
+
+  return true;
+}
+
+void sl_nmea_parse_time(const char *field, sl_nmea_time_t *time)
+{
+  int32_t ms;
+
+  time->valid = false;
+
+  for (uint8_t i = 0; i < 6; i++) {
+    if ((field[i] < '0') || (field[i] > '9')) {
+      return;
+    }
+  }
+
+  time->hour = (field[0] - '0') * 10 + (field[1] - '0');
+  time->minute = (field[2] - '0') * 10 + (field[3] - '0');
+  time->second = (field[4] - '0') * 10 + (field[5] - '0');
+  time->millisecond = 0;
+
+  if ((field[6] == '.') && nmea_parse_digits(&field[6], 3, &ms)) {
+    time->millisecond = (uint16_t)ms;
+  }
+
+  time->valid = true;
+}
+
+void sl_nmea_parse_date(const char *field, sl_nmea_date_t *date)
+{
+  date->valid = false;
+
+  for (uint8_t i = 0; i < 6; i++) {
+    if ((field[i] < '0') || (field[i] > '9')) {
+      return;
+    }
+  }
+
+  date->day = (field[0] - '0') * 10 + (field[1] - '0');
+  date->month = (field[2] - '0') * 10 + (field[3] - '0');
+  date->year = 2000 + (field[4] - '0') * 10 + (field[5] - '0');
+  date->valid = true;
+}
+
+sl_status_t sl_nmea_decode_gga(const sl_nmea_tokenizer_t *tokenizer,
+                               sl_nmea_gga_t *gga)
+{
+  uint32_t value;
+  int32_t fixed;
+
+  if ((tokenizer == NULL) || (gga == NULL)) {
+    return SL_STATUS_NULL_POINTER;
+  }
+
+  if (tokenizer->type != SL_NMEA_SENTENCE_GGA) {
+    return SL_STATUS_INVALID_TYPE;
+  }
+
+  sl_nmea_parse_time(sl_nmea_get_field(tokenizer, 1), &gga->time);
+  gga->position_valid =
+    sl_nmea_parse_coordinate(sl_nmea_get_field(tokenizer, 2),
+                             sl_nmea_get_field(tokenizer, 3),
+                             &gga->latitude)
+    && sl_nmea_parse_coordinate(sl_nmea_get_field(tokenizer, 4),
+                                sl_nmea_get_field(tokenizer, 5),
+                                &gga->longitude);
+  gga->quality = sl_nmea_parse_uint(sl_nmea_get_field(tokenizer, 6), &value)
+                 ? (uint8_t)value : 0;
+  gga->num_satellites =
+    sl_nmea_parse_uint(sl_nmea_get_field(tokenizer, 7), &value)
+    ? (uint8_t)value : 0;
+  gga->hdop = sl_nmea_parse_fixed(sl_nmea_get_field(tokenizer, 8), 2, &fixed)
+              ? (uint16_t)fixed : UINT16_MAX;
+  gga->altitude_valid = sl_nmea_parse_fixed(sl_nmea_get_field(tokenizer, 9),
+                                            3,
+                                            &gga->altitude);
+  gga->geoid_separation_valid =
+    sl_nmea_parse_fixed(sl_nmea_get_field(tokenizer, 11),
+                        3,
+                        &gga->geoid_separation);
+
+  return SL_STATUS_OK;
+}
+
+sl_status_t sl_nmea_decode_gll(const sl_nmea_tokenizer_t *tokenizer,
+                               sl_nmea_gll_t *gll)
+{
+  if ((tokenizer == NULL) || (gll == NULL)) {
+    return SL_STATUS_NULL_POINTER;
+  }
+
+  if (tokenizer->type != SL_NMEA_SENTENCE_GLL) {
+    return SL_STATUS_INVALID_TYPE;
+  }
+
+  gll->position_valid =
+    sl_nmea_parse_coordinate(sl_nmea_get_field(tokenizer, 1),
+                             sl_nmea_get_field(tokenizer, 2),
+                             &gll->latitude)
+    && sl_nmea_parse_coordinate(sl_nmea_get_field(tokenizer, 3),
+                                sl_nmea_get_field(tokenizer, 4),
+                                &gll->longitude);
+  sl_nmea_parse_time(sl_nmea_get_field(tokenizer, 5), &gll->time);
+  gll->status_valid = (*sl_nmea_get_field(tokenizer, 6) == 'A');
+  gll->mode = *sl_nmea_get_field(tokenizer, 7);
+
+  return SL_STATUS_OK;
+}
+
+sl_status_t sl_nmea_decode_gsa(const sl_nmea_tokenizer_t *tokenizer,
+                               sl_nmea_gsa_t *gsa)
+{
+  uint32_t value;
+  int32_t fixed;
+
+  if ((tokenizer == NULL) || (gsa == NULL)) {
+    return SL_STATUS_NULL_POINTER;
+  }
+
+  if (tokenizer->type != SL_NMEA_SENTENCE_GSA) {
+    return SL_STATUS_INVALID_TYPE;
+  }
+
+  gsa->selection_mode = *sl_nmea_get_field(tokenizer, 1);
+  gsa->fix_type = sl_nmea_parse_uint(sl_nmea_get_field(tokenizer, 2), &value)
+                  ? (uint8_t)value : 0;
+
+  gsa->satellite_count = 0;
+  for (uint8_t i = 0; i < SL_NMEA_GSA_MAX_SATELLITES; i++) {
+    if (sl_nmea_parse_uint(sl_nmea_get_field(tokenizer, 3 + i), &value)) {
+      gsa->satellite_id[gsa->satellite_count++] = (uint8_t)value;
+    }
+  }
+
+  gsa->pdop = sl_nmea_parse_fixed(sl_nmea_get_field(tokenizer, 15), 2, &fixed)
+              ? (uint16_t)fixed : UINT16_MAX;
+  gsa->hdop = sl_nmea_parse_fixed(sl_nmea_get_field(tokenizer, 16), 2, &fixed)
+              ? (uint16_t)fixed : UINT16_MAX;
+  gsa->vdop = sl_nmea_parse_fixed(sl_nmea_get_field(tokenizer, 17), 2, &fixed)
+              ? (uint16_t)fixed : UINT16_MAX;
+  gsa->system_id =
+    sl_nmea_parse_uint(sl_nmea_get_field(tokenizer, 18), &value)
+    ? (uint8_t)value : 0;
+
+  return SL_STATUS_OK;
+}
+
+sl_status_t sl_nmea_decode_gsv(const sl_nmea_tokenizer_t *tokenizer,
+                               sl_nmea_gsv_t *gsv)
+{
+  uint32_t value;
+  uint8_t count;
+
+  if ((tokenizer == NULL) || (gsv == NULL)) {
+    return SL_STATUS_NULL_POINTER;
+  }
+
+  if (tokenizer->type != SL_NMEA_SENTENCE_GSV) {
+    return SL_STATUS_INVALID_TYPE;
+  }
+
+  gsv->message_count =
+    sl_nmea_parse_uint(sl_nmea_get_field(tokenizer, 1), &value)
+    ? (uint8_t)value : 0;
+  gsv->message_number =
+    sl_nmea_parse_uint(sl_nmea_get_field(tokenizer, 2), &value)
+    ? (uint8_t)value : 0;
+  gsv->satellites_in_view =
+    sl_nmea_parse_uint(sl_nmea_get_field(tokenizer, 3), &value)
+    ? (uint8_t)value : 0;
+
+  /// Four fields per satellite, NMEA 4.10 appends a single signal ID field
+  count = (tokenizer->field_count > 4) ? (tokenizer->field_count - 4) / 4 : 0;
+  if (count > SL_NMEA_GSV_MAX_SATELLITES) {
+    count = SL_NMEA_GSV_MAX_SATELLITES;
+  }
+
+  gsv->satellite_count = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    sl_nmea_gsv_satellite_t *sat = &gsv->satellites[gsv->satellite_count];
+    uint8_t field = 4 + 4 * i;
+
+    if (!sl_nmea_parse_uint(sl_nmea_get_field(tokenizer, field), &value)) {
+      continue;
+    }
+    sat->id = (uint8_t)value;
+    sat->elevation =
+      sl_nmea_parse_uint(sl_nmea_get_field(tokenizer, field + 1), &value)
+      ? (int8_t)value : 0;
+    sat->azimuth =
+      sl_nmea_parse_uint(sl_nmea_get_field(tokenizer, field + 2), &value)
+      ? (uint16_t)value : 0;
+    sat->snr =
+      sl_nmea_parse_uint(sl_nmea_get_field(tokenizer, field + 3), &value)
+      ? (int8_t)value : -1;
+    gsv->satellite_count++;
+  }
+
+  return SL_STATUS_OK;
+}
+
+sl_status_t sl_nmea_decode_rmc(const sl_nmea_tokenizer_t *tokenizer,
+                               sl_nmea_rmc_t *rmc)
+{
+  if ((tokenizer == NULL) || (rmc == NULL)) {
+    return SL_STATUS_NULL_POINTER;
+  }
+
+  if (tokenizer->type != SL_NMEA_SENTENCE_RMC) {
+    return SL_STATUS_INVALID_TYPE;
+  }
+
+  sl_nmea_parse_time(sl_nmea_get_field(tokenizer, 1), &rmc->time);
+  rmc->status_valid = (*sl_nmea_get_field(tokenizer, 2) == 'A');
+  rmc->position_valid =
+    sl_nmea_parse_coordinate(sl_nmea_get_field(tokenizer, 3),
+                             sl_nmea_get_field(tokenizer, 4),
+                             &rmc->latitude)
+    && sl_nmea_parse_coordinate(sl_nmea_get_field(tokenizer, 5),
+                                sl_nmea_get_field(tokenizer, 6),
+                                &rmc->longitude);
+  rmc->speed_valid = sl_nmea_parse_fixed(sl_nmea_get_field(tokenizer, 7),
+                                         3,
+                                         &rmc->speed);
+  rmc->course_valid = sl_nmea_parse_fixed(sl_nmea_get_field(tokenizer, 8),
+                                          3,
+                                          &rmc->course);
+  sl_nmea_parse_date(sl_nmea_get_field(tokenizer, 9), &rmc->date);
+  rmc->mode = *sl_nmea_get_field(tokenizer, 12);
+
+  return SL_STATUS_OK;
+}
+
+sl_status_t sl_nmea_decode_vtg(const sl_nmea_tokenizer_t *tokenizer,
+                               sl_nmea_vtg_t *vtg)
+{
+  if ((tokenizer == NULL) || (vtg == NULL)) {
+    return SL_STATUS_NULL_POINTER;
+  }
+
+  if (tokenizer->type != SL_NMEA_SENTENCE_VTG) {
+    return SL_STATUS_INVALID_TYPE;
+  }
+
+  vtg->course_true_valid = sl_nmea_parse_fixed(sl_nmea_get_field(tokenizer, 1),
+                                               3,
+                                               &vtg->course_true);
+  vtg->course_magnetic_valid =
+    sl_nmea_parse_fixed(sl_nmea_get_field(tokenizer, 3),
+                        3,
+                        &vtg->course_magnetic);
+  vtg->speed_valid = sl_nmea_parse_fixed(sl_nmea_get_field(tokenizer, 5),
+                                         3,
+                                         &vtg->speed_knots)
+                     && sl_nmea_parse_fixed(sl_nmea_get_field(tokenizer, 7),
+                                            3,
+                                            &vtg->speed_kmh);
+  vtg->mode = *sl_nmea_get_field(tokenizer, 9);
+
+  return SL_STATUS_OK;
+}
+
+static int8_t nmea_hex_value(char c)
+{
+  if ((c >= '0') && (c <= '9')) {
+    return c - '0';
+  } else if ((c >= 'A') && (c <= 'F')) {
+    return c - 'A' + 10;
+  } else if ((c >= 'a') && (c <= 'f')) {
+    return c - 'a' + 10;
+  }
+
+  return -1;
+}
+
+static sl_nmea_sentence_type_t nmea_classify(const char *address)
+{
+  const char *formatter;
+
+  /// Two character talker ID (GP, GN, GL, ...), proprietary ones start with P
+  if ((address[0] == 'P') || (address[0] == '\0') || (address[1] == '\0')) {
+    return SL_NMEA_SENTENCE_UNKNOWN;
+  }
+  formatter = &address[2];
+
+  for (uint8_t i = 0; i < sizeof(sentence_types) / sizeof(sentence_types[0]);
+       i++) {
+    if ((formatter[0] == sentence_types[i].formatter[0])
+        && (formatter[1] == sentence_types[i].formatter[1])
+        && (formatter[2] == sentence_types[i].formatter[2])
+        && (formatter[3] == '\0')) {
+      return sentence_types[i].type;
+    }
+  }
+
+  return SL_NMEA_SENTENCE_UNKNOWN;
+}
+
+static bool nmea_parse_digits(const char *s, uint8_t decimals, int32_t *value)
+{
+  int32_t r = 0;
+  bool found = false;
+
+  while ((*s >= '0') && (*s <= '9')) {
+    r = 10 * r + (*s++ - '0');
+    found = true;
+  }
+
+  r *= nmea_pow10[decimals];
+
+  if (*s == '.') {
+    s++;
+    while ((*s >= '0') && (*s <= '9') && decimals) {
+      r += (*s++ - '0') * nmea_pow10[--decimals];
+      found = true;
+    }
+  }
+
+  *value = r;
+  return found;
+}